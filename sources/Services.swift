@@ -12,6 +12,10 @@ public final class Services {
     public let streamer: Streamer
     /// Instance letting you query a databse for caching purposes.
     public let database: Database
+    /// The clock driving all time-dependent services (it is the `api`'s clock).
+    public var clock: Clock {
+        self.api.clock
+    }
     
     /// Designated initializer specifying every single service.
     ///
@@ -34,12 +38,15 @@ public final class Services {
     /// - parameter serverURL: The base/root URL for all HTTP endpoint calls. The default URL points to IG's production environment.
     /// - parameter apiKey: [API key](https://labs.ig.com/gettingstarted) given by the IG platform identifying the usage of the IG endpoints.
     /// - parameter user: User name and password to log into an IG account.
+    /// - parameter clock: The clock driving all time-dependent services.
+    /// - parameter executors: The executors for each workload class. Workloads with `.automatic` executors run on the services' concurrent queue.
     /// - returns: A fully initialized `Services` instance with all services enabled (and logged in).
-    public static func make(withDatabase databaseLocation: Database.Location, serverURL: URL = API.rootURL, apiKey: API.Key, user: API.User) -> AnyPublisher<Services,IG.Error> {
+    public static func make(withDatabase databaseLocation: Database.Location, serverURL: URL = API.rootURL, apiKey: API.Key, user: API.User, clock: Clock = SystemClock.shared, executors: Executors = .automatic) -> AnyPublisher<Services,IG.Error> {
         let queue = Self._makeQueue(targetQueue: nil)
-        let api = API(rootURL: serverURL, credentials: nil, queue: queue)
+        let executors = executors._resolved(fallback: queue)
+        let api = API(rootURL: serverURL, credentials: nil, executors: executors, clock: clock)
         return api.session.login(type: .certificate, key: apiKey, user: user)
-            .flatMap { _ in Self._make(with: api, queue: queue, location: databaseLocation) }
+            .flatMap { _ in Self._make(with: api, queue: queue, executors: executors, location: databaseLocation) }
             .eraseToAnyPublisher()
     }
     
@@ -50,10 +57,13 @@ public final class Services {
     /// - parameter serverURL: The base/root URL for all HTTP endpoint calls. The default URL points to IG's production environment.
     /// - parameter apiKey: [API key](https://labs.ig.com/gettingstarted) given by the IG platform identifying the usage of the IG endpoints.
     /// - parameter token: The API token (whether OAuth or certificate) to use to retrieve all user's data.
+    /// - parameter clock: The clock driving all time-dependent services.
+    /// - parameter executors: The executors for each workload class. Workloads with `.automatic` executors run on the services' concurrent queue.
     /// - returns: A fully initialized `Services` instance with all services enabled (and logged in).
-    public static func make(withDatabase databaseLocation: Database.Location, serverURL: URL = API.rootURL, apiKey: API.Key, token: API.Token) -> AnyPublisher<Services,IG.Error> {
+    public static func make(withDatabase databaseLocation: Database.Location, serverURL: URL = API.rootURL, apiKey: API.Key, token: API.Token, clock: Clock = SystemClock.shared, executors: Executors = .automatic) -> AnyPublisher<Services,IG.Error> {
         let queue = Self._makeQueue(targetQueue: nil)
-        let api = API(rootURL: serverURL, credentials: nil, queue: queue)
+        let executors = executors._resolved(fallback: queue)
+        let api = API(rootURL: serverURL, credentials: nil, executors: executors, clock: clock)
         
         /// This closure  creates  the remaining subservices from the given api key and token.
         /// - requires: The `token` passed to this closure must be valid and already tested. If not, an error event will be sent.
@@ -61,11 +71,11 @@ public final class Services {
             return api.session.get(key: apiKey, token: token)
                 .flatMap { (session) -> AnyPublisher<Services,IG.Error> in
                     api.channel.credentials = API.Credentials(key: apiKey, client: session.client, account: session.account, streamerURL: session.streamerURL, timezone: session.timezone, token: token)
-                    return Self._make(with: api, queue: queue, location: databaseLocation)
+                    return Self._make(with: api, queue: queue, executors: executors, location: databaseLocation)
                 }
         }
         
-        guard token.expirationDate > Date() else {
+        guard token.expirationDate > clock.now else {
             switch token.value {
             case .certificate:
                 return Fail(error: ._expiredToken())
@@ -93,16 +103,17 @@ private extension Services {
     /// Creates a streamer from an API instance and package both in a `Services` structure.
     /// - parameter api: The API instance with valid credentials.
     /// - parameter queue: Concurrent queue used to synchronize all IG's events.
+    /// - parameter executors: The resolved executors (every workload class points to a concrete queue).
     /// - parameter location: The location of the database (whether "in-memory" or file system).
     /// - requires: Valid (not expired) credentials on the given `API` instance or an error event will be sent.
-    static func _make(with api: API, queue: DispatchQueue, location: Database.Location) -> AnyPublisher<Services,IG.Error> {
+    static func _make(with api: API, queue: DispatchQueue, executors: Executors, location: Database.Location) -> AnyPublisher<Services,IG.Error> {
         // Check that there is API credentials.
         guard var apiCredentials = api.channel.credentials else {
             return Fail(error: ._unfoundAPICredentials())
                 .eraseToAnyPublisher()
         }
         // Check that they haven't expired.
-        guard apiCredentials.token.expirationDate > Date() else {
+        guard apiCredentials.token.expirationDate > api.clock.now else {
             return Fail(error: ._expiredAPICredentials())
                 .eraseToAnyPublisher()
         }
@@ -110,8 +121,8 @@ private extension Services {
         let subServicesGenerator: ()->Result<Services,IG.Error> = {
             do {
                 let secret = try Streamer.Credentials(apiCredentials)
-                let database = try Database(location: location, queue: queue)
-                let streamer = Streamer(rootURL: apiCredentials.streamerURL, credentials: secret, queue: queue)
+                let database = try Database(location: location, executors: executors)
+                let streamer = Streamer(rootURL: apiCredentials.streamerURL, credentials: secret, executors: executors, clock: api.clock)
                 return .success(Services(queue: queue, api: api, streamer: streamer, database: database))
             } catch let error {
                 return .failure(error as! IG.Error)
@@ -11,6 +11,8 @@ public final class API {
     internal final let queue: DispatchQueue
     /// The URL Session instance for performing HTTPS requests.
     internal final let channel: API.Channel
+    /// The clock measuring token expirations and providing default dates.
+    public final let clock: Clock
     
     /// Namespace for endpoints related to the current API session (e.g. log in/out, refresh token, etc.).
     @inlinable public final var session: API.Request.Session { .init(api: self) }
@@ -31,10 +33,21 @@ public final class API {
     /// - parameter rootURL: The base/root URL for all endpoint calls.
     /// - parameter credentials: `nil` for yet unknown credentials (most of the cases); otherwise, use your hard-coded credentials.
     /// - parameter queue: The queue used to process the requests and responses. If `nil`, the system will create a serial queue.
-    public convenience init(rootURL: URL = API.rootURL, credentials: API.Credentials? = nil, queue: DispatchQueue? = nil) {
+    /// - parameter clock: The clock measuring token expirations. Pass a `VirtualClock` to run simulations faster than wall time.
+    public convenience init(rootURL: URL = API.rootURL, credentials: API.Credentials? = nil, queue: DispatchQueue? = nil, clock: Clock = SystemClock.shared) {
         let queue = queue ?? DispatchQueue(label: IG.identifier + ".api.queue", qos: .utility)
         let session = URLSession(configuration: API.Channel.defaultSessionConfigurations, delegate: nil, delegateQueue: OperationQueue(underlying: queue))
-        self.init(rootURL: rootURL, credentials: credentials, queue: queue, session: session)
+        self.init(rootURL: rootURL, credentials: credentials, queue: queue, session: session, clock: clock)
+    }
+    
+    /// Convenience initializer executing the requests and responses on the `trading` executor.
+    /// - parameter rootURL: The base/root URL for all endpoint calls.
+    /// - parameter credentials: `nil` for yet unknown credentials (most of the cases); otherwise, use your hard-coded credentials.
+    /// - parameter executors: The executors configuration. Only the `trading` executor is used.
+    /// - parameter clock: The clock measuring token expirations.
+    public convenience init(rootURL: URL = API.rootURL, credentials: API.Credentials? = nil, executors: Executors, clock: Clock = SystemClock.shared) {
+        let queue = executors.trading._queue(label: IG.identifier + ".api.queue", automatic: DispatchQueue(label: IG.identifier + ".api.queue", qos: .utility))
+        self.init(rootURL: rootURL, credentials: credentials, queue: queue, clock: clock)
     }
     
     /// Designated initializer used for regular and mocked usage.
@@ -42,9 +55,10 @@ public final class API {
     /// - parameter credentials: `nil` for yet unknown credentials (most of the cases); otherwise, use your hard-coded credentials.
     /// - parameter queue: The `DispatchQueue` actually handling the requests and responses. It is also the delegate `OperationQueue`'s underlying queue.
     /// - parameter session: The URL session used to call the real (or mocked) endpoints. 
-    internal init(rootURL: URL, credentials: API.Credentials?, queue: DispatchQueue, session: URLSession) {
-        (self.rootURL, self.queue) = (rootURL, queue)
-        self.channel = API.Channel(session: session, credentials: credentials, scheduler: queue)
+    /// - parameter clock: The clock measuring token expirations.
+    internal init(rootURL: URL, credentials: API.Credentials?, queue: DispatchQueue, session: URLSession, clock: Clock = SystemClock.shared) {
+        (self.rootURL, self.queue, self.clock) = (rootURL, queue, clock)
+        self.channel = API.Channel(session: session, credentials: credentials, scheduler: queue, clock: clock)
     }
 }
 
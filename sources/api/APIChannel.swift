@@ -18,15 +18,20 @@ extension API {
         /// - remark: The subject never fails and only completes successfully when the `Channel` gets deinitialized.
         private let _statusSubject: PassthroughSubject<API.Session.Status,Never>
         /// The status scheduler announcing when a token has expired.
-        private var _statusTimer: DispatchSourceTimer?
+        private var _statusTimer: AnyCancellable?
         /// The processing queue for the status cancellable.
         private unowned let _expirationScheduler: DispatchQueue
+        /// The clock measuring token expirations.
+        private let _clock: Clock
+        /// The session delivering response bodies incrementally (lazily created the first time it is needed).
+        private var _streaming: API.StreamingSession?
         
         /// Designated initializer passing the basic requirements for an API channel.
         /// - parameter session: Real or mock URL session calling the endpoints.
         /// - parameter credentials: `nil` for yet unknown credentials (most of the cases); otherwise, use your hard-coded credentials.
         /// - parameter scheduler: Queue used to schedule the expiration status change (e.g. from valid token to expired).
-        init(session: URLSession, credentials: API.Credentials?, scheduler: DispatchQueue) {
+        /// - parameter clock: The clock measuring token expirations.
+        init(session: URLSession, credentials: API.Credentials?, scheduler: DispatchQueue, clock: Clock) {
             self.session = session
             self._lock = UnfairLock()
             self._credentials = nil
@@ -34,6 +39,8 @@ extension API {
             self._statusSubject = PassthroughSubject()
             self._statusTimer = nil
             self._expirationScheduler = scheduler
+            self._clock = clock
+            self._streaming = nil
             // Set the expiration timer if necessary.
             guard let creds = credentials else { return }
             self.credentials { _ in creds }
@@ -43,6 +50,8 @@ extension API {
             self._lock.execute {
                 self._statusTimer?.cancel()
                 self._statusTimer = nil
+                self._streaming?.invalidate()
+                self._streaming = nil
             }
             self.session.invalidateAndCancel()
             self._statusSubject.send(completion: .finished)
@@ -57,6 +66,19 @@ extension API {
             set { self.credentials { (_) in newValue } }
         }
         
+        /// The session delivering response bodies incrementally.
+        ///
+        /// It shares the main session's configuration and underlying queue; it is created the first time it is requested.
+        var streaming: API.StreamingSession {
+            self._lock.execute {
+                if let streaming = self._streaming { return streaming }
+                let queue = self.session.delegateQueue.underlyingQueue ?? DispatchQueue.global(qos: .default)
+                let streaming = API.StreamingSession(configuration: self.session.configuration, queue: queue)
+                self._streaming = streaming
+                return streaming
+            }
+        }
+        
         /// The current status for the API credentials.
         var status: API.Session.Status {
             return self._lock.execute { self._status }
@@ -121,27 +143,25 @@ extension API.Channel {
             return self._statusSubject.send(.logout)
         }
         // 6. If the new expiration date is further in the past than (aproximately) now. Set the "expired" status
-        guard currentExpirationDate > Date(timeIntervalSinceNow: 0.1) else {
+        guard currentExpirationDate > self._clock.now.addingTimeInterval(0.1) else {
             if case .expired = self._status { return self._lock.unlock() }
             self._status = .expired
             self._lock.unlock()
             return self._statusSubject.send(.expired)
         }
         // 7. If the code reaches this point, the new expiration date is a valid date in the future
-        let deadline = currentExpirationDate.timeIntervalSince(Date(timeIntervalSinceNow: -0.05))
         self._status = .ready(till: currentExpirationDate)
-        self._scheduleTimer(deadline: .now() + deadline)
+        self._scheduleTimer(date: currentExpirationDate.addingTimeInterval(0.05))
         self._lock.unlock()
         self._statusSubject.send(.ready(till: currentExpirationDate))
     }
 
     /// Creates and schedules a timer for token/credentials expiration.
     /// - attention: This function mst be called within a lock.
-    private func _scheduleTimer(deadline: DispatchTime) {
+    private func _scheduleTimer(date: Date) {
         assert(self._statusTimer == nil)
 
-        let source = DispatchSource.makeTimerSource(queue: self._expirationScheduler)
-        source.setEventHandler { [unowned self] in
+        self._statusTimer = self._clock.schedule(at: date, on: self._expirationScheduler) { [unowned self] in
             self._lock.lock()
             self._statusTimer = nil
             // Don't duplicate events. If the status is already expired, don't perform any more work.
@@ -154,9 +174,5 @@ extension API.Channel {
                 self._statusSubject.send(.expired)
             }
         }
-
-        self._statusTimer = source
-        source.schedule(deadline: deadline, repeating: .never, leeway: .nanoseconds(10))
-        source.activate()
     }
 }
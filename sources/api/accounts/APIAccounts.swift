@@ -17,24 +17,14 @@ extension API.Request.Accounts {
     /// - seealso: GET /accounts
     /// - returns: Publisher forwarding a list of user's accounts.
     public func getAll() -> AnyPublisher<[API.Account],IG.Error> {
-        self.api.publisher
-            .makeRequest(.get, "accounts", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: _WrapperList, _) in w.accounts }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getAll().publisher
     }
     
     /// Returns the targeted account preferences.
     /// - seealso: GET /accounts/preferences
     /// - returns: Publisher forwarding the current account's pereferences.
     public func getPreferences() -> AnyPublisher<API.Account.Preferences,IG.Error> {
-        self.api.publisher
-            .makeRequest(.get, "accounts/preferences", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getPreferences().publisher
     }
     
     /// Updates the account preferences.
@@ -42,13 +32,62 @@ extension API.Request.Accounts {
     /// - parameter trailingStops: Enable/Disable trailing stops in the current account.
     /// - returns: Publisher indicating the success of the operation.
     public func updatePreferences(trailingStops: Bool) -> AnyPublisher<Never,IG.Error> {
-        self.api.publisher { _ in _PayloadPreferences(trailingStopsEnabled: trailingStops) }
+        self._updatePreferences(trailingStops: trailingStops).publisher
+            .ignoreOutput()
+            .eraseToAnyPublisher()
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Accounts {
+    /// Returns a list of accounts belonging to the logged-in client.
+    /// - seealso: `getAll()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: A list of user's accounts.
+    public func getAll() async throws -> [API.Account] {
+        try await self._getAll().value()
+    }
+    
+    /// Returns the targeted account preferences.
+    /// - seealso: `getPreferences()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The current account's preferences.
+    public func getPreferences() async throws -> API.Account.Preferences {
+        try await self._getPreferences().value()
+    }
+    
+    /// Updates the account preferences.
+    /// - seealso: `updatePreferences(trailingStops:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func updatePreferences(trailingStops: Bool) async throws {
+        _ = try await self._updatePreferences(trailingStops: trailingStops).value()
+    }
+}
+#endif
+
+private extension API.Request.Accounts {
+    /// Endpoint call shared by `getAll()` and its `async` variant.
+    func _getAll() -> API.Endpoint<Void,[API.Account]> {
+        self.api.endpoint
+            .makeRequest(.get, "accounts", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: _WrapperList, _) in w.accounts }
+    }
+    
+    /// Endpoint call shared by `getPreferences()` and its `async` variant.
+    func _getPreferences() -> API.Endpoint<Void,API.Account.Preferences> {
+        self.api.endpoint
+            .makeRequest(.get, "accounts/preferences", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default())
+    }
+    
+    /// Endpoint call shared by `updatePreferences(trailingStops:)` and its `async` variant.
+    func _updatePreferences(trailingStops: Bool) -> API.Endpoint<_PayloadPreferences,API.Transit.Call<_PayloadPreferences>> {
+        self.api.endpoint { _ in _PayloadPreferences(trailingStopsEnabled: trailingStops) }
             .makeRequest(.put, "accounts/preferences", version: 1, credentials: true, body: { (payload) in
                 (.json, try JSONEncoder().encode(payload))
             }).send(expecting: .json, statusCode: 200)
-            .ignoreOutput()
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
 }
 
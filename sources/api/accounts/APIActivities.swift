@@ -15,7 +15,27 @@ extension API.Request.Accounts {
     /// - parameter pageSize: The number of activities returned per *page* (i.e. `Publisher` value). The valid range is between 10 and 500; anything beyond that will be clamped.
     /// - returns: `Publisher` forwarding multiple values. Each value represents an array of activities.
     public func getActivityContinuously(from: Date, to: Date? = nil, id: IG.Deal.Identifier? = nil, filter: String? = nil, arraySize pageSize: UInt = 50) -> AnyPublisher<[API.Activity],IG.Error> {
-        self.api.publisher { (api) -> DateFormatter in
+        self._activityPages(from: from, to: to, id: id, filter: filter, arraySize: pageSize).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Accounts {
+    /// Returns the account's activity history as an asynchronous sequence of pages.
+    ///
+    /// Each page is requested when the sequence consumer asks for it.
+    /// - seealso: `getActivityContinuously(from:to:id:filter:arraySize:)` (Combine variant).
+    /// - returns: Asynchronous sequence of pages. Each element represents an array of activities.
+    public func getActivityPages(from: Date, to: Date? = nil, id: IG.Deal.Identifier? = nil, filter: String? = nil, arraySize pageSize: UInt = 50) -> AsyncThrowingStream<[API.Activity],Swift.Error> {
+        self._activityPages(from: from, to: to, id: id, filter: filter, arraySize: pageSize).stream
+    }
+}
+#endif
+
+private extension API.Request.Accounts {
+    /// Paginated activity request definition shared by the Combine and `async` surfaces.
+    func _activityPages(from: Date, to: Date?, id: IG.Deal.Identifier?, filter: String?, arraySize pageSize: UInt) -> API.Pages<DateFormatter,_PagedActivities.Metadata.Page,[API.Activity]> {
+        let endpoint = self.api.endpoint { (api) -> DateFormatter in
                 let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
                 if let fiql = filter, !fiql.isEmpty { throw IG.Error._emptyFilter() }
             
@@ -39,23 +59,22 @@ extension API.Request.Accounts {
                                  (pageSize > 10)  ? 10  : pageSize
                 queries.append(.init(name: "pageSize", value: String(size)))
                 return queries
-            }).sendPaginating(request: { (api, initial, previous) -> URLRequest? in
-                guard let previous = previous else { return initial.request }
-                guard let next = previous.metadata.next else { return nil }
-                
-                let queries = try URLComponents(string: next)?.queryItems ?> IG.Error._malformedNextPage(request: previous.request)
-                
-                guard let from = queries.first(where: { $0.name == "from" }),
-                      let to = queries.first(where: { $0.name == "to" }) else { throw IG.Error._malformedPaginated(request: previous.request) }
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(values: true)) { (response: _PagedActivities, _) in
+                (response.metadata.paging, response.activities)
+            }
+        
+        return .init(endpoint: endpoint, next: { (api, initial, previous) -> URLRequest? in
+            guard let previous = previous else { return initial.request }
+            guard let next = previous.metadata.next else { return nil }
+            
+            let queries = try URLComponents(string: next)?.queryItems ?> IG.Error._malformedNextPage(request: previous.request)
+            
+            guard let from = queries.first(where: { $0.name == "from" }),
+                  let to = queries.first(where: { $0.name == "to" }) else { throw IG.Error._malformedPaginated(request: previous.request) }
 
-                return try initial.request.set { try $0.addQueries([from, to])}
-            }, call: { (publisher, _) in
-                publisher.send(expecting: .json, statusCode: 200)
-                    .decodeJSON(decoder: .default(values: true)) { (response: _PagedActivities, _) in
-                        (response.metadata.paging, response.activities)
-                    }.mapError(errorCast)
-            }).mapError(errorCast)
-            .eraseToAnyPublisher()
+            return try initial.request.set { try $0.addQueries([from, to])}
+        })
     }
 }
 
@@ -63,7 +82,7 @@ extension API.Request.Accounts {
 
 extension API.Request.Accounts {
     /// A single page of activity requests.
-    private struct _PagedActivities: Decodable {
+    fileprivate struct _PagedActivities: Decodable {
         let activities: [API.Activity]
         let metadata: Metadata
         
@@ -6,12 +6,7 @@ extension API.Request.Accounts {
     /// - seealso: GET /operations/application
     /// - returns: Publisher forwarding all user's applications.
     public func getApplications() -> AnyPublisher<[API.Application],IG.Error> {
-        self.api.publisher
-            .makeRequest(.get, "operations/application", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getApplications().publisher
     }
 
     /// Alters the details of a given user application.
@@ -21,15 +16,48 @@ extension API.Request.Accounts {
     /// - parameter allowance: `overall`: Per account request per minute allowance. `trading`: Per account trading request per minute allowance.
     /// - returns: Publisher forwarding the newly set targeted application values.
     public func updateApplication(key: API.Key? = nil, status: API.Application.Status, accountAllowance allowance: (overall: UInt, trading: UInt)) -> AnyPublisher<API.Application,IG.Error> {
-        self.api.publisher { (api) throws -> _PayloadUpdate in
+        self._updateApplication(key: key, status: status, accountAllowance: allowance).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Accounts {
+    /// Returns a list of client-owned applications.
+    /// - seealso: `getApplications()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: All user's applications.
+    public func getApplications() async throws -> [API.Application] {
+        try await self._getApplications().value()
+    }
+    
+    /// Alters the details of a given user application.
+    /// - seealso: `updateApplication(key:status:accountAllowance:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The newly set targeted application values.
+    public func updateApplication(key: API.Key? = nil, status: API.Application.Status, accountAllowance allowance: (overall: UInt, trading: UInt)) async throws -> API.Application {
+        try await self._updateApplication(key: key, status: status, accountAllowance: allowance).value()
+    }
+}
+#endif
+
+private extension API.Request.Accounts {
+    /// Endpoint call shared by `getApplications()` and its `async` variant.
+    func _getApplications() -> API.Endpoint<Void,[API.Application]> {
+        self.api.endpoint
+            .makeRequest(.get, "operations/application", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default())
+    }
+    
+    /// Endpoint call shared by `updateApplication(key:status:accountAllowance:)` and its `async` variant.
+    func _updateApplication(key: API.Key?, status: API.Application.Status, accountAllowance allowance: (overall: UInt, trading: UInt)) -> API.Endpoint<_PayloadUpdate,API.Application> {
+        self.api.endpoint { (api) throws -> _PayloadUpdate in
             let apiKey = try (key ?? api.channel.credentials?.key) ?> IG.Error._unfoundCredentials()
                 return .init(key: apiKey, status: status, overallAccountRequests: allowance.overall, tradingAccountRequests: allowance.trading)
             }.makeRequest(.put, "operations/application", version: 1, credentials: true, body: { (payload) in
                 return (.json, try JSONEncoder().encode(payload))
             }).send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
 }
 
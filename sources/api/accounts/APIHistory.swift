@@ -0,0 +1,159 @@
+import Combine
+import Foundation
+
+extension API.Request.Accounts {
+    /// Returns the account's activity history downloading several date windows concurrently.
+    ///
+    /// The `[from, to]` range is split into consecutive windows of `window` seconds. Up to `concurrency` windows are downloaded at the same time (each one through its own paginated request chain) and the results are forwarded in chronological order; that is, a window is only forwarded once all previous windows have been forwarded.
+    /// - seealso: GET /history/activity
+    /// - note: Activities found in more than one window (e.g. at the windows' boundaries) are only forwarded once.
+    /// - parameter from: The start date.
+    /// - parameter to: The end date (`nil` means "now").
+    /// - parameter filter: The FIQL filters that can be applied to the search. FIQL filter supporst operators: `==`, `!=`, `,`, and `;`. No validation is performed in client.
+    /// - parameter window: The duration (in seconds) of each downloaded window. By default a week.
+    /// - parameter concurrency: The maximum number of windows being downloaded at the same time. It only caps the simultaneous request chains; the application's request allowance is not tracked, thus keep it low to stay within the allowance.
+    /// - returns: `Publisher` forwarding one value per window (oldest first). Each value represents an array of activities sorted from oldest to newest.
+    public func getActivityHistory(from: Date, to: Date? = nil, filter: String? = nil, window: TimeInterval = 7 * 86_400, concurrency: Int = 4) -> AnyPublisher<[API.Activity],IG.Error> {
+        let api = self.api
+        return Self._sharded(from: from, to: to ?? api.clock.now, window: window, concurrency: concurrency, fetch: { (start, end) in
+            api.accounts.getActivityContinuously(from: start, to: end, filter: filter, arraySize: 500)
+        }, date: { $0.date }, key: { _ActivityKey(id: $0.deal.id, date: $0.date, summary: $0.deal.summary) })
+    }
+
+    /// Returns the transaction history downloading several date windows concurrently.
+    ///
+    /// The `[from, to]` range is split into consecutive windows of `window` seconds. Up to `concurrency` windows are downloaded at the same time (each one through its own paginated request chain) and the results are forwarded in chronological order; that is, a window is only forwarded once all previous windows have been forwarded.
+    /// - seealso: GET /history/transactions
+    /// - note: Transactions found in more than one window (e.g. at the windows' boundaries) are only forwarded once.
+    /// - parameter from: The start date.
+    /// - parameter to: The end date (`nil` means "now").
+    /// - parameter type: Filter for the transaction types being returned.
+    /// - parameter window: The duration (in seconds) of each downloaded window. By default a week.
+    /// - parameter concurrency: The maximum number of windows being downloaded at the same time. It only caps the simultaneous request chains; the application's request allowance is not tracked, thus keep it low to stay within the allowance.
+    /// - returns: `Publisher` forwarding one value per window (oldest first). Each value represents an array of transactions sorted by closing date.
+    public func getTransactionHistory(from: Date, to: Date? = nil, type: Self.Transaction = .all, window: TimeInterval = 7 * 86_400, concurrency: Int = 4) -> AnyPublisher<[API.Transaction],IG.Error> {
+        let api = self.api
+        return Self._sharded(from: from, to: to ?? api.clock.now, window: window, concurrency: concurrency, fetch: { (start, end) in
+            api.accounts.getTransactionsContinuously(from: start, to: end, type: type, array: (100, 1))
+        }, date: { $0.close.date }, key: { _TransactionKey(reference: $0.reference, type: $0.type, date: $0.close.date) })
+    }
+}
+
+internal extension API.Request.Accounts {
+    /// Splits the given range in windows, downloads them concurrently, and forwards their elements in chronological order (without duplicates).
+    /// - attention: The number of simultaneous downloads is capped by `concurrency` (through `flatMap(maxPublishers:)`); no request rate nor platform allowance is enforced.
+    /// - parameter from: The start date.
+    /// - parameter to: The end date.
+    /// - parameter window: The duration (in seconds) of each window.
+    /// - parameter concurrency: The maximum number of windows being downloaded at the same time.
+    /// - parameter fetch: Closure downloading a single window (possibly in several pages).
+    /// - parameter date: Closure returning the date by which elements are sorted.
+    /// - parameter key: Closure returning the value identifying an element (used for de-duplication).
+    static func _sharded<T,K:Hashable>(from: Date, to: Date, window: TimeInterval, concurrency: Int, fetch: @escaping (_ from: Date, _ to: Date) -> AnyPublisher<[T],IG.Error>, date: @escaping (T) -> Date, key: @escaping (T) -> K) -> AnyPublisher<[T],IG.Error> {
+        guard from <= to else { return Fail(error: IG.Error._invalidRange(from: from, to: to)).eraseToAnyPublisher() }
+        guard window > 0, concurrency > 0 else { return Fail(error: IG.Error._invalidSharding(window: window, concurrency: concurrency)).eraseToAnyPublisher() }
+
+        var windows: [(start: Date, end: Date)] = []
+        var start = from
+        repeat {
+            let end = Swift.min(start.addingTimeInterval(window), to)
+            windows.append((start, end))
+            start = end
+        } while start < to
+
+        return Deferred { () -> AnyPublisher<[T],IG.Error> in
+            let merger = _ShardMerger(count: windows.count, date: date, key: key)
+            return Publishers.Sequence<[(offset: Int, element: (start: Date, end: Date))],IG.Error>(sequence: Array(windows.enumerated()))
+                .flatMap(maxPublishers: .max(concurrency)) { (index, window) in
+                    fetch(window.start, window.end)
+                        .collect()
+                        .map { (index, Array($0.joined())) }
+                }.flatMap { (index, elements) in
+                    Publishers.Sequence<[[T]],IG.Error>(sequence: merger.process(window: index, elements: elements))
+                }.eraseToAnyPublisher()
+        }.eraseToAnyPublisher()
+    }
+}
+
+// MARK: - Entities
+
+/// Value identifying an activity among overlapping windows.
+private struct _ActivityKey: Hashable {
+    let id: IG.Deal.Identifier
+    let date: Date
+    let summary: String
+}
+
+/// Value identifying a transaction among overlapping windows.
+private struct _TransactionKey: Hashable {
+    let reference: String
+    let type: API.Transaction.Kind
+    let date: Date
+}
+
+/// Reorders the windows downloaded concurrently so they are forwarded in chronological order.
+internal final class _ShardMerger<T,K:Hashable> {
+    /// The lock restricting access to the merger state.
+    private let _lock: UnfairLock
+    /// Closure returning the date by which elements are sorted.
+    private let _date: (T) -> Date
+    /// Closure returning the value identifying an element.
+    private let _key: (T) -> K
+    /// The downloaded windows which cannot be forwarded yet (since a previous window is still being downloaded).
+    private var _pending: [Int:[T]]
+    /// The index of the next window to be forwarded.
+    private var _next: Int
+    /// The keys of the elements forwarded in the last window (the only ones which may be duplicated in the following window).
+    private var _forwarded: Set<K>
+
+    init(count: Int, date: @escaping (T) -> Date, key: @escaping (T) -> K) {
+        self._lock = UnfairLock()
+        self._date = date
+        self._key = key
+        self._pending = .init(minimumCapacity: count)
+        self._next = 0
+        self._forwarded = .init()
+    }
+
+    deinit {
+        self._lock.invalidate()
+    }
+
+    /// Processes a downloaded window, returning the windows which can be forwarded (in order).
+    /// - parameter window: The window index.
+    /// - parameter elements: The elements downloaded for the window.
+    func process(window: Int, elements: [T]) -> [[T]] {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        self._pending[window] = elements
+        var result: [[T]] = []
+        while let elements = self._pending.removeValue(forKey: self._next) {
+            self._next += 1
+
+            var keys = Set<K>(minimumCapacity: elements.count)
+            var forwarded: [T] = []
+            forwarded.reserveCapacity(elements.count)
+            for element in elements.sorted(by: { self._date($0) < self._date($1) }) {
+                let key = self._key(element)
+                guard !self._forwarded.contains(key), keys.insert(key).inserted else { continue }
+                forwarded.append(element)
+            }
+
+            self._forwarded = keys
+            result.append(forwarded)
+        }
+        return result
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when the history range is invalid.
+    static func _invalidRange(from: Date, to: Date) -> Self {
+        Self(.api(.invalidRequest), "The 'from' date must indicate a date before the 'to' date", help: "Read the request documentation and be sure to follow all requirements.", info: ["From": from, "To": to])
+    }
+    /// Error raised when the sharding parameters are invalid.
+    static func _invalidSharding(window: TimeInterval, concurrency: Int) -> Self {
+        Self(.api(.invalidRequest), "The history window and concurrency must be greater than zero.", help: "Read the request documentation and be sure to follow all requirements.", info: ["Window": window, "Concurrency": concurrency])
+    }
+}
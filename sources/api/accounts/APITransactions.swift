@@ -11,7 +11,62 @@ extension API.Request.Accounts {
     /// - parameter to: The end date (`nil` means "today").
     /// - parameter type: Filter for the transaction types being returned.
     public func getTransactions(from: Date, to: Date? = nil, type: Self.Transaction = .all) -> AnyPublisher<[API.Transaction],IG.Error> {
-        self.api.publisher { (api) -> DateFormatter in
+        self._getTransactions(from: from, to: to, type: type).publisher
+    }
+    
+    /// Returns the transaction history.
+    ///
+    /// **This is a paginated-request**, which means that the returned `Publisher` will forward downstream several values. Each value is actually an array of transactions with `array.size` number of elements.
+    /// - seealso: GET /history/transactions
+    /// - precondition: `value.size` and `value.number` must be greater than zero.
+    /// - parameter from: The start date.
+    /// - parameter to: The end date (`nil` means "today").
+    /// - parameter type: Filter for the transaction types being returned.
+    /// - parameter page: Paging variables for the transactions page received. `page.size` references the amount of transactions forward per value.
+    /// - returns: Combine `Publisher` forwarding multiple values. Each value represents an array of transactions.
+    public func getTransactionsContinuously(from: Date, to: Date? = nil, type: Self.Transaction = .all, array page: (size: Int, number: Int) = (20, 1)) -> AnyPublisher<[API.Transaction],IG.Error> {
+        self._transactionPages(from: from, to: to, type: type, array: page).publisher
+    }
+    
+    /// Returns the transaction history decoding the transactions as the response bytes arrive.
+    ///
+    /// A single (non-paginated) request is performed, but the transactions are decoded and forwarded in chunks while the response is still being received; thus, the whole response payload is never held in memory.
+    /// - seealso: GET /history/transactions
+    /// - parameter from: The start date.
+    /// - parameter to: The end date (`nil` means "today").
+    /// - parameter type: Filter for the transaction types being returned.
+    /// - parameter chunkSize: The maximum number of transactions forwarded per value.
+    /// - returns: Combine `Publisher` forwarding multiple values. Each value represents an array of (at most `chunkSize`) transactions.
+    public func getTransactionsIncrementally(from: Date, to: Date? = nil, type: Self.Transaction = .all, chunkSize: Int = 100) -> AnyPublisher<[API.Transaction],IG.Error> {
+        self._transactionRequest(from: from, to: to, type: type).publisher
+            .sendStreaming(statusCode: 200, array: "transactions", decoder: .default(), chunkSize: chunkSize)
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Accounts {
+    /// Returns the transaction history.
+    /// - seealso: `getTransactions(from:to:type:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func getTransactions(from: Date, to: Date? = nil, type: Self.Transaction = .all) async throws -> [API.Transaction] {
+        try await self._getTransactions(from: from, to: to, type: type).value()
+    }
+    
+    /// Returns the transaction history as an asynchronous sequence of pages.
+    ///
+    /// Each page is requested when the sequence consumer asks for it.
+    /// - seealso: `getTransactionsContinuously(from:to:type:array:)` (Combine variant).
+    /// - returns: Asynchronous sequence of pages. Each element represents an array of transactions.
+    public func getTransactionPages(from: Date, to: Date? = nil, type: Self.Transaction = .all, array page: (size: Int, number: Int) = (20, 1)) -> AsyncThrowingStream<[API.Transaction],Swift.Error> {
+        self._transactionPages(from: from, to: to, type: type, array: page).stream
+    }
+}
+#endif
+
+private extension API.Request.Accounts {
+    /// Single (non-paginated) transaction request definition shared by the buffered and incremental surfaces.
+    func _transactionRequest(from: Date, to: Date?, type: Self.Transaction) -> API.Prepared<DateFormatter> {
+        self.api.endpoint { (api) -> DateFormatter in
                 let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
                 return DateFormatter.iso8601Broad.deepCopy(timeZone: timezone)
             }.makeRequest(.get, "history/transactions", version: 2, credentials: true, queries: { (dateFormatter) in
@@ -28,24 +83,19 @@ extension API.Request.Accounts {
                 queries.append(.init(name: "pageSize", value: "0"))
                 queries.append(.init(name: "pageNumber", value: "1"))
                 return queries
-            }).send(expecting: .json, statusCode: 200)
+            })
+    }
+    
+    /// Endpoint call shared by `getTransactions(from:to:type:)` and its `async` variant.
+    func _getTransactions(from: Date, to: Date?, type: Self.Transaction) -> API.Endpoint<DateFormatter,[API.Transaction]> {
+        self._transactionRequest(from: from, to: to, type: type)
+            .send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
     
-    /// Returns the transaction history.
-    ///
-    /// **This is a paginated-request**, which means that the returned `Publisher` will forward downstream several values. Each value is actually an array of transactions with `array.size` number of elements.
-    /// - seealso: GET /history/transactions
-    /// - precondition: `value.size` and `value.number` must be greater than zero.
-    /// - parameter from: The start date.
-    /// - parameter to: The end date (`nil` means "today").
-    /// - parameter type: Filter for the transaction types being returned.
-    /// - parameter page: Paging variables for the transactions page received. `page.size` references the amount of transactions forward per value.
-    /// - returns: Combine `Publisher` forwarding multiple values. Each value represents an array of transactions.
-    public func getTransactionsContinuously(from: Date, to: Date? = nil, type: Self.Transaction = .all, array page: (size: Int, number: Int) = (20, 1)) -> AnyPublisher<[API.Transaction],IG.Error> {
-        self.api.publisher { (api) -> DateFormatter in
+    /// Paginated transactions request definition shared by the Combine and `async` surfaces.
+    func _transactionPages(from: Date, to: Date?, type: Self.Transaction, array page: (size: Int, number: Int)) -> API.Pages<DateFormatter,_PagedTransactions.Metadata.Page,[API.Transaction]> {
+        let endpoint = self.api.endpoint { (api) -> DateFormatter in
                 let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
                 guard page.size > 0 else { throw IG.Error._invalid(pageSize: page.size) }
                 guard page.number > 0 else { throw IG.Error._invalid(pageNumber: page.number) }
@@ -63,23 +113,22 @@ extension API.Request.Accounts {
 
                 queries.append(.init(name: "pageSize", value: String(page.size)))
                 return queries
-            }).sendPaginating(request: { (_, initial, previous) -> URLRequest? in
-                let nextPage: Int
-                if let previous = previous {
-                    guard let nextIteration = previous.metadata.next else { return nil }
-                    nextPage = nextIteration
-                } else {
-                    nextPage = page.number
-                }
-                
-                return try initial.request.set { try $0.addQueries([.init(name: "pageNumber", value: String(nextPage))]) }
-            }, call: { (publisher, _) in
-                publisher.send(expecting: .json, statusCode: 200)
-                    .decodeJSON(decoder: .default()) { (response: _PagedTransactions, _) in
-                        (response.metadata.page, response.transactions)
-                    }.mapError(errorCast)
-            }).mapError(errorCast)
-            .eraseToAnyPublisher()
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (response: _PagedTransactions, _) in
+                (response.metadata.page, response.transactions)
+            }
+        
+        return .init(endpoint: endpoint, next: { (_, initial, previous) -> URLRequest? in
+            let nextPage: Int
+            if let previous = previous {
+                guard let nextIteration = previous.metadata.next else { return nil }
+                nextPage = nextIteration
+            } else {
+                nextPage = page.number
+            }
+            
+            return try initial.request.set { try $0.addQueries([.init(name: "pageNumber", value: String(nextPage))]) }
+        })
     }
 }
 
@@ -116,7 +165,7 @@ extension API.Request.Accounts {
 
 extension API.Request.Accounts {
     /// A single Page of transactions request.
-    private struct _PagedTransactions: Decodable {
+    fileprivate struct _PagedTransactions: Decodable {
         let transactions: [API.Transaction]
         let metadata: Self.Metadata
         
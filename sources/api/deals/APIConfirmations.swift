@@ -22,11 +22,28 @@ extension API.Request.Deals {
     /// - note: the confirmation is only available up to 1 minute via this endpoint.
     /// - parameter reference: Temporary targeted deal reference.
     public func getConfirmation(reference: IG.Deal.Reference) -> AnyPublisher<API.Confirmation,IG.Error> {
-        self.api.publisher
+        self._getConfirmation(reference: reference).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Deals {
+    /// Returns a deal confirmation for the given deal reference.
+    /// - seealso: `getConfirmation(reference:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The confirmation of the targeted deal.
+    public func getConfirmation(reference: IG.Deal.Reference) async throws -> API.Confirmation {
+        try await self._getConfirmation(reference: reference).value()
+    }
+}
+#endif
+
+private extension API.Request.Deals {
+    /// Endpoint call shared by `getConfirmation(reference:)` and its `async` variant.
+    func _getConfirmation(reference: IG.Deal.Reference) -> API.Endpoint<Void,API.Confirmation> {
+        self.api.endpoint
             .makeRequest(.get, "confirms/\(reference)", version: 1, credentials: true)
             .send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
 }
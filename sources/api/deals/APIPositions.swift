@@ -9,12 +9,7 @@ extension API.Request.Deals {
     /// - seealso: GET /positions
     /// - returns: Publisher forwarding a list of open positions.
     public func getPositions() -> AnyPublisher<[API.Position],IG.Error> {
-        self.api.publisher
-            .makeRequest(.get, "positions", version: 2, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(date: true)) { (w: _WrappedPositions, _) in w.positions }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getPositions().publisher
     }
     
     /// Returns an open position for the active account by deal identifier.
@@ -22,12 +17,7 @@ extension API.Request.Deals {
     /// - parameter identifier: Targeted permanent deal reference for an already confirmed trade.
     /// - returns: Publisher forwarding the targeted position.
     public func getPosition(id: IG.Deal.Identifier) -> AnyPublisher<API.Position,IG.Error> {
-        self.api.publisher
-            .makeRequest(.get, "positions/\(id)", version: 2, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(date: true))
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getPosition(id: id).publisher
     }
     
     /// Creates a new position.
@@ -49,12 +39,7 @@ extension API.Request.Deals {
     /// - parameter forceOpen: (default `true`). Enabling force open when creating a new position will enable a second position to be opened on a market. This variable must be `true` if the limit and/or the stop are set.
     /// - returns: The transient deal reference (for an unconfirmed trade). If `reference` was set as an argument, that same value will be returned.
     public func createPosition(reference: IG.Deal.Reference? = nil, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code?, direction: IG.Deal.Direction, order: Self.Position.Order, strategy: Self.Position.FillStrategy, size: Decimal64, limit: IG.Deal.Boundary?, stop: Self.Position.Stop?, forceOpen: Bool = true) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
-        self.api.publisher { _ in try _PayloadCreation(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, order: order, strategy: strategy, size: size, limit: limit, stop: stop, forceOpen: forceOpen) }
-            .makeRequest(.post, "positions/otc", version: 2, credentials: true, body: { (.json, try JSONEncoder().encode($0)) })
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: _WrapperReference, _) in w.dealReference }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._createPosition(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, order: order, strategy: strategy, size: size, limit: limit, stop: stop, forceOpen: forceOpen).publisher
     }
     
     /// Edits an opened position (identified by the given deal identifier).
@@ -67,12 +52,7 @@ extension API.Request.Deals {
     /// - parameter stop: Passing values will set a stop level (replacing the previous one, if any). Setting this argument to `nil` will delete the stop position.
     /// - returns: Publisher forwarding the transient deal reference (for an unconfirmed trade).
     public func updatePosition(id: IG.Deal.Identifier, limitLevel: Decimal64?, stop: Self.Position.StopEdit?) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
-        self.api.publisher { _ in try _PayloadUpdate(limit: limitLevel, stop: stop) }
-            .makeRequest(.put, "positions/otc/\(id)", version: 2, credentials: true, body: { (.json, try JSONEncoder().encode($0)) })
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: _WrapperReference, _) in w.dealReference }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._updatePosition(id: id, limitLevel: limitLevel, stop: stop).publisher
     }
     
     /// Closes one or more positions.
@@ -84,12 +64,93 @@ extension API.Request.Deals {
     /// - parameter size: The amount of contracts to close.
     /// - returns: The transient deal reference (for an unconfirmed trade) wrapped in a SignalProducer's value.
     public func closePosition(matchedBy identification: Self.Identification, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
-        self.api.publisher { _ in try _PayloadDeletion(identification: identification, direction: direction, order: order, strategy: strategy, size: size) }
+        self._closePosition(matchedBy: identification, direction: direction, order: order, strategy: strategy, size: size).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Deals {
+    /// Returns all open positions for the active account.
+    /// - seealso: `getPositions()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: A list of open positions.
+    public func getPositions() async throws -> [API.Position] {
+        try await self._getPositions().value()
+    }
+    
+    /// Returns an open position for the active account by deal identifier.
+    /// - seealso: `getPosition(id:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The targeted position.
+    public func getPosition(id: IG.Deal.Identifier) async throws -> API.Position {
+        try await self._getPosition(id: id).value()
+    }
+    
+    /// Creates an OTC position.
+    /// - seealso: `createPosition(reference:epic:expiry:currency:direction:order:strategy:size:limit:stop:forceOpen:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func createPosition(reference: IG.Deal.Reference? = nil, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code?, direction: IG.Deal.Direction, order: Self.Position.Order, strategy: Self.Position.FillStrategy, size: Decimal64, limit: IG.Deal.Boundary?, stop: Self.Position.Stop?, forceOpen: Bool = true) async throws -> IG.Deal.Reference {
+        try await self._createPosition(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, order: order, strategy: strategy, size: size, limit: limit, stop: stop, forceOpen: forceOpen).value()
+    }
+    
+    /// Edits an opened position (identified by the given deal identifier).
+    /// - seealso: `updatePosition(id:limitLevel:stop:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func updatePosition(id: IG.Deal.Identifier, limitLevel: Decimal64?, stop: Self.Position.StopEdit?) async throws -> IG.Deal.Reference {
+        try await self._updatePosition(id: id, limitLevel: limitLevel, stop: stop).value()
+    }
+    
+    /// Closes one or more positions.
+    /// - seealso: `closePosition(matchedBy:direction:order:strategy:size:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func closePosition(matchedBy identification: Self.Identification, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64) async throws -> IG.Deal.Reference {
+        try await self._closePosition(matchedBy: identification, direction: direction, order: order, strategy: strategy, size: size).value()
+    }
+}
+#endif
+
+private extension API.Request.Deals {
+    /// Endpoint call shared by `getPositions()` and its `async` variant.
+    func _getPositions() -> API.Endpoint<Void,[API.Position]> {
+        self.api.endpoint
+            .makeRequest(.get, "positions", version: 2, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(date: true)) { (w: _WrappedPositions, _) in w.positions }
+    }
+    
+    /// Endpoint call shared by `getPosition(id:)` and its `async` variant.
+    func _getPosition(id: IG.Deal.Identifier) -> API.Endpoint<Void,API.Position> {
+        self.api.endpoint
+            .makeRequest(.get, "positions/\(id)", version: 2, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(date: true))
+    }
+    
+    /// Endpoint call shared by `createPosition(reference:epic:expiry:currency:direction:order:strategy:size:limit:stop:forceOpen:)` and its `async` variant.
+    func _createPosition(reference: IG.Deal.Reference?, epic: IG.Market.Epic, expiry: IG.Market.Expiry, currency: Currency.Code?, direction: IG.Deal.Direction, order: Self.Position.Order, strategy: Self.Position.FillStrategy, size: Decimal64, limit: IG.Deal.Boundary?, stop: Self.Position.Stop?, forceOpen: Bool) -> API.Endpoint<_PayloadCreation,IG.Deal.Reference> {
+        self.api.endpoint { _ in try _PayloadCreation(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, order: order, strategy: strategy, size: size, limit: limit, stop: stop, forceOpen: forceOpen) }
+            .makeRequest(.post, "positions/otc", version: 2, credentials: true, body: { (.json, try JSONEncoder().encode($0)) })
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: _WrapperReference, _) in w.dealReference }
+    }
+    
+    /// Endpoint call shared by `updatePosition(id:limitLevel:stop:)` and its `async` variant.
+    func _updatePosition(id: IG.Deal.Identifier, limitLevel: Decimal64?, stop: Self.Position.StopEdit?) -> API.Endpoint<_PayloadUpdate,IG.Deal.Reference> {
+        self.api.endpoint { _ in try _PayloadUpdate(limit: limitLevel, stop: stop) }
+            .makeRequest(.put, "positions/otc/\(id)", version: 2, credentials: true, body: { (.json, try JSONEncoder().encode($0)) })
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: _WrapperReference, _) in w.dealReference }
+    }
+    
+    /// Endpoint call shared by `closePosition(matchedBy:direction:order:strategy:size:)` and its `async` variant.
+    func _closePosition(matchedBy identification: Self.Identification, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64) -> API.Endpoint<_PayloadDeletion,IG.Deal.Reference> {
+        self.api.endpoint { _ in try _PayloadDeletion(identification: identification, direction: direction, order: order, strategy: strategy, size: size) }
             .makeRequest(.post, "positions/otc", version: 1, credentials: true, headers: { _ in [._method: API.HTTP.Method.delete.description] }, body: { (.json, try JSONEncoder().encode($0)) })
             .send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default()) { (w: _WrapperReference, _) in w.dealReference }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
 }
 
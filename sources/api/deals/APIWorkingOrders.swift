@@ -7,12 +7,7 @@ extension API.Request.Deals {
     /// - seealso: GET /workingorders
     /// - returns: Publisher forwarding all open working orders.
     public func getWorkingOrders() -> AnyPublisher<[API.WorkingOrder],IG.Error> {
-        self.api.publisher
-            .makeRequest(.get, "workingorders", version: 2, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(date: true)) { (w: _WrapperList, _) in w.workingOrders }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getWorkingOrders().publisher
     }
     
     /// Creates an OTC working order.
@@ -31,14 +26,7 @@ extension API.Request.Deals {
     /// - parameter forceOpen: Enabling force open when creating a new position or working order will enable a second position to be opened on a market.
     /// - returns: Publisher forwarding the transient deal reference (for an unconfirmed trade).
     public func createWorkingOrder(reference: IG.Deal.Reference? = nil, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool = true) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
-        self.api.publisher { _ in
-                try _PayloadCreation(epic: epic, expiry: expiry, currency: currency, direction: direction, type: type, size: size, level: level, limit: limit, stop: stop, forceOpen: forceOpen, expiration: expiration, reference: reference)
-            }.makeRequest(.post, "workingorders/otc", version: 2, credentials: true, body: {
-                (.json, try JSONEncoder().encode($0))
-            }).send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: Self.WrapperReference, _) in w.dealReference }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._createWorkingOrder(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, type: type, expiration: expiration, size: size, level: level, limit: limit, stop: stop, forceOpen: forceOpen).publisher
     }
     
     /// Updates an OTC working order.
@@ -52,14 +40,7 @@ extension API.Request.Deals {
     /// - parameter stop: Passing a value will set a stop level (replacing the previous one, if any). Setting this argument to `nil` will delete the stop working order.
     /// - returns: Publisher forwarding the transient deal reference (for an unconfirmed trade).
     public func updateWorkingOrder(id: IG.Deal.Identifier, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, level: Decimal64, limit: IG.Deal.Boundary?, stop: IG.Deal.Boundary?) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
-        self.api.publisher { _ in
-                try _PayloadUpdate(type: type, level: level, limit: limit, stop: stop, expiration: expiration)
-            }.makeRequest(.put, "workingorders/otc/\(id)", version: 2, credentials: true, body: {
-                (.json, try JSONEncoder().encode($0))
-            }).send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: Self.WrapperReference, _) in w.dealReference }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._updateWorkingOrder(id: id, type: type, expiration: expiration, level: level, limit: limit, stop: stop).publisher
     }
     
     /// Deletes an OTC working order.
@@ -67,14 +48,83 @@ extension API.Request.Deals {
     /// - parameter id: A permanent deal reference for a confirmed working order.
     /// - returns: Publisher forwarding the deal reference.
     public func deleteWorkingOrder(id: IG.Deal.Identifier) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
-        self.api.publisher
-            .makeRequest(.delete, "workingorders/otc/\(id)", version: 2, credentials: true)
+        self._deleteWorkingOrder(id: id).publisher
+    }
+    
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Deals {
+    /// Returns all open working orders for the active account.
+    /// - seealso: `getWorkingOrders()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: All open working orders.
+    public func getWorkingOrders() async throws -> [API.WorkingOrder] {
+        try await self._getWorkingOrders().value()
+    }
+    
+    /// Creates an OTC working order.
+    /// - seealso: `createWorkingOrder(reference:epic:expiry:currency:direction:type:expiration:size:level:limit:stop:forceOpen:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func createWorkingOrder(reference: IG.Deal.Reference? = nil, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool = true) async throws -> IG.Deal.Reference {
+        try await self._createWorkingOrder(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, type: type, expiration: expiration, size: size, level: level, limit: limit, stop: stop, forceOpen: forceOpen).value()
+    }
+    
+    /// Updates an OTC working order.
+    /// - seealso: `updateWorkingOrder(id:type:expiration:level:limit:stop:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func updateWorkingOrder(id: IG.Deal.Identifier, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, level: Decimal64, limit: IG.Deal.Boundary?, stop: IG.Deal.Boundary?) async throws -> IG.Deal.Reference {
+        try await self._updateWorkingOrder(id: id, type: type, expiration: expiration, level: level, limit: limit, stop: stop).value()
+    }
+    
+    /// Deletes an OTC working order.
+    /// - seealso: `deleteWorkingOrder(id:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The deal reference.
+    public func deleteWorkingOrder(id: IG.Deal.Identifier) async throws -> IG.Deal.Reference {
+        try await self._deleteWorkingOrder(id: id).value()
+    }
+}
+#endif
+
+private extension API.Request.Deals {
+    /// Endpoint call shared by `getWorkingOrders()` and its `async` variant.
+    func _getWorkingOrders() -> API.Endpoint<Void,[API.WorkingOrder]> {
+        self.api.endpoint
+            .makeRequest(.get, "workingorders", version: 2, credentials: true)
             .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(date: true)) { (w: _WrapperList, _) in w.workingOrders }
+    }
+    
+    /// Endpoint call shared by `createWorkingOrder(reference:epic:expiry:currency:direction:type:expiration:size:level:limit:stop:forceOpen:)` and its `async` variant.
+    func _createWorkingOrder(reference: IG.Deal.Reference?, epic: IG.Market.Epic, expiry: IG.Market.Expiry, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool) -> API.Endpoint<_PayloadCreation,IG.Deal.Reference> {
+        self.api.endpoint {
+                try _PayloadCreation(epic: epic, expiry: expiry, currency: currency, direction: direction, type: type, size: size, level: level, limit: limit, stop: stop, forceOpen: forceOpen, expiration: expiration, reference: reference, now: $0.clock.now)
+            }.makeRequest(.post, "workingorders/otc", version: 2, credentials: true, body: {
+                (.json, try JSONEncoder().encode($0))
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: Self.WrapperReference, _) in w.dealReference }
+    }
+    
+    /// Endpoint call shared by `updateWorkingOrder(id:type:expiration:level:limit:stop:)` and its `async` variant.
+    func _updateWorkingOrder(id: IG.Deal.Identifier, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, level: Decimal64, limit: IG.Deal.Boundary?, stop: IG.Deal.Boundary?) -> API.Endpoint<_PayloadUpdate,IG.Deal.Reference> {
+        self.api.endpoint {
+                try _PayloadUpdate(type: type, level: level, limit: limit, stop: stop, expiration: expiration, now: $0.clock.now)
+            }.makeRequest(.put, "workingorders/otc/\(id)", version: 2, credentials: true, body: {
+                (.json, try JSONEncoder().encode($0))
+            }).send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default()) { (w: Self.WrapperReference, _) in w.dealReference }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
     
+    /// Endpoint call shared by `deleteWorkingOrder(id:)` and its `async` variant.
+    func _deleteWorkingOrder(id: IG.Deal.Identifier) -> API.Endpoint<Void,IG.Deal.Reference> {
+        self.api.endpoint
+            .makeRequest(.delete, "workingorders/otc/\(id)", version: 2, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: Self.WrapperReference, _) in w.dealReference }
+    }
 }
 
 // MARK: - Request Entities
@@ -98,8 +148,8 @@ extension API.Request.Deals {
     }
 }
 
-extension API.Request.Deals {
-    private struct _PayloadCreation: Encodable {
+private extension API.Request.Deals {
+    struct _PayloadCreation: Encodable {
         let epic: IG.Market.Epic
         let expiry: IG.Market.Expiry
         let currency: Currency.Code
@@ -113,7 +163,7 @@ extension API.Request.Deals {
         let expiration: IG.Deal.WorkingOrder.Expiration
         let reference: IG.Deal.Reference?
         
-        init(epic: IG.Market.Epic, expiry: IG.Market.Expiry, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool, expiration: IG.Deal.WorkingOrder.Expiration, reference: IG.Deal.Reference?) throws {
+        init(epic: IG.Market.Epic, expiry: IG.Market.Expiry, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool, expiration: IG.Deal.WorkingOrder.Expiration, reference: IG.Deal.Reference?, now: Date) throws {
             self.reference = reference
             self.epic = epic
             self.expiry = expiry
@@ -154,7 +204,7 @@ extension API.Request.Deals {
             
             switch expiration {
             case .tillCancelled: break
-            case .tillDate(let date): guard date > Date(timeIntervalSinceNow: 1) else { throw IG.Error._invalidExpiration(date: date) }
+            case .tillDate(let date): guard date > now.addingTimeInterval(1) else { throw IG.Error._invalidExpiration(date: date) }
             }
             self.expiration = expiration
         }
@@ -215,15 +265,15 @@ extension API.Request.Deals {
     }
 }
 
-extension API.Request.Deals {
-    private struct _PayloadUpdate: Encodable {
+private extension API.Request.Deals {
+    struct _PayloadUpdate: Encodable {
         let type: IG.Deal.WorkingOrder
         let level: Decimal64
         let limit: IG.Deal.Boundary?
         let stop: IG.Deal.Boundary?
         let expiration: IG.Deal.WorkingOrder.Expiration
         
-        init(type: IG.Deal.WorkingOrder, level: Decimal64, limit: IG.Deal.Boundary?, stop: IG.Deal.Boundary?, expiration: IG.Deal.WorkingOrder.Expiration) throws {
+        init(type: IG.Deal.WorkingOrder, level: Decimal64, limit: IG.Deal.Boundary?, stop: IG.Deal.Boundary?, expiration: IG.Deal.WorkingOrder.Expiration, now: Date) throws {
             self.type = type
             self.level = level
             
@@ -248,7 +298,7 @@ extension API.Request.Deals {
             switch expiration {
             case .tillCancelled: break
             case .tillDate(let date):
-                guard date > Date(timeIntervalSinceNow: 1) else { throw IG.Error._invalidExpiration(date: date) }
+                guard date > now.addingTimeInterval(1) else { throw IG.Error._invalidExpiration(date: date) }
             }
             self.expiration = expiration
         }
@@ -42,9 +42,16 @@ extension API {
             self.value = value
         }
         
-        /// Returns `true` when the `expirationDate` is in the past.
+        /// Returns `true` when the `expirationDate` is in the past (as measured by the system's wall clock).
+        /// - note: Use `isExpired(at:)` with the `API` instance's clock when time is virtualized.
         @_transparent public var isExpired: Bool {
-            self.expirationDate < Date()
+            self.isExpired(at: SystemClock.shared.now)
+        }
+
+        /// Returns `true` when the `expirationDate` is before the given date.
+        /// - parameter date: The date to compare with (usually the `API` instance's `clock.now`).
+        @_transparent public func isExpired(at date: Date) -> Bool {
+            self.expirationDate < date
         }
     }
 }
@@ -19,15 +19,7 @@ extension API.Request.Markets {
     /// - parameter epic: The market epic to target onto. It cannot be empty.
     /// - returns: Information about the targeted market.
     public func get(epic: IG.Market.Epic) -> AnyPublisher<API.Market,IG.Error> {
-        self.api.publisher { (api) -> DateFormatter in
-                let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
-                return DateFormatter.iso8601NoSeconds.deepCopy(timeZone: timezone)
-            }.makeRequest(.get, "markets/\(epic)", version: 3, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(values: true, date: true))
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
-        
+        self._get(epic: epic).publisher
     }
     
     /// Returns the details of the given markets.
@@ -100,7 +92,23 @@ extension API.Request.Markets {
             return Result.Publisher([]).eraseToAnyPublisher()
         }
         
-        return api.publisher { (api) -> DateFormatter in
+        return Self._endpoint(api: api, epics: epics).publisher
+    }
+    
+    /// Endpoint call shared by `get(epic:)` and its `async` variant.
+    private func _get(epic: IG.Market.Epic) -> API.Endpoint<DateFormatter,API.Market> {
+        self.api.endpoint { (api) -> DateFormatter in
+                let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
+                return DateFormatter.iso8601NoSeconds.deepCopy(timeZone: timezone)
+            }.makeRequest(.get, "markets/\(epic)", version: 3, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(values: true, date: true))
+    }
+    
+    /// Endpoint call retrieving the details of the given markets (shared by the Combine and `async` surfaces).
+    /// - parameter epics: The market epics to target onto. It cannot be empty or greater than 50.
+    private static func _endpoint(api: API, epics: Set<IG.Market.Epic>) -> API.Endpoint<DateFormatter,[API.Market]> {
+        api.endpoint { (api) -> DateFormatter in
             let epicRange = 1...50
             guard epicRange.contains(epics.count) else { throw IG.Error._invalidEpicRequest(num: epics.count, max: epicRange.upperBound) }
             
@@ -111,11 +119,49 @@ extension API.Request.Markets {
              .init(name: "epics", value: epics.map { $0.description }.joined(separator: ",")) ]
         }).send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default(values: true, date: true)) { (l: _WrapperList, _) in l.marketDetails }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
 }
 
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Markets {
+    /// Returns the details of a given market.
+    /// - seealso: `get(epic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: Information about the targeted market.
+    public func get(epic: IG.Market.Epic) async throws -> API.Market {
+        try await self._get(epic: epic).value()
+    }
+    
+    /// Returns the details of the given markets.
+    /// - seealso: `get(epics:)` (Combine variant).
+    /// - attention: The array argument `epics` can't be bigger than 50.
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: Extended information of all the requested markets.
+    public func get(epics: Set<IG.Market.Epic>) async throws -> [API.Market] {
+        guard !epics.isEmpty else { return [] }
+        return try await Self._endpoint(api: self.api, epics: epics).value()
+    }
+    
+    /// Returns the details of the given markets as an asynchronous sequence of batches (of 50 markets at most).
+    ///
+    /// Each batch is requested when the sequence consumer asks for it.
+    /// - seealso: `getContinuously(epics:)` (Combine variant).
+    /// - parameter epics: The market epics to target onto.
+    /// - returns: Asynchronous sequence of batches. Each element contains extended information of the requested markets.
+    public func getPages(epics: Set<IG.Market.Epic>) -> AsyncThrowingStream<[API.Market],Swift.Error> {
+        let chunks = epics.chunked(into: 50)
+        var index = 0
+        return AsyncThrowingStream(unfolding: { [weak weakAPI = self.api] in
+            guard index < chunks.count else { return nil }
+            guard let api = weakAPI else { throw IG.Error._deallocatedAPI() }
+            let markets = try await Self._endpoint(api: api, epics: chunks[index]).value()
+            index += 1
+            return markets
+        })
+    }
+}
+#endif
+
 // MARK: - Request Entities
 
 extension API.Request.Markets {
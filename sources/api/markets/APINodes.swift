@@ -22,7 +22,7 @@ extension API.Request.Nodes {
     public func get(identifier: String?, name: String? = nil, depth: Self.Depth = .none) -> AnyPublisher<API.Node,IG.Error> {
         let layers = depth._value
         guard layers > 0 else {
-            return Self._get(api: self._api, node: API.Node(id: identifier, name: name))
+            return Self._get(api: self._api, node: API.Node(id: identifier, name: name)).publisher
         }
         
         return Self._iterate(api: self._api, node: API.Node(id: identifier, name: name), depth: layers)
@@ -35,14 +35,7 @@ extension API.Request.Nodes {
     /// - parameter searchTerm: The term to be used in the search. This parameter is mandatory and cannot be empty.
     /// - returns: Publisher forwarding all markets matching the search term.
     public func getMarkets(matching searchTerm: String) -> AnyPublisher<[API.Node.Market],IG.Error> {
-        self._api.publisher { (api) -> String in
-                guard !searchTerm.isEmpty else { throw IG.Error._invalidSearchTerm() }
-                return searchTerm
-            }.makeRequest(.get, "markets", version: 1, credentials: true, queries: { [.init(name: "searchTerm", value: $0)] })
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(date: true)) { (w: _WrapperSearch, _) in w.markets }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getMarkets(matching: searchTerm).publisher
     }
 }
 
@@ -52,9 +45,9 @@ extension API.Request.Nodes {
     /// The subnodes are not recursively retrieved; thus only a flat hierarchy will be built with this endpoint.
     /// - seealso: GET /marketnavigation/{nodeId}
     /// - parameter node: The entity targeting a specific node. Only the identifier is used.
-    /// - returns: Publisher forwarding a *full* node.
-    private static func _get(api: API, node: API.Node) -> AnyPublisher<API.Node,IG.Error> {
-        api.publisher
+    /// - returns: Endpoint call retrieving a *full* node.
+    private static func _get(api: API, node: API.Node) -> API.Endpoint<Void,API.Node> {
+        api.endpoint
             .makeRequest(.get, "marketnavigation/\(node.id ?? "")", version: 1, credentials: true)
             .send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .custom({ (request, response, _) -> JSONDecoder in
@@ -70,8 +63,7 @@ extension API.Request.Nodes {
                         $0.userInfo[API.JSON.DecoderKey.nodeName] = name
                     }
                 }
-            })).mapError(errorCast)
-            .eraseToAnyPublisher()
+            }))
     }
     
     /// Returns the navigation node indicated by the given node argument as well as all its children till a given depth.
@@ -80,7 +72,7 @@ extension API.Request.Nodes {
     /// - returns: Publisher forwarding the node given as an argument with complete subnodes and submarkets information.
     private static func _iterate(api: API, node: API.Node, depth: Int) -> AnyPublisher<API.Node,IG.Error> {
         // 1. Retrieve the targeted node.
-        return _get(api: api, node: node).flatMap { [weak weakAPI = api] (node) -> AnyPublisher<API.Node,IG.Error> in
+        return _get(api: api, node: node).publisher.flatMap { [weak weakAPI = api] (node) -> AnyPublisher<API.Node,IG.Error> in
             let countdown = depth - 1
             // 2. If there aren't any more levels to drill down into or the target node doesn't have subnodes, send the targeted node.
             guard countdown >= 0, let subnodes = node.subnodes, !subnodes.isEmpty else {
@@ -134,6 +126,54 @@ extension API.Request.Nodes {
     }
 }
 
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Nodes {
+    /// Returns the navigation node with the given id and all the children till a specified depth.
+    /// - seealso: `get(identifier:name:depth:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The targeted node (and its children till the given depth).
+    public func get(identifier: String?, name: String? = nil, depth: Self.Depth = .none) async throws -> API.Node {
+        try await Self._iterate(api: self._api, node: API.Node(id: identifier, name: name), depth: depth._value)
+    }
+    
+    /// Returns all markets matching the search term.
+    /// - seealso: `getMarkets(matching:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: All markets matching the search term.
+    public func getMarkets(matching searchTerm: String) async throws -> [API.Node.Market] {
+        try await self._getMarkets(matching: searchTerm).value()
+    }
+    
+    /// Returns the navigation node indicated by the given node argument as well as all its children till a given depth.
+    ///
+    /// The children are retrieved one after the other (as in the Combine variant).
+    /// - parameter node: The entity targeting a specific node. Only the identifier is used for identification purposes.
+    /// - parameter depth: The depth at which the tree will be travelled.  A negative integer will default to `0`.
+    /// - returns: The node given as an argument with complete subnodes and submarkets information.
+    private static func _iterate(api: API, node: API.Node, depth: Int) async throws -> API.Node {
+        var result = try await Self._get(api: api, node: node).value()
+        guard depth > 0, let subnodes = result.subnodes else { return result }
+        
+        for (index, subnode) in subnodes.enumerated() {
+            result.subnodes![index] = try await Self._iterate(api: api, node: subnode, depth: depth - 1)
+        }
+        return result
+    }
+}
+#endif
+
+private extension API.Request.Nodes {
+    /// Endpoint call shared by `getMarkets(matching:)` and its `async` variant.
+    func _getMarkets(matching searchTerm: String) -> API.Endpoint<String,[API.Node.Market]> {
+        self._api.endpoint { (api) -> String in
+                guard !searchTerm.isEmpty else { throw IG.Error._invalidSearchTerm() }
+                return searchTerm
+            }.makeRequest(.get, "markets", version: 1, credentials: true, queries: { [.init(name: "searchTerm", value: $0)] })
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(date: true)) { (w: _WrapperSearch, _) in w.markets }
+    }
+}
+
 // MARK: - Request Entities
 
 extension API.Request.Nodes {
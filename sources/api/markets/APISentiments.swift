@@ -7,16 +7,7 @@ extension API.Request.Markets {
     /// - parameter marketIdentifiers: The platform's markets being targeted (don't confuse it with `epic` identifiers).
     /// - returns: Publisher forwarding  a list of all targeted markets along with their short/long sentiments.
     public func getSentiment(from marketIdentifiers: [String]) -> AnyPublisher<[API.Market.Sentiment],IG.Error> {
-        self.api.publisher { _ -> [String] in
-                let filteredIds = marketIdentifiers.filter { !$0.isEmpty }
-                guard !filteredIds.isEmpty else { throw IG.Error._emptyMarketIdentifiers() }
-                return filteredIds
-            }.makeRequest(.get, "clientsentiment", version: 1, credentials: true, queries: {
-                [.init(name: "marketIds", value: $0.joined(separator: ","))]
-            }).send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: _WrapperList, _) in w.clientSentiments }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getSentiment(from: marketIdentifiers).publisher
     }
     
     /// Returns the client sentiment for the gven market.
@@ -24,12 +15,7 @@ extension API.Request.Markets {
     /// - parameter marketIdentifier: The platform's market being targeted (don't confuse it with `epic` identifiers).
     /// - returns: Publisher forwarding  a market's short/long sentiments.
     public func getSentiment(from marketIdentifier: String) -> AnyPublisher<API.Market.Sentiment,IG.Error> {
-        self.api.publisher { _ in guard !marketIdentifier.isEmpty else { throw IG.Error._emptyMarketIdentifier() } }
-            .makeRequest(.get, "clientsentiment/\(marketIdentifier)", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getSentiment(from: marketIdentifier).publisher
     }
     
     /// Returns a list of markets (and its sentiments) that are being traded the most and are related to the gven market.
@@ -37,14 +23,67 @@ extension API.Request.Markets {
     /// - parameter marketIdentifier: The platform's market being targeted (don't confuse it with `epic` identifiers).
     /// - returns: Publisher forwarding a list of markets related to the given market along with their short/long sentiments.
     public func getSentiment(relatedTo marketIdentifier: String) -> AnyPublisher<[API.Market.Sentiment],IG.Error> {
-        self.api.publisher { _ in guard !marketIdentifier.isEmpty else { throw IG.Error._emptyMarketIdentifier() } }
+        self._getSentiment(relatedTo: marketIdentifier).publisher
+    }
+    
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Markets {
+    /// Returns the client sentiment for the given markets.
+    /// - seealso: `getSentiment(from:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: A list of all targeted markets along with their short/long sentiments.
+    public func getSentiment(from marketIdentifiers: [String]) async throws -> [API.Market.Sentiment] {
+        try await self._getSentiment(from: marketIdentifiers).value()
+    }
+    
+    /// Returns the client sentiment for the given market.
+    /// - seealso: `getSentiment(from:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The market's short/long sentiments.
+    public func getSentiment(from marketIdentifier: String) async throws -> API.Market.Sentiment {
+        try await self._getSentiment(from: marketIdentifier).value()
+    }
+    
+    /// Returns a list of markets (and its sentiments) that are being traded the most and are related to the given market.
+    /// - seealso: `getSentiment(relatedTo:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: A list of markets related to the given market along with their short/long sentiments.
+    public func getSentiment(relatedTo marketIdentifier: String) async throws -> [API.Market.Sentiment] {
+        try await self._getSentiment(relatedTo: marketIdentifier).value()
+    }
+}
+#endif
+
+private extension API.Request.Markets {
+    /// Endpoint call shared by `getSentiment(from:)` and its `async` variant.
+    func _getSentiment(from marketIdentifiers: [String]) -> API.Endpoint<[String],[API.Market.Sentiment]> {
+        self.api.endpoint { _ -> [String] in
+                let filteredIds = marketIdentifiers.filter { !$0.isEmpty }
+                guard !filteredIds.isEmpty else { throw IG.Error._emptyMarketIdentifiers() }
+                return filteredIds
+            }.makeRequest(.get, "clientsentiment", version: 1, credentials: true, queries: {
+                [.init(name: "marketIds", value: $0.joined(separator: ","))]
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: _WrapperList, _) in w.clientSentiments }
+    }
+    
+    /// Endpoint call shared by `getSentiment(from:)` and its `async` variant.
+    func _getSentiment(from marketIdentifier: String) -> API.Endpoint<Void,API.Market.Sentiment> {
+        self.api.endpoint { _ in guard !marketIdentifier.isEmpty else { throw IG.Error._emptyMarketIdentifier() } }
+            .makeRequest(.get, "clientsentiment/\(marketIdentifier)", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default())
+    }
+    
+    /// Endpoint call shared by `getSentiment(relatedTo:)` and its `async` variant.
+    func _getSentiment(relatedTo marketIdentifier: String) -> API.Endpoint<Void,[API.Market.Sentiment]> {
+        self.api.endpoint { _ in guard !marketIdentifier.isEmpty else { throw IG.Error._emptyMarketIdentifier() } }
             .makeRequest(.get, "clientsentiment/related/\(marketIdentifier)", version: 1, credentials: true)
             .send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default()) { (w: _WrapperList, _) in w.clientSentiments }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
-    
 }
 
 // MARK: - Request Entities
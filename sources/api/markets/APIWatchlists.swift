@@ -19,27 +19,14 @@ extension API.Request.Watchlists {
     /// - parameter epics: List of market epics to be associated to this new watchlist.
     /// - returns: Publisher forwarding the identifier of the created watchlist and a Boolean indicating whether the all epics where added to the watchlist).
     public func create(name: String, epics: [IG.Market.Epic]) -> AnyPublisher<(identifier: String, areAllInstrumentsAdded: Bool),IG.Error> {
-        self._api.publisher { _ -> _PayloadCreation in
-                guard !name.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() }
-                return .init(name: name, epics: epics.uniqueElements)
-            }.makeRequest(.post, "watchlists", version: 1, credentials: true, body: {
-                (.json, try JSONEncoder().encode($0))
-            }).send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: _WrapperCreation, _) in (w.id, w.areAllInstrumentsAdded) }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._create(name: name, epics: epics).publisher
     }
     
     /// Returns all watchlists belonging to the active account.
     /// - seealso: GET /watchlists
     /// - returns: Publisher forwarding an array of watchlists.
     public func getAll() -> AnyPublisher<[API.Watchlist],IG.Error> {
-        self._api.publisher
-            .makeRequest(.get, "watchlists", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default()) { (w: _WrapperList, _) in w.watchlists }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getAll().publisher
     }
     
     /// Returns the targeted watchlist.
@@ -47,13 +34,7 @@ extension API.Request.Watchlists {
     /// - parameter identifier: The identifier for the watchlist being targeted.
     /// - returns: Publisher forwarding all markets under the targeted watchlist.
     public func getMarkets(from identifier: String) -> AnyPublisher<[API.Node.Market],IG.Error> {
-        self._api.publisher { _ -> Void in
-                guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() }
-            }.makeRequest(.get, "watchlists/\(identifier)", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(date: true)) { (w: _WrapperWatchlist, _) in w.markets }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._getMarkets(from: identifier).publisher
     }
     
     /// Adds a market to a watchlist.
@@ -62,12 +43,8 @@ extension API.Request.Watchlists {
     /// - parameter epic: The market epic to be added to the watchlist.
     /// - returns: Publisher indicating the success of the operation.
     public func update(identifier: String, addingEpic epic: IG.Market.Epic) -> AnyPublisher<Never,IG.Error> {
-        self._api.publisher { _ in guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() } }
-            .makeRequest(.put, "watchlists/\(identifier)", version: 1, credentials: true, body: { (.json, try JSONEncoder().encode(["epic": epic])) })
-            .send(expecting: .json, statusCode: 200)
-            //.decodeJSON(decoder: .default()) { (_: Self.WrapperUpdate, _) in return }
+        self._update(identifier: identifier, addingEpic: epic).publisher
             .ignoreOutput()
-            .mapError(errorCast)
             .eraseToAnyPublisher()
     }
     
@@ -77,12 +54,8 @@ extension API.Request.Watchlists {
     /// - parameter epic: The market epic to be removed from the watchlist.
     /// - returns: Publisher indicating the success of the operation.
     public func update(identifier: String, removingEpic epic: IG.Market.Epic) -> AnyPublisher<Never,IG.Error> {
-        self._api.publisher { _ in guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() } }
-            .makeRequest(.delete, "watchlists/\(identifier)/\(epic)", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            //.decodeJSON(decoder: .default()) { (_: Self.WrapperUpdate, _) in return }
+        self._update(identifier: identifier, removingEpic: epic).publisher
             .ignoreOutput()
-            .mapError(errorCast)
             .eraseToAnyPublisher()
     }
     
@@ -91,16 +64,112 @@ extension API.Request.Watchlists {
     /// - parameter identifier: The identifier for the watchlist being targeted.
     /// - returns: Publisher indicating the success of the operation.
     public func delete(identifier: String) -> AnyPublisher<Never,IG.Error> {
-        self._api.publisher { _ in guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() } }
-            .makeRequest(.delete, "watchlists/\(identifier)", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            //.decodeJSON(decoder: .default()) { (w: Self.WrapperUpdate, _) in return }
+        self._delete(identifier: identifier).publisher
             .ignoreOutput()
-            .mapError(errorCast)
             .eraseToAnyPublisher()
     }
 }
 
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Watchlists {
+    /// Creates a watchlist.
+    /// - seealso: `create(name:epics:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The identifier of the created watchlist and a Boolean indicating whether the all epics where added to the watchlist.
+    public func create(name: String, epics: [IG.Market.Epic]) async throws -> (identifier: String, areAllInstrumentsAdded: Bool) {
+        try await self._create(name: name, epics: epics).value()
+    }
+    
+    /// Returns all watchlists belonging to the active account.
+    /// - seealso: `getAll()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: An array of watchlists.
+    public func getAll() async throws -> [API.Watchlist] {
+        try await self._getAll().value()
+    }
+    
+    /// Returns the targeted watchlist.
+    /// - seealso: `getMarkets(from:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: All markets under the targeted watchlist.
+    public func getMarkets(from identifier: String) async throws -> [API.Node.Market] {
+        try await self._getMarkets(from: identifier).value()
+    }
+    
+    /// Adds a market to a watchlist.
+    /// - seealso: `update(identifier:addingEpic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(identifier: String, addingEpic epic: IG.Market.Epic) async throws {
+        _ = try await self._update(identifier: identifier, addingEpic: epic).value()
+    }
+    
+    /// Removes a market from a watchlist.
+    /// - seealso: `update(identifier:removingEpic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(identifier: String, removingEpic epic: IG.Market.Epic) async throws {
+        _ = try await self._update(identifier: identifier, removingEpic: epic).value()
+    }
+    
+    /// Deletes the targeted watchlist.
+    /// - seealso: `delete(identifier:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func delete(identifier: String) async throws {
+        _ = try await self._delete(identifier: identifier).value()
+    }
+}
+#endif
+
+private extension API.Request.Watchlists {
+    /// Endpoint call shared by `create(name:epics:)` and its `async` variant.
+    func _create(name: String, epics: [IG.Market.Epic]) -> API.Endpoint<_PayloadCreation,(identifier: String, areAllInstrumentsAdded: Bool)> {
+        self._api.endpoint { _ -> _PayloadCreation in
+                guard !name.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() }
+                return .init(name: name, epics: epics.uniqueElements)
+            }.makeRequest(.post, "watchlists", version: 1, credentials: true, body: {
+                (.json, try JSONEncoder().encode($0))
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: _WrapperCreation, _) in (w.id, w.areAllInstrumentsAdded) }
+    }
+    
+    /// Endpoint call shared by `getAll()` and its `async` variant.
+    func _getAll() -> API.Endpoint<Void,[API.Watchlist]> {
+        self._api.endpoint
+            .makeRequest(.get, "watchlists", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default()) { (w: _WrapperList, _) in w.watchlists }
+    }
+    
+    /// Endpoint call shared by `getMarkets(from:)` and its `async` variant.
+    func _getMarkets(from identifier: String) -> API.Endpoint<Void,[API.Node.Market]> {
+        self._api.endpoint { _ -> Void in
+                guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() }
+            }.makeRequest(.get, "watchlists/\(identifier)", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(date: true)) { (w: _WrapperWatchlist, _) in w.markets }
+    }
+    
+    /// Endpoint call shared by `update(identifier:addingEpic:)` and its `async` variant.
+    func _update(identifier: String, addingEpic epic: IG.Market.Epic) -> API.Endpoint<Void,API.Transit.Call<Void>> {
+        self._api.endpoint { _ in guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() } }
+            .makeRequest(.put, "watchlists/\(identifier)", version: 1, credentials: true, body: { (.json, try JSONEncoder().encode(["epic": epic])) })
+            .send(expecting: .json, statusCode: 200)
+    }
+    
+    /// Endpoint call shared by `update(identifier:removingEpic:)` and its `async` variant.
+    func _update(identifier: String, removingEpic epic: IG.Market.Epic) -> API.Endpoint<Void,API.Transit.Call<Void>> {
+        self._api.endpoint { _ in guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() } }
+            .makeRequest(.delete, "watchlists/\(identifier)/\(epic)", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+    }
+    
+    /// Endpoint call shared by `delete(identifier:)` and its `async` variant.
+    func _delete(identifier: String) -> API.Endpoint<Void,API.Transit.Call<Void>> {
+        self._api.endpoint { _ in guard !identifier.isEmpty else { throw IG.Error._emptyWatchlistIdentifier() } }
+            .makeRequest(.delete, "watchlists/\(identifier)", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+    }
+}
+
 // MARK: - Request Entities
 
 private extension API.Request.Watchlists {
@@ -23,20 +23,7 @@ extension API.Request.Prices {
     /// - parameter resolution: It defines the resolution of requested prices.
     /// - returns: Publisher forwarding a list of price points and how many more requests (i.e. `allowance`) can still be performed on a unit of time.
     public func get(epic: IG.Market.Epic, from: Date, to: Date = Date(), resolution: API.Price.Resolution = .minute) -> AnyPublisher<(prices: [API.Price], allowance: API.Price.Allowance),IG.Error> {
-        self._api.publisher { (api) -> DateFormatter in
-                let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
-                return DateFormatter.iso8601Broad.deepCopy(timeZone: timezone)
-            }.makeRequest(.get, "prices/\(epic)", version: 3, credentials: true, queries: { (values) -> [URLQueryItem] in
-                [.init(name: "from", value: values.string(from: from)),
-                 .init(name: "to", value: values.string(from: to)),
-                 .init(name: "resolution", value: resolution.description),
-                 .init(name: "pageSize", value: "0"),
-                 .init(name: "pageNumber", value: "1") ]
-            }).send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(response: true)) { (response: _PagedPrices, _) in
-                (response.prices, response.metadata.allowance)
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._get(epic: epic, from: from, to: to, resolution: resolution).publisher
     }
     
     /// Returns historical prices for a particular instrument.
@@ -50,7 +37,74 @@ extension API.Request.Prices {
     /// - parameter page: Paging variables for the transactions page received. For the `page.size` and `page.number` must be greater than zero, or the publisher will fail.
     /// - returns: Combine `Publisher` forwarding multiple values. Each value represents a list of price points and how many more requests (i.e. `allowance`) can still be performed on a unit of time.
     public func getContinuously(epic: IG.Market.Epic, from: Date, to: Date = Date(), resolution: API.Price.Resolution = .minute, array page: (size: Int, number: Int) = (20, 1)) -> AnyPublisher<(prices: [API.Price], allowance: API.Price.Allowance),IG.Error> {
-        self._api.publisher { (api) -> (pageSize: Int, pageNumber: Int, formatter: DateFormatter) in
+        self._pages(epic: epic, from: from, to: to, resolution: resolution, array: page).publisher
+    }
+    
+    /// Returns historical prices for a particular instrument decoding them as the response bytes arrive.
+    ///
+    /// A single (non-paginated) request is performed, but the price points are decoded and forwarded in chunks while the response is still being received; thus, the whole response payload is never held in memory.
+    /// - seealso: GET /prices/{epic}
+    /// - note: The historical data allowance is not forwarded, since it is found after the price points in the response payload.
+    /// - parameter epic: Instrument's epic (e.g. `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query.
+    /// - parameter to: The date from which to end the query.
+    /// - parameter resolution: It defines the resolution of requested prices.
+    /// - parameter chunkSize: The maximum number of price points forwarded per value.
+    /// - returns: Combine `Publisher` forwarding multiple values. Each value represents a list of (at most `chunkSize`) price points sorted from oldest to newest.
+    public func getIncrementally(epic: IG.Market.Epic, from: Date, to: Date = Date(), resolution: API.Price.Resolution = .minute, chunkSize: Int = 500) -> AnyPublisher<[API.Price],IG.Error> {
+        self._request(epic: epic, from: from, to: to, resolution: resolution).publisher
+            .sendStreaming(statusCode: 200, array: "prices", decoder: .default(response: true), chunkSize: chunkSize)
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Prices {
+    /// Returns historical prices for a particular instrument.
+    /// - seealso: `get(epic:from:to:resolution:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: A list of price points and how many more requests (i.e. `allowance`) can still be performed on a unit of time.
+    public func get(epic: IG.Market.Epic, from: Date, to: Date = Date(), resolution: API.Price.Resolution = .minute) async throws -> (prices: [API.Price], allowance: API.Price.Allowance) {
+        try await self._get(epic: epic, from: from, to: to, resolution: resolution).value()
+    }
+    
+    /// Returns historical prices for a particular instrument as an asynchronous sequence of pages.
+    ///
+    /// Each page is requested when the sequence consumer asks for it.
+    /// - seealso: `getContinuously(epic:from:to:resolution:array:)` (Combine variant).
+    /// - returns: Asynchronous sequence of pages. Each element represents a list of price points and how many more requests (i.e. `allowance`) can still be performed on a unit of time.
+    public func getPages(epic: IG.Market.Epic, from: Date, to: Date = Date(), resolution: API.Price.Resolution = .minute, array page: (size: Int, number: Int) = (20, 1)) -> AsyncThrowingStream<(prices: [API.Price], allowance: API.Price.Allowance),Swift.Error> {
+        self._pages(epic: epic, from: from, to: to, resolution: resolution, array: page).stream
+    }
+}
+#endif
+
+private extension API.Request.Prices {
+    /// Single (non-paginated) price request definition shared by the buffered and incremental surfaces.
+    func _request(epic: IG.Market.Epic, from: Date, to: Date, resolution: API.Price.Resolution) -> API.Prepared<DateFormatter> {
+        self._api.endpoint { (api) -> DateFormatter in
+                let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
+                return DateFormatter.iso8601Broad.deepCopy(timeZone: timezone)
+            }.makeRequest(.get, "prices/\(epic)", version: 3, credentials: true, queries: { (values) -> [URLQueryItem] in
+                [.init(name: "from", value: values.string(from: from)),
+                 .init(name: "to", value: values.string(from: to)),
+                 .init(name: "resolution", value: resolution.description),
+                 .init(name: "pageSize", value: "0"),
+                 .init(name: "pageNumber", value: "1") ]
+            })
+    }
+    
+    /// Endpoint call shared by `get(epic:from:to:resolution:)` and its `async` variant.
+    func _get(epic: IG.Market.Epic, from: Date, to: Date, resolution: API.Price.Resolution) -> API.Endpoint<DateFormatter,(prices: [API.Price], allowance: API.Price.Allowance)> {
+        self._request(epic: epic, from: from, to: to, resolution: resolution)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(response: true)) { (response: _PagedPrices, _) in
+                (response.prices, response.metadata.allowance)
+            }
+    }
+    
+    /// Paginated price request definition shared by the Combine and `async` surfaces.
+    func _pages(epic: IG.Market.Epic, from: Date, to: Date, resolution: API.Price.Resolution, array page: (size: Int, number: Int)) -> API.Pages<(pageSize: Int, pageNumber: Int, formatter: DateFormatter),_PagedPrices.Metadata.Page,(prices: [API.Price], allowance: API.Price.Allowance)> {
+        let endpoint = self._api.endpoint { (api) -> (pageSize: Int, pageNumber: Int, formatter: DateFormatter) in
                 let timezone = try api.channel.credentials?.timezone ?> IG.Error._unfoundCredentials()
                 guard page.size > 0 else { throw IG.Error._invalid(pageSize: page.size) }
                 guard page.number > 0 else { throw IG.Error._invalid(pageNumber: page.number) }
@@ -63,17 +117,16 @@ extension API.Request.Prices {
                  .init(name: "resolution", value: resolution.description),
                  .init(name: "pageSize", value: String(values.pageSize)),
                  .init(name: "pageNumber", value: String(values.pageNumber)) ]
-            }).sendPaginating(request: { (_, initial, previous) -> URLRequest? in
-                guard let previous = previous else { return initial.request }
-                guard let pageNumber = previous.metadata.next else { return nil }
-                return try initial.request.set { try $0.addQueries([URLQueryItem(name: "pageNumber", value: String(pageNumber))]) }
-            }, call: { (publisher, _) in
-                publisher.send(expecting: .json, statusCode: 200)
-                    .decodeJSON(decoder: .default(response: true)) { (response: _PagedPrices, _) in
-                        (response.metadata.page, (response.prices, response.metadata.allowance))
-                    }.mapError(errorCast)
-            }).mapError(errorCast)
-            .eraseToAnyPublisher()
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(response: true)) { (response: _PagedPrices, _) in
+                (response.metadata.page, (prices: response.prices, allowance: response.metadata.allowance))
+            }
+        
+        return .init(endpoint: endpoint, next: { (_, initial, previous) -> URLRequest? in
+            guard let previous = previous else { return initial.request }
+            guard let pageNumber = previous.metadata.next else { return nil }
+            return try initial.request.set { try $0.addQueries([URLQueryItem(name: "pageNumber", value: String(pageNumber))]) }
+        })
     }
 }
 
@@ -148,7 +201,7 @@ extension API.Price {
 
 extension API.Request.Prices {
     /// Single page of prices request.
-    private struct _PagedPrices: Decodable {
+    fileprivate struct _PagedPrices: Decodable {
         let instrumentType: API.Market.Instrument.Kind
         let prices: [API.Price]
         let metadata: Self.Metadata
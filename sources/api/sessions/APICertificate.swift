@@ -14,28 +14,18 @@ extension API.Request.Session {
     /// - parameter encryptPassword: Boolean indicating whether the given password shall be encrypted before sending it to the server.
     /// - returns: Publisher forwarding platform credentials if the login was successful.
     internal func loginCertificate(key: API.Key, user: API.User, encryptPassword: Bool = false) -> AnyPublisher<(credentials: API.Credentials, settings: API.Session.Settings), Swift.Error> {
-        self.api.publisher
-            .makeRequest(.post, "session", version: 2, credentials: false, headers: { [.apiKey: key.description] }, body: {
-                let payload = _PayloadCertificate(user: user, encryptedPassword: encryptPassword)
-                return (.json, try JSONEncoder().encode(payload))
-            }).send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(response: true)) { (r: API.Session._Certificate, _) -> (credentials: API.Credentials, settings: API.Session.Settings) in
-                let token = API.Token(.certificate(access: r.tokens.accessToken, security: r.tokens.securityToken), expirationDate: r.tokens.expirationDate)
-                let credentials = API.Credentials(key: key, client: r.session.client, account: r.account.id, streamerURL: r.session.streamerURL, timezone: r.session.timezone, token: token)
-                return (credentials, r.session.settings)
-            }.eraseToAnyPublisher()
+        self._loginCertificate(key: key, user: user, encryptPassword: encryptPassword).publisher
+            .mapError { $0 as Swift.Error }
+            .eraseToAnyPublisher()
     }
 
     /// It regenerates certificate credentials from the current session (whether OAuth or Certificate logged in).
     /// - seealso: GET /session?fetchSessionTokens=true
     /// - returns: Publisher forwarding a `API.Credentials.Token.certificate` if the process was successful.
     internal func refreshCertificate() -> AnyPublisher<API.Token,Swift.Error> {
-        self.api.publisher
-            .makeRequest(.get, "session", version: 1, credentials: true, queries: { [URLQueryItem(name: "fetchSessionTokens", value: "true")] })
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(response: true)) { (r: API.Session._WrapperCertificate, _) in
-                .init(.certificate(access: r.token.accessToken, security: r.token.securityToken), expirationDate: r.token.expirationDate)
-            }.eraseToAnyPublisher()
+        self._refreshCertificate().publisher
+            .mapError { $0 as Swift.Error }
+            .eraseToAnyPublisher()
     }
 
     /// Returns the user's session details for the credentials given as arguments and regenerates the certificate tokens.
@@ -84,6 +74,32 @@ extension API.Request.Session {
     }
 }
 
+extension API.Request.Session {
+    /// Endpoint call shared by `loginCertificate(key:user:encryptPassword:)` and the `async` login.
+    internal func _loginCertificate(key: API.Key, user: API.User, encryptPassword: Bool = false) -> API.Endpoint<Void,(credentials: API.Credentials, settings: API.Session.Settings)> {
+        self.api.endpoint
+            .makeRequest(.post, "session", version: 2, credentials: false, headers: { [.apiKey: key.description] }, body: {
+                let payload = _PayloadCertificate(user: user, encryptedPassword: encryptPassword)
+                return (.json, try JSONEncoder().encode(payload))
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(response: true)) { (r: API.Session._Certificate, _) -> (credentials: API.Credentials, settings: API.Session.Settings) in
+                let token = API.Token(.certificate(access: r.tokens.accessToken, security: r.tokens.securityToken), expirationDate: r.tokens.expirationDate)
+                let credentials = API.Credentials(key: key, client: r.session.client, account: r.account.id, streamerURL: r.session.streamerURL, timezone: r.session.timezone, token: token)
+                return (credentials, r.session.settings)
+            }
+    }
+
+    /// Endpoint call shared by `refreshCertificate()` and the `async` token refresh.
+    internal func _refreshCertificate() -> API.Endpoint<Void,API.Token> {
+        self.api.endpoint
+            .makeRequest(.get, "session", version: 1, credentials: true, queries: { [URLQueryItem(name: "fetchSessionTokens", value: "true")] })
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(response: true)) { (r: API.Session._WrapperCertificate, _) in
+                .init(.certificate(access: r.token.accessToken, security: r.token.securityToken), expirationDate: r.token.expirationDate)
+            }
+    }
+}
+
 // MARK: - Request Entities
 
 private extension API.Request.Session {
@@ -10,15 +10,9 @@ extension API.Request.Session {
     /// - parameter user: User name and password to log in into an account.
     /// - returns: Publisher forwarding the platform credentials if the login was successful.
     internal func loginOAuth(key: API.Key, user: API.User) -> AnyPublisher<API.Credentials,Swift.Error> {
-        self.api.publisher
-            .makeRequest(.post, "session", version: 3, credentials: false, headers: { [.apiKey: key.description] }, body: {
-                let payload = _PayloadOAuth(user: user)
-                return (.json, try JSONEncoder().encode(payload))
-            }).send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default(response: true)) { (r: API.Session._OAuth, _) -> API.Credentials in
-                let token = API.Token(.oauth(access: r.tokens.accessToken, refresh: r.tokens.refreshToken, scope: r.tokens.scope, type: r.tokens.type), expirationDate: r.tokens.expirationDate)
-                return API.Credentials(key: key, client: r.clientId, account: r.accountId, streamerURL: r.streamerURL, timezone: r.timezone, token: token)
-            }.eraseToAnyPublisher()
+        self._loginOAuth(key: key, user: user).publisher
+            .mapError { $0 as Swift.Error }
+            .eraseToAnyPublisher()
     }
 
     /// Refreshes a trading session token, obtaining new session for subsequent API.
@@ -28,16 +22,37 @@ extension API.Request.Session {
     /// - parameter key: API key given by the IG platform identifying the usage of the IG endpoints.
     /// - returns: Publisher forwarding the OAUth token if the refresh process was successful.
     internal func refreshOAuth(token: String, key: API.Key) -> AnyPublisher<API.Token,Swift.Error> {
-        self.api.publisher { _ -> _TemporaryRefresh in
+        self._refreshOAuth(token: token, key: key).publisher
+            .mapError { $0 as Swift.Error }
+            .eraseToAnyPublisher()
+    }
+}
+
+extension API.Request.Session {
+    /// Endpoint call shared by `loginOAuth(key:user:)` and the `async` login.
+    internal func _loginOAuth(key: API.Key, user: API.User) -> API.Endpoint<Void,API.Credentials> {
+        self.api.endpoint
+            .makeRequest(.post, "session", version: 3, credentials: false, headers: { [.apiKey: key.description] }, body: {
+                let payload = _PayloadOAuth(user: user)
+                return (.json, try JSONEncoder().encode(payload))
+            }).send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default(response: true)) { (r: API.Session._OAuth, _) -> API.Credentials in
+                let token = API.Token(.oauth(access: r.tokens.accessToken, refresh: r.tokens.refreshToken, scope: r.tokens.scope, type: r.tokens.type), expirationDate: r.tokens.expirationDate)
+                return API.Credentials(key: key, client: r.clientId, account: r.accountId, streamerURL: r.streamerURL, timezone: r.timezone, token: token)
+            }
+    }
+
+    /// Endpoint call shared by `refreshOAuth(token:key:)` and the `async` token refresh.
+    internal func _refreshOAuth(token: String, key: API.Key) -> API.Endpoint<Void,API.Token> {
+        self.api.endpoint { _ -> Void in
                 guard !token.isEmpty else { throw IG.Error._emptyRefreshToken(key: key) }
-                return _TemporaryRefresh(refreshToken: token, apiKey: key)
-            }.makeRequest(.post, "session/refresh-token", version: 1, credentials: false, headers: { [.apiKey: $0.apiKey.description] }, body: {
-                let payload = ["refresh_token": $0.refreshToken]
+            }.makeRequest(.post, "session/refresh-token", version: 1, credentials: false, headers: { _ in [.apiKey: key.description] }, body: { _ in
+                let payload = ["refresh_token": token]
                 return (.json, try JSONEncoder().encode(payload))
             }).send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default(response: true)) { (r: API.Session._OAuth._Token, _) in
                 .init(.oauth(access: r.accessToken, refresh: r.refreshToken, scope: r.scope, type: r.type), expirationDate: r.expirationDate)
-            }.eraseToAnyPublisher()
+            }
     }
 }
 
@@ -57,11 +72,6 @@ private extension API.Request.Session {
             case identifier, password
         }
     }
-    
-    struct _TemporaryRefresh {
-        let refreshToken: String
-        let apiKey: API.Key
-    }
 }
 
 // MARK: Response Entities
@@ -32,10 +32,10 @@ extension API.Request.Session {
     
     /// Boolean indicating whether the API can perform priviledge endpoints.
     ///
-    /// To return `true`, there must be credentials in the session and the token must not be expired.
+    /// To return `true`, there must be credentials in the session and the token must not be expired (as measured by the API instance's clock).
     public var isActive: Bool {
         guard let credentials = self.api.channel.credentials else { return false }
-        return !credentials.token.isExpired
+        return !credentials.token.isExpired(at: self.api.clock.now)
     }
 
     /// Logs a user in the platform and stores the credentials within the API instance.
@@ -48,24 +48,9 @@ extension API.Request.Session {
     /// - parameter user: User name and password to log in into an IG account.
     /// - returns: Publisher outputting a login success with a successful complete event. If the login is of `.certificate` type, extra information on the session settings is forwarded as a value. The `.oauth` login type will simply complete successfully for successful operations (without forwarding any value).
     public func login(type: Self.Kind, key: API.Key, user: API.User) -> AnyPublisher<API.Session.Settings,IG.Error> {
-        switch type {
-        case .certificate:
-            return self.loginCertificate(key: key, user: user, encryptPassword: false)
-                .tryMap { [weak weakAPI = self.api] (credentials, settings) in
-                    let api = try weakAPI ?> IG.Error._deallocatedAPI()
-                    api.channel.credentials = credentials
-                    return settings
-                }.mapError(errorCast)
-                .eraseToAnyPublisher()
-        case .oauth:
-            return self.loginOAuth(key: key, user: user)
-                .tryCompactMap { [weak weakAPI = self.api] (credentials) -> API.Session.Settings? in
-                    let api = try weakAPI ?> IG.Error._deallocatedAPI()
-                    api.channel.credentials = credentials
-                    return nil
-                }.mapError(errorCast)
-                .eraseToAnyPublisher()
-        }
+        self._login(type: type, key: key, user: user).publisher
+            .compactMap { $0 }
+            .eraseToAnyPublisher()
     }
 
     /// Refreshes the underlying secret token so the session can remain connected for longer time.
@@ -75,21 +60,8 @@ extension API.Request.Session {
     /// - returns: Publisher indicating a successful token refresh with a successful complete.
     public func refresh() -> AnyPublisher<Never,IG.Error> {
         self.api.publisher { try $0.channel.credentials ?> IG.Error._unfoundCredentials() }
-            .mapError { $0 as Swift.Error }
-            .flatMap { (api, credentials) -> AnyPublisher<API.Token,Swift.Error> in
-                switch credentials.token.value {
-                case .certificate: return api.session.refreshCertificate()
-                case .oauth(_, let refresh, _, _): return api.session.refreshOAuth(token: refresh, key: credentials.key)
-                }
-            }.tryCompactMap { [weak weakAPI = self.api] (token) in
-                let api = try weakAPI ?> IG.Error._deallocatedAPI()
-                try api.channel.credentials { (oldCredentials) in
-                    var newCredentials = try oldCredentials ?> IG.Error._unfoundCredentials()
-                    newCredentials.token = token
-                    return newCredentials
-                }
-                return nil
-            }.mapError(errorCast)
+            .flatMap { (api, credentials) in api.session._refresh(credentials: credentials).publisher }
+            .ignoreOutput()
             .eraseToAnyPublisher()
     }
 
@@ -97,12 +69,7 @@ extension API.Request.Session {
     /// - seealso: GET /session
     /// - returns: Publisher forwarding the user's session details.
     public func get() -> AnyPublisher<API.Session,IG.Error> {
-        self.api.publisher
-            .makeRequest(.get, "session", version: 1, credentials: true)
-            .send(expecting: .json, statusCode: 200)
-            .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+        self._get().publisher
     }
 
     /// Returns the user's session details for the given credentials.
@@ -111,7 +78,140 @@ extension API.Request.Session {
     /// - parameter token: The credentials for the user session to query.
     /// - returns: Publisher forwarding information about the current user's session.
     public func get(key: API.Key, token: API.Token) -> AnyPublisher<API.Session,IG.Error> {
-        self.api.publisher
+        self._get(key: key, token: token).publisher
+    }
+
+    /// Switches active accounts, optionally setting the default account.
+    ///
+    /// This method will change the credentials stored within the API instance (in case of successfull endpoint call).
+    /// - seealso: PUT /session
+    /// - attention: The identifier of the account to switch to must be different than the current account or the server will return an error.
+    /// - parameter accountId: The identifier for the account that the user want to switch to.
+    /// - parameter makingDefault: Boolean indicating whether the new account should be made the default one.
+    /// - returns: Publisher indicating a successful account switch with a successful complete.
+    public func `switch`(to accountId: IG.Account.Identifier, makingDefault: Bool = false) -> AnyPublisher<API.Session.Settings,IG.Error> {
+        self._switch(to: accountId, makingDefault: makingDefault).publisher
+    }
+
+    /// Log out from the current session.
+    ///
+    /// This method will delete the credentials stored in the API instance (in case of successful endpoint call).
+    /// - seealso: DELETE /session
+    /// - note: If the API instance didn't have any credentials (i.e. a user was not logged in), the response is successful.
+    /// - returns: Publisher indicating a succesful logout operation with a sucessful complete.
+    public func logout() -> AnyPublisher<Never,IG.Error> {
+        self._logout().publisher
+            .ignoreOutput()
+            .eraseToAnyPublisher()
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension API.Request.Session {
+    /// Logs a user in the platform and stores the credentials within the API instance.
+    /// - seealso: `login(type:key:user:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The session settings for `.certificate` logins (`nil` for `.oauth` logins).
+    public func login(type: Self.Kind, key: API.Key, user: API.User) async throws -> API.Session.Settings? {
+        try await self._login(type: type, key: key, user: user).value()
+    }
+    
+    /// Refreshes the underlying secret token so the session can remain connected for longer time.
+    /// - seealso: `refresh()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func refresh() async throws {
+        let credentials = try self.api.channel.credentials ?> IG.Error._unfoundCredentials()
+        try await self._refresh(credentials: credentials).value()
+    }
+    
+    /// Returns the user's session details.
+    /// - seealso: `get()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The user's session details.
+    public func get() async throws -> API.Session {
+        try await self._get().value()
+    }
+    
+    /// Returns the user's session details for the given credentials.
+    /// - seealso: `get(key:token:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: Information about the user's session.
+    public func get(key: API.Key, token: API.Token) async throws -> API.Session {
+        try await self._get(key: key, token: token).value()
+    }
+    
+    /// Switches active accounts, optionally setting the default account.
+    /// - seealso: `switch(to:makingDefault:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The new session settings.
+    public func `switch`(to accountId: IG.Account.Identifier, makingDefault: Bool = false) async throws -> API.Session.Settings {
+        try await self._switch(to: accountId, makingDefault: makingDefault).value()
+    }
+    
+    /// Log out from the current session.
+    /// - seealso: `logout()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func logout() async throws {
+        try await self._logout().value()
+    }
+}
+#endif
+
+private extension API.Request.Session {
+    /// Endpoint call shared by `login(type:key:user:)` and its `async` variant.
+    ///
+    /// The received credentials are stored within the API instance. Only `.certificate` logins forward the session settings.
+    func _login(type: Self.Kind, key: API.Key, user: API.User) -> API.Endpoint<Void,API.Session.Settings?> {
+        switch type {
+        case .certificate:
+            return self._loginCertificate(key: key, user: user, encryptPassword: false)
+                .map { [weak weakAPI = self.api] (credentials, settings) in
+                    let api = try weakAPI ?> IG.Error._deallocatedAPI()
+                    api.channel.credentials = credentials
+                    return settings
+                }
+        case .oauth:
+            return self._loginOAuth(key: key, user: user)
+                .map { [weak weakAPI = self.api] (credentials) -> API.Session.Settings? in
+                    let api = try weakAPI ?> IG.Error._deallocatedAPI()
+                    api.channel.credentials = credentials
+                    return nil
+                }
+        }
+    }
+
+    /// Endpoint call shared by `refresh()` and its `async` variant.
+    ///
+    /// The refreshed token replaces the one stored within the API instance.
+    /// - parameter credentials: The credentials (at the time of call) whose token type selects the refresh endpoint.
+    func _refresh(credentials: API.Credentials) -> API.Endpoint<Void,Void> {
+        let endpoint: API.Endpoint<Void,API.Token>
+        switch credentials.token.value {
+        case .certificate: endpoint = self._refreshCertificate()
+        case .oauth(_, let refresh, _, _): endpoint = self._refreshOAuth(token: refresh, key: credentials.key)
+        }
+
+        return endpoint.map { [weak weakAPI = self.api] (token) in
+            let api = try weakAPI ?> IG.Error._deallocatedAPI()
+            try api.channel.credentials { (oldCredentials) in
+                var newCredentials = try oldCredentials ?> IG.Error._unfoundCredentials()
+                newCredentials.token = token
+                return newCredentials
+            }
+        }
+    }
+
+    /// Endpoint call shared by `get()` and its `async` variant.
+    func _get() -> API.Endpoint<Void,API.Session> {
+        self.api.endpoint
+            .makeRequest(.get, "session", version: 1, credentials: true)
+            .send(expecting: .json, statusCode: 200)
+            .decodeJSON(decoder: .default())
+    }
+    
+    /// Endpoint call shared by `get(key:token:)` and its `async` variant.
+    func _get(key: API.Key, token: API.Token) -> API.Endpoint<Void,API.Session> {
+        self.api.endpoint
             .makeRequest(.get, "session", version: 1, credentials: false, headers: {
                 var result = [API.HTTP.Header.Key.apiKey: key.description]
                 switch token.value {
@@ -124,20 +224,11 @@ extension API.Request.Session {
                 return result
             }).send(expecting: .json, statusCode: 200)
             .decodeJSON(decoder: .default())
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
     }
-
-    /// Switches active accounts, optionally setting the default account.
-    ///
-    /// This method will change the credentials stored within the API instance (in case of successfull endpoint call).
-    /// - seealso: PUT /session
-    /// - attention: The identifier of the account to switch to must be different than the current account or the server will return an error.
-    /// - parameter accountId: The identifier for the account that the user want to switch to.
-    /// - parameter makingDefault: Boolean indicating whether the new account should be made the default one.
-    /// - returns: Publisher indicating a successful account switch with a successful complete.
-    public func `switch`(to accountId: IG.Account.Identifier, makingDefault: Bool = false) -> AnyPublisher<API.Session.Settings,IG.Error> {
-        self.api.publisher
+    
+    /// Endpoint call shared by `switch(to:makingDefault:)` and its `async` variant.
+    func _switch(to accountId: IG.Account.Identifier, makingDefault: Bool) -> API.Endpoint<Void,API.Session.Settings> {
+        self.api.endpoint
             .makeRequest(.put, "session", version: 1, credentials: true, body: {
                 let payload = _PayloadSwitch(accountId: accountId.description, defaultAccount: makingDefault)
                 return (.json, try JSONEncoder().encode(payload))
@@ -150,23 +241,15 @@ extension API.Request.Session {
                     return newCredentials
                 }
                 return sessionSwitch
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
-
-    /// Log out from the current session.
-    ///
-    /// This method will delete the credentials stored in the API instance (in case of successful endpoint call).
-    /// - seealso: DELETE /session
-    /// - note: If the API instance didn't have any credentials (i.e. a user was not logged in), the response is successful.
-    /// - returns: Publisher indicating a succesful logout operation with a sucessful complete.
-    public func logout() -> AnyPublisher<Never,IG.Error> {
-        self.api.publisher
+    
+    /// Endpoint call shared by `logout()` and its `async` variant.
+    func _logout() -> API.Endpoint<Void,Void> {
+        self.api.endpoint
             .makeRequest(.delete, "session", version: 1, credentials: true)
             .send(statusCode: 204)
-            .compactMap { [weak weakAPI = self.api] _ in weakAPI?.channel.credentials = nil; return nil }
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+            .map { [weak weakAPI = self.api] _ in weakAPI?.channel.credentials = nil }
     }
 }
 
@@ -0,0 +1,828 @@
+import Combine
+import Foundation
+import Decimals
+
+extension API {
+    /// Creates an API instance whose endpoints are served in process by the given exchange simulator (no network access is performed).
+    /// - parameter simulator: The simulator serving the session, position, working order, and confirmation endpoints.
+    /// - parameter credentials: `nil` for yet unknown credentials (most of the cases); otherwise, use your hard-coded credentials.
+    /// - parameter queue: The queue used to process the requests and responses. If `nil`, the system will create a serial queue.
+    /// - parameter clock: The clock measuring token expirations.
+    public convenience init(simulator: API.Simulator, credentials: API.Credentials? = nil, queue: DispatchQueue? = nil, clock: Clock = SystemClock.shared) {
+        let queue = queue ?? DispatchQueue(label: IG.identifier + ".api.queue", qos: .utility)
+        let configuration = API.Channel.defaultSessionConfigurations
+        configuration.protocolClasses = [API.Simulator._URLProtocol.self]
+        let session = URLSession(configuration: configuration, delegate: nil, delegateQueue: OperationQueue(underlying: queue))
+        self.init(rootURL: simulator.rootURL, credentials: credentials, queue: queue, session: session, clock: clock)
+    }
+}
+
+extension API {
+    /// In-process stand-in for the IG dealing endpoints.
+    ///
+    /// The simulator serves the `session`, `positions/otc`, `workingorders/otc`, and `confirms` endpoints through a custom `URLProtocol`; thus the regular `API` request path (payload validation, encoding, decoding) is exercised without network access.
+    /// Orders are matched against the prices passed to `update(epic:bid:ask:date:)` (or fed from a streamed/recorded publisher); positions, working orders, and margin are kept in memory and every deal change is forwarded through `events` (mirroring the streamer's confirmation and OPU updates).
+    /// - note: Only the OAuth login is simulated. Credentials are not validated.
+    public final class Simulator {
+        /// The lock restricting access to the simulated exchange state.
+        private let _lock: UnfairLock
+        /// The queue where responses are delivered.
+        internal let queue: DispatchQueue
+        /// The subject forwarding the simulated deal events.
+        private let _subject: PassthroughSubject<Event,Never>
+        /// The root URL identifying the simulator (to be used as the `API` root URL).
+        public let rootURL: URL
+        /// The simulated account identifier.
+        public let account: IG.Account.Identifier
+        /// The simulated account currency.
+        public let currency: Currency.Code
+        /// The fraction of a deal's notional value required as margin.
+        public let marginFactor: Decimal64
+        /// The artificial delay (in seconds) added to every response.
+        public let latency: TimeInterval
+        /// The clock dating deals and responses, and delaying the responses.
+        public let clock: Clock
+        /// The latest prices indexed by market epic.
+        private var _quotes: [IG.Market.Epic:(bid: Decimal64, ask: Decimal64, date: Date)]
+        /// The open positions indexed by deal identifier.
+        private var _positions: [IG.Deal.Identifier:Position]
+        /// The working orders indexed by deal identifier.
+        private var _orders: [IG.Deal.Identifier:WorkingOrder]
+        /// The encoded confirmations indexed by deal reference.
+        private var _confirmations: [IG.Deal.Reference:Data]
+        /// The account balance (without unrealized profit/loss).
+        private var _balance: Decimal64
+        /// Counter used to generate unique deal identifiers and references.
+        private var _counter: Int
+        /// Counters measuring the simulator usage.
+        private var _statistics: Statistics
+
+        /// Designated initializer.
+        /// - parameter account: The simulated account identifier.
+        /// - parameter currency: The simulated account currency.
+        /// - parameter funds: The initial account balance.
+        /// - parameter marginFactor: The fraction of a deal's notional value required as margin (e.g. `0.05` for 5%).
+        /// - parameter latency: The artificial delay (in seconds) added to every response.
+        /// - parameter clock: The clock dating deals and responses (token expirations are computed from the responses' `Date` header). Pass the same `VirtualClock` given to the `API` instance to run simulations faster than wall time.
+        public init(account: IG.Account.Identifier = "SIM01", currency: Currency.Code = "EUR", funds: Decimal64 = Decimal64(10_000, power: 0)!, marginFactor: Decimal64 = Decimal64(5, power: -2)!, latency: TimeInterval = 0, clock: Clock = SystemClock.shared) {
+            self._lock = UnfairLock()
+            self.queue = DispatchQueue(label: IG.identifier + ".api.simulator", qos: .utility)
+            self._subject = PassthroughSubject()
+            self.rootURL = URL(string: "https://\(UUID().uuidString.lowercased()).\(Self._hostSuffix)/gateway/deal").unsafelyUnwrapped
+            self.account = account
+            self.currency = currency
+            self.marginFactor = marginFactor
+            self.latency = Swift.max(0, latency)
+            self.clock = clock
+            self._quotes = .init()
+            self._positions = .init()
+            self._orders = .init()
+            self._confirmations = .init()
+            self._balance = funds
+            self._counter = 0
+            self._statistics = .init()
+            Self._register(self)
+        }
+
+        deinit {
+            Self._unregister(self)
+            self._subject.send(completion: .finished)
+            self._lock.invalidate()
+        }
+
+        /// Publisher forwarding every confirmation and position/working order change (as the streamer's `TRADE` subscription would).
+        public var events: AnyPublisher<Event,Never> {
+            self._subject.eraseToAnyPublisher()
+        }
+
+        /// The open positions.
+        public var positions: [Position] {
+            self._lock.execute { self._positions.values.sorted { ($0.date, $0.id.description) < ($1.date, $1.id.description) } }
+        }
+
+        /// The working orders waiting to be triggered.
+        public var workingOrders: [WorkingOrder] {
+            self._lock.execute { self._orders.values.sorted { ($0.date, $0.id.description) < ($1.date, $1.id.description) } }
+        }
+
+        /// The account balance, used margin, and unrealized profit/loss.
+        public var funds: (balance: Decimal64, margin: Decimal64, profitLoss: Decimal64) {
+            self._lock.execute { (self._balance, self._margin(), self._profitLoss()) }
+        }
+
+        /// Counters measuring the simulator usage.
+        public var statistics: Statistics {
+            self._lock.execute { self._statistics }
+        }
+
+        /// Sets the latest prices for a market; triggering working orders, stops, and limits reached by them.
+        /// - parameter epic: The market epic.
+        /// - parameter bid: The bid price.
+        /// - parameter ask: The ask/offer price.
+        /// - parameter date: The date of the prices. If `nil`, the simulator's clock current date is used.
+        public func update(epic: IG.Market.Epic, bid: Decimal64, ask: Decimal64, date: Date? = nil) {
+            let date = date ?? self.clock.now
+            self._lock.lock()
+            self._quotes[epic] = (bid, ask, date)
+            var events: [Event] = []
+            self._expireOrders(epic: epic, date: date, events: &events)
+            self._triggerOrders(epic: epic, events: &events)
+            self._triggerPositions(epic: epic, events: &events)
+            self._lock.unlock()
+            events.forEach { self._subject.send($0) }
+        }
+
+        /// Feeds the prices of every streamed market update into the simulator.
+        /// - parameter upstream: Publisher forwarding market updates (e.g. a streamer subscription).
+        /// - returns: The subscription; cancel it to stop feeding prices.
+        public func feed<P>(_ upstream: P) -> AnyCancellable where P:Publisher, P.Output==Streamer.Market {
+            upstream.sink(receiveCompletion: { _ in }, receiveValue: { [weak self] in
+                guard let bid = $0.bid, let ask = $0.ask else { return }
+                self?.update(epic: $0.epic, bid: bid, ask: ask, date: $0.date)
+            })
+        }
+
+        /// Feeds the close prices of every candle into the simulator.
+        /// - parameter upstream: Publisher forwarding candles (e.g. a streamer subscription or a `Database.Replay` of recorded prices).
+        /// - returns: The subscription; cancel it to stop feeding prices.
+        public func feed<P>(_ upstream: P) -> AnyCancellable where P:Publisher, P.Output==Streamer.Chart.Aggregated {
+            upstream.sink(receiveCompletion: { _ in }, receiveValue: { [weak self] in
+                guard let bid = $0.candle.close.bid, let ask = $0.candle.close.ask else { return }
+                self?.update(epic: $0.epic, bid: bid, ask: ask, date: $0.candle.date)
+            })
+        }
+    }
+}
+
+extension API.Simulator {
+    /// A simulated open position.
+    public struct Position: Identifiable {
+        /// Permanent deal identifier.
+        public let id: IG.Deal.Identifier
+        /// The deal reference of the order opening the position.
+        public let reference: IG.Deal.Reference
+        /// The opening date.
+        public let date: Date
+        /// Instrument epic identifier.
+        public let epic: IG.Market.Epic
+        /// Instrument expiration period.
+        public let expiry: IG.Market.Expiry
+        /// Deal direction.
+        public let direction: IG.Deal.Direction
+        /// Remaining deal size.
+        public internal(set) var size: Decimal64
+        /// Opening level.
+        public let level: Decimal64
+        /// The level at which profit is taken.
+        public internal(set) var limit: Decimal64?
+        /// The level at which losses are stopped.
+        public internal(set) var stop: Decimal64?
+        /// Boolean indicating whether the stop is guaranteed.
+        public internal(set) var isStopGuaranteed: Bool
+        /// The trailing stop distance and increment (if the stop is trailing).
+        public internal(set) var trailing: (distance: Decimal64, increment: Decimal64)?
+    }
+
+    /// A simulated working order.
+    public struct WorkingOrder: Identifiable {
+        /// Permanent deal identifier.
+        public let id: IG.Deal.Identifier
+        /// The deal reference of the order creation.
+        public let reference: IG.Deal.Reference
+        /// The creation date.
+        public let date: Date
+        /// Instrument epic identifier.
+        public let epic: IG.Market.Epic
+        /// Instrument expiration period.
+        public let expiry: IG.Market.Expiry
+        /// Deal direction.
+        public let direction: IG.Deal.Direction
+        /// The working order type.
+        public internal(set) var type: IG.Deal.WorkingOrder
+        /// Deal size.
+        public let size: Decimal64
+        /// Level at which the order is triggered.
+        public internal(set) var level: Decimal64
+        /// The limit attached to the resulting position.
+        public internal(set) var limit: IG.Deal.Boundary?
+        /// The stop attached to the resulting position.
+        public internal(set) var stop: IG.Deal.Boundary?
+        /// Boolean indicating whether the resulting position's stop is guaranteed.
+        public internal(set) var isStopGuaranteed: Bool
+        /// The date at which the order expires (if any).
+        public internal(set) var expiration: Date?
+    }
+
+    /// A simulated deal event.
+    public enum Event {
+        /// A deal confirmation (accepted if `rejection` is `nil`).
+        case confirmation(reference: IG.Deal.Reference, id: IG.Deal.Identifier, rejection: API.Confirmation.Deal.Status.RejectionReason?)
+        /// A position has been opened, amended, or (partially) closed.
+        case position(Position, status: IG.Deal.Status)
+        /// A working order has been opened, amended, or deleted.
+        case workingOrder(WorkingOrder, status: IG.Deal.Status)
+    }
+
+    /// Counters measuring the simulator usage.
+    public struct Statistics {
+        /// The number of HTTP requests served.
+        public internal(set) var requests: Int = 0
+        /// The number of accepted deals.
+        public internal(set) var accepted: Int = 0
+        /// The number of rejected deals.
+        public internal(set) var rejected: Int = 0
+        /// The number of fills (positions opened from orders or working orders).
+        public internal(set) var fills: Int = 0
+    }
+}
+
+// MARK: - Routing
+
+extension API.Simulator {
+    /// A simulated HTTP response.
+    internal typealias Response = (statusCode: Int, body: Data?)
+
+    /// Serves the given request.
+    /// - parameter request: The request as received by the URL protocol.
+    /// - parameter body: The request body (if any).
+    internal func respond(to request: URLRequest, body: Data?) -> Response {
+        guard let url = request.url else { return Self._error(400, "error.simulator.invalid-url") }
+        let root = self.rootURL.pathComponents
+        let components = Array(url.pathComponents.dropFirst(root.count))
+        let method = (request.value(forHTTPHeaderField: "_method") ?? request.httpMethod ?? "GET").uppercased()
+
+        self._lock.execute { self._statistics.requests += 1 }
+
+        switch (method, components) {
+        case ("POST", ["session"]):
+            return self._login()
+        case ("POST", ["session", "refresh-token"]):
+            return Self._encode(Self._token())
+        case ("GET", ["session"]):
+            return Self._encode(_Session(clientId: Self._client, accountId: self.account, timezoneOffset: 0, lightstreamerEndpoint: self.rootURL, locale: "en_GB", currency: self.currency))
+        case ("DELETE", ["session"]):
+            return (204, nil)
+        case ("POST", ["positions", "otc"]):
+            guard let payload = Self._decode(body) else { return Self._error(400, "error.simulator.invalid-payload") }
+            return self._reference(self._createPosition(payload))
+        case ("DELETE", ["positions", "otc"]):
+            guard let payload = Self._decode(body) else { return Self._error(400, "error.simulator.invalid-payload") }
+            return self._reference(self._closePositions(payload))
+        case ("PUT", ["positions", "otc", let id]):
+            guard let payload = Self._decode(body), let id = IG.Deal.Identifier(id) else { return Self._error(400, "error.simulator.invalid-payload") }
+            return self._reference(self._updatePosition(id: id, payload))
+        case ("POST", ["workingorders", "otc"]):
+            guard let payload = Self._decode(body) else { return Self._error(400, "error.simulator.invalid-payload") }
+            return self._reference(self._createWorkingOrder(payload))
+        case ("PUT", ["workingorders", "otc", let id]):
+            guard let payload = Self._decode(body), let id = IG.Deal.Identifier(id) else { return Self._error(400, "error.simulator.invalid-payload") }
+            return self._reference(self._updateWorkingOrder(id: id, payload))
+        case ("DELETE", ["workingorders", "otc", let id]):
+            guard let id = IG.Deal.Identifier(id) else { return Self._error(400, "error.simulator.invalid-payload") }
+            return self._reference(self._deleteWorkingOrder(id: id))
+        case ("GET", ["confirms", let reference]):
+            let data = IG.Deal.Reference(reference).flatMap { (reference) in self._lock.execute { self._confirmations[reference] } }
+            guard let confirmation = data else { return Self._error(404, "error.confirms.deal-not-found") }
+            return (200, confirmation)
+        default:
+            return Self._error(404, "error.simulator.unsupported-endpoint")
+        }
+    }
+}
+
+extension API.Simulator {
+    /// The host suffix shared by all simulators (the `.invalid` top level domain guarantees no real host is ever targeted).
+    internal static var _hostSuffix: String { "simulator.invalid" }
+}
+
+private extension API.Simulator {
+    /// Returns the simulated OAuth login response.
+    func _login() -> Response {
+        Self._encode(_OAuth(clientId: Self._client, accountId: self.account, timezoneOffset: 0, lightstreamerEndpoint: self.rootURL, oauthToken: Self._token()))
+    }
+
+    /// The simulated client identifier.
+    static var _client: String { "10000000" }
+
+    /// Returns a simulated OAuth token.
+    static func _token() -> _OAuth._Token {
+        .init(access_token: UUID().uuidString, refresh_token: UUID().uuidString, scope: "profile", token_type: "Bearer", expires_in: "60")
+    }
+
+    /// Sends the events and returns the reference response for the given deal outcome.
+    func _reference(_ outcome: (reference: IG.Deal.Reference, events: [Event])) -> Response {
+        outcome.events.forEach { self._subject.send($0) }
+        return Self._encode(["dealReference": outcome.reference])
+    }
+
+    /// Returns an error response with the given code.
+    static func _error(_ statusCode: Int, _ code: String) -> Response {
+        (statusCode, try? JSONEncoder().encode(["errorCode": code]))
+    }
+
+    /// Encodes the given value as a successful response.
+    static func _encode<T:Encodable>(_ value: T) -> Response {
+        guard let data = try? JSONEncoder().encode(value) else { return Self._error(500, "error.simulator.encoding") }
+        return (200, data)
+    }
+
+    /// Decodes the deal request payload.
+    static func _decode(_ body: Data?) -> _Payload? {
+        body.flatMap { try? JSONDecoder().decode(_Payload.self, from: $0) }
+    }
+}
+
+// MARK: - Dealing
+
+private extension API.Simulator {
+    /// Generates a unique deal identifier and reference.
+    /// - attention: This function must be called while holding the lock.
+    func _generate(reference: IG.Deal.Reference? = nil) -> (id: IG.Deal.Identifier, reference: IG.Deal.Reference) {
+        self._counter += 1
+        let suffix = String(self._counter)
+        return (IG.Deal.Identifier("DIAAAASIM" + suffix)!, reference ?? IG.Deal.Reference("SIMREF" + suffix)!)
+    }
+
+    /// Stores the confirmation for a deal and returns the matching confirmation event.
+    /// - attention: This function must be called while holding the lock.
+    func _confirm(_ confirmation: _Confirmation) -> Event {
+        self._confirmations[confirmation.dealReference] = try? JSONEncoder().encode(confirmation)
+        if confirmation.reason == nil { self._statistics.accepted += 1 } else { self._statistics.rejected += 1 }
+        return .confirmation(reference: confirmation.dealReference, id: confirmation.dealId, rejection: confirmation.reason.flatMap { .init(rawValue: $0) })
+    }
+
+    /// Records a rejected deal.
+    /// - attention: This function must be called while holding the lock.
+    func _reject(_ reason: API.Confirmation.Deal.Status.RejectionReason, reference: IG.Deal.Reference?, epic: IG.Market.Epic?, direction: IG.Deal.Direction?) -> (reference: IG.Deal.Reference, events: [Event]) {
+        let deal = self._generate(reference: reference)
+        let confirmation = _Confirmation(date: self._now(epic: epic), dealId: deal.id, dealReference: deal.reference, reason: reason.rawValue,
+                                         epic: epic ?? "UNKNOWN", direction: direction ?? .buy)
+        return (deal.reference, [self._confirm(confirmation)])
+    }
+
+    /// Returns the latest known date for the given market (or the simulator's clock date if unknown).
+    func _now(epic: IG.Market.Epic?) -> Date {
+        epic.flatMap { self._quotes[$0]?.date } ?? self.clock.now
+    }
+
+    /// Returns the margin used by all open positions.
+    func _margin() -> Decimal64 {
+        self._positions.values.reduce(.zero) { $0 + $1.size * $1.level * self.marginFactor }
+    }
+
+    /// Returns the unrealized profit/loss of all open positions.
+    func _profitLoss() -> Decimal64 {
+        self._positions.values.reduce(.zero) { (result, position) in
+            guard let quote = self._quotes[position.epic] else { return result }
+            return result + Self._profit(position, size: position.size, level: (position.direction == .buy) ? quote.bid : quote.ask)
+        }
+    }
+
+    /// Returns the profit/loss of closing the given size of a position at the given level.
+    static func _profit(_ position: Position, size: Decimal64, level: Decimal64) -> Decimal64 {
+        (position.direction == .buy) ? (level - position.level) * size : (position.level - level) * size
+    }
+
+    /// Returns the absolute level for a boundary given as level or distance from the opening level.
+    static func _level(_ boundary: IG.Deal.Boundary?, from level: Decimal64, direction: IG.Deal.Direction, isLimit: Bool) -> Decimal64? {
+        switch boundary {
+        case .none: return nil
+        case .level(let l): return l
+        case .distance(let d): return ((direction == .buy) == isLimit) ? level + d : level - d
+        }
+    }
+
+    /// Opens a position at the given level (if the margin allows it), netting off opposite positions when `forceOpen` is `false`.
+    /// - attention: This function must be called while holding the lock.
+    func _fill(reference: IG.Deal.Reference?, epic: IG.Market.Epic, expiry: IG.Market.Expiry, direction: IG.Deal.Direction, size: Decimal64, level: Decimal64,
+               limit: IG.Deal.Boundary?, stop: IG.Deal.Boundary?, isStopGuaranteed: Bool, trailing: (distance: Decimal64, increment: Decimal64)?, forceOpen: Bool) -> (reference: IG.Deal.Reference, events: [Event]) {
+        let date = self._now(epic: epic)
+        var (remaining, events, affected) = (size, [Event](), [_Confirmation._AffectedDeal]())
+        // Netting is rolled back if the residual position cannot be opened; thus, a rejected deal never changes the account.
+        let snapshot = (positions: self._positions, balance: self._balance)
+
+        // Net off opposite positions (FIFO) when force open is disabled.
+        if !forceOpen {
+            let opposite = self._positions.values.filter { $0.epic == epic && $0.direction != direction }.sorted { $0.date < $1.date }
+            for position in opposite where remaining > .zero {
+                let closed = (position.size < remaining) ? position.size : remaining
+                let (status, event) = self._close(id: position.id, size: closed, level: level)
+                events.append(event)
+                affected.append(.init(dealId: position.id, status: status))
+                remaining = remaining - closed
+            }
+        }
+
+        let deal = self._generate(reference: reference)
+        if remaining > .zero {
+            let margin = remaining * level * self.marginFactor
+            guard margin <= self._balance + self._profitLoss() - self._margin() else {
+                (self._positions, self._balance) = snapshot
+                return self._reject(.insufficientFunds, reference: deal.reference, epic: epic, direction: direction)
+            }
+
+            let position = Position(id: deal.id, reference: deal.reference, date: date, epic: epic, expiry: expiry, direction: direction, size: remaining, level: level,
+                                    limit: Self._level(limit, from: level, direction: direction, isLimit: true),
+                                    stop: Self._level(stop, from: level, direction: direction, isLimit: false),
+                                    isStopGuaranteed: isStopGuaranteed, trailing: trailing)
+            self._positions[deal.id] = position
+            self._statistics.fills += 1
+            affected.append(.init(dealId: deal.id, status: "OPENED"))
+            events.append(.position(position, status: .opened))
+        }
+
+        let position = self._positions[deal.id]
+        let confirmation = _Confirmation(date: date, dealId: deal.id, dealReference: deal.reference, reason: nil, affectedDeals: affected,
+                                         status: (position != nil) ? "OPEN" : "FULLY_CLOSED", epic: epic, expiry: expiry, direction: direction, size: size, level: level,
+                                         limitLevel: position?.limit, stopLevel: position?.stop, guaranteedStop: position?.isStopGuaranteed ?? false, trailingStop: position?.trailing != nil)
+        events.insert(self._confirm(confirmation), at: 0)
+        return (deal.reference, events)
+    }
+
+    /// Closes the given size of a position at the given level, realizing its profit/loss.
+    /// - attention: This function must be called while holding the lock.
+    func _close(id: IG.Deal.Identifier, size: Decimal64, level: Decimal64) -> (status: String, event: Event) {
+        var position = self._positions[id]!
+        self._balance = self._balance + Self._profit(position, size: size, level: level)
+        position.size = position.size - size
+
+        if position.size > .zero {
+            self._positions[id] = position
+            return ("PARTIALLY_CLOSED", .position(position, status: .closed(.partially)))
+        } else {
+            self._positions.removeValue(forKey: id)
+            return ("FULLY_CLOSED", .position(position, status: .closed(.fully)))
+        }
+    }
+
+    /// Handles a position creation request.
+    func _createPosition(_ p: _Payload) -> (reference: IG.Deal.Reference, events: [Event]) {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        guard let epic = p.epic, let direction = p.direction, let size = p.size, size > .zero else {
+            return self._reject(.generalError, reference: p.dealReference, epic: p.epic, direction: p.direction)
+        }
+        guard let quote = self._quotes[epic] else {
+            return self._reject(.instrumentNotFound, reference: p.dealReference, epic: epic, direction: direction)
+        }
+
+        let market = (direction == .buy) ? quote.ask : quote.bid
+        let level: Decimal64
+        switch (p.orderType, p.level) {
+        case ("LIMIT", let limit?):
+            // Fill-or-kill at the given level or better.
+            guard (direction == .buy) ? (market <= limit) : (market >= limit) else {
+                return self._reject(.invalidMarketLevel, reference: p.dealReference, epic: epic, direction: direction)
+            }
+            level = market
+        case ("QUOTE", let quoted?): level = quoted
+        default: level = market
+        }
+
+        let limit: IG.Deal.Boundary? = p.limitLevel.map { .level($0) } ?? p.limitDistance.map { .distance($0) }
+        let stop: IG.Deal.Boundary? = p.stopLevel.map { .level($0) } ?? p.stopDistance.map { .distance($0) }
+        let trailing = (p.trailingStop ?? false) ? p.stopDistance.map { ($0, p.trailingStopIncrement ?? .zero) } : nil
+        return self._fill(reference: p.dealReference, epic: epic, expiry: p.expiry ?? .none, direction: direction, size: size, level: level,
+                          limit: limit, stop: stop, isStopGuaranteed: p.guaranteedStop ?? false, trailing: trailing, forceOpen: p.forceOpen ?? true)
+    }
+
+    /// Handles a position closing request (matching by deal identifier or by epic).
+    func _closePositions(_ p: _Payload) -> (reference: IG.Deal.Reference, events: [Event]) {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        guard let direction = p.direction, let size = p.size, size > .zero else {
+            return self._reject(.generalError, reference: nil, epic: p.epic, direction: p.direction)
+        }
+
+        let matches: [Position]
+        if let id = p.dealId {
+            matches = self._positions[id].map { [$0] } ?? []
+        } else {
+            matches = self._positions.values.filter { $0.epic == p.epic && $0.direction != direction }.sorted { $0.date < $1.date }
+        }
+        guard let first = matches.first, first.direction != direction,
+              let quote = self._quotes[first.epic] else {
+            return self._reject(.positionNotFound, reference: nil, epic: p.epic, direction: direction)
+        }
+        guard matches.reduce(.zero, { $0 + $1.size }) >= size else {
+            return self._reject(.failedPositionClose, reference: nil, epic: first.epic, direction: direction)
+        }
+
+        let level = (first.direction == .buy) ? quote.bid : quote.ask
+        var (remaining, profit, events, affected) = (size, Decimal64.zero, [Event](), [_Confirmation._AffectedDeal]())
+        for position in matches where remaining > .zero {
+            let closed = (position.size < remaining) ? position.size : remaining
+            let (status, event) = self._close(id: position.id, size: closed, level: level)
+            profit = profit + Self._profit(position, size: closed, level: level)
+            events.append(event)
+            affected.append(.init(dealId: position.id, status: status))
+            remaining = remaining - closed
+        }
+
+        let deal = self._generate()
+        let confirmation = _Confirmation(date: quote.date, dealId: first.id, dealReference: deal.reference, reason: nil, affectedDeals: affected,
+                                         status: affected.last?.status ?? "FULLY_CLOSED", epic: first.epic, expiry: first.expiry, direction: direction, size: size, level: level,
+                                         profit: profit, profitCurrency: self.currency)
+        events.insert(self._confirm(confirmation), at: 0)
+        return (deal.reference, events)
+    }
+
+    /// Handles a position amendment request (replacing its limit and stop).
+    func _updatePosition(id: IG.Deal.Identifier, _ p: _Payload) -> (reference: IG.Deal.Reference, events: [Event]) {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        guard var position = self._positions[id] else {
+            return self._reject(.positionNotFound, reference: nil, epic: nil, direction: nil)
+        }
+        position.limit = p.limitLevel
+        position.stop = p.stopLevel
+        position.trailing = (p.trailingStop ?? false) ? p.trailingStopDistance.map { ($0, p.trailingStopIncrement ?? .zero) } : nil
+        self._positions[id] = position
+
+        let deal = self._generate()
+        let confirmation = _Confirmation(date: self._now(epic: position.epic), dealId: id, dealReference: deal.reference, reason: nil, affectedDeals: [.init(dealId: id, status: "AMENDED")],
+                                         status: "AMENDED", epic: position.epic, expiry: position.expiry, direction: position.direction, size: position.size, level: position.level,
+                                         limitLevel: position.limit, stopLevel: position.stop, guaranteedStop: position.isStopGuaranteed, trailingStop: position.trailing != nil)
+        return (deal.reference, [self._confirm(confirmation), .position(position, status: .amended)])
+    }
+
+    /// Handles a working order creation request.
+    func _createWorkingOrder(_ p: _Payload) -> (reference: IG.Deal.Reference, events: [Event]) {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        guard let epic = p.epic, let direction = p.direction, let type = p.type, let size = p.size, size > .zero, let level = p.level else {
+            return self._reject(.generalError, reference: p.dealReference, epic: p.epic, direction: p.direction)
+        }
+        guard self._quotes[epic] != nil else {
+            return self._reject(.instrumentNotFound, reference: p.dealReference, epic: epic, direction: direction)
+        }
+
+        let deal = self._generate(reference: p.dealReference)
+        let order = WorkingOrder(id: deal.id, reference: deal.reference, date: self._now(epic: epic), epic: epic, expiry: p.expiry ?? .none, direction: direction, type: type, size: size, level: level,
+                                 limit: p.limitLevel.map { .level($0) } ?? p.limitDistance.map { .distance($0) },
+                                 stop: p.stopLevel.map { .level($0) } ?? p.stopDistance.map { .distance($0) },
+                                 isStopGuaranteed: p.guaranteedStop ?? false, expiration: p.expiration)
+        self._orders[deal.id] = order
+
+        let confirmation = _Confirmation(date: order.date, dealId: deal.id, dealReference: deal.reference, reason: nil, affectedDeals: [.init(dealId: deal.id, status: "OPENED")],
+                                         status: "OPEN", epic: epic, expiry: order.expiry, direction: direction, size: size, level: level)
+        var events = [self._confirm(confirmation), .workingOrder(order, status: .opened)]
+        // The order may be immediately triggered by the current prices.
+        self._triggerOrders(epic: epic, events: &events)
+        return (deal.reference, events)
+    }
+
+    /// Handles a working order amendment request.
+    func _updateWorkingOrder(id: IG.Deal.Identifier, _ p: _Payload) -> (reference: IG.Deal.Reference, events: [Event]) {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        guard var order = self._orders[id] else {
+            return self._reject(.orderNotFound, reference: nil, epic: nil, direction: nil)
+        }
+        if let type = p.type { order.type = type }
+        if let level = p.level { order.level = level }
+        order.limit = p.limitLevel.map { .level($0) } ?? p.limitDistance.map { .distance($0) }
+        order.stop = p.stopLevel.map { .level($0) } ?? p.stopDistance.map { .distance($0) }
+        order.expiration = p.expiration
+        self._orders[id] = order
+
+        let deal = self._generate()
+        let confirmation = _Confirmation(date: self._now(epic: order.epic), dealId: id, dealReference: deal.reference, reason: nil, affectedDeals: [.init(dealId: id, status: "AMENDED")],
+                                         status: "AMENDED", epic: order.epic, expiry: order.expiry, direction: order.direction, size: order.size, level: order.level)
+        var events = [self._confirm(confirmation), .workingOrder(order, status: .amended)]
+        self._triggerOrders(epic: order.epic, events: &events)
+        return (deal.reference, events)
+    }
+
+    /// Handles a working order deletion request.
+    func _deleteWorkingOrder(id: IG.Deal.Identifier) -> (reference: IG.Deal.Reference, events: [Event]) {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        guard let order = self._orders.removeValue(forKey: id) else {
+            return self._reject(.orderNotFound, reference: nil, epic: nil, direction: nil)
+        }
+        let deal = self._generate()
+        let confirmation = _Confirmation(date: self._now(epic: order.epic), dealId: id, dealReference: deal.reference, reason: nil, affectedDeals: [.init(dealId: id, status: "DELETED")],
+                                         status: "DELETED", epic: order.epic, expiry: order.expiry, direction: order.direction, size: order.size, level: order.level)
+        return (deal.reference, [self._confirm(confirmation), .workingOrder(order, status: .deleted)])
+    }
+}
+
+// MARK: - Matching
+
+private extension API.Simulator {
+    /// Deletes the working orders (for the given market) whose expiration date has been reached.
+    /// - attention: This function must be called while holding the lock.
+    func _expireOrders(epic: IG.Market.Epic, date: Date, events: inout [Event]) {
+        for order in self._orders.values where order.epic == epic {
+            guard let expiration = order.expiration, expiration <= date else { continue }
+            self._orders.removeValue(forKey: order.id)
+            events.append(.workingOrder(order, status: .deleted))
+        }
+    }
+
+    /// Converts into positions the working orders (for the given market) triggered by the latest prices.
+    /// - attention: This function must be called while holding the lock.
+    func _triggerOrders(epic: IG.Market.Epic, events: inout [Event]) {
+        guard let quote = self._quotes[epic] else { return }
+
+        let triggered = self._orders.values.filter {
+            guard $0.epic == epic else { return false }
+            let price = ($0.direction == .buy) ? quote.ask : quote.bid
+            switch ($0.type, $0.direction) {
+            case (.limit, .buy), (.stop, .sell): return price <= $0.level
+            case (.limit, .sell), (.stop, .buy): return price >= $0.level
+            }
+        }.sorted { $0.date < $1.date }
+
+        for order in triggered {
+            self._orders.removeValue(forKey: order.id)
+            events.append(.workingOrder(order, status: .deleted))
+            // Triggered orders are filled at the current market price (limit orders at the given level or better; stop orders with slippage).
+            let level = (order.direction == .buy) ? quote.ask : quote.bid
+            let outcome = self._fill(reference: nil, epic: epic, expiry: order.expiry, direction: order.direction, size: order.size, level: level,
+                                     limit: order.limit, stop: order.stop, isStopGuaranteed: order.isStopGuaranteed, trailing: nil, forceOpen: true)
+            events.append(contentsOf: outcome.events)
+        }
+    }
+
+    /// Moves trailing stops and closes the positions (for the given market) whose stop or limit has been reached.
+    /// - attention: This function must be called while holding the lock.
+    func _triggerPositions(epic: IG.Market.Epic, events: inout [Event]) {
+        guard let quote = self._quotes[epic] else { return }
+
+        for var position in self._positions.values where position.epic == epic {
+            let price = (position.direction == .buy) ? quote.bid : quote.ask
+            let isBuy = (position.direction == .buy)
+
+            // Trailing stops follow the price in increments.
+            if let trailing = position.trailing, let stop = position.stop {
+                let target = isBuy ? price - trailing.distance : price + trailing.distance
+                let movement = isBuy ? target - stop : stop - target
+                if movement > .zero, movement >= trailing.increment {
+                    position.stop = target
+                    self._positions[position.id] = position
+                    events.append(.position(position, status: .amended))
+                }
+            }
+
+            let isLimitReached = position.limit.map { isBuy ? price >= $0 : price <= $0 } ?? false
+            let isStopReached = position.stop.map { isBuy ? price <= $0 : price >= $0 } ?? false
+            guard isLimitReached || isStopReached else { continue }
+            // Guaranteed stops are filled at the stop level; otherwise the current price is used (simulating slippage).
+            let level = (isStopReached && position.isStopGuaranteed) ? position.stop! : price
+            events.append(self._close(id: position.id, size: position.size, level: level).event)
+        }
+    }
+}
+
+// MARK: - Entities
+
+private extension API.Simulator {
+    /// The payload of all simulated deal requests (all fields are optional since each endpoint uses a subset of them).
+    struct _Payload: Decodable {
+        let dealId: IG.Deal.Identifier?
+        let dealReference: IG.Deal.Reference?
+        let epic: IG.Market.Epic?
+        let expiry: IG.Market.Expiry?
+        let direction: IG.Deal.Direction?
+        let orderType: String?
+        let type: IG.Deal.WorkingOrder?
+        let size: Decimal64?
+        let level: Decimal64?
+        let limitLevel: Decimal64?
+        let limitDistance: Decimal64?
+        let stopLevel: Decimal64?
+        let stopDistance: Decimal64?
+        let guaranteedStop: Bool?
+        let trailingStop: Bool?
+        let trailingStopDistance: Decimal64?
+        let trailingStopIncrement: Decimal64?
+        let forceOpen: Bool?
+        let expiration: Date?
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: _Keys.self)
+            self.dealId = try container.decodeIfPresent(IG.Deal.Identifier.self, forKey: .dealId)
+            self.dealReference = try container.decodeIfPresent(IG.Deal.Reference.self, forKey: .dealReference)
+            self.epic = try container.decodeIfPresent(IG.Market.Epic.self, forKey: .epic)
+            self.expiry = try container.decodeIfPresent(IG.Market.Expiry.self, forKey: .expiry)
+            self.direction = try container.decodeIfPresent(IG.Deal.Direction.self, forKey: .direction)
+            self.orderType = try container.decodeIfPresent(String.self, forKey: .orderType)
+            self.type = try container.decodeIfPresent(IG.Deal.WorkingOrder.self, forKey: .type)
+            self.size = try container.decodeIfPresent(Decimal64.self, forKey: .size)
+            self.level = try container.decodeIfPresent(Decimal64.self, forKey: .level)
+            self.limitLevel = try container.decodeIfPresent(Decimal64.self, forKey: .limitLevel)
+            self.limitDistance = try container.decodeIfPresent(Decimal64.self, forKey: .limitDistance)
+            self.stopLevel = try container.decodeIfPresent(Decimal64.self, forKey: .stopLevel)
+            self.stopDistance = try container.decodeIfPresent(Decimal64.self, forKey: .stopDistance)
+            self.guaranteedStop = try container.decodeIfPresent(Bool.self, forKey: .guaranteedStop)
+            self.trailingStop = try container.decodeIfPresent(Bool.self, forKey: .trailingStop)
+            self.trailingStopDistance = try container.decodeIfPresent(Decimal64.self, forKey: .trailingStopDistance)
+            self.trailingStopIncrement = try container.decodeIfPresent(Decimal64.self, forKey: .trailingStopIncrement)
+            self.forceOpen = try container.decodeIfPresent(Bool.self, forKey: .forceOpen)
+            self.expiration = try container.decodeIfPresent(Date.self, forKey: .goodTillDate, with: DateFormatter.humanReadable)
+        }
+
+        private enum _Keys: String, CodingKey {
+            case dealId, dealReference
+            case epic, expiry, direction
+            case orderType, type, size, level
+            case limitLevel, limitDistance
+            case stopLevel, stopDistance, guaranteedStop
+            case trailingStop, trailingStopDistance, trailingStopIncrement
+            case forceOpen, goodTillDate
+        }
+    }
+
+    /// The deal confirmation as returned by the `confirms` endpoint.
+    struct _Confirmation: Encodable {
+        let date: Date
+        let dealId: IG.Deal.Identifier
+        let dealReference: IG.Deal.Reference
+        /// The rejection reason (or `nil` if the deal has been accepted).
+        let reason: String?
+        var affectedDeals: [_AffectedDeal] = []
+        var status: String? = nil
+        let epic: IG.Market.Epic
+        var expiry: IG.Market.Expiry? = nil
+        let direction: IG.Deal.Direction
+        var size: Decimal64? = nil
+        var level: Decimal64? = nil
+        var limitLevel: Decimal64? = nil
+        var stopLevel: Decimal64? = nil
+        var guaranteedStop: Bool = false
+        var trailingStop: Bool = false
+        var profit: Decimal64? = nil
+        var profitCurrency: Currency.Code? = nil
+
+        struct _AffectedDeal: Encodable {
+            let dealId: IG.Deal.Identifier
+            let status: String
+        }
+
+        func encode(to encoder: Encoder) throws {
+            var container = encoder.container(keyedBy: _Keys.self)
+            try container.encode(self.date, forKey: .date, with: DateFormatter.iso8601)
+            try container.encode(self.dealId, forKey: .dealId)
+            try container.encode(self.dealReference, forKey: .dealReference)
+            try container.encode((self.reason == nil) ? "ACCEPTED" : "REJECTED", forKey: .dealStatus)
+            try container.encode(self.reason ?? "SUCCESS", forKey: .reason)
+            try container.encode(self.affectedDeals, forKey: .affectedDeals)
+            try container.encodeIfPresent(self.status, forKey: .status)
+            try container.encode(self.epic, forKey: .epic)
+            try container.encodeIfPresent(self.expiry, forKey: .expiry)
+            try container.encode(self.direction, forKey: .direction)
+            try container.encodeIfPresent(self.size, forKey: .size)
+            try container.encodeIfPresent(self.level, forKey: .level)
+            try container.encodeIfPresent(self.limitLevel, forKey: .limitLevel)
+            try container.encodeIfPresent(self.stopLevel, forKey: .stopLevel)
+            try container.encode(self.guaranteedStop, forKey: .guaranteedStop)
+            try container.encode(self.trailingStop, forKey: .trailingStop)
+            if let profit = self.profit, let currency = self.profitCurrency {
+                try container.encode(profit, forKey: .profit)
+                try container.encode(currency, forKey: .profitCurrency)
+            }
+        }
+
+        private enum _Keys: String, CodingKey {
+            case date, dealId, dealReference, dealStatus, reason, affectedDeals
+            case status, epic, expiry, direction, size, level
+            case limitLevel, stopLevel, guaranteedStop, trailingStop
+            case profit, profitCurrency
+        }
+    }
+
+    /// The OAuth login response.
+    struct _OAuth: Encodable {
+        let clientId: String
+        let accountId: IG.Account.Identifier
+        let timezoneOffset: Int
+        let lightstreamerEndpoint: URL
+        let oauthToken: _Token
+
+        struct _Token: Encodable {
+            let access_token: String
+            let refresh_token: String
+            let scope: String
+            let token_type: String
+            let expires_in: String
+        }
+    }
+
+    /// The session details response.
+    struct _Session: Encodable {
+        let clientId: String
+        let accountId: IG.Account.Identifier
+        let timezoneOffset: Int
+        let lightstreamerEndpoint: URL
+        let locale: String
+        let currency: Currency.Code
+    }
+}
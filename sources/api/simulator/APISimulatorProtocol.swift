@@ -0,0 +1,103 @@
+import Combine
+import Foundation
+
+extension API.Simulator {
+    /// URL protocol routing the requests targeting a simulator's root URL to the simulator instance.
+    internal final class _URLProtocol: URLProtocol {
+        /// The scheduled response delivery (if any).
+        private var _delivery: AnyCancellable?
+
+        override class func canInit(with request: URLRequest) -> Bool {
+            guard let host = request.url?.host else { return false }
+            return host.hasSuffix(API.Simulator._hostSuffix)
+        }
+
+        override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+            request
+        }
+
+        override func startLoading() {
+            guard let url = self.request.url, let simulator = API.Simulator._simulator(host: url.host) else {
+                return self.client!.urlProtocol(self, didFailWithError: URLError(.cannotConnectToHost))
+            }
+
+            let body = Self._body(of: self.request)
+            let (statusCode, data) = simulator.respond(to: self.request, body: body)
+            var headers = ["Date": DateFormatter.humanReadableLong.string(from: simulator.clock.now)]
+            if data != nil { headers["Content-Type"] = "application/json; charset=UTF-8" }
+
+            let date = simulator.clock.now.addingTimeInterval(simulator.latency)
+            self._delivery = simulator.clock.schedule(at: date, on: simulator.queue) { [self] in
+                let response = HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: headers)!
+                self.client!.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+                if let data = data { self.client!.urlProtocol(self, didLoad: data) }
+                self.client!.urlProtocolDidFinishLoading(self)
+            }
+        }
+
+        override func stopLoading() {
+            self._delivery?.cancel()
+            self._delivery = nil
+        }
+
+        /// Returns the body of the given request.
+        ///
+        /// `URLSession` moves the HTTP body into a stream before handing the request to the URL protocol; therefore, both storages are checked.
+        private static func _body(of request: URLRequest) -> Data? {
+            if let body = request.httpBody { return body }
+            guard let stream = request.httpBodyStream else { return nil }
+
+            stream.open()
+            defer { stream.close() }
+
+            var result = Data()
+            var buffer = [UInt8](repeating: 0, count: 4_096)
+            while stream.hasBytesAvailable {
+                let count = stream.read(&buffer, maxLength: buffer.count)
+                guard count > 0 else { break }
+                result.append(buffer, count: count)
+            }
+            return result
+        }
+    }
+}
+
+extension API.Simulator {
+    /// The lock restricting access to the simulator registry.
+    private static let _registryLock = UnfairLock()
+    /// The live simulators indexed by their root URL host (weakly referenced).
+    private static var _registry: [String:_WeakSimulator] = [:]
+
+    /// Makes the given simulator reachable by the URL protocol.
+    internal static func _register(_ simulator: API.Simulator) {
+        guard let host = simulator.rootURL.host else { return }
+        self._registryLock.lock()
+        self._registry[host] = _WeakSimulator(simulator)
+        self._registryLock.unlock()
+    }
+
+    /// Removes the given simulator from the registry.
+    internal static func _unregister(_ simulator: API.Simulator) {
+        guard let host = simulator.rootURL.host else { return }
+        self._registryLock.lock()
+        self._registry.removeValue(forKey: host)
+        self._registryLock.unlock()
+    }
+
+    /// Returns the simulator identified by the given host (if any).
+    fileprivate static func _simulator(host: String?) -> API.Simulator? {
+        guard let host = host else { return nil }
+        self._registryLock.lock()
+        defer { self._registryLock.unlock() }
+        return self._registry[host]?.value
+    }
+
+    /// Weak reference wrapper for the simulator registry.
+    private struct _WeakSimulator {
+        weak var value: API.Simulator?
+
+        init(_ value: API.Simulator) {
+            self.value = value
+        }
+    }
+}
@@ -60,27 +60,8 @@ internal extension Publisher {
                         body    bodyGenerator:  ((_ values: T) throws -> (contentType: API.HTTP.Header.Value.ContentType, data: Data))? = nil
                        ) -> Publishers.TryMap<Self,API.Transit.Request<T>> where Output==API.Transit.Instance<T> {
         self.tryMap { (api, values) in
-            var request = URLRequest(url: api.rootURL.appendingPathComponent(relativeURL))
-            request.httpMethod = method.description
-            
-            do {
-                if let queries = try queryGenerator?(values) {
-                    try request.addQueries(queries)
-                }
-
-                let credentials = (!usingCredentials) ? nil : try api.channel.credentials ?> IG.Error._unfoundCredentials(request: request)
-                request.addHeaders(version: version, credentials: credentials, try headGenerator?(values))
-
-                if let body = try bodyGenerator?(values) {
-                    request.addValue(body.contentType.description, forHTTPHeaderField: API.HTTP.Header.Key.requestType.rawValue)
-                    request.httpBody = body.data
-                }
-            } catch let error as IG.Error {
-                throw error
-            } catch let underlyingError {
-                throw IG.Error._unableToFormRequest(request: request, error: underlyingError)
-            }
-
+            let request = try API._makeRequest(api: api, values: values, method, relativeURL, version: version, credentials: usingCredentials,
+                                               queries: queryGenerator, headers: headGenerator, body: bodyGenerator)
             return (api, request, values)
         }
     }
@@ -100,15 +81,7 @@ internal extension Publisher {
                 .dataTaskPublisher(for: request)
                 .mapError { IG.Error._unknownInternal(error: $0, request: request) }
                 .tryMap { (data, response) in
-                    guard let httpResponse = response as? HTTPURLResponse else {
-                        throw IG.Error._invalidURL(response: response, request: request, data: data)
-                    }
-                    
-                    if let expectedCodes = statusCodes, !expectedCodes.contains(httpResponse.statusCode) {
-                        throw IG.Error._invalidResponse(code: httpResponse.statusCode, expected: expectedCodes, request: request, response: httpResponse, data: data)
-                    }
-                    
-                    return (request, httpResponse, data, values)
+                    (request, try API._validate(request: request, response: response, data: data, statusCodes: statusCodes), data, values)
                 }
         }
     }
@@ -228,17 +201,7 @@ internal extension Publisher {
     /// - parameter decoder: Enum indicating how the `JSONDecoder` is created/obtained.
     /// - returns: Each value event triggers a JSON decoding process. This publisher forwards the response of that process.
     func decodeJSON<T,R>(decoder: API.JSON.Decoder<T>, result: R.Type = R.self) -> Publishers.TryMap<Self,R> where Self.Output==API.Transit.Call<T>, R: Decodable {
-        self.tryMap { (request, response, data, values) -> R in
-            var stage: Int = 0
-            do {
-                let jsonDecoder = try decoder.makeDecoder(request: request, response: response, values: values); stage += 1
-                return try jsonDecoder.decode(R.self, from: data)
-            } catch let error as IG.Error {
-                throw error
-            } catch let error {
-                throw IG.Error._unableToDecode(stage: stage, request: request, response: response, data: data, error: error)
-            }
-        }
+        self.tryMap { try API._decodeJSON($0, decoder: decoder) { (payload: R, _) in payload } }
     }
     
     /// Decodes the JSON payload with a given `JSONDecoder` and then performs a transformation to the result.
@@ -246,17 +209,239 @@ internal extension Publisher {
     /// - parameter transform: Transformation to be applied to the result of the JSON decoding.
     /// - returns: Each value event triggers a JSON decoding process. This publisher forwards the response of that process after being transformed by the closure.
     func decodeJSON<T,R,W>(decoder: API.JSON.Decoder<T>, transform: @escaping (_ decoded: R, _ call: (request: URLRequest, response: HTTPURLResponse)) throws -> W) -> Publishers.TryMap<Self,W> where Self.Output==API.Transit.Call<T>, R:Decodable {
-        self.tryMap { (request, response, data, values) -> W in
-            var stage: Int = 0
+        self.tryMap { try API._decodeJSON($0, decoder: decoder, transform: transform) }
+    }
+}
+
+// MARK: - Endpoint Description
+
+internal extension API {
+    /// Values computed before an endpoint call along with the API instance performing it.
+    ///
+    /// It is the first stage of a reusable `API.Endpoint`.
+    struct Precomputed<T> {
+        /// The API instance performing the call (or `nil` if it has been deallocated).
+        private(set) weak var api: API?
+        /// Closure generating the values to be passed to the following stages.
+        let generator: (_ api: API) throws -> T
+        
+        /// Designated initializer.
+        /// - parameter api: The API instance performing the call.
+        /// - parameter generator: Closure generating the values to be passed to the following stages.
+        fileprivate init(api: API, generator: @escaping (_ api: API) throws -> T) {
+            self.api = api
+            self.generator = generator
+        }
+        
+        /// Returns the API instance and the precomputed values.
+        /// - throws: `IG.Error` exclusively if the API instance has been deallocated or the values cannot be generated.
+        func instance() throws -> API.Transit.Instance<T> {
+            guard let api = self.api else { throw IG.Error._deallocatedAPI() }
             do {
-                let jsonDecoder = try decoder.makeDecoder(request: request, response: response, values: values); stage += 1
-                let payload = try jsonDecoder.decode(R.self, from: data); stage += 1
-                return try transform(payload, (request, response))
+                return (api, try self.generator(api))
             } catch let error as IG.Error {
                 throw error
-            } catch let error {
-                throw IG.Error._unableToDecode(stage: stage, request: request, response: response, data: data, error: error)
+            } catch let underlyingError {
+                throw IG.Error._invalidPrecomputedValues(error: underlyingError)
+            }
+        }
+    }
+    
+    /// Precomputed values along with the way to form the URL request of an endpoint call.
+    ///
+    /// It is the second stage of a reusable `API.Endpoint`.
+    struct Prepared<T> {
+        /// The values computed before forming the request.
+        let values: Precomputed<T>
+        /// Closure forming the URL request.
+        let request: (_ api: API, _ values: T) throws -> URLRequest
+        
+        /// Publisher sending downstream the API instance, the formed URL request, and the precomputed values.
+        var publisher: DeferredResult<API.Transit.Request<T>,Swift.Error> {
+            let (values, request) = (self.values, self.request)
+            return DeferredResult {
+                Result {
+                    let (api, values) = try values.instance()
+                    return (api, try request(api, values), values)
+                }
+            }
+        }
+    }
+    
+    /// Description of a single endpoint call, which can be executed as a Combine publisher or as an `async` call.
+    struct Endpoint<T,R> {
+        /// The precomputed values and the request formation.
+        let prepared: Prepared<T>
+        /// Closure checking the received response and turning it into an HTTP response.
+        let validate: (_ request: URLRequest, _ response: URLResponse, _ data: Data) throws -> HTTPURLResponse
+        /// Closure transforming the validated response into the endpoint result.
+        let decode: (_ call: API.Transit.Call<T>) throws -> R
+        
+        /// Publisher performing the endpoint call once it is subscribed to.
+        var publisher: AnyPublisher<R,IG.Error> {
+            self.calls(self.prepared.publisher)
+        }
+        
+        /// Performs a call for each URL request forwarded by the upstream publisher and forwards the decoded results.
+        /// - parameter upstream: Publisher forwarding the API instance, the URL request to perform, and the precomputed values.
+        func calls<P>(_ upstream: P) -> AnyPublisher<R,IG.Error> where P:Publisher, P.Output==API.Transit.Request<T>, P.Failure==Swift.Error {
+            let (validate, decode) = (self.validate, self.decode)
+            return upstream.flatMap { (api, request, values) in
+                    api.channel.session
+                        .dataTaskPublisher(for: request)
+                        .mapError { IG.Error._unknownInternal(error: $0, request: request) }
+                        .tryMap { (data, response) in try decode((request, try validate(request, response, data), data, values)) }
+                }.mapError(errorCast)
+                .eraseToAnyPublisher()
+        }
+        
+        /// Transforms the endpoint result.
+        /// - parameter transform: Transformation to be applied to the endpoint result.
+        func map<W>(_ transform: @escaping (_ result: R) throws -> W) -> API.Endpoint<T,W> {
+            let decode = self.decode
+            return .init(prepared: self.prepared, validate: self.validate) { try transform(try decode($0)) }
+        }
+    }
+    
+    /// Starts the description of an endpoint call that doesn't need precomputed values.
+    var endpoint: API.Precomputed<Void> {
+        .init(api: self) { _ in () }
+    }
+    
+    /// Starts the description of an endpoint call by indicating the values to compute before forming the request.
+    /// - parameter valuesGenerator: Closure generating the values to be passed to the following stages.
+    /// - returns: The first stage of an endpoint call.
+    func endpoint<T>(_ valuesGenerator: @escaping (_ api: API) throws -> T) -> API.Precomputed<T> {
+        .init(api: self, generator: valuesGenerator)
+    }
+}
+
+internal extension API.Precomputed {
+    /// Describes the URL request of the endpoint call.
+    ///
+    /// The arguments are the same as the ones for `Publisher.makeRequest(_:_:version:credentials:queries:headers:body:)`.
+    func makeRequest(_ method: API.HTTP.Method, _ relativeURL: String, version: Int, credentials usingCredentials: Bool,
+                     queries queryGenerator: ((_ values: T) throws -> [URLQueryItem])? = nil,
+                     headers headGenerator:  ((_ values: T) throws -> [API.HTTP.Header.Key:String])? = nil,
+                     body    bodyGenerator:  ((_ values: T) throws -> (contentType: API.HTTP.Header.Value.ContentType, data: Data))? = nil
+                    ) -> API.Prepared<T> {
+        .init(values: self) { (api, values) in
+            try API._makeRequest(api: api, values: values, method, relativeURL, version: version, credentials: usingCredentials,
+                                 queries: queryGenerator, headers: headGenerator, body: bodyGenerator)
+        }
+    }
+}
+
+internal extension API.Prepared {
+    /// Describes the response expected from the endpoint call.
+    /// - parameter type: The HTTP content type expected as a result.
+    /// - parameter codes: List of HTTP status codes expected (i.e. the endpoint call is considered successful).
+    /// - returns: Endpoint call forwarding the performed request, the received response and payload, and the precomputed values.
+    func send(expecting type: API.HTTP.Header.Value.ContentType? = nil, statusCode codes: Int...) -> API.Endpoint<T,API.Transit.Call<T>> {
+        .init(prepared: self, validate: { (request, response, data) in
+            try API._validate(request: request, response: response, data: data, statusCodes: codes)
+        }, decode: { $0 })
+    }
+}
+
+internal extension API.Endpoint {
+    /// Decodes the JSON payload with a given `JSONDecoder`.
+    /// - parameter decoder: Enum indicating how the `JSONDecoder` is created/obtained.
+    /// - returns: Endpoint call forwarding the decoded payload.
+    func decodeJSON<D>(decoder: API.JSON.Decoder<T>, result: D.Type = D.self) -> API.Endpoint<T,D> where R==API.Transit.Call<T>, D:Decodable {
+        .init(prepared: self.prepared, validate: self.validate) { try API._decodeJSON($0, decoder: decoder) { (payload: D, _) in payload } }
+    }
+    
+    /// Decodes the JSON payload with a given `JSONDecoder` and then performs a transformation to the result.
+    /// - parameter decoder: Enum indicating how the `JSONDecoder` is created/obtained.
+    /// - parameter transform: Transformation to be applied to the result of the JSON decoding.
+    /// - returns: Endpoint call forwarding the decoded payload after being transformed by the closure.
+    func decodeJSON<D,W>(decoder: API.JSON.Decoder<T>, transform: @escaping (_ decoded: D, _ call: (request: URLRequest, response: HTTPURLResponse)) throws -> W) -> API.Endpoint<T,W> where R==API.Transit.Call<T>, D:Decodable {
+        .init(prepared: self.prepared, validate: self.validate) { try API._decodeJSON($0, decoder: decoder, transform: transform) }
+    }
+}
+
+internal extension API {
+    /// Definition of a paginated endpoint, shared by the Combine and `async` surfaces.
+    struct Pages<T,M,R> {
+        /// The endpoint call performing the initial request and decoding the metadata and result of each page.
+        let endpoint: API.Endpoint<T,(M,R)>
+        /// Closure generating the request for the following page. If `nil` is returned, there are no more pages.
+        let next: (_ api: API, _ initial: (request: URLRequest, values: T), _ previous: API.Transit.PreviousPage<M>?) throws -> URLRequest?
+        
+        /// Publisher forwarding the result of each page as soon as it arrives.
+        var publisher: AnyPublisher<R,IG.Error> {
+            let endpoint = self.endpoint
+            return endpoint.prepared.publisher
+                .sendPaginating(request: self.next) { (pageRequest, _) in endpoint.calls(pageRequest) }
+                .mapError(errorCast)
+                .eraseToAnyPublisher()
+        }
+    }
+}
+
+// MARK: - Endpoint Steps
+
+internal extension API {
+    /// Forms the URL request of an endpoint call.
+    ///
+    /// The arguments are the same as the ones for `Publisher.makeRequest(_:_:version:credentials:queries:headers:body:)`.
+    static func _makeRequest<T>(api: API, values: T, _ method: API.HTTP.Method, _ relativeURL: String, version: Int, credentials usingCredentials: Bool,
+                                queries queryGenerator: ((_ values: T) throws -> [URLQueryItem])?,
+                                headers headGenerator:  ((_ values: T) throws -> [API.HTTP.Header.Key:String])?,
+                                body    bodyGenerator:  ((_ values: T) throws -> (contentType: API.HTTP.Header.Value.ContentType, data: Data))?) throws -> URLRequest {
+        var request = URLRequest(url: api.rootURL.appendingPathComponent(relativeURL))
+        request.httpMethod = method.description
+        
+        do {
+            if let queries = try queryGenerator?(values) {
+                try request.addQueries(queries)
+            }
+
+            let credentials = (!usingCredentials) ? nil : try api.channel.credentials ?> IG.Error._unfoundCredentials(request: request)
+            request.addHeaders(version: version, credentials: credentials, try headGenerator?(values))
+
+            if let body = try bodyGenerator?(values) {
+                request.addValue(body.contentType.description, forHTTPHeaderField: API.HTTP.Header.Key.requestType.rawValue)
+                request.httpBody = body.data
             }
+        } catch let error as IG.Error {
+            throw error
+        } catch let underlyingError {
+            throw IG.Error._unableToFormRequest(request: request, error: underlyingError)
+        }
+        
+        return request
+    }
+    
+    /// Checks that the received response is an `HTTPURLResponse` with one of the expected status codes (if any has been indicated).
+    /// - parameter statusCodes: If not `nil`, the sequence indicates all *viable*/supported status codes.
+    static func _validate<S>(request: URLRequest, response: URLResponse, data: Data, statusCodes: S?) throws -> HTTPURLResponse where S:Sequence, S.Element==Int {
+        guard let httpResponse = response as? HTTPURLResponse else {
+            throw IG.Error._invalidURL(response: response, request: request, data: data)
+        }
+        
+        if let expectedCodes = statusCodes, !expectedCodes.contains(httpResponse.statusCode) {
+            throw IG.Error._invalidResponse(code: httpResponse.statusCode, expected: expectedCodes, request: request, response: httpResponse, data: data)
+        }
+        
+        return httpResponse
+    }
+    
+    /// Decodes the JSON payload of an endpoint call and then performs a transformation to the result.
+    /// - parameter call: The performed request, the received response and payload, and the precomputed values.
+    /// - parameter decoder: Enum indicating how the `JSONDecoder` is created/obtained.
+    /// - parameter transform: Transformation to be applied to the result of the JSON decoding.
+    static func _decodeJSON<T,R,W>(_ call: API.Transit.Call<T>, decoder: API.JSON.Decoder<T>, transform: (_ decoded: R, _ call: (request: URLRequest, response: HTTPURLResponse)) throws -> W) throws -> W where R:Decodable {
+        var stage: Int = 0
+        do {
+            let jsonDecoder = try decoder.makeDecoder(request: call.request, response: call.response, values: call.values); stage += 1
+            let payload = try jsonDecoder.decode(R.self, from: call.data); stage += 1
+            return try transform(payload, (call.request, call.response))
+        } catch let error as IG.Error {
+            throw error
+        } catch let error {
+            throw IG.Error._unableToDecode(stage: stage, request: call.request, response: call.response, data: call.data, error: error)
         }
     }
 }
@@ -0,0 +1,169 @@
+#if compiler(>=5.7) && canImport(_Concurrency)
+import Foundation
+
+internal extension API.Endpoint {
+    /// Performs the endpoint call and suspends the current task till the response is received and decoded.
+    ///
+    /// No publisher is involved: the URL request is formed, sent through a URL session data task, and its response validated and decoded in place.
+    ///
+    /// Cancelling the surrounding task cancels the underlying URL session task.
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The decoded endpoint result.
+    func value() async throws -> R {
+        let (api, values) = try self.prepared.values.instance()
+        let request = try self.prepared.request(api, values)
+        return try await self.call(api: api, request: request, values: values)
+    }
+    
+    /// Performs the given URL request and suspends the current task till the response is received and decoded.
+    /// - parameter api: The API instance performing the call.
+    /// - parameter request: The URL request to perform.
+    /// - parameter values: The precomputed values.
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The decoded endpoint result.
+    func call(api: API, request: URLRequest, values: T) async throws -> R {
+        try Task.checkCancellation()
+        let (data, response) = try await _DataTask.run(request, on: api.channel.session)
+        let httpResponse = try self.validate(request, response, data)
+        return try self.decode((request, httpResponse, data, values))
+    }
+}
+
+internal extension API.Pages {
+    /// Asynchronous sequence fetching each page when it is requested.
+    ///
+    /// Pages are pulled: the following page request is only sent once the consumer asks for the next element; thus, slow consumers never accumulate pages in memory. Cancelling the consuming task cancels the ongoing page request.
+    var stream: AsyncThrowingStream<R,Swift.Error> {
+        let (endpoint, next) = (self.endpoint, self.next)
+        /// The API instance, initial request, and precomputed values (once they are retrieved).
+        var start: (api: () -> API?, request: URLRequest, values: T)? = nil
+        /// The last successful page request and its metadata.
+        var previous: API.Transit.PreviousPage<M>? = nil
+        /// Boolean indicating whether the last page has been retrieved.
+        var isFinished = false
+
+        return AsyncThrowingStream(unfolding: {
+            guard !isFinished else { return nil }
+            do {
+                if start == nil {
+                    let (api, values) = try endpoint.prepared.values.instance()
+                    let request = try endpoint.prepared.request(api, values)
+                    start = ({ [weak api] in api }, request, values)
+                }
+
+                let (initialRequest, values) = (start!.request, start!.values)
+                guard let api = start!.api() else { throw IG.Error._deallocatedAPI() }
+
+                let pageRequest: URLRequest
+                do {
+                    guard let request = try next(api, (initialRequest, values), previous) else {
+                        isFinished = true
+                        return nil
+                    }
+                    pageRequest = request
+                } catch let error as IG.Error {
+                    throw error
+                } catch let error {
+                    throw IG.Error._invalidPaginated(request: initialRequest, error: error)
+                }
+
+                let (metadata, result) = try await endpoint.call(api: api, request: pageRequest, values: values)
+                previous = (pageRequest, metadata)
+                return result
+            } catch let error as IG.Error {
+                isFinished = true
+                if let previous = previous {
+                    error.errorUserInfo["Last successful page request"] = previous.request
+                    error.errorUserInfo["Last successful page metadata"] = previous.metadata
+                }
+                throw error
+            } catch let error {
+                isFinished = true
+                throw error
+            }
+        })
+    }
+}
+
+// MARK: -
+
+/// URL session data task resuming a continuation once the response is received.
+private final class _DataTask {
+    /// The lock restricting access to the task state.
+    private let _lock: UnfairLock
+    /// The underlying URL session task (or `nil` if it hasn't been created yet).
+    private var _task: URLSessionDataTask?
+    /// Boolean indicating whether the surrounding task has been cancelled.
+    private var _isCancelled: Bool
+
+    /// Performs the given request and suspends the current task till the response is received.
+    /// - parameter request: The URL request to perform.
+    /// - parameter session: The URL session performing the request.
+    static func run(_ request: URLRequest, on session: URLSession) async throws -> (Data, URLResponse) {
+        let dataTask = _DataTask()
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<(Data,URLResponse),Swift.Error>) in
+                let task = session.dataTask(with: request) { (data, response, error) in
+                    if let response = response, error == nil {
+                        continuation.resume(returning: (data ?? Data(), response))
+                    } else if dataTask.isCancelled {
+                        continuation.resume(throwing: CancellationError())
+                    } else {
+                        continuation.resume(throwing: IG.Error._unknownInternal(error: error ?? URLError(.badServerResponse), request: request))
+                    }
+                }
+                dataTask._start(task)
+            }
+        } onCancel: {
+            dataTask._cancel()
+        }
+    }
+
+    private init() {
+        self._lock = UnfairLock()
+        self._isCancelled = false
+    }
+
+    deinit {
+        self._lock.invalidate()
+    }
+
+    /// Boolean indicating whether the surrounding task has been cancelled.
+    private var isCancelled: Bool {
+        self._lock.execute { self._isCancelled }
+    }
+
+    /// Resumes the given URL session task (or cancels it straight away if the surrounding task has already been cancelled).
+    private func _start(_ task: URLSessionDataTask) {
+        let isCancelled: Bool = self._lock.execute {
+            self._task = task
+            return self._isCancelled
+        }
+        (isCancelled) ? task.cancel() : task.resume()
+    }
+
+    /// Cancels the underlying URL session task (if it has been started).
+    private func _cancel() {
+        let task: URLSessionDataTask? = self._lock.execute {
+            self._isCancelled = true
+            return self._task
+        }
+        task?.cancel()
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when the API instance is deallocated.
+    static func _deallocatedAPI() -> Self {
+        Self(.api(.sessionExpired), "The API instance has been deallocated.", help: "The API functionality is asynchronous. Keep around the API instance while the request/response is being processed.")
+    }
+    /// Error raised when an internal URL session error happened.
+    static func _unknownInternal(error: Swift.Error, request: URLRequest) -> Self {
+        Self(.api(.callFailed), "An internal session error occurred while calling the HTTP endpoint.", help: "Review the underlying error and try to fix the problem.", underlying: error, info: ["Request": request])
+    }
+    /// Error raised when the paginated request cannot be created.
+    static func _invalidPaginated(request: URLRequest, error: Swift.Error) -> Self {
+        Self(.api(.invalidRequest), "The paginated request couldn't be created.", underlying: error, info: ["Request": request])
+    }
+}
+#endif
@@ -0,0 +1,435 @@
+import Combine
+import Foundation
+
+internal extension API {
+    /// URL session delivering the response payloads incrementally (as the bytes arrive) instead of buffering the whole body.
+    ///
+    /// It shares the configuration of the API's main session (including any registered URL protocols), but it has its own serial delegate queue so the callbacks of a given task are received in order.
+    final class StreamingSession: NSObject, URLSessionDataDelegate {
+        /// The underlying session (it strongly retains the receiving instance till it is invalidated).
+        private var _session: URLSession!
+        /// The lock restricting access to the handlers.
+        private let _lock: UnfairLock
+        /// The handlers for the ongoing tasks (identified by their task identifier).
+        private var _handlers: [Int:Handler]
+
+        /// Designated initializer.
+        /// - parameter configuration: The configuration of the underlying session.
+        /// - parameter queue: The queue where the session callbacks will be executed.
+        init(configuration: URLSessionConfiguration, queue: DispatchQueue) {
+            self._lock = UnfairLock()
+            self._handlers = .init()
+            super.init()
+            let delegateQueue = OperationQueue(underlying: queue, maxConcurrentOperationCount: 1)
+            self._session = URLSession(configuration: configuration, delegate: self, delegateQueue: delegateQueue)
+        }
+
+        deinit {
+            self._lock.invalidate()
+        }
+
+        /// Cancels all ongoing tasks and breaks the retain cycle between the session and the receiving instance.
+        func invalidate() {
+            self._session.invalidateAndCancel()
+        }
+
+        /// Starts the given request.
+        /// - parameter request: The URL request to perform.
+        /// - parameter handler: The closures receiving the task's events.
+        /// - returns: The started task (which can be cancelled at any time).
+        func start(_ request: URLRequest, handler: Handler) -> URLSessionDataTask {
+            let task = self._session.dataTask(with: request)
+            self._lock.execute { self._handlers[task.taskIdentifier] = handler }
+            task.resume()
+            return task
+        }
+
+        func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive response: URLResponse, completionHandler: @escaping (URLSession.ResponseDisposition) -> Void) {
+            let handler = self._lock.execute { self._handlers[dataTask.taskIdentifier] }
+            handler?.response(response)
+            completionHandler((handler != nil) ? .allow : .cancel)
+        }
+
+        func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
+            self._lock.execute { self._handlers[dataTask.taskIdentifier] }?.data(data)
+        }
+
+        func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Swift.Error?) {
+            self._lock.execute { self._handlers.removeValue(forKey: task.taskIdentifier) }?.completion(error)
+        }
+    }
+}
+
+extension API.StreamingSession {
+    /// The closures receiving the events of a streaming task.
+    struct Handler {
+        /// The response header has been received.
+        let response: (URLResponse) -> Void
+        /// A new segment of the response body has been received.
+        let data: (Data) -> Void
+        /// The task has finished (successfully if the error is `nil`).
+        let completion: (Swift.Error?) -> Void
+    }
+}
+
+internal extension Publisher {
+    /// Performs the request specified as upstream value and decodes the elements of a JSON array (found under the given key of the response root object) as the response bytes arrive.
+    ///
+    /// Elements are forwarded in chunks as soon as `chunkSize` elements have been decoded; thus, the full response is never held in memory (neither as raw bytes nor as decoded values).
+    /// - parameter statusCode: The HTTP status code expected.
+    /// - parameter key: The key of the response root object under which the array of elements is found.
+    /// - parameter decoder: Enum indicating how the `JSONDecoder` is created/obtained.
+    /// - parameter chunkSize: The maximum number of elements forwarded per value.
+    /// - returns: Publisher forwarding arrays of decoded elements (in the same order as they are found in the response).
+    func sendStreaming<T,E>(statusCode: Int, array key: String, decoder: API.JSON.Decoder<T>, chunkSize: Int) -> AnyPublisher<[E],IG.Error> where Self.Output==API.Transit.Request<T>, Self.Failure==Swift.Error, E:Decodable {
+        self.mapError(errorCast)
+            .flatMap(maxPublishers: .max(1)) { (api, request, values) -> AnyPublisher<[E],IG.Error> in
+                let streaming = api.channel.streaming
+                let task = _StreamingTask<T,E>(request: request, values: values, statusCode: statusCode, key: key, decoder: decoder, chunkSize: Swift.max(1, chunkSize))
+                return DeferredPassthrough<[E],IG.Error> { (subject) in
+                    task.start(on: streaming, subject: subject)
+                }.handleEvents(receiveCancel: { task.cancel() })
+                .eraseToAnyPublisher()
+            }.eraseToAnyPublisher()
+    }
+}
+
+// MARK: -
+
+/// A single streaming request decoding the array elements as the response bytes arrive.
+private final class _StreamingTask<T,E:Decodable> {
+    /// The request being performed.
+    private let _request: URLRequest
+    /// The precomputed values passed to the JSON decoder factory.
+    private let _values: T
+    /// The HTTP status code expected.
+    private let _statusCode: Int
+    /// The JSON decoder factory.
+    private let _decoderFactory: API.JSON.Decoder<T>
+    /// The maximum number of elements forwarded per value.
+    private let _chunkSize: Int
+    /// The lock restricting access to the task state.
+    private let _lock: UnfairLock
+    /// The incremental parser delimiting the array elements.
+    private var _scanner: _JSONArrayScanner
+    /// The ongoing data task (or `nil` if it hasn't started or it has already finished).
+    private var _task: URLSessionDataTask?
+    /// The subject forwarding decoded chunks downstream.
+    private var _subject: PassthroughSubject<[E],IG.Error>?
+    /// The response header and the decoder created from it (once the header has been received).
+    private var _state: (response: HTTPURLResponse, decoder: JSONDecoder)?
+    /// The response body received when the response is unexpected (kept for error reporting).
+    private var _unexpected: (response: URLResponse, data: Data)?
+    /// The decoded elements not yet forwarded.
+    private var _buffer: [E]
+
+    init(request: URLRequest, values: T, statusCode: Int, key: String, decoder: API.JSON.Decoder<T>, chunkSize: Int) {
+        self._request = request
+        self._values = values
+        self._statusCode = statusCode
+        self._decoderFactory = decoder
+        self._chunkSize = chunkSize
+        self._lock = UnfairLock()
+        self._scanner = _JSONArrayScanner(key: key)
+        self._buffer = []
+        self._buffer.reserveCapacity(chunkSize)
+    }
+
+    deinit {
+        self._lock.invalidate()
+    }
+
+    /// Starts the data task forwarding the decoded elements through the given subject.
+    func start(on session: API.StreamingSession, subject: PassthroughSubject<[E],IG.Error>) {
+        self._lock.execute { self._subject = subject }
+        let handler = API.StreamingSession.Handler(response: { [weak self] in self?._receive(response: $0) },
+                                                   data: { [weak self] in self?._receive(data: $0) },
+                                                   completion: { [weak self] in self?._complete(error: $0) })
+        let task = session.start(self._request, handler: handler)
+        self._lock.execute { self._task = task }
+    }
+
+    /// Cancels the ongoing data task (without forwarding any further event).
+    func cancel() {
+        self._lock.lock()
+        let task = self._task
+        (self._task, self._subject) = (nil, nil)
+        self._lock.unlock()
+        task?.cancel()
+    }
+
+    private func _receive(response: URLResponse) {
+        self._lock.lock()
+        guard let httpResponse = response as? HTTPURLResponse, httpResponse.statusCode == self._statusCode else {
+            self._unexpected = (response, Data())
+            return self._lock.unlock()
+        }
+
+        let failure: IG.Error
+        do {
+            self._state = (httpResponse, try self._decoderFactory.makeDecoder(request: self._request, response: httpResponse, values: self._values))
+            return self._lock.unlock()
+        } catch let error {
+            failure = (error as? IG.Error) ?? IG.Error._unableToDecode(request: self._request, response: httpResponse, error: error)
+        }
+        let (task, subject) = self._detach()
+        self._lock.unlock()
+        Self._fail(failure, task: task, subject: subject)
+    }
+
+    private func _receive(data: Data) {
+        self._lock.lock()
+        if self._unexpected != nil {
+            self._unexpected!.data.append(data)
+            return self._lock.unlock()
+        }
+
+        guard let (response, decoder) = self._state, let subject = self._subject else { return self._lock.unlock() }
+
+        var chunks: [[E]] = []
+        do {
+            for element in try self._scanner.feed(data) {
+                self._buffer.append(try decoder.decode(E.self, from: element))
+                guard self._buffer.count >= self._chunkSize else { continue }
+                chunks.append(self._buffer)
+                self._buffer.removeAll(keepingCapacity: true)
+            }
+        } catch let error {
+            let failure = (error as? IG.Error) ?? IG.Error._unableToDecode(request: self._request, response: response, error: error)
+            let (task, subject) = self._detach()
+            self._lock.unlock()
+            return Self._fail(failure, task: task, subject: subject)
+        }
+        self._lock.unlock()
+
+        for chunk in chunks { subject.send(chunk) }
+    }
+
+    private func _complete(error: Swift.Error?) {
+        self._lock.lock()
+        guard let subject = self._subject else { return self._lock.unlock() }
+        let (remaining, unexpected, state, isFinished) = (self._buffer, self._unexpected, self._state, self._scanner.isFinished)
+        (self._task, self._subject, self._buffer) = (nil, nil, [])
+        self._lock.unlock()
+
+        if let error = error {
+            return subject.send(completion: .failure(IG.Error._unknownInternal(error: error, request: self._request)))
+        }
+
+        if let (response, data) = unexpected {
+            guard let httpResponse = response as? HTTPURLResponse else {
+                return subject.send(completion: .failure(IG.Error._invalidURL(response: response, request: self._request, data: data)))
+            }
+            return subject.send(completion: .failure(IG.Error._invalidResponse(code: httpResponse.statusCode, expected: [self._statusCode], request: self._request, response: httpResponse, data: data)))
+        }
+
+        guard state != nil, isFinished else {
+            return subject.send(completion: .failure(IG.Error._unfoundArray(request: self._request, response: state?.response)))
+        }
+
+        if !remaining.isEmpty { subject.send(remaining) }
+        subject.send(completion: .finished)
+    }
+
+    /// Clears the task state and returns the data task and subject it held, so they can be cancelled/completed once the lock is released.
+    /// - precondition: The lock must be held.
+    private func _detach() -> (task: URLSessionDataTask?, subject: PassthroughSubject<[E],IG.Error>?) {
+        let (task, subject) = (self._task, self._subject)
+        (self._task, self._subject, self._buffer) = (nil, nil, [])
+        return (task, subject)
+    }
+
+    /// Cancels the data task and forwards the given error downstream.
+    /// - precondition: The lock must not be held (downstream subscribers may call back into the task).
+    private static func _fail(_ error: IG.Error, task: URLSessionDataTask?, subject: PassthroughSubject<[E],IG.Error>?) {
+        task?.cancel()
+        subject?.send(completion: .failure(error))
+    }
+}
+
+/// Incremental parser delimiting the elements of a JSON array found under a given key of the root object.
+///
+/// The parser doesn't validate the JSON; it only tracks strings and container nesting, so it can find the element boundaries (whatever the received segments' boundaries are). Each element is decoded independently afterwards.
+internal struct _JSONArrayScanner {
+    /// The targeted key (as UTF8 bytes).
+    private let _key: [UInt8]
+    /// The parsing phase.
+    private var _phase: Phase
+    /// The current container nesting level.
+    private var _depth: Int
+    /// Boolean indicating whether the parser is within a JSON string.
+    private var _isInString: Bool
+    /// Boolean indicating whether the previous character was an escaping backslash (within a string).
+    private var _isEscaped: Bool
+    /// The root object string being parsed (or the last one parsed).
+    private var _token: [UInt8]
+    /// Boolean indicating whether the last parsed root object key matches the targeted key.
+    private var _isKeyMatched: Bool
+    /// The bytes of the array element being parsed.
+    private var _element: [UInt8]
+
+    /// The parsing phases.
+    enum Phase {
+        /// The targeted array hasn't been found yet.
+        case searching
+        /// The parser is within the targeted array.
+        case array
+        /// The targeted array has been fully parsed.
+        case finished
+    }
+
+    init(key: String) {
+        self._key = Array(key.utf8)
+        self._phase = .searching
+        self._depth = 0
+        self._isInString = false
+        self._isEscaped = false
+        self._token = []
+        self._isKeyMatched = false
+        self._element = []
+    }
+
+    /// Boolean indicating whether the targeted array has been fully parsed.
+    var isFinished: Bool {
+        self._phase == .finished
+    }
+
+    /// Parses the given segment of bytes and returns the array elements completed within it.
+    mutating func feed(_ data: Data) throws -> [Data] {
+        var result: [Data] = []
+        for byte in data {
+            switch self._phase {
+            case .searching: self._search(byte)
+            case .array: if let element = try self._parse(byte) { result.append(element) }
+            case .finished: return result
+            }
+        }
+        return result
+    }
+
+    /// Parses a byte while looking for the targeted array.
+    private mutating func _search(_ byte: UInt8) {
+        if self._isInString {
+            if self._isEscaped {
+                self._isEscaped = false
+            } else if byte == .backslash {
+                self._isEscaped = true
+            } else if byte == .quote {
+                self._isInString = false
+                return
+            }
+            if self._depth == 1 { self._token.append(byte) }
+            return
+        }
+
+        switch byte {
+        case .quote:
+            self._isInString = true
+            self._token.removeAll(keepingCapacity: true)
+        case .colon where self._depth == 1:
+            self._isKeyMatched = (self._token == self._key)
+        case .comma where self._depth == 1:
+            self._isKeyMatched = false
+        case .openBracket where self._depth == 1 && self._isKeyMatched:
+            self._depth += 1
+            self._phase = .array
+        case .openBrace, .openBracket:
+            self._depth += 1
+        case .closeBrace, .closeBracket:
+            self._depth -= 1
+        default:
+            break
+        }
+    }
+
+    /// Parses a byte within the targeted array, returning an element if the byte completes it.
+    private mutating func _parse(_ byte: UInt8) throws -> Data? {
+        if self._isInString {
+            self._element.append(byte)
+            if self._isEscaped {
+                self._isEscaped = false
+            } else if byte == .backslash {
+                self._isEscaped = true
+            } else if byte == .quote {
+                self._isInString = false
+            }
+            return nil
+        }
+
+        // The array's own nesting level (i.e. in between elements or within a scalar element).
+        let arrayDepth = 2
+        switch byte {
+        case .quote:
+            self._isInString = true
+            self._element.append(byte)
+        case .openBrace, .openBracket:
+            self._depth += 1
+            self._element.append(byte)
+        case .closeBrace, .closeBracket:
+            guard self._depth > arrayDepth else {
+                // The targeted array is closed.
+                self._depth -= 1
+                self._phase = .finished
+                return self._flush()
+            }
+            self._depth -= 1
+            self._element.append(byte)
+            if self._depth == arrayDepth { return self._flush() }
+        case .comma where self._depth == arrayDepth:
+            return self._flush()
+        case .space, .tab, .newline, .carriageReturn:
+            // Whitespace is insignificant outside strings.
+            break
+        default:
+            self._element.append(byte)
+        }
+        return nil
+    }
+
+    /// Returns the bytes of the element being parsed (if any) and resets the element storage.
+    private mutating func _flush() -> Data? {
+        guard !self._element.isEmpty else { return nil }
+        defer { self._element.removeAll(keepingCapacity: true) }
+        return Data(self._element)
+    }
+}
+
+private extension UInt8 {
+    static let quote = UInt8(ascii: "\"")
+    static let backslash = UInt8(ascii: "\\")
+    static let colon = UInt8(ascii: ":")
+    static let comma = UInt8(ascii: ",")
+    static let openBrace = UInt8(ascii: "{")
+    static let closeBrace = UInt8(ascii: "}")
+    static let openBracket = UInt8(ascii: "[")
+    static let closeBracket = UInt8(ascii: "]")
+    static let space = UInt8(ascii: " ")
+    static let tab = UInt8(ascii: "\t")
+    static let newline = UInt8(ascii: "\n")
+    static let carriageReturn = UInt8(ascii: "\r")
+}
+
+private extension IG.Error {
+    /// Error raised when an internal URL session error happened.
+    static func _unknownInternal(error: Swift.Error, request: URLRequest) -> Self {
+        Self(.api(.callFailed), "An internal session error occurred while calling the HTTP endpoint.", help: "Review the underlying error and try to fix the problem.", underlying: error, info: ["Request": request])
+    }
+    /// Error raised when the response is not of HTTP type.
+    static func _invalidURL(response: URLResponse, request: URLRequest, data: Data) -> Self {
+        Self(.api(.callFailed), "The received URL response was not of 'HTTPURLResponse' type.", help: "A unexpected error was encountered. Please contact the repository maintainer and attach this debug print.", info: ["Request": request, "Response": response, "Data": data])
+    }
+    /// Error raised when the response status code don't match expectations.
+    static func _invalidResponse(code: Int, expected: [Int], request: URLRequest, response: HTTPURLResponse, data: Data) -> Self {
+        Self(.api(.invalidResponse), "The URL response code '\(code)' was received, but only \(expected) codes were expected.", help: "Review the returned response and data, and try to fix the problem.", info: ["Request": request, "Response": response, "Data": data])
+    }
+    /// Error raised when an array element cannot be decoded.
+    static func _unableToDecode(request: URLRequest, response: HTTPURLResponse, error: Swift.Error) -> Self {
+        Self(.api(.invalidResponse), "The response body could not be decoded as the expected type.", help: "Contact the repo maintainer.", underlying: error, info: ["Request": request, "Response": response])
+    }
+    /// Error raised when the response body doesn't contain the expected array.
+    static func _unfoundArray(request: URLRequest, response: HTTPURLResponse?) -> Self {
+        let error = Self(.api(.invalidResponse), "The response body didn't contain the expected array of elements.", help: "Contact the repo maintainer.", info: ["Request": request])
+        if let response = response { error.errorUserInfo["Response"] = response }
+        return error
+    }
+}
@@ -21,6 +21,10 @@ public final class Database {
     @inlinable public final var prices: Database.Request.Prices { .init(database: self) }
     /// Namespace for functionality related to central banks interest rates and inflation.
     @inlinable public final var rates: Database.Request.Rates { .init(database: self) }
+    /// Namespace for functionality related to the order lifecycle journal and execution analytics.
+    @inlinable public final var journal: Database.Request.Journal { .init(database: self) }
+    /// Namespace for functionality related to the volume profiles of finished trading sessions.
+    @inlinable public final var profiles: Database.Request.Profiles { .init(database: self) }
     
     /// The database version.
     public final var version: Int { Database.Version.latest.rawValue }
@@ -40,6 +44,18 @@ public final class Database {
         try self.init(channel: channel, queue: queue)
     }
     
+    /// Creates a database instance whose accesses are executed on the `background` executor.
+    ///
+    /// - precondition: The `background` executor cannot be (or target) `DispatchQueue.main`. Also, the initializer cannot be called from within the executor's execution context.
+    ///
+    /// - parameter location: The location of the database (whether "in-memory" or file system).
+    /// - parameter executors: The executors configuration. Only the `background` executor is used.
+    /// - throws: `IG.Error` exclusively.
+    public convenience init(location: Database.Location, executors: Executors) throws {
+        let queue = executors.background._queue(label: IG.identifier + ".database.queue", automatic: DispatchQueue(label: IG.identifier + ".database.queue", qos: .utility, attributes: .concurrent))
+        try self.init(location: location, queue: queue)
+    }
+    
     /// Designated initializer for the database instance providing the database configuration.
     /// - parameter rootURL: The file URL where the databse file is or `nil` for "in memory" storage.
     /// - parameter channel: The SQLite opaque pointer to the database.
@@ -107,10 +107,10 @@ extension Database.Channel {
     /// This is a parallel access, meaning that other read access may be performed in parallel.
     /// - warning: Don't call another read or write within the `interaction` closure or a deadlock will occur.
     /// - parameter promise: Closure receiving the result of the transaction (the one returned by the `interaction` closure).
-    /// - parameter receptionQueue: The queue where the `promise` will be executed.
+    /// - parameter receptionQueue: The queue where the `promise` will be executed. If `nil`, the `promise` is executed directly on the database queue (right after the transaction ends).
     /// - parameter interaction: Closure giving the priviledge database connection.
     /// - parameter database: Low-level pointer to the SQLite database. Usage of this pointer outside the `interaction` closure produces a fatal error.
-    @_transparent func readAsync<T>(promise: @escaping (Result<T,IG.Error>) -> Void, on receptionQueue: DispatchQueue, _ interaction: @escaping (_ database: SQLite.Database) throws -> T) {
+    @_transparent func readAsync<T>(promise: @escaping (Result<T,IG.Error>) -> Void, on receptionQueue: DispatchQueue?, _ interaction: @escaping (_ database: SQLite.Database) throws -> T) {
         dispatchPrecondition(condition: .notOnQueue(self._queue))
         self._asyncTransactionAccess(flags: [], promise: promise, on: receptionQueue, interaction)
     }
@@ -120,10 +120,10 @@ extension Database.Channel {
     /// This is a barrier access, meaning that all other access are kept on hold while this interaction is in operation.
     /// - warning: Don't call another read or write within the `interaction` closure or a deadlock will occur.
     /// - parameter promise: Closure receiving the result of the transaction (the one returned by the `interaction` closure).
-    /// - parameter receptionQueue: The queue where the `promise` will be executed.
+    /// - parameter receptionQueue: The queue where the `promise` will be executed. If `nil`, the `promise` is executed directly on the database queue (right after the transaction ends).
     /// - parameter interaction: Closure giving the priviledge database connection.
     /// - parameter database: Low-level pointer to the SQLite database. Usage of this pointer outside the `interaction` closure produces a fatal error.
-    @_transparent func writeAsync<T>(promise: @escaping (Result<T,IG.Error>) -> Void, on receptionQueue: DispatchQueue, _ interaction: @escaping (_ database: SQLite.Database) throws -> T) {
+    @_transparent func writeAsync<T>(promise: @escaping (Result<T,IG.Error>) -> Void, on receptionQueue: DispatchQueue?, _ interaction: @escaping (_ database: SQLite.Database) throws -> T) {
         dispatchPrecondition(condition: .notOnQueue(self._queue))
         self._asyncTransactionAccess(flags: .barrier, promise: promise, on: receptionQueue, interaction)
     }
@@ -134,13 +134,13 @@ extension Database.Channel {
     /// - warning: Don't call another read or write within the `interaction` closure or a deadlock will occur.
     /// - parameter flags: The behavior for the executing work item.
     /// - parameter promise: Closure receiving the result of the transaction (that one returned by the `interaction` closure).
-    /// - parameter receptionQueue: The queue where the `promise` will be executed.
+    /// - parameter receptionQueue: The queue where the `promise` will be executed. If `nil`, the `promise` is executed directly on the database queue (right after the transaction ends).
     /// - parameter interaction: Closure giving the priviledge database connection.
     /// - parameter database: Low-level pointer to the SQLite database. Usage of this pointer outside the `interaction` closure produces a fatal error.
-    private func _asyncTransactionAccess<T>(flags: DispatchWorkItemFlags, promise: @escaping (Result<T,IG.Error>) -> Void, on receptionQueue: DispatchQueue, _ interaction: @escaping (_ database: SQLite.Database) throws -> T) {
+    private func _asyncTransactionAccess<T>(flags: DispatchWorkItemFlags, promise: @escaping (Result<T,IG.Error>) -> Void, on receptionQueue: DispatchQueue?, _ interaction: @escaping (_ database: SQLite.Database) throws -> T) {
         self._queue.async(flags: flags) {
             if let errorCode = sqlite3_exec(self._database, "BEGIN TRANSACTION", nil, nil, nil).enforce(.ok) {
-                return receptionQueue.async { promise(.failure(._invalidExecution(code: errorCode))) }
+                return Self._deliver(.failure(._invalidExecution(code: errorCode)), to: promise, on: receptionQueue)
             }
             
             let output: T
@@ -161,11 +161,18 @@ extension Database.Channel {
                 fatalError("An error occurred (code: \(errorCode) trying to end a transaction.")
             }
             
-            return receptionQueue.async {
-                promise(.success(output))
-            }
+            return Self._deliver(.success(output), to: promise, on: receptionQueue)
         }
     }
+    
+    /// Executes the `promise` with the given result on the reception queue (or right away if there is none).
+    /// - parameter result: The transaction result.
+    /// - parameter promise: Closure receiving the result of the transaction.
+    /// - parameter receptionQueue: The queue where the `promise` will be executed. If `nil`, the `promise` is executed in the current execution context.
+    @_transparent private static func _deliver<T>(_ result: Result<T,IG.Error>, to promise: @escaping (Result<T,IG.Error>) -> Void, on receptionQueue: DispatchQueue?) {
+        guard let queue = receptionQueue else { return promise(result) }
+        queue.async { promise(result) }
+    }
 }
 
 private extension Database.Channel {
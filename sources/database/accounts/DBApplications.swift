@@ -16,7 +16,59 @@ extension Database.Request.Accounts {
     /// Returns all applications stored in the database.
     /// - returns: Discrete publisher producing a single value containing an array of all stored applications and then successfully completes.
     public func getApplications() -> AnyPublisher<[Database.Application],IG.Error> {
-        self._database.publisher { _ in "SELECT * FROM \(Database.Application.tableName)" }
+        self._getApplications().publisher
+    }
+
+    /// Returns the application specified by its API key.
+    ///
+    /// If the application is not found, an `.invalidResponse` is returned.
+    /// - parameter key: The API key identifying the application.
+    public func getApplication(key: API.Key) -> AnyPublisher<Database.Application,IG.Error> {
+        self._getApplication(key: key).publisher
+    }
+
+    /// Updates the database with the information received from the server.
+    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
+    /// - parameter applications: Information returned from the server.
+    public func update(applications: [API.Application]) -> AnyPublisher<Never,IG.Error> {
+        self._update(applications: applications).publisher.ignoreOutput().eraseToAnyPublisher()
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Accounts {
+    /// Returns all applications stored in the database.
+    /// - seealso: `getApplications()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func getApplications() async throws -> [Database.Application] {
+        try await self._getApplications().value()
+    }
+    
+    /// Returns the application specified by its API key.
+    ///
+    /// If the application is not found, an `.invalidResponse` is returned.
+    /// - parameter key: The API key identifying the application.
+    /// - seealso: `getApplication(key:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func getApplication(key: API.Key) async throws -> Database.Application {
+        try await self._getApplication(key: key).value()
+    }
+    
+    /// Updates the database with the information received from the server.
+    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
+    /// - parameter applications: Information returned from the server.
+    /// - seealso: `update(applications:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(applications: [API.Application]) async throws {
+        try await self._update(applications: applications).value()
+    }
+}
+#endif
+
+private extension Database.Request.Accounts {
+    /// Database access shared by `getApplications()` and its `async` variant.
+    func _getApplications() -> Database.Access<String,[Database.Application]> {
+        self._database.access { _ in "SELECT * FROM \(Database.Application.tableName)" }
             .read { (sqlite, statement, query) in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 
@@ -28,16 +80,12 @@ extension Database.Request.Accounts {
                     case let e: throw IG.Error._queryFailed(code: e)
                     }
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
-
-    /// Returns the application specified by its API key.
-    ///
-    /// If the application is not found, an `.invalidResponse` is returned.
-    /// - parameter key: The API key identifying the application.
-    public func getApplication(key: API.Key) -> AnyPublisher<Database.Application,IG.Error> {
-        self._database.publisher { _ in "SELECT * FROM Apps where key = ?1" }
+    
+    /// Database access shared by `getApplication(key:)` and its `async` variant.
+    func _getApplication(key: API.Key) -> Database.Access<String,Database.Application> {
+        self._database.access { _ in "SELECT * FROM Apps where key = ?1" }
             .read { (sqlite, statement, query) in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 try sqlite3_bind_text(statement, 1, key.description, -1, SQLite.Destructor.transient).expects(.ok) { IG.Error._bindingFailed(code: $0) }
@@ -47,15 +95,12 @@ extension Database.Request.Accounts {
                 case .done: throw IG.Error._unfoundRequestValue()
                 case let e: throw IG.Error._queryFailed(code: e)
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
-
-    /// Updates the database with the information received from the server.
-    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
-    /// - parameter applications: Information returned from the server.
-    public func update(applications: [API.Application]) -> AnyPublisher<Never,IG.Error> {
-        self._database.publisher { _ in
+    
+    /// Database access shared by `update(applications:)` and its `async` variant.
+    func _update(applications: [API.Application]) -> Database.Access<String,Void> {
+        self._database.access { _ in
             """
             INSERT INTO \(Database.Application.tableName) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, CURRENT_TIMESTAMP)
                 ON CONFLICT(key) DO UPDATE SET
@@ -80,9 +125,7 @@ extension Database.Request.Accounts {
                 sqlite3_clear_bindings(statement)
                 sqlite3_reset(statement)
             }
-        }.ignoreOutput()
-        .mapError(errorCast)
-        .eraseToAnyPublisher()
+        }
     }
 }
 
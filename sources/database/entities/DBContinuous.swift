@@ -0,0 +1,138 @@
+import Foundation
+import Decimals
+import SQLite3
+
+extension Database {
+    /// A contract roll detected on the price history of an expiring market.
+    ///
+    /// Expiring markets keep their epic while the underlying contract changes, so the stored price history jumps at every roll.
+    public struct Roll {
+        /// The date of the first price of the new contract.
+        public let date: Date
+        /// How the roll has been detected.
+        public let source: Self.Source
+        /// The mid close price of the last candle of the expired contract.
+        public let previousClose: Decimal64
+        /// The mid open price of the first candle of the new contract.
+        public let nextOpen: Decimal64
+
+        /// The price difference between the new and the expired contract (used by `.difference` back-adjustment).
+        public var gap: Decimal64 { self.nextOpen - self.previousClose }
+        /// The price ratio between the new and the expired contract (used by `.ratio` back-adjustment).
+        public var ratio: Double { Double(self.nextOpen.description)! / Double(self.previousClose.description)! }
+    }
+}
+
+extension Database.Roll {
+    /// The mechanism by which a roll has been detected.
+    public enum Source: Int32 {
+        /// A stored contract expiration date has been crossed.
+        case expiry = 0
+        /// The gap between two consecutive candles exceeded the given threshold.
+        case discontinuity = 1
+    }
+
+    /// The method used to stitch the contracts together.
+    ///
+    /// Both methods back-adjust (i.e. the latest contract keeps its quoted prices and the history is shifted).
+    public enum Adjustment: Int32 {
+        /// Previous contracts are shifted by the price gap at each roll (preserving absolute price differences).
+        case difference = 0
+        /// Previous contracts are multiplied by the price ratio at each roll (preserving relative returns).
+        case ratio = 1
+    }
+}
+
+extension Database.Market {
+    /// The expiration date of one of the contracts traded under an epic.
+    internal struct Contract {
+        /// Instrument identifier.
+        let epic: IG.Market.Epic
+        /// The last dealing date of the contract.
+        let expiry: Date
+
+        /// Extracts the contract expiration from the given market (if it is an expiring market).
+        init?(market: API.Market) {
+            let expiration = market.instrument.expiration
+            switch (expiration.lastDealingDate, expiration.expiry) {
+            case (let date?, _): self.expiry = date
+            case (.none, .forward(let date)): self.expiry = date
+            default: return nil
+            }
+            self.epic = market.instrument.epic
+        }
+    }
+}
+
+// MARK: -
+
+extension Database.Market.Contract: DBTable {
+    static let tableName: String = Database.Market.tableName.appending("_Contracts")
+
+    static var tableDefinition: String { """
+        CREATE TABLE \(Self.tableName) (
+            epic   TEXT    NOT NULL CHECK( LENGTH(epic) BETWEEN 6 AND 30 ),
+            expiry INTEGER NOT NULL,
+
+            PRIMARY KEY(epic, expiry),
+            FOREIGN KEY(epic) REFERENCES Markets(epic)
+        ) WITHOUT ROWID;
+        """
+    }
+}
+
+extension Database.Roll: DBTable {
+    internal static let tableName: String = "Continuous_Rolls"
+
+    internal static var tableDefinition: String { """
+        CREATE TABLE \(Self.tableName) (
+            epic      TEXT    NOT NULL CHECK( LENGTH(epic) BETWEEN 6 AND 30 ),
+            date      INTEGER NOT NULL,
+            source    INTEGER NOT NULL CHECK( source BETWEEN 0 AND 1 ),
+            prevClose INTEGER NOT NULL,
+            nextOpen  INTEGER NOT NULL,
+
+            PRIMARY KEY(epic, date)
+        ) WITHOUT ROWID;
+        CREATE TABLE \(Self.stateTableName) (
+            epic       TEXT    NOT NULL CHECK( LENGTH(epic) BETWEEN 6 AND 30 ),
+            adjustment INTEGER NOT NULL CHECK( adjustment BETWEEN 0 AND 1 ),
+            threshold  REAL,
+            lastDate   INTEGER NOT NULL,
+
+            PRIMARY KEY(epic)
+        ) WITHOUT ROWID;
+        """
+    }
+
+    /// The table keeping track of how far each continuous series has been materialised.
+    internal static let stateTableName: String = "Continuous_State"
+    /// The prefix of the materialised continuous series tables (followed by the market epic).
+    internal static let seriesTableNamePrefix: String = "Continuous_"
+}
+
+internal extension Database.Roll {
+    typealias Indices = (date: Int32, source: Int32, prevClose: Int32, nextOpen: Int32)
+
+    init(date: Date, source: Self.Source, previousClose: Decimal64, nextOpen: Decimal64) {
+        self.date = date
+        self.source = source
+        self.previousClose = previousClose
+        self.nextOpen = nextOpen
+    }
+
+    init(statement s: SQLite.Statement, indices: Indices = (1, 2, 3, 4)) {
+        self.date = Date(timeIntervalSince1970: TimeInterval(sqlite3_column_int(s, indices.date)))
+        self.source = Self.Source(rawValue: sqlite3_column_int(s, indices.source))!
+        self.previousClose = Decimal64(.init(sqlite3_column_int64(s, indices.prevClose)), power: -Database.Price.Point.powerOf10)!
+        self.nextOpen = Decimal64(.init(sqlite3_column_int64(s, indices.nextOpen)), power: -Database.Price.Point.powerOf10)!
+    }
+
+    func _bind(to statement: SQLite.Statement, epic: IG.Market.Epic, indices: Indices = (2, 3, 4, 5)) {
+        sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient)
+        sqlite3_bind_int(statement, indices.date, Int32(self.date.timeIntervalSince1970))
+        sqlite3_bind_int(statement, indices.source, self.source.rawValue)
+        sqlite3_bind_int64(statement, indices.prevClose, Int64(clamping: self.previousClose << Database.Price.Point.powerOf10))
+        sqlite3_bind_int64(statement, indices.nextOpen, Int64(clamping: self.nextOpen << Database.Price.Point.powerOf10))
+    }
+}
@@ -0,0 +1,177 @@
+import Foundation
+import Decimals
+import SQLite3
+
+extension Database {
+    /// A single step on the lifecycle of an order (as recorded on the order journal).
+    ///
+    /// Events of the same order are linked through their deal reference; thus, set the `reference` explicitly when building the order (e.g. `createPosition(reference:...)`) or send the order through `API.Request.Deals.journaled(on:)`, which records every step on its own.
+    public struct OrderEvent {
+        /// The deal reference identifying the order.
+        public let reference: IG.Deal.Reference
+        /// The lifecycle step being recorded.
+        public let stage: Self.Stage
+        /// The moment the step happened.
+        public let date: Date
+        /// Instrument epic identifier (if known at this step).
+        public let epic: IG.Market.Epic?
+        /// The order direction (if known at this step).
+        public let direction: IG.Deal.Direction?
+        /// The quote at decision time (for `.built` events) or `nil`.
+        public let quote: (bid: Decimal64, ask: Decimal64)?
+        /// The execution level (for accepted confirmations) or `nil`.
+        public let level: Decimal64?
+        /// The deal identifier (for confirmations) or `nil`.
+        public let dealId: IG.Deal.Identifier?
+        /// The rejection reason (for rejected confirmations) or `nil`.
+        public let rejection: API.Confirmation.Deal.Status.RejectionReason?
+
+        /// Designated initializer.
+        public init(reference: IG.Deal.Reference, stage: Self.Stage, date: Date, epic: IG.Market.Epic? = nil, direction: IG.Deal.Direction? = nil, quote: (bid: Decimal64, ask: Decimal64)? = nil, level: Decimal64? = nil, dealId: IG.Deal.Identifier? = nil, rejection: API.Confirmation.Deal.Status.RejectionReason? = nil) {
+            self.reference = reference
+            self.stage = stage
+            self.date = date
+            self.epic = epic
+            self.direction = direction
+            self.quote = quote
+            self.level = level
+            self.dealId = dealId
+            self.rejection = rejection
+        }
+    }
+}
+
+extension Database.OrderEvent {
+    /// The lifecycle steps of an order.
+    public enum Stage: Int32, CaseIterable {
+        /// The order has been decided and its payload built (the quote at decision time is recorded).
+        case built = 0
+        /// The order request has been handed to the network.
+        case sent = 1
+        /// The order request has been answered with a deal reference.
+        case acknowledged = 2
+        /// The deal has been confirmed through the REST confirmation endpoint.
+        case confirmedREST = 3
+        /// The deal has been confirmed through the streamer's confirmation subscription.
+        case confirmedStream = 4
+    }
+
+    /// Records the decision to place an order.
+    /// - parameter reference: The deal reference which will be sent with the order.
+    /// - parameter epic: Instrument epic identifier.
+    /// - parameter direction: The order direction.
+    /// - parameter quote: The market quote at decision time (against which slippage is measured).
+    /// - parameter date: The moment the order has been built.
+    public static func built(reference: IG.Deal.Reference, epic: IG.Market.Epic, direction: IG.Deal.Direction, quote: (bid: Decimal64, ask: Decimal64), date: Date) -> Self {
+        Self(reference: reference, stage: .built, date: date, epic: epic, direction: direction, quote: quote)
+    }
+
+    /// Records the moment an order request is sent.
+    /// - parameter reference: The deal reference sent with the order.
+    /// - parameter date: The moment the order has been sent.
+    public static func sent(reference: IG.Deal.Reference, date: Date) -> Self {
+        Self(reference: reference, stage: .sent, date: date)
+    }
+
+    /// Records the moment the server answers an order request with a deal reference.
+    /// - parameter reference: The deal reference received.
+    /// - parameter date: The moment the response has been received.
+    public static func acknowledged(reference: IG.Deal.Reference, date: Date) -> Self {
+        Self(reference: reference, stage: .acknowledged, date: date)
+    }
+
+    /// Records a confirmation received through the REST confirmation endpoint.
+    /// - parameter confirmation: The received confirmation.
+    /// - parameter date: The moment the confirmation has been received.
+    public static func confirmed(_ confirmation: API.Confirmation, date: Date) -> Self {
+        let rejection: API.Confirmation.Deal.Status.RejectionReason?
+        switch confirmation.deal.status {
+        case .accepted: rejection = nil
+        case .rejected(let reason): rejection = reason ?? .unknown
+        }
+        return Self(reference: confirmation.deal.reference, stage: .confirmedREST, date: date, epic: confirmation.details.epic, direction: confirmation.details.direction, level: confirmation.details.level, dealId: confirmation.deal.id, rejection: rejection)
+    }
+
+    /// Records a confirmation received through the streamer's confirmation subscription.
+    /// - parameter confirmation: The received confirmation.
+    /// - parameter date: The moment the confirmation has been received.
+    public static func confirmed(_ confirmation: Streamer.Confirmation, date: Date) -> Self {
+        let rejection: API.Confirmation.Deal.Status.RejectionReason?
+        switch confirmation.deal.status {
+        case .accepted: rejection = nil
+        case .rejected(let reason): rejection = reason.flatMap { .init(rawValue: $0.rawValue) } ?? .unknown
+        }
+        return Self(reference: confirmation.deal.reference, stage: .confirmedStream, date: date, epic: confirmation.details.epic, direction: confirmation.details.direction, level: confirmation.details.level, dealId: confirmation.deal.id, rejection: rejection)
+    }
+}
+
+// MARK: -
+
+extension Database.OrderEvent: DBTable {
+    internal static let tableName: String = "Journal_Orders"
+
+    internal static var tableDefinition: String { """
+        CREATE TABLE '\(Self.tableName)' (
+            id        INTEGER PRIMARY KEY AUTOINCREMENT,
+            reference TEXT    NOT NULL CHECK( LENGTH(reference) > 0 ),
+            stage     INTEGER NOT NULL CHECK( stage BETWEEN 0 AND 4 ),
+            date      INTEGER NOT NULL,
+            epic      TEXT             CHECK( LENGTH(epic) BETWEEN 6 AND 30 ),
+            direction INTEGER          CHECK( direction BETWEEN 0 AND 1 ),
+            bid       INTEGER,
+            ask       INTEGER,
+            level     INTEGER,
+            dealId    TEXT,
+            rejection TEXT
+        );
+        CREATE INDEX 'idx_\(Self.tableName)_date' ON '\(Self.tableName)' (date);
+        CREATE INDEX 'idx_\(Self.tableName)_reference' ON '\(Self.tableName)' (reference);
+        """
+    }
+}
+
+internal extension Database.OrderEvent {
+    typealias Indices = (reference: Int32, stage: Int32, date: Int32, epic: Int32, direction: Int32, bid: Int32, ask: Int32, level: Int32, dealId: Int32, rejection: Int32)
+    /// The amount of decimal digits stored for prices.
+    private static let powerOf10: Int = 8
+
+    init(statement s: SQLite.Statement, indices: Indices = (1, 2, 3, 4, 5, 6, 7, 8, 9, 10)) {
+        self.reference = IG.Deal.Reference(String(cString: sqlite3_column_text(s, indices.reference)))!
+        self.stage = Self.Stage(rawValue: sqlite3_column_int(s, indices.stage))!
+        self.date = Date(timeIntervalSince1970: TimeInterval(sqlite3_column_int64(s, indices.date)) / 1_000_000)
+        self.epic = sqlite3_column_text(s, indices.epic).flatMap { IG.Market.Epic(String(cString: $0)) }
+        self.direction = (sqlite3_column_type(s, indices.direction) == SQLITE_NULL) ? nil : ((sqlite3_column_int(s, indices.direction) == 0) ? .buy : .sell)
+        if sqlite3_column_type(s, indices.bid) != SQLITE_NULL, sqlite3_column_type(s, indices.ask) != SQLITE_NULL {
+            self.quote = (Self._decimal(statement: s, index: indices.bid), Self._decimal(statement: s, index: indices.ask))
+        } else {
+            self.quote = nil
+        }
+        self.level = (sqlite3_column_type(s, indices.level) == SQLITE_NULL) ? nil : Self._decimal(statement: s, index: indices.level)
+        self.dealId = sqlite3_column_text(s, indices.dealId).flatMap { IG.Deal.Identifier(String(cString: $0)) }
+        self.rejection = sqlite3_column_text(s, indices.rejection).flatMap { API.Confirmation.Deal.Status.RejectionReason(rawValue: String(cString: $0)) }
+    }
+
+    func _bind(to statement: SQLite.Statement, indices: Indices = (1, 2, 3, 4, 5, 6, 7, 8, 9, 10)) {
+        sqlite3_bind_text(statement, indices.reference, self.reference.description, -1, SQLite.Destructor.transient)
+        sqlite3_bind_int(statement, indices.stage, self.stage.rawValue)
+        sqlite3_bind_int64(statement, indices.date, Int64((self.date.timeIntervalSince1970 * 1_000_000).rounded()))
+        self.epic.unwrap(none: { sqlite3_bind_null(statement, indices.epic) },
+                         some: { sqlite3_bind_text(statement, indices.epic, $0.description, -1, SQLite.Destructor.transient) })
+        self.direction.unwrap(none: { sqlite3_bind_null(statement, indices.direction) },
+                              some: { sqlite3_bind_int(statement, indices.direction, ($0 == .buy) ? 0 : 1) })
+        self.quote.unwrap(none: { sqlite3_bind_null(statement, indices.bid); sqlite3_bind_null(statement, indices.ask) },
+                          some: { sqlite3_bind_int64(statement, indices.bid, Int64(clamping: $0.bid << Self.powerOf10))
+                                  sqlite3_bind_int64(statement, indices.ask, Int64(clamping: $0.ask << Self.powerOf10)) })
+        self.level.unwrap(none: { sqlite3_bind_null(statement, indices.level) },
+                          some: { sqlite3_bind_int64(statement, indices.level, Int64(clamping: $0 << Self.powerOf10)) })
+        self.dealId.unwrap(none: { sqlite3_bind_null(statement, indices.dealId) },
+                           some: { sqlite3_bind_text(statement, indices.dealId, $0.description, -1, SQLite.Destructor.transient) })
+        self.rejection.unwrap(none: { sqlite3_bind_null(statement, indices.rejection) },
+                              some: { sqlite3_bind_text(statement, indices.rejection, $0.rawValue, -1, SQLite.Destructor.transient) })
+    }
+
+    /// Decodes a price stored as a scaled integer.
+    private static func _decimal(statement s: SQLite.Statement, index: Int32) -> Decimal64 {
+        Decimal64(.init(sqlite3_column_int64(s, index)), power: -Self.powerOf10)!
+    }
+}
@@ -0,0 +1,86 @@
+import Foundation
+import Decimals
+import SQLite3
+
+extension Streamer.Profile: DBTable {
+    internal static let tableName: String = "Profiles"
+
+    internal static var tableDefinition: String { """
+        CREATE TABLE \(Self.tableName) (
+            epic      TEXT    NOT NULL CHECK( LENGTH(epic) BETWEEN 6 AND 30 ),
+            start     INTEGER NOT NULL,
+            end       INTEGER NOT NULL CHECK( end > start ),
+            binSize   INTEGER NOT NULL CHECK( binSize > 0 ),
+            base      INTEGER NOT NULL,
+            poc       INTEGER,
+            valueLow  INTEGER,
+            valueHigh INTEGER,
+            bins      BLOB    NOT NULL,
+
+            PRIMARY KEY(epic, start)
+        ) WITHOUT ROWID;
+        """
+    }
+}
+
+internal extension Streamer.Profile {
+    typealias Indices = (epic: Int32, start: Int32, end: Int32, binSize: Int32, base: Int32, poc: Int32, valueLow: Int32, valueHigh: Int32, bins: Int32)
+
+    /// The number of 64-bit words encoding every histogram bin (volume, ticks, and time).
+    private static let _words: Int = 3
+    /// The decimal places stored for the price levels.
+    private static let powerOf10: Int = 8
+
+    init?(statement s: SQLite.Statement, indices: Indices = (0, 1, 2, 3, 4, 5, 6, 7, 8)) {
+        let bytes = Int(sqlite3_column_bytes(s, indices.bins))
+        guard bytes % (Self._words * MemoryLayout<UInt64>.size) == 0,
+              let epic = IG.Market.Epic(String(cString: sqlite3_column_text(s, indices.epic))) else { return nil }
+
+        var words = [UInt64](repeating: 0, count: bytes / MemoryLayout<UInt64>.size)
+        if bytes > 0 {
+            guard let blob = sqlite3_column_blob(s, indices.bins) else { return nil }
+            words.withUnsafeMutableBytes { $0.copyMemory(from: UnsafeRawBufferPointer(start: blob, count: $0.count)) }
+        }
+        let bins = stride(from: 0, to: words.count, by: Self._words).map {
+            Bin(volume: Double(bitPattern: UInt64(littleEndian: words[$0])),
+                ticks: Int(truncatingIfNeeded: UInt64(littleEndian: words[$0 + 1])),
+                time: Double(bitPattern: UInt64(littleEndian: words[$0 + 2])))
+        }
+
+        self.init(epic: epic,
+                  start: Date(timeIntervalSince1970: TimeInterval(sqlite3_column_int64(s, indices.start))),
+                  end: Date(timeIntervalSince1970: TimeInterval(sqlite3_column_int64(s, indices.end))),
+                  binSize: Self._decimal(statement: s, index: indices.binSize),
+                  base: Self._decimal(statement: s, index: indices.base),
+                  bins: bins)
+    }
+
+    func _bind(to statement: SQLite.Statement, indices: Indices = (1, 2, 3, 4, 5, 6, 7, 8, 9)) {
+        sqlite3_bind_text(statement, indices.epic, self.epic.description, -1, SQLite.Destructor.transient)
+        sqlite3_bind_int64(statement, indices.start, Int64(self.start.timeIntervalSince1970))
+        sqlite3_bind_int64(statement, indices.end, Int64(self.end.timeIntervalSince1970))
+        sqlite3_bind_int64(statement, indices.binSize, Int64(clamping: self.binSize << Self.powerOf10))
+        sqlite3_bind_int64(statement, indices.base, Int64(clamping: self.base << Self.powerOf10))
+        self.pointOfControl.unwrap(none: { sqlite3_bind_null(statement, indices.poc) },
+                                   some: { sqlite3_bind_int64(statement, indices.poc, Int64(clamping: $0 << Self.powerOf10)) })
+        self.valueArea().unwrap(none: { sqlite3_bind_null(statement, indices.valueLow); sqlite3_bind_null(statement, indices.valueHigh) },
+                                some: { sqlite3_bind_int64(statement, indices.valueLow, Int64(clamping: $0.lowerBound << Self.powerOf10))
+                                        sqlite3_bind_int64(statement, indices.valueHigh, Int64(clamping: $0.upperBound << Self.powerOf10)) })
+
+        var words: [UInt64] = .init()
+        words.reserveCapacity(self.bins.count * Self._words)
+        for bin in self.bins {
+            words.append(bin.volume.bitPattern.littleEndian)
+            words.append(UInt64(truncatingIfNeeded: bin.ticks).littleEndian)
+            words.append(bin.time.bitPattern.littleEndian)
+        }
+        guard !words.isEmpty else { sqlite3_bind_zeroblob(statement, indices.bins, 0); return }
+        words.withUnsafeBytes {
+            _ = sqlite3_bind_blob(statement, indices.bins, $0.baseAddress, Int32($0.count), SQLite.Destructor.transient)
+        }
+    }
+
+    private static func _decimal(statement s: SQLite.Statement, index: Int32) -> Decimal64 {
+        Decimal64(.init(sqlite3_column_int64(s, index)), power: -Self.powerOf10)!
+    }
+}
@@ -0,0 +1,178 @@
+import Foundation
+import SQLite3
+
+extension Database.Market {
+    /// The weekly opening hours of a market compiled into a minute-of-week bitmap.
+    ///
+    /// Each bit represents a minute of the week (starting on Monday 00:00 in the market's timezone); thus, checking whether the market is open is a constant time operation.
+    public struct TradingHours {
+        /// Instrument identifier.
+        public let epic: IG.Market.Epic
+        /// The timezone in which the opening hours are expressed.
+        public let timezone: TimeZone
+        /// The minute-of-week bitmap (one bit per minute; set bits indicate the market is open).
+        internal let bitmap: [UInt64]
+
+        /// Compiles the given daily opening hours into a weekly bitmap.
+        ///
+        /// Ranges whose closing time is before (or equal to) their opening time are considered to end on the following day.
+        /// - parameter epic: Instrument identifier.
+        /// - parameter timezone: The timezone in which the opening hours are expressed.
+        /// - parameter ranges: The daily opening hours in `HH:mm` format (e.g. `("08:00", "16:30")`).
+        /// - parameter weekdays: The days on which the ranges start, following the ISO 8601 numbering (`1` for Monday till `7` for Sunday). If `nil`, the trading days are Monday till Friday: ranges contained within a day start on those days, while ranges spilling over into the following day (e.g. a forex session opening on Sunday evening) start on the eve of each trading day (i.e. Sunday till Thursday).
+        /// - returns: The compiled trading hours or `nil` if any range is malformed.
+        public init?(epic: IG.Market.Epic, timezone: TimeZone, ranges: [(open: String, close: String)], weekdays: Set<Int>? = nil) {
+            var bitmap = [UInt64](repeating: 0, count: Self._words)
+            for range in ranges {
+                guard let open = Self._minuteOfDay(range.open), let close = Self._minuteOfDay(range.close) else { return nil }
+                let duration = (close > open) ? close - open : close + Self._minutesPerDay - open
+                let days = weekdays ?? ((open + duration > Self._minutesPerDay) ? [7, 1, 2, 3, 4] : [1, 2, 3, 4, 5])
+                for weekday in days where (1...7).contains(weekday) {
+                    let start = (weekday - 1) * Self._minutesPerDay + open
+                    for minute in start..<(start + duration) {
+                        let index = minute % Self._minutesPerWeek
+                        bitmap[index >> 6] |= (1 << UInt64(index & 63))
+                    }
+                }
+            }
+            self.init(epic: epic, timezone: timezone, bitmap: bitmap)
+        }
+
+        /// Compiles the opening hours of the given market.
+        /// - parameter market: The market information returned from the server.
+        /// - parameter timezone: The timezone in which the server expressed the opening hours.
+        /// - parameter weekdays: The days on which the ranges start, following the ISO 8601 numbering (`1` for Monday till `7` for Sunday). If `nil`, they are derived from the ranges (see `init(epic:timezone:ranges:weekdays:)`).
+        /// - returns: The compiled trading hours or `nil` if the market has no opening hours information (or it is malformed).
+        public init?(market: API.Market, timezone: TimeZone, weekdays: Set<Int>? = nil) {
+            guard let ranges = market.instrument.openingTime, !ranges.isEmpty else { return nil }
+            self.init(epic: market.instrument.epic, timezone: timezone, ranges: ranges.map { ($0.open, $0.close) }, weekdays: weekdays)
+        }
+
+        /// Designated initializer.
+        internal init(epic: IG.Market.Epic, timezone: TimeZone, bitmap: [UInt64]) {
+            precondition(bitmap.count == Self._words)
+            self.epic = epic
+            self.timezone = timezone
+            self.bitmap = bitmap
+        }
+    }
+}
+
+extension Database.Market.TradingHours {
+    /// Returns a Boolean indicating whether the market is open at the given date.
+    /// - complexity: O(1).
+    public func isOpen(at date: Date) -> Bool {
+        self._isOpen(minute: self._minuteOfWeek(date))
+    }
+
+    /// Returns the moment the market is next open.
+    ///
+    /// If the market is already open at the given date, the same date is returned.
+    /// - complexity: O(1) (at most a week worth of 64-bit words is scanned).
+    /// - returns: The next opening date or `nil` if the market is never open.
+    public func nextOpen(after date: Date) -> Date? {
+        let current = self._minuteOfWeek(date)
+        guard !self._isOpen(minute: current) else { return date }
+        guard let distance = self._distanceToNextOpen(from: current) else { return nil }
+
+        let startOfMinute = (date.timeIntervalSince1970 / 60).rounded(.down) * 60
+        let candidate = Date(timeIntervalSince1970: startOfMinute + TimeInterval(distance * 60))
+        // Correct for any timezone offset change (e.g. daylight saving time) in between.
+        let drift = self.timezone.secondsFromGMT(for: candidate) - self.timezone.secondsFromGMT(for: date)
+        return candidate.addingTimeInterval(-TimeInterval(drift))
+    }
+}
+
+// MARK: -
+
+extension Database.Market.TradingHours: DBTable {
+    internal static let tableName: String = Database.Market.tableName.appending("_Hours")
+
+    internal static var tableDefinition: String { """
+        CREATE TABLE \(Self.tableName) (
+            epic     TEXT NOT NULL UNIQUE CHECK( LENGTH(epic) BETWEEN 6 AND 30 ),
+            timezone TEXT NOT NULL        CHECK( LENGTH(timezone) > 0 ),
+            bitmap   BLOB NOT NULL        CHECK( LENGTH(bitmap) == \(Self._words * MemoryLayout<UInt64>.size) ),
+
+            FOREIGN KEY(epic) REFERENCES Markets(epic)
+        );
+        """
+    }
+}
+
+internal extension Database.Market.TradingHours {
+    typealias Indices = (epic: Int32, timezone: Int32, bitmap: Int32)
+
+    init?(statement s: SQLite.Statement, indices: Indices = (0, 1, 2)) {
+        guard let timezone = TimeZone(identifier: String(cString: sqlite3_column_text(s, indices.timezone))),
+              Int(sqlite3_column_bytes(s, indices.bitmap)) == Self._words * MemoryLayout<UInt64>.size,
+              let blob = sqlite3_column_blob(s, indices.bitmap) else { return nil }
+
+        var bitmap = [UInt64](repeating: 0, count: Self._words)
+        bitmap.withUnsafeMutableBytes { $0.copyMemory(from: UnsafeRawBufferPointer(start: blob, count: $0.count)) }
+        for index in bitmap.indices { bitmap[index] = UInt64(littleEndian: bitmap[index]) }
+        self.init(epic: IG.Market.Epic(String(cString: sqlite3_column_text(s, indices.epic)))!, timezone: timezone, bitmap: bitmap)
+    }
+
+    func _bind(to statement: SQLite.Statement, indices: Indices = (1, 2, 3)) {
+        sqlite3_bind_text(statement, indices.epic, self.epic.description, -1, SQLite.Destructor.transient)
+        sqlite3_bind_text(statement, indices.timezone, self.timezone.identifier, -1, SQLite.Destructor.transient)
+        let words = self.bitmap.map { $0.littleEndian }
+        words.withUnsafeBytes {
+            _ = sqlite3_bind_blob(statement, indices.bitmap, $0.baseAddress, Int32($0.count), SQLite.Destructor.transient)
+        }
+    }
+}
+
+private extension Database.Market.TradingHours {
+    /// The amount of minutes in a day.
+    static var _minutesPerDay: Int { 1_440 }
+    /// The amount of minutes in a week.
+    static var _minutesPerWeek: Int { 10_080 }
+    /// The amount of 64-bit words needed to store a bit per minute of the week.
+    static var _words: Int { (Self._minutesPerWeek + 63) >> 6 }
+
+    /// Parses a `HH:mm` string into the minutes elapsed since midnight.
+    static func _minuteOfDay(_ string: String) -> Int? {
+        let components = string.split(separator: ":")
+        guard components.count >= 2, let hours = Int(components[0]), let minutes = Int(components[1]),
+              (0...24).contains(hours), (0..<60).contains(minutes) else { return nil }
+        return Swift.min(hours * 60 + minutes, Self._minutesPerDay)
+    }
+
+    /// Returns the minute of the week (starting on Monday 00:00 in the receiving timezone) for the given date.
+    func _minuteOfWeek(_ date: Date) -> Int {
+        let seconds = date.timeIntervalSince1970 + TimeInterval(self.timezone.secondsFromGMT(for: date))
+        // 1970-01-01 was a Thursday (i.e. three days after the start of the week).
+        let minutes = Int((seconds / 60).rounded(.down)) + 3 * Self._minutesPerDay
+        let remainder = minutes % Self._minutesPerWeek
+        return (remainder >= 0) ? remainder : remainder + Self._minutesPerWeek
+    }
+
+    /// Returns a Boolean indicating whether the given minute of the week is flagged as open.
+    @inline(__always) func _isOpen(minute: Int) -> Bool {
+        (self.bitmap[minute >> 6] >> UInt64(minute & 63)) & 1 == 1
+    }
+
+    /// Returns the amount of minutes from the given minute of the week till the next open minute (or `nil` if none is open).
+    func _distanceToNextOpen(from minute: Int) -> Int? {
+        let words = Self._words
+        let start = minute + 1
+        // The bits of the first word before the starting minute are masked out.
+        var wordIndex = start >> 6
+        var word = (wordIndex < words) ? self.bitmap[wordIndex] & (~0 << UInt64(start & 63)) : 0
+
+        for _ in 0...words {
+            if word != 0 {
+                let found = wordIndex * 64 + word.trailingZeroBitCount
+                if found < Self._minutesPerWeek {
+                    let distance = found - minute
+                    return (distance > 0) ? distance : distance + Self._minutesPerWeek
+                }
+            }
+            wordIndex = (wordIndex + 1) % words
+            word = self.bitmap[wordIndex]
+        }
+        return nil
+    }
+}
@@ -9,6 +9,14 @@ internal extension Database {
         case v2 = 2
         /// DB added the interest rate table.
         case v3 = 3
+        /// DB added the order journal table.
+        case v4 = 4
+        /// DB added the market trading hours table.
+        case v5 = 5
+        /// DB added the contract expiration and continuous price series tables.
+        case v6 = 6
+        /// DB added the session volume profiles table.
+        case v7 = 7
         
         /// The last described migration.
         static var latest: Self { Self.allCases.last! }
@@ -12,6 +12,8 @@ extension Database.Request {
         
         /// It holds data and functionality related to the forex markets.
         public var forex: Database.Request.Markets.Forex { .init(database: self._database) }
+        /// It holds data and functionality related to the markets' trading hours.
+        public var hours: Database.Request.Markets.Hours { .init(database: self._database) }
     }
 }
 
@@ -21,7 +23,94 @@ extension Database.Request.Markets {
     public func contains(epics: Set<IG.Market.Epic>) -> AnyPublisher<[(epic: IG.Market.Epic, isInDatabase: Bool)],IG.Error> {
         guard !epics.isEmpty else { return Result.Publisher([]).eraseToAnyPublisher() }
         
-        return self._database.publisher { _ -> String in
+        return self._contains(epics: epics).publisher
+    }
+    
+    /// Returns all markets stored in the database.
+    ///
+    /// Only the epic and the type of markets are returned.
+    public func getAll() -> AnyPublisher<[Database.Market],IG.Error> {
+        self._getAll().publisher
+    }
+    
+    /// Returns the type of Market identified by the given epic.
+    /// - parameter epic: Market instrument identifier.
+    /// - returns: `SignalProducer` returning the market type or `nil` if the market has been found in the database. If the epic didn't matched any stored market, the producer generates an error `IG.Error.invalidResponse`.
+    public func type(epic: IG.Market.Epic) -> AnyPublisher<Database.Market.Kind?,IG.Error> {
+        self._type(epic: epic).publisher
+    }
+    
+    /// Updates the database with the information received from the server.
+    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
+    /// - parameter market: Information returned from the server.
+    public func update(_ market: API.Market...) -> AnyPublisher<Never,IG.Error> {
+        self.update(market)
+    }
+    
+    /// Updates the database with the information received from the server.
+    ///
+    /// The trading hours of markets already stored through `hours.update(_:timezone:)` are recompiled in their stored timezone. Markets without stored trading hours are left alone, since the timezone of their opening hours is unknown.
+    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
+    /// - parameter markets: Information returned from the server.
+    public func update(_ markets: [API.Market]) -> AnyPublisher<Never,IG.Error> {
+        self._update(markets).publisher.ignoreOutput().eraseToAnyPublisher()
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Markets {
+    /// Returns an array for which each element has the epic and a Boolean indicating whether the market is currently stored on the database or not.
+    /// - parameter epics: Array of market identifiers to be checked against the database.
+    /// - seealso: `contains(epics:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func contains(epics: Set<IG.Market.Epic>) async throws -> [(epic: IG.Market.Epic, isInDatabase: Bool)] {
+        guard !epics.isEmpty else { return [] }
+        
+        return try await self._contains(epics: epics).value()
+    }
+    
+    /// Returns all markets stored in the database.
+    ///
+    /// Only the epic and the type of markets are returned.
+    /// - seealso: `getAll()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func getAll() async throws -> [Database.Market] {
+        try await self._getAll().value()
+    }
+    
+    /// Returns the type of Market identified by the given epic.
+    /// - parameter epic: Market instrument identifier.
+    /// - seealso: `type(epic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func type(epic: IG.Market.Epic) async throws -> Database.Market.Kind? {
+        try await self._type(epic: epic).value()
+    }
+    
+    /// Updates the database with the information received from the server.
+    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
+    /// - parameter market: Information returned from the server.
+    /// - seealso: `update(_:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(_ market: API.Market...) async throws {
+        try await self.update(market)
+    }
+    
+    /// Updates the database with the information received from the server.
+    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
+    /// - parameter markets: Information returned from the server.
+    /// - seealso: `update(_:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(_ markets: [API.Market]) async throws {
+        try await self._update(markets).value()
+    }
+
+}
+#endif
+
+private extension Database.Request.Markets {
+    /// Database access shared by `contains(epics:)` and its `async` variant.
+    func _contains(epics: Set<IG.Market.Epic>) -> Database.Access<String,[(epic: IG.Market.Epic, isInDatabase: Bool)]> {
+        self._database.access { _ -> String in
                 let clause = epics.enumerated().map { (index, _) in "epic=?\(index+1)" }.joined(separator: " OR ")
                 return "SELECT epic FROM \(Database.Market.tableName) WHERE \(clause)"
             }.read { (sqlite, statement, query) in
@@ -41,15 +130,12 @@ extension Database.Request.Markets {
                 }
                 
                 return epics.map { ($0, result.contains($0)) }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Returns all markets stored in the database.
-    ///
-    /// Only the epic and the type of markets are returned.
-    public func getAll() -> AnyPublisher<[Database.Market],IG.Error> {
-        self._database.publisher { _ in "SELECT * FROM \(Database.Market.tableName)" }
+    /// Database access shared by `getAll()` and its `async` variant.
+    func _getAll() -> Database.Access<String,[Database.Market]> {
+        self._database.access { _ in "SELECT * FROM \(Database.Market.tableName)" }
             .read { (sqlite, statement, query) -> [Database.Market] in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 
@@ -61,15 +147,12 @@ extension Database.Request.Markets {
                     case let e: throw IG.Error._queryFailed(code: e)
                     }
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Returns the type of Market identified by the given epic.
-    /// - parameter epic: Market instrument identifier.
-    /// - returns: `SignalProducer` returning the market type or `nil` if the market has been found in the database. If the epic didn't matched any stored market, the producer generates an error `IG.Error.invalidResponse`.
-    public func type(epic: IG.Market.Epic) -> AnyPublisher<Database.Market.Kind?,IG.Error> {
-        self._database.publisher { _ in "SELECT type FROM \(Database.Market.tableName) WHERE epic=?1" }
+    /// Database access shared by `type(epic:)` and its `async` variant.
+    func _type(epic: IG.Market.Epic) -> Database.Access<String,Database.Market.Kind?> {
+        self._database.access { _ in "SELECT type FROM \(Database.Market.tableName) WHERE epic=?1" }
             .read { (sqlite, statement, query) -> Database.Market.Kind? in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 try sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient).expects(.ok) { IG.Error._bindingFailed(code: $0) }
@@ -79,22 +162,12 @@ extension Database.Request.Markets {
                 case .done: throw IG.Error._unfoundRequestValue()
                 case let e: throw IG.Error._queryFailed(code: e)
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
-    }
-    
-    /// Updates the database with the information received from the server.
-    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
-    /// - parameter market: Information returned from the server.
-    public func update(_ market: API.Market...) -> AnyPublisher<Never,IG.Error> {
-        self.update(market)
+            }
     }
     
-    /// Updates the database with the information received from the server.
-    /// - remark: If this function encounters an error in the middle of a transaction, it keeps the values stored right before the error.
-    /// - parameter markets: Information returned from the server.
-    public func update(_ markets: [API.Market]) -> AnyPublisher<Never,IG.Error> {
-        self._database.publisher { _ in "INSERT INTO \(Database.Market.tableName) VALUES(?1, ?2) ON CONFLICT(epic) DO UPDATE SET type=excluded.type" }
+    /// Database access shared by `update(_:)` and its `async` variant.
+    func _update(_ markets: [API.Market]) -> Database.Access<String,Void> {
+        self._database.access { _ in "INSERT INTO \(Database.Market.tableName) VALUES(?1, ?2) ON CONFLICT(epic) DO UPDATE SET type=excluded.type" }
             .write { (sqlite, statement, query) -> Void in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 
@@ -109,9 +182,9 @@ extension Database.Request.Markets {
                 
                 sqlite3_finalize(statement); statement = nil
                 try Self.Forex.update(markets: markets, sqlite: sqlite)
-            }.ignoreOutput()
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+                try Self.Hours.update(markets: markets, timezone: nil, sqlite: sqlite)
+                try Database.Request.Prices.Continuous.update(contracts: markets, sqlite: sqlite)
+            }
     }
 }
 
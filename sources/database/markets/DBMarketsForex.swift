@@ -17,7 +17,105 @@ extension Database.Request.Markets.Forex {
     ///
     /// If there are no forex markets in the database yet, an empty array will be returned.
     public func getAll() -> AnyPublisher<[Database.Market.Forex],IG.Error> {
-        self._database.publisher { _ in "SELECT * FROM \(Database.Market.Forex.tableName)" }
+        self._getAll().publisher
+    }
+    
+    /// Discrete publisher returning the markets stored in the database matching the given epics.
+    ///
+    /// Depending on the `expectsAll` argument, this method will return the exact number of market forex or a subset of them.
+    /// - parameter epics: The forex market epics identifiers.
+    /// - parameter expectsAll: Boolean indicating whether an error should be emitted if not all markets are in the database.
+    public func get(epics: Set<IG.Market.Epic>, expectsAll: Bool) -> AnyPublisher<Set<Database.Market.Forex>,IG.Error> {
+        self._get(epics: epics, expectsAll: expectsAll).publisher
+    }
+    
+    /// Returns the market stored in the database matching the given epic.
+    ///
+    /// If the market is not in the database, a `.invalidResponse` error will be returned.
+    /// - parameter epic: The forex market epic identifier.
+    public func get(epic: IG.Market.Epic) -> AnyPublisher<Database.Market.Forex,IG.Error> {
+        self._get(epic: epic).publisher
+    }
+    
+    /// Returns the forex markets matching the given currency.
+    /// - parameter currency: A currency used as base or counter in the result markets.
+    /// - parameter otherCurrency: A currency matching the first argument. It is optional.
+    public func get(currency: Currency.Code, _ otherCurrency: Currency.Code? = nil) -> AnyPublisher<[Database.Market.Forex],IG.Error> {
+        self._get(currency: currency, otherCurrency).publisher
+    }
+    
+    /// Returns the forex markets in the database matching the given currencies.
+    ///
+    /// If there are no forex markets matching the given requirements, an empty array will be returned.
+    /// - parameter base: The base currency code (or `nil` if this requirement is not needed).
+    /// - parameter counter: The counter currency code (or `nil` if this requirement is not needed).
+    public func get(base: Currency.Code?, counter: Currency.Code?) -> AnyPublisher<[Database.Market.Forex],IG.Error> {
+        guard base != nil || counter != nil else { return self.getAll() }
+        
+        return self._get(base: base, counter: counter).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Markets.Forex {
+    /// Returns all forex markets.
+    ///
+    /// If there are no forex markets in the database yet, an empty array will be returned.
+    /// - seealso: `getAll()` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func getAll() async throws -> [Database.Market.Forex] {
+        try await self._getAll().value()
+    }
+    
+    /// Discrete publisher returning the markets stored in the database matching the given epics.
+    ///
+    /// Depending on the `expectsAll` argument, this method will return the exact number of market forex or a subset of them.
+    /// - parameter epics: The forex market epics identifiers.
+    /// - parameter expectsAll: Boolean indicating whether an error should be emitted if not all markets are in the database.
+    /// - seealso: `get(epics:expectsAll:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func get(epics: Set<IG.Market.Epic>, expectsAll: Bool) async throws -> Set<Database.Market.Forex> {
+        try await self._get(epics: epics, expectsAll: expectsAll).value()
+    }
+    
+    /// Returns the market stored in the database matching the given epic.
+    ///
+    /// If the market is not in the database, a `.invalidResponse` error will be returned.
+    /// - parameter epic: The forex market epic identifier.
+    /// - seealso: `get(epic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func get(epic: IG.Market.Epic) async throws -> Database.Market.Forex {
+        try await self._get(epic: epic).value()
+    }
+    
+    /// Returns the forex markets matching the given currency.
+    /// - parameter currency: A currency used as base or counter in the result markets.
+    /// - parameter otherCurrency: A currency matching the first argument. It is optional.
+    /// - seealso: `get(currency:_:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func get(currency: Currency.Code, _ otherCurrency: Currency.Code? = nil) async throws -> [Database.Market.Forex] {
+        try await self._get(currency: currency, otherCurrency).value()
+    }
+    
+    /// Returns the forex markets in the database matching the given currencies.
+    ///
+    /// If there are no forex markets matching the given requirements, an empty array will be returned.
+    /// - parameter base: The base currency code (or `nil` if this requirement is not needed).
+    /// - parameter counter: The counter currency code (or `nil` if this requirement is not needed).
+    /// - seealso: `get(base:counter:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func get(base: Currency.Code?, counter: Currency.Code?) async throws -> [Database.Market.Forex] {
+        guard base != nil || counter != nil else { return try await self.getAll() }
+        
+        return try await self._get(base: base, counter: counter).value()
+    }
+}
+#endif
+
+private extension Database.Request.Markets.Forex {
+    /// Database access shared by `getAll()` and its `async` variant.
+    func _getAll() -> Database.Access<String,[Database.Market.Forex]> {
+        self._database.access { _ in "SELECT * FROM \(Database.Market.Forex.tableName)" }
             .read { (sqlite, statement, query) in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 
@@ -29,17 +127,12 @@ extension Database.Request.Markets.Forex {
                     case let e: throw IG.Error._queryFailed(code: e)
                     }
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Discrete publisher returning the markets stored in the database matching the given epics.
-    ///
-    /// Depending on the `expectsAll` argument, this method will return the exact number of market forex or a subset of them.
-    /// - parameter epics: The forex market epics identifiers.
-    /// - parameter expectsAll: Boolean indicating whether an error should be emitted if not all markets are in the database.
-    public func get(epics: Set<IG.Market.Epic>, expectsAll: Bool) -> AnyPublisher<Set<Database.Market.Forex>,IG.Error> {
-        self._database.publisher { _ -> String in
+    /// Database access shared by `get(epics:expectsAll:)` and its `async` variant.
+    func _get(epics: Set<IG.Market.Epic>, expectsAll: Bool) -> Database.Access<String,Set<Database.Market.Forex>> {
+        self._database.access { _ -> String in
                 let values = (1...epics.count).map { "?\($0)" }.joined(separator: ", ")
                 return "SELECT * FROM \(Database.Market.Forex.tableName) WHERE epic IN (\(values))"
             }.read { (sqlite, statement, query) in
@@ -64,16 +157,12 @@ extension Database.Request.Markets.Forex {
                     throw IG.Error._notEnough(epics: epics, numResult: result.count)
                 }
                 return result
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Returns the market stored in the database matching the given epic.
-    ///
-    /// If the market is not in the database, a `.invalidResponse` error will be returned.
-    /// - parameter epic: The forex market epic identifier.
-    public func get(epic: IG.Market.Epic) -> AnyPublisher<Database.Market.Forex,IG.Error> {
-        self._database.publisher { _ in "SELECT * FROM \(Database.Market.Forex.tableName) WHERE epic=?1" }
+    /// Database access shared by `get(epic:)` and its `async` variant.
+    func _get(epic: IG.Market.Epic) -> Database.Access<String,Database.Market.Forex> {
+        self._database.access { _ in "SELECT * FROM \(Database.Market.Forex.tableName) WHERE epic=?1" }
             .read { (sqlite, statement, query) in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
 
@@ -84,15 +173,12 @@ extension Database.Request.Markets.Forex {
                 case .done: throw IG.Error._unfoundRequestValue()
                 case let e: throw IG.Error._queryFailed(code: e)
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Returns the forex markets matching the given currency.
-    /// - parameter currency: A currency used as base or counter in the result markets.
-    /// - parameter otherCurrency: A currency matching the first argument. It is optional.
-    public func get(currency: Currency.Code, _ otherCurrency: Currency.Code? = nil) -> AnyPublisher<[Database.Market.Forex],IG.Error> {
-        self._database.publisher { _ -> (query: String, binds: [(index: Int32, text: Currency.Code)]) in
+    /// Database access shared by `get(currency:_:)` and its `async` variant.
+    func _get(currency: Currency.Code, _ otherCurrency: Currency.Code?) -> Database.Access<(query: String, binds: [(index: Int32, text: Currency.Code)]),[Database.Market.Forex]> {
+        self._database.access { _ -> (query: String, binds: [(index: Int32, text: Currency.Code)]) in
                 var sql = "SELECT * FROM \(Database.Market.Forex.tableName) WHERE "
             
                 var binds: [(index: Int32, text: Currency.Code)] = [(1, currency)]
@@ -118,19 +204,12 @@ extension Database.Request.Markets.Forex {
                     case let e: throw IG.Error._queryFailed(code: e)
                     }
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Returns the forex markets in the database matching the given currencies.
-    ///
-    /// If there are no forex markets matching the given requirements, an empty array will be returned.
-    /// - parameter base: The base currency code (or `nil` if this requirement is not needed).
-    /// - parameter counter: The counter currency code (or `nil` if this requirement is not needed).
-    public func get(base: Currency.Code?, counter: Currency.Code?) -> AnyPublisher<[Database.Market.Forex],IG.Error> {
-        guard base != nil || counter != nil else { return self.getAll() }
-        
-        return self._database.publisher { _ -> (query: String, binds: [(index: Int32, text: Currency.Code)]) in
+    /// Database access shared by `get(base:counter:)` and its `async` variant.
+    func _get(base: Currency.Code?, counter: Currency.Code?) -> Database.Access<(query: String, binds: [(index: Int32, text: Currency.Code)]),[Database.Market.Forex]> {
+        self._database.access { _ -> (query: String, binds: [(index: Int32, text: Currency.Code)]) in
             var sql = "SELECT * FROM \(Database.Market.Forex.tableName) WHERE "
             
             let binds: [(index: Int32, text: Currency.Code)]
@@ -157,10 +236,11 @@ extension Database.Request.Markets.Forex {
                 case let e: throw IG.Error._queryFailed(code: e)
                 }
             }
-        }.mapError(errorCast)
-        .eraseToAnyPublisher()
+        }
     }
+}
 
+extension Database.Request.Markets.Forex {
     /// Updates the database with the information received from the server.
     /// - note: This method is intended to be called from the update of generic markets. That is why, no transaction is performed here, since the parent method will wrap everything in its own transaction.
     /// - precondition: The market must be of currency type or an error will be returned.
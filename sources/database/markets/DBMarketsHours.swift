@@ -0,0 +1,240 @@
+import Combine
+import Foundation
+import SQLite3
+
+extension Database.Request.Markets {
+    /// Contains all functionality related to the markets' trading hours.
+    @frozen public struct Hours {
+        /// Pointer to the actual database instance in charge of the low-level objects.
+        private unowned let _database: Database
+        /// Hidden initializer passing the instance needed to perform the database fetches/updates.
+        @usableFromInline internal init(database: Database) { self._database = database }
+    }
+}
+
+extension Database.Request.Markets.Hours {
+    /// Returns the compiled trading hours of the given markets.
+    ///
+    /// Markets without stored trading hours are simply not part of the result.
+    /// - parameter epics: The market epics identifiers.
+    public func get(epics: Set<IG.Market.Epic>) -> AnyPublisher<[Database.Market.TradingHours],IG.Error> {
+        guard !epics.isEmpty else { return Result.Publisher([]).eraseToAnyPublisher() }
+        return self._get(epics: epics).publisher
+    }
+
+    /// Loads the stored trading hours into an in-memory calendar answering `isOpen(epic:at:)` and `nextOpen(epic:after:)` without touching the database.
+    /// - parameter epics: The market epics identifiers to load. If `nil`, all stored trading hours are loaded.
+    public func calendar(epics: Set<IG.Market.Epic>? = nil) -> AnyPublisher<Database.TradingCalendar,IG.Error> {
+        self._calendar(epics: epics).publisher
+    }
+
+    /// Compiles and stores the opening hours of the given markets.
+    ///
+    /// The market's opening hours are provided by the server as local time ranges (without timezone information); thus, the timezone in which they are expressed must be given explicitly.
+    /// - remark: Markets without opening hours information (or with malformed ones) have their previously stored trading hours deleted.
+    /// - parameter markets: Information returned from the server. The markets must already be stored on the database.
+    /// - parameter timezone: The timezone in which the markets' opening hours are expressed.
+    public func update(_ markets: [API.Market], timezone: TimeZone) -> AnyPublisher<Never,IG.Error> {
+        self._update(markets, timezone: timezone).publisher.ignoreOutput().eraseToAnyPublisher()
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Markets.Hours {
+    /// Returns the compiled trading hours of the given markets.
+    /// - parameter epics: The market epics identifiers.
+    /// - seealso: `get(epics:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func get(epics: Set<IG.Market.Epic>) async throws -> [Database.Market.TradingHours] {
+        guard !epics.isEmpty else { return [] }
+        return try await self._get(epics: epics).value()
+    }
+
+    /// Loads the stored trading hours into an in-memory calendar.
+    /// - parameter epics: The market epics identifiers to load. If `nil`, all stored trading hours are loaded.
+    /// - seealso: `calendar(epics:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func calendar(epics: Set<IG.Market.Epic>? = nil) async throws -> Database.TradingCalendar {
+        try await self._calendar(epics: epics).value()
+    }
+
+    /// Compiles and stores the opening hours of the given markets.
+    /// - parameter markets: Information returned from the server. The markets must already be stored on the database.
+    /// - parameter timezone: The timezone in which the markets' opening hours are expressed.
+    /// - seealso: `update(_:timezone:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(_ markets: [API.Market], timezone: TimeZone) async throws {
+        try await self._update(markets, timezone: timezone).value()
+    }
+}
+#endif
+
+private extension Database.Request.Markets.Hours {
+    /// Database access shared by `get(epics:)` and its `async` variant.
+    func _get(epics: Set<IG.Market.Epic>) -> Database.Access<String,[Database.Market.TradingHours]> {
+        self._database.access { _ -> String in
+                let values = (1...epics.count).map { "?\($0)" }.joined(separator: ", ")
+                return "SELECT * FROM \(Database.Market.TradingHours.tableName) WHERE epic IN (\(values))"
+            }.read { (sqlite, statement, query) in
+                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+
+                for (index, epic) in epics.enumerated() {
+                    try sqlite3_bind_text(statement, Int32(index + 1), epic.description, -1, SQLite.Destructor.transient).expects(.ok) { IG.Error._bindingFailed(code: $0) }
+                }
+                return try Self._select(statement: statement!)
+            }
+    }
+
+    /// Database access shared by `calendar(epics:)` and its `async` variant.
+    func _calendar(epics: Set<IG.Market.Epic>?) -> Database.Access<String,Database.TradingCalendar> {
+        self._database.access { _ -> String in
+                var query = "SELECT * FROM \(Database.Market.TradingHours.tableName)"
+                if let epics = epics, !epics.isEmpty {
+                    query.append(" WHERE epic IN (\((1...epics.count).map { "?\($0)" }.joined(separator: ", ")))")
+                }
+                return query
+            }.read { (sqlite, statement, query) in
+                guard epics.map({ !$0.isEmpty }) ?? true else { return Database.TradingCalendar(hours: []) }
+                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+
+                for (index, epic) in (epics ?? []).enumerated() {
+                    try sqlite3_bind_text(statement, Int32(index + 1), epic.description, -1, SQLite.Destructor.transient).expects(.ok) { IG.Error._bindingFailed(code: $0) }
+                }
+                return Database.TradingCalendar(hours: try Self._select(statement: statement!))
+            }
+    }
+
+    /// Database access shared by `update(_:timezone:)` and its `async` variant.
+    func _update(_ markets: [API.Market], timezone: TimeZone) -> Database.Access<Void,Void> {
+        self._database.access { _ in () }
+            .write { (sqlite, _, _) in try Self.update(markets: markets, timezone: timezone, sqlite: sqlite) }
+    }
+
+    /// Iterates through all the rows of the given (already bound) statement decoding the trading hours.
+    static func _select(statement: SQLite.Statement) throws -> [Database.Market.TradingHours] {
+        var result: [Database.Market.TradingHours] = .init()
+        while true {
+            switch sqlite3_step(statement).result {
+            case .row:
+                guard let hours = Database.Market.TradingHours(statement: statement) else { throw IG.Error._invalidRow() }
+                result.append(hours)
+            case .done: return result
+            case let e: throw IG.Error._queryFailed(code: e)
+            }
+        }
+    }
+}
+
+extension Database.Request.Markets.Hours {
+    /// Compiles and stores the opening hours of the given markets.
+    ///
+    /// Markets without opening hours information (or with malformed opening hours) have their previously stored hours deleted, so stale hours are never queried.
+    /// - note: This method is intended to be called from the update of generic markets. That is why, no transaction is performed here, since the parent method will wrap everything in its own transaction.
+    /// - parameter markets: The markets whose opening hours will be compiled.
+    /// - parameter timezone: The timezone in which the opening hours are expressed. If `nil`, only markets with stored hours are recompiled (in their stored timezone); the rest are skipped since the timezone of their opening hours is unknown.
+    /// - parameter sqlite: SQLite pointer priviledge access.
+    internal static func update(markets: [API.Market], timezone: TimeZone?, sqlite: SQLite.Database) throws {
+        var lookup: SQLite.Statement? = nil, statement: SQLite.Statement? = nil, deletion: SQLite.Statement? = nil
+        defer { sqlite3_finalize(lookup); sqlite3_finalize(statement); sqlite3_finalize(deletion) }
+
+        if timezone == nil {
+            let query = "SELECT timezone FROM \(Database.Market.TradingHours.tableName) WHERE epic=?1"
+            try sqlite3_prepare_v2(sqlite, query, -1, &lookup, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        }
+
+        let query = """
+            INSERT INTO \(Database.Market.TradingHours.tableName) VALUES(?1, ?2, ?3)
+                ON CONFLICT(epic) DO UPDATE SET timezone=excluded.timezone, bitmap=excluded.bitmap
+            """
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        try sqlite3_prepare_v2(sqlite, "DELETE FROM \(Database.Market.TradingHours.tableName) WHERE epic=?1", -1, &deletion, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+
+        for market in markets {
+            let epic = market.instrument.epic
+            let zone: TimeZone
+            if let timezone = timezone {
+                zone = timezone
+            } else {
+                sqlite3_bind_text(lookup, 1, epic.description, -1, SQLite.Destructor.transient)
+                let stored: TimeZone?
+                switch sqlite3_step(lookup).result {
+                case .row:  stored = sqlite3_column_text(lookup, 0).flatMap { TimeZone(identifier: String(cString: $0)) }
+                case .done: stored = nil
+                case let e: throw IG.Error._queryFailed(code: e)
+                }
+                sqlite3_clear_bindings(lookup)
+                sqlite3_reset(lookup)
+                // Guessing a timezone would silently shift the market's opening hours.
+                guard let storedZone = stored else { continue }
+                zone = storedZone
+            }
+
+            if let hours = Database.Market.TradingHours(market: market, timezone: zone) {
+                hours._bind(to: statement!)
+                try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+                sqlite3_clear_bindings(statement)
+                sqlite3_reset(statement)
+            } else {
+                sqlite3_bind_text(deletion, 1, epic.description, -1, SQLite.Destructor.transient)
+                try sqlite3_step(deletion).expects(.done) { IG.Error._storingFailed(code: $0) }
+                sqlite3_clear_bindings(deletion)
+                sqlite3_reset(deletion)
+            }
+        }
+    }
+}
+
+// MARK: -
+
+extension Database {
+    /// In-memory snapshot of the stored trading hours.
+    ///
+    /// All queries are answered without touching the database; thus, the calendar can be consulted from the trading path.
+    public final class TradingCalendar {
+        /// The compiled trading hours indexed by epic.
+        public let hours: [IG.Market.Epic:Database.Market.TradingHours]
+
+        /// Designated initializer.
+        /// - parameter hours: The compiled trading hours (later elements replace earlier elements for the same epic).
+        public init(hours: [Database.Market.TradingHours]) {
+            self.hours = Dictionary(hours.map { ($0.epic, $0) }, uniquingKeysWith: { $1 })
+        }
+
+        /// Returns a Boolean indicating whether the given market is open at the given date.
+        /// - complexity: O(1).
+        /// - returns: Whether the market is open or `nil` if there are no trading hours for the given epic.
+        public func isOpen(epic: IG.Market.Epic, at date: Date) -> Bool? {
+            self.hours[epic]?.isOpen(at: date)
+        }
+
+        /// Returns the moment the given market is next open (or the given date if the market is already open).
+        /// - complexity: O(1).
+        /// - returns: The next opening date or `nil` if there are no trading hours for the given epic (or the market is never open).
+        public func nextOpen(epic: IG.Market.Epic, after date: Date) -> Date? {
+            self.hours[epic]?.nextOpen(after: date)
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when a SQLite command couldn't be compiled.
+    static func _compilationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred trying to compile a SQL statement.", info: ["Error code": code])
+    }
+    /// Error raised when a SQLite binding couldn't take place.
+    static func _bindingFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred binding attributes to a SQL statement.", info: ["Error code": code])
+    }
+    /// Error raised when a SQLite table fails.
+    static func _queryFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred querying the SQLite table.", info: ["Table": Database.Market.TradingHours.self, "Error code": code])
+    }
+    /// Error raised when a stored row cannot be decoded.
+    static func _invalidRow() -> Self {
+        Self(.database(.invalidResponse), "A stored trading hours row couldn't be decoded.", help: "The timezone identifier or the bitmap are malformed. Update the market to recompile its trading hours.")
+    }
+    /// Error raised when storing fails.
+    static func _storingFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred storing values on '\(Database.Market.TradingHours.self)'.", info: ["Error code": code])
+    }
+}
@@ -0,0 +1,27 @@
+import Foundation
+import SQLite3
+
+extension Database.Migration {
+    /// Migration from v3 to v4.
+    ///
+    /// This migration simply add a new (append-only) "order journal" table.
+    /// - parameter channel: The SQLite database connection.
+    /// - throws: `IG.Error` exclusively.
+    internal static func toVersion4(channel: Database.Channel) throws {
+        try channel.write { (database) throws -> Void in
+            /// Create the order journal table.
+            try sqlite3_exec(database, Database.OrderEvent.tableDefinition, nil, nil, nil).expects(.ok) {
+                IG.Error._tableCreationFailed(code: $0)
+            }
+            // Set the new version number.
+            try database.set(version: .v4)
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when a SQLite table cannot be created.
+    static func _tableCreationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "The SQL statement to create an order journal table failed to execute", info: ["Error code": code])
+    }
+}
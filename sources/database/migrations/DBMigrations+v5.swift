@@ -0,0 +1,27 @@
+import Foundation
+import SQLite3
+
+extension Database.Migration {
+    /// Migration from v4 to v5.
+    ///
+    /// This migration simply add a new "market trading hours" table.
+    /// - parameter channel: The SQLite database connection.
+    /// - throws: `IG.Error` exclusively.
+    internal static func toVersion5(channel: Database.Channel) throws {
+        try channel.write { (database) throws -> Void in
+            /// Create the market trading hours table.
+            try sqlite3_exec(database, Database.Market.TradingHours.tableDefinition, nil, nil, nil).expects(.ok) {
+                IG.Error._tableCreationFailed(code: $0)
+            }
+            // Set the new version number.
+            try database.set(version: .v5)
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when a SQLite table cannot be created.
+    static func _tableCreationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "The SQL statement to create a market trading hours table failed to execute", info: ["Error code": code])
+    }
+}
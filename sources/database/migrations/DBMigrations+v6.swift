@@ -0,0 +1,31 @@
+import Foundation
+import SQLite3
+
+extension Database.Migration {
+    /// Migration from v5 to v6.
+    ///
+    /// This migration adds the market contract expirations table and the continuous price series bookkeeping tables.
+    /// - parameter channel: The SQLite database connection.
+    /// - throws: `IG.Error` exclusively.
+    internal static func toVersion6(channel: Database.Channel) throws {
+        try channel.write { (database) throws -> Void in
+            /// Create the contract expirations table.
+            try sqlite3_exec(database, Database.Market.Contract.tableDefinition, nil, nil, nil).expects(.ok) {
+                IG.Error._tableCreationFailed(code: $0)
+            }
+            /// Create the rolls and continuous series state tables.
+            try sqlite3_exec(database, Database.Roll.tableDefinition, nil, nil, nil).expects(.ok) {
+                IG.Error._tableCreationFailed(code: $0)
+            }
+            // Set the new version number.
+            try database.set(version: .v6)
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when a SQLite table cannot be created.
+    static func _tableCreationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "The SQL statement to create a continuous price series table failed to execute", info: ["Error code": code])
+    }
+}
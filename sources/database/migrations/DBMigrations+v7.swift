@@ -0,0 +1,27 @@
+import Foundation
+import SQLite3
+
+extension Database.Migration {
+    /// Migration from v6 to v7.
+    ///
+    /// This migration adds the finished session profiles table.
+    /// - parameter channel: The SQLite database connection.
+    /// - throws: `IG.Error` exclusively.
+    internal static func toVersion7(channel: Database.Channel) throws {
+        try channel.write { (database) throws -> Void in
+            /// Create the session profiles table.
+            try sqlite3_exec(database, Streamer.Profile.tableDefinition, nil, nil, nil).expects(.ok) {
+                IG.Error._tableCreationFailed(code: $0)
+            }
+            // Set the new version number.
+            try database.set(version: .v7)
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when a SQLite table cannot be created.
+    static func _tableCreationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "The SQL statement to create the session profiles table failed to execute", info: ["Error code": code])
+    }
+}
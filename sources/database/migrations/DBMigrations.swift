@@ -37,7 +37,11 @@ private extension Database {
         case .v0: try Database.Migration.toVersion1(channel: self.channel)
         case .v1: try Database.Migration.toVersion2(channel: self.channel)
         case .v2: try Database.Migration.toVersion3(channel: self.channel)
-        case .v3: break
+        case .v3: try Database.Migration.toVersion4(channel: self.channel)
+        case .v4: try Database.Migration.toVersion5(channel: self.channel)
+        case .v5: try Database.Migration.toVersion6(channel: self.channel)
+        case .v6: try Database.Migration.toVersion7(channel: self.channel)
+        case .v7: break
         }
     }
 }
@@ -0,0 +1,195 @@
+import Combine
+import Foundation
+import SQLite3
+
+extension Database.Request {
+    /// Contains all functionality related to the order lifecycle journal.
+    @frozen public struct Journal {
+        /// Pointer to the actual database instance in charge of the low-level objects.
+        private unowned let _database: Database
+        /// Hidden initializer passing the instance needed to perform the database fetches/updates.
+        @usableFromInline internal init(database: Database) { self._database = database }
+    }
+}
+
+extension Database.Request.Journal {
+    /// Returns a writer buffering order events in memory and appending them to the journal in batches.
+    ///
+    /// Recording an event never waits on the database; thus, the writer can be used from the trading path.
+    /// - parameter batchSize: The amount of buffered events triggering a journal write.
+    /// - parameter interval: The maximum amount of seconds an event is kept in memory before being written.
+    public func makeWriter(batchSize: Int = 256, interval: TimeInterval = 1) -> Database.JournalWriter {
+        Database.JournalWriter(database: self._database, batchSize: batchSize, interval: interval)
+    }
+
+    /// Appends the given events to the order journal.
+    ///
+    /// Events are never updated nor deleted; every call adds new rows to the journal.
+    /// - parameter events: The order events to be stored.
+    /// - returns: A publisher that completes successfully (without sending any value) if the operation has been successful.
+    public func append(_ events: [Database.OrderEvent]) -> AnyPublisher<Never,IG.Error> {
+        guard !events.isEmpty else { return Empty().eraseToAnyPublisher() }
+        return self._append(events).publisher
+            .ignoreOutput()
+            .eraseToAnyPublisher()
+    }
+
+    /// Returns the order events recorded during the given time frame (in the order they were appended).
+    /// - parameter from: The date from which to start the query (inclusive). If `nil`, the retrieved data starts with the first ever recorded event.
+    /// - parameter to: The date from which to end the query (inclusive). If `nil`, the retrieved data ends with the last recorded event.
+    /// - returns: The requested order events or an empty array if no event has been recorded for that timeframe.
+    public func get(from: Date? = nil, to: Date? = nil) -> AnyPublisher<[Database.OrderEvent],IG.Error> {
+        self._get(from: from, to: to).publisher
+    }
+
+    /// Analyzes the execution quality of the orders built during the given time frame.
+    ///
+    /// Events are grouped by deal reference and every order is measured against its own lifecycle: slippage of the execution level versus the quote's mid at decision time, latency of every lifecycle stage, and rejection rates by reason.
+    /// - parameter from: The date from which to start the analysis (inclusive). If `nil`, the analysis starts with the first ever recorded event.
+    /// - parameter to: The date from which to end the analysis (inclusive). If `nil`, the analysis ends with the last recorded event.
+    /// - returns: The transaction cost analysis report.
+    public func analyze(from: Date? = nil, to: Date? = nil) -> AnyPublisher<Database.ExecutionReport,IG.Error> {
+        self._analyze(from: from, to: to).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Journal {
+    /// Appends the given events to the order journal.
+    /// - parameter events: The order events to be stored.
+    /// - seealso: `append(_:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func append(_ events: [Database.OrderEvent]) async throws {
+        guard !events.isEmpty else { return }
+        try await self._append(events).value()
+    }
+
+    /// Returns the order events recorded during the given time frame (in the order they were appended).
+    /// - parameter from: The date from which to start the query (inclusive). If `nil`, the retrieved data starts with the first ever recorded event.
+    /// - parameter to: The date from which to end the query (inclusive). If `nil`, the retrieved data ends with the last recorded event.
+    /// - seealso: `get(from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The requested order events or an empty array if no event has been recorded for that timeframe.
+    public func get(from: Date? = nil, to: Date? = nil) async throws -> [Database.OrderEvent] {
+        try await self._get(from: from, to: to).value()
+    }
+
+    /// Analyzes the execution quality of the orders built during the given time frame.
+    /// - parameter from: The date from which to start the analysis (inclusive). If `nil`, the analysis starts with the first ever recorded event.
+    /// - parameter to: The date from which to end the analysis (inclusive). If `nil`, the analysis ends with the last recorded event.
+    /// - seealso: `analyze(from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transaction cost analysis report.
+    public func analyze(from: Date? = nil, to: Date? = nil) async throws -> Database.ExecutionReport {
+        try await self._analyze(from: from, to: to).value()
+    }
+}
+#endif
+
+internal extension Database.Request.Journal {
+    /// Inserts the given events in the order journal.
+    /// - precondition: It must be called within a write transaction.
+    /// - parameter events: The order events to be stored.
+    /// - parameter sqlite: SQLite pointer priviledge access.
+    static func _insert(_ events: [Database.OrderEvent], sqlite: SQLite.Database) throws {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        let query = "INSERT INTO '\(Database.OrderEvent.tableName)' (reference, stage, date, epic, direction, bid, ask, level, dealId, rejection) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10)"
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+
+        for event in events {
+            event._bind(to: statement!)
+            try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+            sqlite3_clear_bindings(statement)
+            sqlite3_reset(statement)
+        }
+    }
+}
+
+private extension Database.Request.Journal {
+    /// Database access shared by `append(_:)` and its `async` variant.
+    func _append(_ events: [Database.OrderEvent]) -> Database.Access<Void,Void> {
+        self._database.access { _ in () }
+            .write { (sqlite, _, _) in try Self._insert(events, sqlite: sqlite) }
+    }
+
+    /// Database access shared by `get(from:to:)` and its `async` variant.
+    func _get(from: Date?, to: Date?) -> Database.Access<String,[Database.OrderEvent]> {
+        self._database.access { _ in try Self._selectionQuery(from: from, to: to, builtWithin: false) }
+            .read { (sqlite, statement, query) in try Self._select(sqlite: sqlite, statement: &statement, query: query, from: from, to: to) }
+    }
+
+    /// Database access shared by `analyze(from:to:)` and its `async` variant.
+    func _analyze(from: Date?, to: Date?) -> Database.Access<String,Database.ExecutionReport> {
+        self._database.access { _ in try Self._selectionQuery(from: from, to: to, builtWithin: true) }
+            .read { (sqlite, statement, query) in
+                Database.ExecutionReport(events: try Self._select(sqlite: sqlite, statement: &statement, query: query, from: from, to: to))
+            }
+    }
+
+    /// Returns the SQL query selecting the events within the given time frame.
+    /// - parameter builtWithin: Boolean indicating whether the time frame applies to the order decisions instead of to the events themselves. If `true`, all events (whenever they happened) of the orders built within the time frame are selected.
+    static func _selectionQuery(from: Date?, to: Date?, builtWithin: Bool) throws -> String {
+        let table = Database.OrderEvent.tableName
+        let condition: String
+        switch (from, to) {
+        case (let from?, let to?):
+            guard from <= to else { throw IG.Error._invalidDates() }
+            condition = "date BETWEEN ?1 AND ?2"
+        case (.some, .none): condition = "date >= ?1"
+        case (.none, .some): condition = "date <= ?1"
+        case (.none, .none): return "SELECT * FROM '\(table)' ORDER BY id ASC"
+        }
+
+        guard builtWithin else { return "SELECT * FROM '\(table)' WHERE \(condition) ORDER BY id ASC" }
+        return """
+            SELECT * FROM '\(table)' WHERE reference IN (
+                SELECT reference FROM '\(table)' WHERE stage = \(Database.OrderEvent.Stage.built.rawValue) AND \(condition)
+            ) ORDER BY id ASC
+            """
+    }
+
+    /// Performs the given selection query and decodes the resulting events.
+    static func _select(sqlite: SQLite.Database, statement: inout SQLite.Statement?, query: String, from: Date?, to: Date?) throws -> [Database.OrderEvent] {
+        // 1. Compile the SQL statement
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        // 2. Add the variables to the statement
+        let microseconds: (Date) -> Int64 = { Int64(($0.timeIntervalSince1970 * 1_000_000).rounded()) }
+        switch (from, to) {
+        case (let from?, let to?): sqlite3_bind_int64(statement, 1, microseconds(from))
+                                   sqlite3_bind_int64(statement, 2, microseconds(to))
+        case (let from?, .none):   sqlite3_bind_int64(statement, 1, microseconds(from))
+        case (.none, let to?):     sqlite3_bind_int64(statement, 1, microseconds(to))
+        case (.none, .none): break
+        }
+        // 3. Retrieve the events
+        var result: [Database.OrderEvent] = []
+        while true {
+            switch sqlite3_step(statement).result {
+            case .row: result.append(Database.OrderEvent(statement: statement!))
+            case .done: return result
+            case let c: throw IG.Error._queryFailed(code: c)
+            }
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when the _from_ and _to_ date interval are invalid.
+    static func _invalidDates() -> Self {
+        Self(.database(.invalidRequest), "The 'from' date must indicate a date before the 'to' date", help: "Read the request documentation and be sure to follow all requirements.")
+    }
+    /// Error raised when a SQLite command couldn't be compiled.
+    static func _compilationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred trying to compile a SQL statement.", info: ["Error code": code])
+    }
+    /// Error raised when a SQLite table fails.
+    static func _queryFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred querying the SQLite table.", info: ["Table": Database.OrderEvent.self, "Error code": code])
+    }
+    /// Error raised when storing fails.
+    static func _storingFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred storing values on '\(Database.OrderEvent.self)'.", info: ["Error code": code])
+    }
+}
@@ -0,0 +1,172 @@
+import Foundation
+import Decimals
+
+extension Database {
+    /// Transaction cost analysis of the orders recorded on the order journal.
+    public struct ExecutionReport {
+        /// The amount of orders (distinct deal references) found.
+        public let orders: Int
+        /// The amount of orders with at least one confirmation (whether accepted or rejected).
+        public let confirmed: Int
+        /// The amount of orders rejected, indexed by rejection reason.
+        public let rejections: [API.Confirmation.Deal.Status.RejectionReason:Int]
+        /// The execution level slippage (in basis points of the decision quote's mid) of the accepted orders with a recorded decision quote.
+        ///
+        /// Positive values indicate an execution worse than the mid (i.e. higher for buys and lower for sells).
+        public let slippage: Distribution?
+        /// The latency distribution of each lifecycle interval (only intervals with measurements are present).
+        public let latencies: [Interval:Distribution]
+
+        /// The fraction of confirmed orders that have been rejected, indexed by rejection reason.
+        public var rejectionRates: [API.Confirmation.Deal.Status.RejectionReason:Double] {
+            guard self.confirmed > 0 else { return [:] }
+            return self.rejections.mapValues { Double($0) / Double(self.confirmed) }
+        }
+    }
+}
+
+extension Database.ExecutionReport {
+    /// The measured lifecycle intervals.
+    public enum Interval: Hashable, CaseIterable {
+        /// From the order decision (`built`) till the request is handed to the network (`sent`).
+        case submission
+        /// From the request being sent till the deal reference is received (`acknowledged`).
+        case acknowledgement
+        /// From the request being sent till the REST confirmation is received.
+        case restConfirmation
+        /// From the request being sent till the streamer confirmation is received.
+        case streamConfirmation
+        /// From the order decision till the first confirmation (whatever its source) is received.
+        case endToEnd
+    }
+
+    /// A distribution of measurements.
+    public struct Distribution {
+        /// The amount of measurements.
+        public let count: Int
+        /// The average value.
+        public let mean: Double
+        /// The median value.
+        public let p50: Double
+        /// The 90th percentile value.
+        public let p90: Double
+        /// The 99th percentile value.
+        public let p99: Double
+        /// The maximum value.
+        public let maximum: Double
+
+        /// Computes the distribution of the given measurements (or returns `nil` if there are none).
+        /// - complexity: O(n log n) where `n` is the number of measurements.
+        fileprivate init?(_ values: [Double]) {
+            guard !values.isEmpty else { return nil }
+            let sorted = values.sorted()
+            func percentile(_ p: Double) -> Double {
+                let index = Swift.min(sorted.count - 1, Int((p * Double(sorted.count)).rounded(.up)) - 1)
+                return sorted[Swift.max(0, index)]
+            }
+            self.count = sorted.count
+            self.mean = sorted.reduce(0, +) / Double(sorted.count)
+            self.p50 = percentile(0.5)
+            self.p90 = percentile(0.9)
+            self.p99 = percentile(0.99)
+            self.maximum = sorted.last!
+        }
+    }
+}
+
+// MARK: -
+
+internal extension Database.ExecutionReport {
+    /// Analyzes the given journal events.
+    /// - parameter events: The journal events (in the order they were appended).
+    /// - complexity: O(n log n) where `n` is the number of events.
+    init(events: [Database.OrderEvent]) {
+        var orders: [IG.Deal.Reference:_Lifecycle] = [:]
+        var references: [IG.Deal.Reference] = []
+        for event in events {
+            if orders[event.reference] == nil { references.append(event.reference) }
+            orders[event.reference, default: _Lifecycle()].record(event)
+        }
+
+        var latencies: [Interval:[Double]] = [:]
+        var slippages: [Double] = []
+        var rejections: [API.Confirmation.Deal.Status.RejectionReason:Int] = [:]
+        var confirmed = 0
+
+        for reference in references {
+            let order = orders[reference]!
+            func measure(_ interval: Interval, from start: Database.OrderEvent?, to end: Database.OrderEvent?) {
+                guard let start = start, let end = end else { return }
+                latencies[interval, default: []].append(end.date.timeIntervalSince(start.date))
+            }
+
+            let confirmation = order.confirmation
+            measure(.submission, from: order.built, to: order.sent)
+            measure(.acknowledgement, from: order.sent, to: order.acknowledged)
+            measure(.restConfirmation, from: order.sent, to: order.restConfirmation)
+            measure(.streamConfirmation, from: order.sent, to: order.streamConfirmation)
+            measure(.endToEnd, from: order.built, to: confirmation)
+
+            guard let outcome = confirmation else { continue }
+            confirmed += 1
+            if let reason = outcome.rejection {
+                rejections[reason, default: 0] += 1
+            } else if let slippage = order.slippage {
+                slippages.append(slippage)
+            }
+        }
+
+        self.orders = references.count
+        self.confirmed = confirmed
+        self.rejections = rejections
+        self.slippage = Distribution(slippages)
+        self.latencies = latencies.compactMapValues { Distribution($0) }
+    }
+}
+
+/// The first event recorded for each lifecycle stage of a single order.
+private struct _Lifecycle {
+    private(set) var built: Database.OrderEvent?
+    private(set) var sent: Database.OrderEvent?
+    private(set) var acknowledged: Database.OrderEvent?
+    private(set) var restConfirmation: Database.OrderEvent?
+    private(set) var streamConfirmation: Database.OrderEvent?
+
+    /// Records the given event (unless an earlier event for the same stage has already been recorded).
+    mutating func record(_ event: Database.OrderEvent) {
+        func keep(_ stored: inout Database.OrderEvent?) {
+            guard let previous = stored else { return stored = event }
+            if event.date < previous.date { stored = event }
+        }
+
+        switch event.stage {
+        case .built: keep(&self.built)
+        case .sent: keep(&self.sent)
+        case .acknowledged: keep(&self.acknowledged)
+        case .confirmedREST: keep(&self.restConfirmation)
+        case .confirmedStream: keep(&self.streamConfirmation)
+        }
+    }
+
+    /// The earliest confirmation received (whatever its source).
+    var confirmation: Database.OrderEvent? {
+        switch (self.restConfirmation, self.streamConfirmation) {
+        case (let rest?, let stream?): return (stream.date < rest.date) ? stream : rest
+        case (let rest?, .none): return rest
+        case (.none, let stream?): return stream
+        case (.none, .none): return nil
+        }
+    }
+
+    /// The slippage (in basis points of the decision quote's mid) of the execution level or `nil` if it cannot be computed.
+    var slippage: Double? {
+        guard let quote = self.built?.quote,
+              let direction = self.built?.direction ?? self.confirmation?.direction,
+              let level = self.restConfirmation?.level ?? self.streamConfirmation?.level else { return nil }
+
+        let mid = quote.bid + Decimal64(5, power: -1).unsafelyUnwrapped * (quote.ask - quote.bid)
+        guard mid > .zero else { return nil }
+        let difference = (direction == .buy) ? level - mid : mid - level
+        return Double((difference / mid).description).map { $0 * 10_000 }
+    }
+}
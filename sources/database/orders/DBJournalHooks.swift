@@ -0,0 +1,215 @@
+import Combine
+import Foundation
+import Decimals
+
+extension API.Request.Deals {
+    /// Returns a proxy over the deal endpoints recording the lifecycle of every deal call on the given journal writer.
+    /// - parameter writer: The writer buffering the order events.
+    public func journaled(on writer: Database.JournalWriter) -> Database.JournaledDeals {
+        Database.JournaledDeals(deals: self, writer: writer)
+    }
+}
+
+extension Database {
+    /// Proxy over the deal endpoints recording the `built`, `sent`, `acknowledged`, and `confirmedREST` steps of every call on an order journal.
+    ///
+    /// Positions and working orders are always sent with a deal reference (a unique one is generated if none is given), so all their events are linked from the start.
+    /// Calls for which the server generates the reference (i.e. closing positions and deleting working orders) have their `built` and `sent` steps recorded once the reference is received (with the dates they actually happened).
+    /// All dates are taken from the API's clock.
+    public struct JournaledDeals {
+        /// The proxied deal endpoints.
+        private let _deals: API.Request.Deals
+        /// The writer buffering the order events.
+        public let writer: Database.JournalWriter
+
+        /// Hidden initializer passing the proxied endpoints and the journal writer.
+        internal init(deals: API.Request.Deals, writer: Database.JournalWriter) {
+            self._deals = deals
+            self.writer = writer
+        }
+
+        /// Creates a new position and journals its lifecycle.
+        ///
+        /// The rest of the parameters are the same as for `API.Request.Deals.createPosition(reference:epic:expiry:currency:direction:order:strategy:size:limit:stop:forceOpen:)`.
+        /// - parameter reference: A user-defined reference identifying the order. If `nil`, a unique reference is generated.
+        /// - parameter quote: The market quote at decision time (against which slippage is measured).
+        /// - returns: Publisher forwarding the transient deal reference (for an unconfirmed trade).
+        public func createPosition(reference: IG.Deal.Reference? = nil, quote: (bid: Decimal64, ask: Decimal64)?, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code?, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.Position.Stop?, forceOpen: Bool = true) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
+            let (deals, reference) = (self._deals, reference ?? Self.makeReference())
+            return self._journal(reference: reference, epic: epic, direction: direction, quote: quote) {
+                deals.createPosition(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, order: order, strategy: strategy, size: size, limit: limit, stop: stop, forceOpen: forceOpen)
+            }
+        }
+
+        /// Creates a new working order and journals its lifecycle.
+        ///
+        /// The rest of the parameters are the same as for `API.Request.Deals.createWorkingOrder(reference:epic:expiry:currency:direction:type:expiration:size:level:limit:stop:forceOpen:)`.
+        /// - parameter reference: A user-defined reference identifying the order. If `nil`, a unique reference is generated.
+        /// - parameter quote: The market quote at decision time (against which slippage is measured).
+        /// - returns: Publisher forwarding the transient deal reference (for an unconfirmed trade).
+        public func createWorkingOrder(reference: IG.Deal.Reference? = nil, quote: (bid: Decimal64, ask: Decimal64)?, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool = true) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
+            let (deals, reference) = (self._deals, reference ?? Self.makeReference())
+            return self._journal(reference: reference, epic: epic, direction: direction, quote: quote) {
+                deals.createWorkingOrder(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, type: type, expiration: expiration, size: size, level: level, limit: limit, stop: stop, forceOpen: forceOpen)
+            }
+        }
+
+        /// Closes one or more positions and journals the call lifecycle.
+        ///
+        /// The rest of the parameters are the same as for `API.Request.Deals.closePosition(matchedBy:direction:order:strategy:size:)`.
+        /// - parameter quote: The market quote at decision time (against which slippage is measured).
+        /// - returns: Publisher forwarding the transient deal reference (for an unconfirmed trade).
+        public func closePosition(quote: (bid: Decimal64, ask: Decimal64)?, matchedBy identification: API.Request.Deals.Identification, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
+            let deals = self._deals
+            return self._journal(reference: nil, epic: nil, direction: direction, quote: quote) {
+                deals.closePosition(matchedBy: identification, direction: direction, order: order, strategy: strategy, size: size)
+            }
+        }
+
+        /// Deletes a working order and journals the call lifecycle.
+        /// - parameter id: A permanent deal reference for a confirmed working order.
+        /// - returns: Publisher forwarding the deal reference.
+        public func deleteWorkingOrder(id: IG.Deal.Identifier) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
+            let deals = self._deals
+            return self._journal(reference: nil, epic: nil, direction: nil, quote: nil) {
+                deals.deleteWorkingOrder(id: id)
+            }
+        }
+
+        /// Returns a deal confirmation for the given deal reference and journals it as a `confirmedREST` step.
+        /// - parameter reference: Temporary targeted deal reference.
+        public func getConfirmation(reference: IG.Deal.Reference) -> AnyPublisher<API.Confirmation,IG.Error> {
+            let (clock, writer) = (self._deals.api.clock, self.writer)
+            return self._deals.getConfirmation(reference: reference)
+                .handleEvents(receiveOutput: { writer.record(.confirmed($0, date: clock.now)) })
+                .eraseToAnyPublisher()
+        }
+
+        /// Generates a unique deal reference (30 characters long) to link the journaled events of an order.
+        public static func makeReference() -> IG.Deal.Reference {
+            let hexadecimal = UUID().uuidString.filter { $0 != "-" }
+            return IG.Deal.Reference("J" + hexadecimal.prefix(29))!
+        }
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.JournaledDeals {
+    /// Creates a new position and journals its lifecycle.
+    /// - seealso: `createPosition(reference:quote:epic:expiry:currency:direction:order:strategy:size:limit:stop:forceOpen:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func createPosition(reference: IG.Deal.Reference? = nil, quote: (bid: Decimal64, ask: Decimal64)?, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code?, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.Position.Stop?, forceOpen: Bool = true) async throws -> IG.Deal.Reference {
+        let (deals, reference) = (self._deals, reference ?? Self.makeReference())
+        return try await self._journal(reference: reference, epic: epic, direction: direction, quote: quote) {
+            try await deals.createPosition(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, order: order, strategy: strategy, size: size, limit: limit, stop: stop, forceOpen: forceOpen)
+        }
+    }
+
+    /// Creates a new working order and journals its lifecycle.
+    /// - seealso: `createWorkingOrder(reference:quote:epic:expiry:currency:direction:type:expiration:size:level:limit:stop:forceOpen:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func createWorkingOrder(reference: IG.Deal.Reference? = nil, quote: (bid: Decimal64, ask: Decimal64)?, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool = true) async throws -> IG.Deal.Reference {
+        let (deals, reference) = (self._deals, reference ?? Self.makeReference())
+        return try await self._journal(reference: reference, epic: epic, direction: direction, quote: quote) {
+            try await deals.createWorkingOrder(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, type: type, expiration: expiration, size: size, level: level, limit: limit, stop: stop, forceOpen: forceOpen)
+        }
+    }
+
+    /// Closes one or more positions and journals the call lifecycle.
+    /// - seealso: `closePosition(quote:matchedBy:direction:order:strategy:size:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The transient deal reference (for an unconfirmed trade).
+    public func closePosition(quote: (bid: Decimal64, ask: Decimal64)?, matchedBy identification: API.Request.Deals.Identification, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64) async throws -> IG.Deal.Reference {
+        let deals = self._deals
+        return try await self._journal(reference: nil, epic: nil, direction: direction, quote: quote) {
+            try await deals.closePosition(matchedBy: identification, direction: direction, order: order, strategy: strategy, size: size)
+        }
+    }
+
+    /// Deletes a working order and journals the call lifecycle.
+    /// - seealso: `deleteWorkingOrder(id:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The deal reference.
+    public func deleteWorkingOrder(id: IG.Deal.Identifier) async throws -> IG.Deal.Reference {
+        let deals = self._deals
+        return try await self._journal(reference: nil, epic: nil, direction: nil, quote: nil) {
+            try await deals.deleteWorkingOrder(id: id)
+        }
+    }
+
+    /// Returns a deal confirmation for the given deal reference and journals it as a `confirmedREST` step.
+    /// - seealso: `getConfirmation(reference:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The confirmation of the targeted deal.
+    public func getConfirmation(reference: IG.Deal.Reference) async throws -> API.Confirmation {
+        let confirmation = try await self._deals.getConfirmation(reference: reference)
+        self.writer.record(.confirmed(confirmation, date: self._deals.api.clock.now))
+        return confirmation
+    }
+}
+
+private extension Database.JournaledDeals {
+    /// Journals the lifecycle steps of the given deal call (`async` variant).
+    /// - parameter reference: The reference sent with the call or `nil` if the server generates it.
+    /// - parameter call: The deal call.
+    func _journal(reference: IG.Deal.Reference?, epic: IG.Market.Epic?, direction: IG.Deal.Direction?, quote: (bid: Decimal64, ask: Decimal64)?, call: () async throws -> IG.Deal.Reference) async throws -> IG.Deal.Reference {
+        let (clock, writer) = (self._deals.api.clock, self.writer)
+        let built = clock.now
+        if let reference = reference {
+            writer.record(.init(reference: reference, stage: .built, date: built, epic: epic, direction: direction, quote: quote))
+            writer.record(.sent(reference: reference, date: clock.now))
+            let acknowledged = try await call()
+            writer.record(.acknowledged(reference: acknowledged, date: clock.now))
+            return acknowledged
+        } else {
+            let sent = clock.now
+            let acknowledged = try await call()
+            let date = clock.now
+            writer.record(.init(reference: acknowledged, stage: .built, date: built, epic: epic, direction: direction, quote: quote))
+            writer.record(.sent(reference: acknowledged, date: sent))
+            writer.record(.acknowledged(reference: acknowledged, date: date))
+            return acknowledged
+        }
+    }
+}
+#endif
+
+private extension Database.JournaledDeals {
+    /// Journals the lifecycle steps of the given deal call.
+    ///
+    /// The `built` date is taken when this function is called, the `sent` date when the call is subscribed to, and the `acknowledged` date when the deal reference is received.
+    /// - parameter reference: The reference sent with the call or `nil` if the server generates it.
+    /// - parameter call: Closure generating the deal call publisher.
+    func _journal(reference: IG.Deal.Reference?, epic: IG.Market.Epic?, direction: IG.Deal.Direction?, quote: (bid: Decimal64, ask: Decimal64)?, call: @escaping () -> AnyPublisher<IG.Deal.Reference,IG.Error>) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
+        let (clock, writer) = (self._deals.api.clock, self.writer)
+        let built = clock.now
+
+        return Deferred { () -> AnyPublisher<IG.Deal.Reference,IG.Error> in
+            var sent: Date? = nil
+            return call().handleEvents(receiveSubscription: { _ in
+                sent = clock.now
+                guard let reference = reference else { return }
+                writer.record(.init(reference: reference, stage: .built, date: built, epic: epic, direction: direction, quote: quote))
+                writer.record(.sent(reference: reference, date: sent!))
+            }, receiveOutput: { (acknowledged) in
+                let date = clock.now
+                if reference == nil {
+                    writer.record(.init(reference: acknowledged, stage: .built, date: built, epic: epic, direction: direction, quote: quote))
+                    writer.record(.sent(reference: acknowledged, date: sent ?? built))
+                }
+                writer.record(.acknowledged(reference: acknowledged, date: date))
+            }).eraseToAnyPublisher()
+        }.eraseToAnyPublisher()
+    }
+}
+
+extension Publisher where Output==Streamer.Confirmation {
+    /// Records every confirmation received from upstream as a `confirmedStream` step on the given journal writer.
+    /// - parameter writer: The writer buffering the order events.
+    /// - parameter clock: The clock providing the reception dates (it should be the one used to journal the deal calls).
+    public func journal(on writer: Database.JournalWriter, clock: Clock = SystemClock.shared) -> Publishers.HandleEvents<Self> {
+        self.handleEvents(receiveOutput: { writer.record(.confirmed($0, date: clock.now)) })
+    }
+}
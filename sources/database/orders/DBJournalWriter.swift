@@ -0,0 +1,112 @@
+import Combine
+import Foundation
+
+extension Database {
+    /// Buffers order events in memory and appends them to the order journal in batches.
+    ///
+    /// `record(_:)` only takes a lock and appends to an in-memory buffer; the journal write is performed asynchronously on the database queue once `batchSize` events have been buffered or `interval` seconds have passed.
+    /// Buffered events are written one last time when the writer is deinitialized (as long as the database is still alive).
+    public final class JournalWriter {
+        /// The database storing the journal.
+        private weak var _database: Database?
+        /// The amount of buffered events triggering a journal write.
+        public let batchSize: Int
+        /// The lock restricting access to the buffer.
+        private let _lock: UnfairLock
+        /// The events waiting to be written.
+        private var _buffer: [Database.OrderEvent]
+        /// The periodic flush timer.
+        private var _timer: Cancellable?
+        /// Subject forwarding the errors of the automatic (batched or periodic) writes.
+        private let _errors: PassthroughSubject<IG.Error,Never>
+
+        /// Designated initializer.
+        /// - parameter database: The database storing the journal.
+        /// - parameter batchSize: The amount of buffered events triggering a journal write.
+        /// - parameter interval: The maximum amount of seconds an event is kept in memory before being written.
+        internal init(database: Database, batchSize: Int, interval: TimeInterval) {
+            self._database = database
+            self.batchSize = Swift.max(1, batchSize)
+            self._lock = UnfairLock()
+            self._buffer = []
+            self._buffer.reserveCapacity(self.batchSize)
+            self._errors = PassthroughSubject()
+
+            let queue = DispatchQueue(label: IG.identifier + ".database.journal", qos: .utility)
+            let period = DispatchQueue.SchedulerTimeType.Stride(.milliseconds(Int(Swift.max(0.001, interval) * 1_000)))
+            self._timer = queue.schedule(after: queue.now.advanced(by: period), interval: period) { [weak self] in
+                guard let self = self else { return }
+                self._write(self._drain())
+            }
+        }
+
+        deinit {
+            self._timer?.cancel()
+            self._write(self._drain())
+            self._errors.send(completion: .finished)
+            self._lock.invalidate()
+        }
+
+        /// Publisher forwarding the errors of the automatic (batched or periodic) journal writes.
+        ///
+        /// The events of a failed write are discarded.
+        public var errors: AnyPublisher<IG.Error,Never> {
+            self._errors.eraseToAnyPublisher()
+        }
+
+        /// Buffers the given event; the journal write is triggered asynchronously if the buffer is full.
+        /// - parameter event: The order event to be recorded.
+        public func record(_ event: Database.OrderEvent) {
+            self._lock.lock()
+            self._buffer.append(event)
+            guard self._buffer.count >= self.batchSize else { return self._lock.unlock() }
+            let events = self._buffer
+            self._buffer.removeAll(keepingCapacity: true)
+            self._lock.unlock()
+            self._write(events)
+        }
+
+        /// Writes all buffered events to the journal right away.
+        /// - returns: A publisher that completes successfully (without sending any value) once the buffered events have been written. The buffer is emptied on subscription.
+        public func flush() -> AnyPublisher<Never,IG.Error> {
+            Deferred { [weak self] () -> AnyPublisher<Never,IG.Error> in
+                guard let self = self else { return Empty().eraseToAnyPublisher() }
+                let events = self._drain()
+                guard let database = self._database else {
+                    guard events.isEmpty else { return Fail(error: IG.Error._deallocatedDB()).eraseToAnyPublisher() }
+                    return Empty().eraseToAnyPublisher()
+                }
+                return database.journal.append(events)
+            }.eraseToAnyPublisher()
+        }
+
+        /// Empties the buffer returning the events it held.
+        private func _drain() -> [Database.OrderEvent] {
+            self._lock.lock()
+            defer { self._lock.unlock() }
+            guard !self._buffer.isEmpty else { return [] }
+            let events = self._buffer
+            self._buffer.removeAll(keepingCapacity: true)
+            return events
+        }
+
+        /// Writes the given events to the journal asynchronously (forwarding any error through `errors`).
+        private func _write(_ events: [Database.OrderEvent]) {
+            guard !events.isEmpty, let database = self._database else { return }
+            let subject = self._errors
+            database.channel.writeAsync(promise: {
+                guard case .failure(let error) = $0 else { return }
+                subject.send(error)
+            }, on: nil) { (sqlite) in
+                try Database.Request.Journal._insert(events, sqlite: sqlite)
+            }
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when the DB instance is deallocated.
+    static func _deallocatedDB() -> Self {
+        Self(.database(.sessionExpired), "The DB instance has been deallocated.", help: "The DB functionality is asynchronous. Keep around the API instance while the request/response is being processed.")
+    }
+}
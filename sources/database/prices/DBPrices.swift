@@ -10,6 +10,9 @@ extension Database.Request {
         private unowned let _database: Database
         /// Hidden initializer passing the instance needed to perform the database fetches/updates.
         @usableFromInline internal init(database: Database) { self._database = database }
+        
+        /// It holds data and functionality related to continuous (stitched) price series of expiring markets.
+        public var continuous: Database.Request.Prices.Continuous { .init(database: self._database) }
     }
 }
 
@@ -20,7 +23,223 @@ extension Database.Request.Prices {
     /// - parameter to: The date from which to end the query. If `nil`, the date at the end of the database is assumed.
     /// - returns: The dates under which there are prices or an empty array if no data has been previously stored for that timeframe.
     public func getAvailableDates(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) -> AnyPublisher<[Date],IG.Error> {
-        self._database.publisher { _ -> (tableName: String, query: String) in
+        self._getAvailableDates(epic: epic, from: from, to: to).publisher
+    }
+    
+    /// Returns the first available date for which there are prices stored in the database.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - returns: The date furthest in the past stored in the database.
+    public func getFirstDate(epic: IG.Market.Epic) -> AnyPublisher<Date?,IG.Error> {
+        self._getFirstDate(epic: epic).publisher
+    }
+    
+    /// Returns the last available date for which there are prices stored in the database.
+    /// - warning: The table existance is not check before using this method.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - returns: The date from "newest" date stored in the database. If `nil`, no price points are for the given table.
+    public func getLastDate(epic: IG.Market.Epic) -> AnyPublisher<Date?,IG.Error> {
+        self._getLastDate(epic: epic).publisher
+    }
+    
+    /// Returns the number of price points for the given date interval.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query. If `nil`, the date at the beginning of the database is assumed.
+    /// - parameter to: The date from which to end the query. If `nil`, the date at the end of the database is assumed.
+    public func count(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) -> AnyPublisher<Int,IG.Error> {
+        self._count(epic: epic, from: from, to: to).publisher
+    }
+}
+
+extension Database.Request.Prices {
+    /// Returns historical prices for a particular instrument.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query (included). If `nil`, the retrieved data starts with the first ever recorded price.
+    /// - parameter to: The date at which to end the query (included). If `nil`, the retrieved data ends with the last recorded price.
+    /// - returns: The requested price points or an empty array if no data has been previously stored for that timeframe.
+    public func get(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) -> AnyPublisher<[Database.Price],IG.Error> {
+        self._get(epic: epic, from: from, to: to).publisher
+    }
+    
+    /// Returns the most recent stored prices for a particular instrument (sorted by date).
+    /// - parameter count: The maximum amount of prices to retrieve.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to consider prices (included). If `nil`, all stored prices are considered.
+    /// - returns: The last `count` price points (or less if not enough have been stored) or an empty array if no data has been previously stored.
+    public func getLast(_ count: Int, epic: IG.Market.Epic, from: Date? = nil) -> AnyPublisher<[Database.Price],IG.Error> {
+        self._getLast(count, epic: epic, from: from).publisher
+    }
+    
+    /// Returns the first price starting from a given date to an optional end date (or the last stored price) which matches the buying or selling price.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query.
+    /// - parameter to: The date from which to end the query. If `nil`, all prices from `from` to the end available prices will be searched.
+    /// - parameter buying: The buying price at which to match the price.
+    /// - parameter selling: The selling price at which to match the price.
+    /// - returns: A signal with price point matching the closure as value.
+    public func first(epic: IG.Market.Epic, from: Date, to: Date?, buying: Decimal64, selling: Decimal64) -> AnyPublisher<Database.Price?,IG.Error> {
+        self._first(epic: epic, from: from, to: to, buying: buying, selling: selling).publisher
+    }
+    
+    /// Creates a replay source emitting the stored prices of one or many markets in time order, shaped as streamed chart candles.
+    ///
+    /// Strategies consuming `Streamer.Chart.Aggregated` publishers may run unchanged against the stored history.
+    /// - parameter epics: Instruments' epics (such as `CS.D.EURUSD.MINI.IP`) to replay.
+    /// - parameter from: The date from which to start the replay (included). If `nil`, the replay starts with the first recorded price.
+    /// - parameter to: The date at which to end the replay (included). If `nil`, the replay ends with the last recorded price.
+    /// - parameter speed: The pace at which prices are emitted in relation to the wall clock.
+    /// - parameter interval: The interval assigned to the emitted candles (it should match the resolution of the stored prices).
+    /// - parameter batchSize: The number of prices read ahead (per epic) on every database access.
+    /// - parameter clock: Virtual clock advanced to the date of every price right before it is emitted (e.g. the clock injected on the services consuming the replay).
+    /// - returns: A replay source. The replay starts once its `publisher` is subscribed to.
+    public func replay(epics: Set<IG.Market.Epic>, from: Date? = nil, to: Date? = nil, speed: Database.Replay.Speed = .maximum, interval: Streamer.Chart.Aggregated.Interval = .minute, batchSize: Int = 1_000, clock: VirtualClock? = nil) -> Database.Replay {
+        Database.Replay(database: self._database, epics: epics, from: from, to: to, speed: speed, interval: interval, batchSize: batchSize, clock: clock)
+    }
+}
+
+extension Database.Request.Prices {
+    /// Updates the database with the information received from the server.
+    /// - note: The market must be in the database before storing its price points.
+    /// - parameter prices: The array of price points that have arrived from the server.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - returns: A publisher that completes successfully (without sending any value) if the operation has been successful.
+    public func update(_ prices: [API.Price], epic: IG.Market.Epic) -> AnyPublisher<Never,IG.Error> {
+        guard !prices.isEmpty else { return Empty().eraseToAnyPublisher() }
+        
+        return self._update(prices, epic: epic).publisher.ignoreOutput().eraseToAnyPublisher()
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Prices {
+    /// Returns all dates for which there are prices stored in the database.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query. If `nil`, the date at the beginning of the database is assumed.
+    /// - parameter to: The date from which to end the query. If `nil`, the date at the end of the database is assumed.
+    /// - seealso: `getAvailableDates(epic:from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The dates under which there are prices or an empty array if no data has been previously stored for that timeframe.
+    public func getAvailableDates(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) async throws -> [Date] {
+        try await self._getAvailableDates(epic: epic, from: from, to: to).value()
+    }
+    
+    /// Returns the first available date for which there are prices stored in the database.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - seealso: `getFirstDate(epic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The date furthest in the past stored in the database.
+    public func getFirstDate(epic: IG.Market.Epic) async throws -> Date? {
+        try await self._getFirstDate(epic: epic).value()
+    }
+    
+    /// Returns the last available date for which there are prices stored in the database.
+    /// - warning: The table existance is not check before using this method.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - seealso: `getLastDate(epic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The date from "newest" date stored in the database. If `nil`, no price points are for the given table.
+    public func getLastDate(epic: IG.Market.Epic) async throws -> Date? {
+        try await self._getLastDate(epic: epic).value()
+    }
+    
+    /// Returns the number of price points for the given date interval.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query. If `nil`, the date at the beginning of the database is assumed.
+    /// - parameter to: The date from which to end the query. If `nil`, the date at the end of the database is assumed.
+    /// - seealso: `count(epic:from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func count(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) async throws -> Int {
+        try await self._count(epic: epic, from: from, to: to).value()
+    }
+    
+    /// Returns historical prices for a particular instrument.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query (included). If `nil`, the retrieved data starts with the first ever recorded price.
+    /// - parameter to: The date at which to end the query (included). If `nil`, the retrieved data ends with the last recorded price.
+    /// - seealso: `get(epic:from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The requested price points or an empty array if no data has been previously stored for that timeframe.
+    public func get(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) async throws -> [Database.Price] {
+        try await self._get(epic: epic, from: from, to: to).value()
+    }
+    
+    /// Returns the most recent stored prices for a particular instrument (sorted by date).
+    /// - parameter count: The maximum amount of prices to retrieve.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to consider prices (included). If `nil`, all stored prices are considered.
+    /// - seealso: `getLast(_:epic:from:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The last `count` price points (or less if not enough have been stored) or an empty array if no data has been previously stored.
+    public func getLast(_ count: Int, epic: IG.Market.Epic, from: Date? = nil) async throws -> [Database.Price] {
+        try await self._getLast(count, epic: epic, from: from).value()
+    }
+    
+    /// Returns the historical prices for a particular instrument as an asynchronous sequence.
+    ///
+    /// The sequence behaves as a database cursor: prices are read in batches of `batchSize` elements and the following batch is only read once the consumer has iterated through the previous one; thus, arbitrarily long histories can be iterated with bounded memory.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query (included). If `nil`, the retrieved data starts with the first ever recorded price.
+    /// - parameter to: The date at which to end the query (included). If `nil`, the retrieved data ends with the last recorded price.
+    /// - parameter batchSize: The number of prices read on every database access.
+    /// - seealso: `get(epic:from:to:)` (single access variant).
+    /// - returns: Asynchronous sequence of price points in date order.
+    public func getCursor(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil, batchSize: Int = 1_000) -> AsyncThrowingStream<Database.Price,Swift.Error> {
+        let batchSize = Swift.max(batchSize, 1)
+        let database: () -> Database? = { [weak database = self._database] in database }
+        /// The prices read in the last batch and the index of the next price to be returned.
+        var (buffer, index): ([Database.Price], Int) = ([], 0)
+        /// Boolean indicating whether the last batch has been read.
+        var isExhausted = false
+        
+        return AsyncThrowingStream(unfolding: {
+            if index == buffer.count {
+                guard !isExhausted else { return nil }
+                do {
+                    let db = try database() ?> IG.Error._deallocatedDB()
+                    buffer = try await db.prices._getBatch(epic: epic, after: buffer.last?.date, from: from, to: to, limit: batchSize).value()
+                } catch let error {
+                    isExhausted = true
+                    throw error
+                }
+                index = 0
+                isExhausted = buffer.count < batchSize
+                guard !buffer.isEmpty else { return nil }
+            }
+            
+            defer { index += 1 }
+            return buffer[index]
+        })
+    }
+    
+    /// Returns the first price starting from a given date to an optional end date (or the last stored price) which matches the buying or selling price.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query.
+    /// - parameter to: The date from which to end the query. If `nil`, all prices from `from` to the end available prices will be searched.
+    /// - parameter buying: The buying price at which to match the price.
+    /// - parameter selling: The selling price at which to match the price.
+    /// - seealso: `first(epic:from:to:buying:selling:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func first(epic: IG.Market.Epic, from: Date, to: Date?, buying: Decimal64, selling: Decimal64) async throws -> Database.Price? {
+        try await self._first(epic: epic, from: from, to: to, buying: buying, selling: selling).value()
+    }
+    
+    /// Updates the database with the information received from the server.
+    /// - note: The market must be in the database before storing its price points.
+    /// - parameter prices: The array of price points that have arrived from the server.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - seealso: `update(_:epic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(_ prices: [API.Price], epic: IG.Market.Epic) async throws {
+        guard !prices.isEmpty else { return }
+        
+        try await self._update(prices, epic: epic).value()
+    }
+}
+#endif
+
+private extension Database.Request.Prices {
+    /// Database access shared by `getAvailableDates(epic:from:to:)` and its `async` variant.
+    func _getAvailableDates(epic: IG.Market.Epic, from: Date?, to: Date?) -> Database.Access<(tableName: String, query: String),[Date]> {
+        self._database.access { _ -> (tableName: String, query: String) in
             let tableName = Database.Price.tableNamePrefix.appending(epic.description)
             var query = "SELECT date FROM '\(tableName)'"
             switch (from, to) {
@@ -57,15 +276,12 @@ extension Database.Request.Prices {
                 case let c: throw IG.Error._queryFailed(code: c)
                 }
             }
-        }.mapError(errorCast)
-        .eraseToAnyPublisher()
+        }
     }
     
-    /// Returns the first available date for which there are prices stored in the database.
-    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
-    /// - returns: The date furthest in the past stored in the database.
-    public func getFirstDate(epic: IG.Market.Epic) -> AnyPublisher<Date?,IG.Error> {
-        self._database.publisher { _  in "SELECT MIN(date) FROM '\(Database.Price.tableNamePrefix.appending(epic.description))'" }
+    /// Database access shared by `getFirstDate(epic:)` and its `async` variant.
+    func _getFirstDate(epic: IG.Market.Epic) -> Database.Access<String,Date?> {
+        self._database.access { _  in "SELECT MIN(date) FROM '\(Database.Price.tableNamePrefix.appending(epic.description))'" }
             .read { (sqlite, statement, query) in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 switch sqlite3_step(statement).result {
@@ -73,16 +289,12 @@ extension Database.Request.Prices {
                 case .done: return nil
                 case let c: throw IG.Error._queryFailed(code: c)
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Returns the last available date for which there are prices stored in the database.
-    /// - warning: The table existance is not check before using this method.
-    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
-    /// - returns: The date from "newest" date stored in the database. If `nil`, no price points are for the given table.
-    public func getLastDate(epic: IG.Market.Epic) -> AnyPublisher<Date?,IG.Error> {
-        self._database.publisher { _ in "SELECT MAX(date) FROM '\(Database.Price.tableNamePrefix.appending(epic.description))'" }
+    /// Database access shared by `getLastDate(epic:)` and its `async` variant.
+    func _getLastDate(epic: IG.Market.Epic) -> Database.Access<String,Date?> {
+        self._database.access { _ in "SELECT MAX(date) FROM '\(Database.Price.tableNamePrefix.appending(epic.description))'" }
             .read { (sqlite, statement, query) in
                 try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
                 switch sqlite3_step(statement).result {
@@ -90,16 +302,12 @@ extension Database.Request.Prices {
                 case .done: return nil
                 case let c: throw IG.Error._queryFailed(code: c)
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
     
-    /// Returns the number of price points for the given date interval.
-    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
-    /// - parameter from: The date from which to start the query. If `nil`, the date at the beginning of the database is assumed.
-    /// - parameter to: The date from which to end the query. If `nil`, the date at the end of the database is assumed.
-    public func count(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) -> AnyPublisher<Int,IG.Error> {
-        self._database.publisher { _ -> String in
+    /// Database access shared by `count(epic:from:to:)` and its `async` variant.
+    func _count(epic: IG.Market.Epic, from: Date?, to: Date?) -> Database.Access<String,Int> {
+        self._database.access { _ -> String in
                 let tableName = Database.Price.tableNamePrefix.appending(epic.description)
                 var query = "SELECT COUNT(*) FROM '\(tableName)'"
                 switch (from, to) {
@@ -127,19 +335,12 @@ extension Database.Request.Prices {
                 case .done: fatalError()
                 case let c: throw IG.Error._queryFailed(code: c)
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
-}
-
-extension Database.Request.Prices {
-    /// Returns historical prices for a particular instrument.
-    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
-    /// - parameter from: The date from which to start the query (included). If `nil`, the retrieved data starts with the first ever recorded price.
-    /// - parameter to: The date at which to end the query (included). If `nil`, the retrieved data ends with the last recorded price.
-    /// - returns: The requested price points or an empty array if no data has been previously stored for that timeframe.
-    public func get(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) -> AnyPublisher<[Database.Price],IG.Error> {
-        self._database.publisher { _ -> (tableName: String, query: String) in
+    
+    /// Database access shared by `get(epic:from:to:)` and its `async` variant.
+    func _get(epic: IG.Market.Epic, from: Date?, to: Date?) -> Database.Access<(tableName: String, query: String),[Database.Price]> {
+        self._database.access { _ -> (tableName: String, query: String) in
             let tableName = Database.Price.tableNamePrefix.appending(epic.description)
             var query = "SELECT * FROM '\(tableName)'"
             switch (from, to) {
@@ -174,19 +375,12 @@ extension Database.Request.Prices {
                 case let c: throw IG.Error._queryFailed(code: c)
                 }
             }
-        }.mapError(errorCast)
-        .eraseToAnyPublisher()
+        }
     }
     
-    /// Returns the first price starting from a given date to an optional end date (or the last stored price) which matches the buying or selling price.
-    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
-    /// - parameter from: The date from which to start the query.
-    /// - parameter to: The date from which to end the query. If `nil`, all prices from `from` to the end available prices will be searched.
-    /// - parameter buying: The buying price at which to match the price.
-    /// - parameter selling: The selling price at which to match the price.
-    /// - returns: A signal with price point matching the closure as value.
-    public func first(epic: IG.Market.Epic, from: Date, to: Date?, buying: Decimal64, selling: Decimal64) -> AnyPublisher<Database.Price?,IG.Error> {
-        return self._database.publisher { _ -> (tableName: String, query: String) in
+    /// Database access shared by `first(epic:from:to:buying:selling:)` and its `async` variant.
+    func _first(epic: IG.Market.Epic, from: Date, to: Date?, buying: Decimal64, selling: Decimal64) -> Database.Access<(tableName: String, query: String),Database.Price?> {
+        self._database.access { _ -> (tableName: String, query: String) in
             let tableName = Database.Price.tableNamePrefix.appending(epic.description)
             var query = "SELECT * FROM '\(tableName)'"
             
@@ -217,21 +411,12 @@ extension Database.Request.Prices {
             case .done: return nil
             case let c: throw IG.Error._queryFailed(code: c)
             }
-        }.mapError(errorCast)
-        .eraseToAnyPublisher()
+        }
     }
-}
-
-extension Database.Request.Prices {
-    /// Updates the database with the information received from the server.
-    /// - note: The market must be in the database before storing its price points.
-    /// - parameter prices: The array of price points that have arrived from the server.
-    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
-    /// - returns: A publisher that completes successfully (without sending any value) if the operation has been successful.
-    public func update(_ prices: [API.Price], epic: IG.Market.Epic) -> AnyPublisher<Never,IG.Error> {
-        guard !prices.isEmpty else { return Empty().eraseToAnyPublisher() }
-        
-        return self._database.publisher { _ in
+    
+    /// Database access shared by `update(_:epic:)` and its `async` variant.
+    func _update(_ prices: [API.Price], epic: IG.Market.Epic) -> Database.Access<(tableName: String, query: String),Void> {
+        self._database.access { _ in
                 Self._priceInsertionQuery(epic: epic)
             }.write { (sqlite, statement, input) -> Void in
                 // 1. Check the epic is on the Markets table.
@@ -257,9 +442,61 @@ extension Database.Request.Prices {
                     sqlite3_clear_bindings(statement)
                     sqlite3_reset(statement)
                 }
-            }.ignoreOutput()
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
+    }
+    
+    /// Database access shared by `getLast(_:epic:from:)` and its `async` variant.
+    func _getLast(_ count: Int, epic: IG.Market.Epic, from: Date?) -> Database.Access<String,[Database.Price]> {
+        self._database.access { _ -> String in
+            let filter = (from == nil) ? "" : " WHERE date >= ?2"
+            return "SELECT * FROM (SELECT * FROM '\(Database.Price.tableNamePrefix.appending(epic.description))'\(filter) ORDER BY date DESC LIMIT ?1) ORDER BY date ASC"
+        }.read { (sqlite, statement, query) in
+            var result: [Database.Price] = []
+            // 1. Check the price table is there.
+            guard try Self._existsPriceTable(epic: epic, sqlite: sqlite) else { return result }
+            // 2. Compile the SQL statement and add the variables (negative limits mean no limit in SQLite).
+            try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+            sqlite3_bind_int64(statement, 1, Int64(Swift.max(0, count)))
+            if let from = from { sqlite3_bind_int(statement, 2, Int32(from.timeIntervalSince1970)) }
+            // 3. Retrieve the data.
+            result.reserveCapacity(Swift.max(0, count))
+            while true {
+                switch sqlite3_step(statement).result {
+                case .row:  result.append(Database.Price(statement: statement!))
+                case .done: return result
+                case let c: throw IG.Error._queryFailed(code: c)
+                }
+            }
+        }
+    }
+    
+    /// Database access reading (in date order) a batch of prices from the given range.
+    /// - parameter after: The date of the last price read in the previous batch (or `nil` if this is the first batch).
+    func _getBatch(epic: IG.Market.Epic, after: Date?, from: Date?, to: Date?, limit: Int) -> Database.Access<String,[Database.Price]> {
+        self._database.access { _ -> String in
+            if let from = from, let to = to, from > to { throw IG.Error._invalidDates() }
+            return "SELECT * FROM '\(Database.Price.tableNamePrefix.appending(epic.description))' WHERE date BETWEEN ?1 AND ?2 ORDER BY date ASC LIMIT ?3"
+        }.read { (sqlite, statement, query) in
+            var result: [Database.Price] = []
+            // 1. Check the price table is there.
+            guard try Self._existsPriceTable(epic: epic, sqlite: sqlite) else { return result }
+            // 2. Compile the SQL statement
+            try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+            // 3. Add the variables to the statement
+            let lowerBound = after.map { Int32($0.timeIntervalSince1970) + 1 } ?? from.map { Int32($0.timeIntervalSince1970) } ?? .min
+            sqlite3_bind_int(statement, 1, lowerBound)
+            sqlite3_bind_int(statement, 2, to.map { Int32($0.timeIntervalSince1970) } ?? .max)
+            sqlite3_bind_int(statement, 3, Int32(clamping: limit))
+            // 4. Retrieve data
+            result.reserveCapacity(limit)
+            while true {
+                switch sqlite3_step(statement).result {
+                case .row:  result.append(Database.Price(statement: statement!))
+                case .done: return result
+                case let c: throw IG.Error._queryFailed(code: c)
+                }
+            }
+        }
     }
 }
 
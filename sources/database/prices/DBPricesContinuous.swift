@@ -0,0 +1,389 @@
+import Combine
+import Foundation
+import Decimals
+import SQLite3
+
+extension Database.Request.Prices {
+    /// Contains all functionality related to continuous (stitched) price series of expiring markets.
+    ///
+    /// The same epic represents a different underlying contract after each rollover; thus, its stored price history jumps at every roll. A continuous series detects those rolls and back-adjusts the previous contracts, producing a single price series suitable for long horizon analysis.
+    @frozen public struct Continuous {
+        /// Pointer to the actual database instance in charge of the low-level objects.
+        private unowned let _database: Database
+        /// Hidden initializer passing the instance needed to perform the database fetches/updates.
+        @usableFromInline internal init(database: Database) { self._database = database }
+    }
+}
+
+extension Database.Request.Prices.Continuous {
+    /// Stitches the stored prices of the given market into its continuous series.
+    ///
+    /// The series is materialised on the database and updated incrementally: only candles stored after the last materialised candle are processed. Rolls are detected from the stored contract expiration dates (recorded on every market update) and, optionally, from price discontinuities.
+    /// - remark: Changing the adjustment method or the threshold (or setting `rebuild` to `true`) recomputes the whole series. Rebuild the series if candles older than the last materialised candle are modified.
+    /// - parameter epic: Instrument's epic (such as `IX.D.FTSE.FWM1.IP`).
+    /// - parameter adjustment: The method used to back-adjust the previous contracts at each roll.
+    /// - parameter threshold: The relative gap between a candle's close and the following candle's open (e.g. `0.02` for 2%) considered a roll. If `nil`, only expiration dates are considered.
+    /// - parameter rebuild: Boolean indicating whether the series shall be recomputed from scratch.
+    /// - returns: A publisher that completes successfully (without sending any value) if the operation has been successful.
+    public func update(epic: IG.Market.Epic, adjustment: Database.Roll.Adjustment, threshold: Double? = nil, rebuild: Bool = false) -> AnyPublisher<Never,IG.Error> {
+        self._update(epic: epic, adjustment: adjustment, threshold: threshold, rebuild: rebuild).publisher
+            .ignoreOutput()
+            .eraseToAnyPublisher()
+    }
+
+    /// Returns the continuous (back-adjusted) prices of the given market.
+    /// - parameter epic: Instrument's epic (such as `IX.D.FTSE.FWM1.IP`).
+    /// - parameter from: The date from which to start the query. If `nil`, the date at the beginning of the series is assumed.
+    /// - parameter to: The date from which to end the query. If `nil`, the date at the end of the series is assumed.
+    /// - returns: The adjusted prices or an empty array if the series hasn't been materialised.
+    public func get(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) -> AnyPublisher<[Database.Price],IG.Error> {
+        self._get(epic: epic, from: from, to: to).publisher
+    }
+
+    /// Returns the rolls detected on the continuous series of the given market (in date order).
+    /// - parameter epic: Instrument's epic (such as `IX.D.FTSE.FWM1.IP`).
+    public func rolls(epic: IG.Market.Epic) -> AnyPublisher<[Database.Roll],IG.Error> {
+        self._rolls(epic: epic).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Prices.Continuous {
+    /// Stitches the stored prices of the given market into its continuous series.
+    /// - parameter epic: Instrument's epic (such as `IX.D.FTSE.FWM1.IP`).
+    /// - parameter adjustment: The method used to back-adjust the previous contracts at each roll.
+    /// - parameter threshold: The relative gap between a candle's close and the following candle's open considered a roll. If `nil`, only expiration dates are considered.
+    /// - parameter rebuild: Boolean indicating whether the series shall be recomputed from scratch.
+    /// - seealso: `update(epic:adjustment:threshold:rebuild:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(epic: IG.Market.Epic, adjustment: Database.Roll.Adjustment, threshold: Double? = nil, rebuild: Bool = false) async throws {
+        try await self._update(epic: epic, adjustment: adjustment, threshold: threshold, rebuild: rebuild).value()
+    }
+
+    /// Returns the continuous (back-adjusted) prices of the given market.
+    /// - parameter epic: Instrument's epic (such as `IX.D.FTSE.FWM1.IP`).
+    /// - parameter from: The date from which to start the query. If `nil`, the date at the beginning of the series is assumed.
+    /// - parameter to: The date from which to end the query. If `nil`, the date at the end of the series is assumed.
+    /// - seealso: `get(epic:from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func get(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) async throws -> [Database.Price] {
+        try await self._get(epic: epic, from: from, to: to).value()
+    }
+
+    /// Returns the rolls detected on the continuous series of the given market (in date order).
+    /// - parameter epic: Instrument's epic (such as `IX.D.FTSE.FWM1.IP`).
+    /// - seealso: `rolls(epic:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func rolls(epic: IG.Market.Epic) async throws -> [Database.Roll] {
+        try await self._rolls(epic: epic).value()
+    }
+}
+#endif
+
+private extension Database.Request.Prices.Continuous {
+    /// Database access shared by `update(epic:adjustment:threshold:rebuild:)` and its `async` variant.
+    func _update(epic: IG.Market.Epic, adjustment: Database.Roll.Adjustment, threshold: Double?, rebuild: Bool) -> Database.Access<Void,Void> {
+        self._database.access { _ -> Void in
+                if let threshold = threshold, !(threshold > 0) { throw IG.Error._invalidThreshold(threshold) }
+            }.write { (sqlite, _, _) in
+                try Self._materialize(epic: epic, adjustment: adjustment, threshold: threshold, rebuild: rebuild, sqlite: sqlite)
+            }
+    }
+
+    /// Database access shared by `get(epic:from:to:)` and its `async` variant.
+    func _get(epic: IG.Market.Epic, from: Date?, to: Date?) -> Database.Access<String,[Database.Price]> {
+        self._database.access { _ -> String in
+                if let from = from, let to = to, from > to { throw IG.Error._invalidDates() }
+                return "SELECT * FROM '\(Database.Roll.seriesTableNamePrefix.appending(epic.description))' WHERE date BETWEEN ?1 AND ?2 ORDER BY date ASC"
+            }.read { (sqlite, statement, query) in
+                var result: [Database.Price] = []
+                // 1. Check the series has been materialised.
+                guard try Self._existsTable(Database.Roll.seriesTableNamePrefix.appending(epic.description), sqlite: sqlite) else { return result }
+                // 2. Compile the SQL statement and add the variables.
+                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+                sqlite3_bind_int(statement, 1, from.map { Int32($0.timeIntervalSince1970) } ?? .min)
+                sqlite3_bind_int(statement, 2, to.map { Int32($0.timeIntervalSince1970) } ?? .max)
+                // 3. Retrieve the data.
+                while true {
+                    switch sqlite3_step(statement).result {
+                    case .row:  result.append(Database.Price(statement: statement!))
+                    case .done: return result
+                    case let c: throw IG.Error._queryFailed(code: c)
+                    }
+                }
+            }
+    }
+
+    /// Database access shared by `rolls(epic:)` and its `async` variant.
+    func _rolls(epic: IG.Market.Epic) -> Database.Access<String,[Database.Roll]> {
+        self._database.access { _ in "SELECT * FROM \(Database.Roll.tableName) WHERE epic=?1 ORDER BY date ASC" }
+            .read { (sqlite, statement, query) in
+                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+                sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient)
+
+                var result: [Database.Roll] = []
+                while true {
+                    switch sqlite3_step(statement).result {
+                    case .row:  result.append(Database.Roll(statement: statement!))
+                    case .done: return result
+                    case let c: throw IG.Error._queryFailed(code: c)
+                    }
+                }
+            }
+    }
+}
+
+// MARK: -
+
+extension Database.Request.Prices.Continuous {
+    /// Stores the contract expiration dates of the given markets (markets without expiration are ignored).
+    /// - note: This method is intended to be called from the update of generic markets. That is why, no transaction is performed here, since the parent method will wrap everything in its own transaction.
+    /// - parameter markets: Information returned from the server.
+    /// - parameter sqlite: SQLite pointer priviledge access.
+    internal static func update(contracts markets: [API.Market], sqlite: SQLite.Database) throws {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        let query = "INSERT INTO \(Database.Market.Contract.tableName) VALUES(?1, ?2) ON CONFLICT(epic, expiry) DO NOTHING"
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+
+        for contract in markets.compactMap(Database.Market.Contract.init(market:)) {
+            sqlite3_bind_text(statement, 1, contract.epic.description, -1, SQLite.Destructor.transient)
+            sqlite3_bind_int(statement, 2, Int32(contract.expiry.timeIntervalSince1970))
+            try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+            sqlite3_clear_bindings(statement)
+            sqlite3_reset(statement)
+        }
+    }
+}
+
+private extension Database.Request.Prices.Continuous {
+    /// The materialisation progress of a continuous series.
+    typealias _State = (adjustment: Database.Roll.Adjustment, threshold: Double?, lastDate: Int32)
+
+    /// Appends the candles stored after the last materialised candle to the continuous series, back-adjusting the series at every detected roll.
+    /// - precondition: It must be called within a write transaction.
+    static func _materialize(epic: IG.Market.Epic, adjustment: Database.Roll.Adjustment, threshold: Double?, rebuild: Bool, sqlite: SQLite.Database) throws {
+        let priceTable = Database.Price.tableNamePrefix.appending(epic.description)
+        let seriesTable = Database.Roll.seriesTableNamePrefix.appending(epic.description)
+        // 1. Without raw prices there is nothing to stitch.
+        guard try Database.Request.Prices._existsPriceTable(epic: epic, sqlite: sqlite) else { return }
+        // 2. Resume from the previous state (or start from scratch if the parameters changed).
+        var lastDate: Int32 = .min
+        if !rebuild, let state = try Self._state(epic: epic, sqlite: sqlite), state.adjustment == adjustment, state.threshold == threshold {
+            lastDate = state.lastDate
+        } else {
+            try Self._execute("DROP TABLE IF EXISTS '\(seriesTable)'", sqlite: sqlite)
+            try Self._execute("DELETE FROM \(Database.Roll.tableName) WHERE epic=?1", epic: epic, sqlite: sqlite)
+            try Self._execute(Database.Price.tableDefinition(name: seriesTable), sqlite: sqlite)
+        }
+        // 3. Detect the rolls among the new candles.
+        let (rolls, newest) = try Self._detectRolls(epic: epic, after: lastDate, threshold: threshold, sqlite: sqlite)
+        // 4. Materialise the new candles contract by contract, adjusting the history at each roll.
+        var cursor = lastDate
+        for roll in rolls {
+            let date = Int32(roll.date.timeIntervalSince1970)
+            try Self._copy(from: priceTable, to: seriesTable, after: cursor, before: date, sqlite: sqlite)
+            try Self._adjust(seriesTable, roll: roll, adjustment: adjustment, sqlite: sqlite)
+            try Self._store(roll: roll, epic: epic, sqlite: sqlite)
+            cursor = date - 1
+        }
+        try Self._copy(from: priceTable, to: seriesTable, after: cursor, before: nil, sqlite: sqlite)
+        // 5. Record the progress.
+        try Self._store(state: (adjustment, threshold, newest ?? lastDate), epic: epic, sqlite: sqlite)
+    }
+
+    /// Iterates through the candles stored after the given date looking for contract rolls.
+    /// - returns: The detected rolls and the date of the newest candle (or `nil` if there are no new candles).
+    static func _detectRolls(epic: IG.Market.Epic, after lastDate: Int32, threshold: Double?, sqlite: SQLite.Database) throws -> (rolls: [Database.Roll], newest: Int32?) {
+        let priceTable = Database.Price.tableNamePrefix.appending(epic.description)
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        // 1. Retrieve the contract expiration dates.
+        var expiries: [Int32] = []
+        try sqlite3_prepare_v2(sqlite, "SELECT expiry FROM \(Database.Market.Contract.tableName) WHERE epic=?1 ORDER BY expiry ASC", -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient)
+        loop: while true {
+            switch sqlite3_step(statement).result {
+            case .row:  expiries.append(sqlite3_column_int(statement, 0))
+            case .done: break loop
+            case let c: throw IG.Error._queryFailed(code: c)
+            }
+        }
+        sqlite3_finalize(statement); statement = nil
+
+        // 2. Retrieve the last materialised candle (needed to detect a roll right at the boundary).
+        var previous: Database.Price? = nil
+        try sqlite3_prepare_v2(sqlite, "SELECT * FROM '\(priceTable)' WHERE date <= ?1 ORDER BY date DESC LIMIT 1", -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_int(statement, 1, lastDate)
+        switch sqlite3_step(statement).result {
+        case .row:  previous = (lastDate > .min) ? Database.Price(statement: statement!) : nil
+        case .done: break
+        case let c: throw IG.Error._queryFailed(code: c)
+        }
+        sqlite3_finalize(statement); statement = nil
+
+        // 3. Iterate through the new candles comparing each one with its predecessor.
+        try sqlite3_prepare_v2(sqlite, "SELECT * FROM '\(priceTable)' WHERE date > ?1 ORDER BY date ASC", -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_int(statement, 1, lastDate)
+
+        var (rolls, newest, index): ([Database.Roll], Int32?, Int) = ([], nil, 0)
+        while true {
+            switch sqlite3_step(statement).result {
+            case .row: break
+            case .done: return (rolls, newest)
+            case let c: throw IG.Error._queryFailed(code: c)
+            }
+
+            let price = Database.Price(statement: statement!)
+            let date = Int32(price.date.timeIntervalSince1970)
+            defer { previous = price; newest = date }
+            guard let before = previous else { continue }
+
+            let (close, open) = (before.close.mid, price.open.mid)
+            let beforeDate = Int32(before.date.timeIntervalSince1970)
+            while index < expiries.count, expiries[index] < beforeDate { index += 1 }
+
+            let source: Database.Roll.Source
+            if index < expiries.count, expiries[index] < date {
+                source = .expiry
+                while index < expiries.count, expiries[index] < date { index += 1 }
+            } else if let threshold = threshold, close > .zero, let gap = Double(((open - close) / close).description), abs(gap) > threshold {
+                source = .discontinuity
+            } else {
+                continue
+            }
+            guard close > .zero, open > .zero else { continue }
+            rolls.append(Database.Roll(date: price.date, source: source, previousClose: close, nextOpen: open))
+        }
+    }
+
+    /// Copies the raw candles within the given (exclusive) date range into the continuous series.
+    static func _copy(from priceTable: String, to seriesTable: String, after: Int32, before: Int32?, sqlite: SQLite.Database) throws {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        let query = "INSERT OR REPLACE INTO '\(seriesTable)' SELECT * FROM '\(priceTable)' WHERE date > ?1 AND date < ?2"
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_int(statement, 1, after)
+        sqlite3_bind_int64(statement, 2, before.map(Int64.init) ?? .max)
+        try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+    }
+
+    /// Back-adjusts all candles currently stored in the continuous series with the given roll.
+    static func _adjust(_ seriesTable: String, roll: Database.Roll, adjustment: Database.Roll.Adjustment, sqlite: SQLite.Database) throws {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        let columns = ["openBid", "openAsk", "closeBid", "closeAsk", "lowBid", "lowAsk", "highBid", "highAsk"]
+        let assignments: [String]
+        switch adjustment {
+        case .difference: assignments = columns.map { "\($0)=\($0)+?1" }
+        case .ratio:      assignments = columns.map { "\($0)=CAST(ROUND(\($0)*?1) AS INTEGER)" }
+        }
+
+        let query = "UPDATE '\(seriesTable)' SET \(assignments.joined(separator: ", "))"
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        switch adjustment {
+        case .difference: sqlite3_bind_int64(statement, 1, Int64(clamping: roll.gap << Database.Price.Point.powerOf10))
+        case .ratio:      sqlite3_bind_double(statement, 1, roll.ratio)
+        }
+        try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+    }
+
+    /// Stores the given roll.
+    static func _store(roll: Database.Roll, epic: IG.Market.Epic, sqlite: SQLite.Database) throws {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        let query = "INSERT OR REPLACE INTO \(Database.Roll.tableName) VALUES(?1, ?2, ?3, ?4, ?5)"
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        roll._bind(to: statement!, epic: epic)
+        try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+    }
+
+    /// Returns the materialisation progress of the continuous series of the given market (or `nil` if it has never been materialised).
+    static func _state(epic: IG.Market.Epic, sqlite: SQLite.Database) throws -> _State? {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        let query = "SELECT adjustment, threshold, lastDate FROM \(Database.Roll.stateTableName) WHERE epic=?1"
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient)
+
+        switch sqlite3_step(statement).result {
+        case .row:
+            guard let adjustment = Database.Roll.Adjustment(rawValue: sqlite3_column_int(statement, 0)) else { return nil }
+            let threshold = (sqlite3_column_type(statement, 1) == SQLITE_NULL) ? nil : sqlite3_column_double(statement, 1)
+            return (adjustment, threshold, sqlite3_column_int(statement, 2))
+        case .done: return nil
+        case let c: throw IG.Error._queryFailed(code: c)
+        }
+    }
+
+    /// Stores the materialisation progress of the continuous series of the given market.
+    static func _store(state: _State, epic: IG.Market.Epic, sqlite: SQLite.Database) throws {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        let query = "INSERT OR REPLACE INTO \(Database.Roll.stateTableName) VALUES(?1, ?2, ?3, ?4)"
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient)
+        sqlite3_bind_int(statement, 2, state.adjustment.rawValue)
+        state.threshold.unwrap(none: { sqlite3_bind_null(statement, 3) }, some: { sqlite3_bind_double(statement, 3, $0) })
+        sqlite3_bind_int(statement, 4, state.lastDate)
+        try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+    }
+
+    /// Executes the given SQL statement (optionally binding the epic as its first variable).
+    static func _execute(_ query: String, epic: IG.Market.Epic? = nil, sqlite: SQLite.Database) throws {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        guard let epic = epic else {
+            return try sqlite3_exec(sqlite, query, nil, nil, nil).expects(.ok) { IG.Error._storingFailed(code: $0) }
+        }
+        try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient)
+        try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+    }
+
+    /// Returns a Boolean indicating whether the given table exists in the database.
+    static func _existsTable(_ name: String, sqlite: SQLite.Database) throws -> Bool {
+        var statement: SQLite.Statement? = nil
+        defer { sqlite3_finalize(statement) }
+
+        try sqlite3_prepare_v2(sqlite, "SELECT 1 FROM sqlite_master WHERE type='table' AND name=?1", -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+        sqlite3_bind_text(statement, 1, name, -1, SQLite.Destructor.transient)
+
+        switch sqlite3_step(statement).result {
+        case .row:  return true
+        case .done: return false
+        case let c: throw IG.Error._queryFailed(code: c)
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when the _from_ and _to_ date interval are invalid.
+    static func _invalidDates() -> Self {
+        Self(.database(.invalidRequest), "The 'from' date must indicate a date before the 'to' date", help: "Read the request documentation and be sure to follow all requirements.")
+    }
+    /// Error raised when the discontinuity threshold is invalid.
+    static func _invalidThreshold(_ threshold: Double) -> Self {
+        Self(.database(.invalidRequest), "The discontinuity threshold must be a positive number.", help: "Provide a relative gap (e.g. 0.02 for 2%) or `nil` to only consider expiration dates.", info: ["Threshold": threshold])
+    }
+    /// Error raised when a SQLite command couldn't be compiled.
+    static func _compilationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred trying to compile a SQL statement.", info: ["Error code": code])
+    }
+    /// Error raised when a SQLite table fails.
+    static func _queryFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred querying the SQLite table.", info: ["Table": Database.Roll.self, "Error code": code])
+    }
+    /// Error raised when storing fails.
+    static func _storingFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred storing values on '\(Database.Roll.self)'.", info: ["Error code": code])
+    }
+}
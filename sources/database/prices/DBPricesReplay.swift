@@ -0,0 +1,374 @@
+import Combine
+import Foundation
+import Decimals
+import SQLite3
+
+extension Database {
+    /// Replays stored prices of several markets in time order against a virtual clock.
+    ///
+    /// If a `VirtualClock` is given, it is advanced to the date of every price right before the price is emitted (executing any closure scheduled till then); thus, time-dependent logic driven by that clock runs in lockstep with the replayed prices.
+    ///
+    /// Every epic is read through its own cursor, which reads ahead a batch of prices before they are needed. The cursors are merged through a k-way merge (a binary heap keyed by date), so memory usage is bounded by the batch size times the number of epics.
+    /// - note: The replay doesn't support multiple subscribers; use `share()` if needed.
+    public final class Replay {
+        /// The lock restricting access to the replay state shared with other threads.
+        private let _lock: UnfairLock
+        /// The database storing the prices.
+        private let _database: Database
+        /// The serial queue where the cursors are merged and values are emitted.
+        private let _queue: DispatchQueue
+        /// The subject forwarding the replayed values.
+        private let _subject: PassthroughSubject<Streamer.Chart.Aggregated,IG.Error>
+        /// The date range being replayed (as stored in the database).
+        private let _range: (from: Int32, to: Int32)
+        /// The number of prices read ahead on every database access.
+        private let _batchSize: Int
+        /// The replayed epics.
+        public let epics: Set<IG.Market.Epic>
+        /// The pace at which prices are emitted.
+        public let speed: Speed
+        /// The interval assigned to the emitted candles.
+        public let interval: Streamer.Chart.Aggregated.Interval
+        /// The virtual clock advanced as prices are emitted (if any).
+        public let clock: VirtualClock?
+        /// The replay lifecycle state.
+        private var _state: _State
+        /// The date of the last emitted price.
+        private var _date: Date?
+        /// The per-epic cursors (only accessed within `_queue`).
+        private var _cursors: [_Cursor]
+        /// Heap merging the cursors with buffered prices (only accessed within `_queue`).
+        private var _heap: _Heap
+        /// The number of cursors with no buffered prices waiting for a database read (only accessed within `_queue`).
+        private var _waiting: Int
+        /// The wall/virtual time pair used to pace the emission (only accessed within `_queue`).
+        private var _anchor: (wall: DispatchTime, virtual: Date)?
+        /// Boolean indicating whether a delayed emission is already scheduled (only accessed within `_queue`).
+        private var _isScheduled: Bool
+
+        /// Designated initializer.
+        /// - precondition: The `.multiplied` speed factor must be a finite number greater than zero.
+        internal init(database: Database, epics: Set<IG.Market.Epic>, from: Date?, to: Date?, speed: Speed, interval: Streamer.Chart.Aggregated.Interval, batchSize: Int, clock: VirtualClock?) {
+            if case .multiplied(let factor) = speed {
+                precondition(factor > 0 && factor.isFinite, "The replay speed factor must be a finite number greater than zero")
+            }
+            self._lock = UnfairLock()
+            self._database = database
+            self._queue = DispatchQueue(label: IG.identifier + ".database.replay", qos: .utility, target: database.queue)
+            self._subject = PassthroughSubject()
+            self._range = (from.map { Int32($0.timeIntervalSince1970) } ?? .min, to.map { Int32($0.timeIntervalSince1970) } ?? .max)
+            self._batchSize = Swift.max(batchSize, 2)
+            self.epics = epics
+            self.speed = speed
+            self.interval = interval
+            self.clock = clock
+            self._state = .idle
+            self._cursors = epics.sorted().map { _Cursor(epic: $0) }
+            self._heap = _Heap()
+            self._waiting = 0
+            self._isScheduled = false
+        }
+
+        deinit {
+            self._lock.invalidate()
+        }
+
+        /// Publisher forwarding the stored prices in time order.
+        ///
+        /// The first subscriber starts the replay. Cancelling the subscription stops it.
+        /// - note: The publisher keeps the replay alive; there is no need to hold a reference to the replay instance.
+        public var publisher: AnyPublisher<Streamer.Chart.Aggregated,IG.Error> {
+            self._subject
+                .handleEvents(receiveSubscription: { [self] _ in self._start() },
+                              receiveCancel: { [self] in self._stop() })
+                .eraseToAnyPublisher()
+        }
+
+        /// The date of the last emitted price (or `nil` if no price has been emitted yet).
+        public var date: Date? {
+            self._lock.execute { self._date }
+        }
+    }
+}
+
+extension Database.Replay {
+    /// The pace at which prices are emitted.
+    public enum Speed: Equatable {
+        /// Prices are emitted following the wall clock (i.e. 1×).
+        case realTime
+        /// Prices are emitted the given times faster than the wall clock (e.g. `60` replays an hour of prices in a minute).
+        /// - precondition: The factor must be a finite number greater than zero.
+        case multiplied(Double)
+        /// Prices are emitted as fast as the database is read.
+        case maximum
+
+        /// The speed factor (or `nil` for maximum speed).
+        fileprivate var _factor: Double? {
+            switch self {
+            case .realTime: return 1
+            case .multiplied(let factor): return factor
+            case .maximum: return nil
+            }
+        }
+    }
+}
+
+// MARK: -
+
+private extension Database.Replay {
+    /// The replay lifecycle states.
+    enum _State {
+        /// The replay hasn't been subscribed to yet.
+        case idle
+        /// The replay is emitting values.
+        case running
+        /// The replay has finished, failed, or it has been cancelled.
+        case terminated
+    }
+
+    /// The reading position for a single epic.
+    struct _Cursor {
+        /// The market epic being read.
+        let epic: IG.Market.Epic
+        /// The prices read ahead.
+        var buffer: [Database.Price] = []
+        /// The index of the next price to emit in `buffer`.
+        var head: Int = 0
+        /// The lowest date (included) of the next database read.
+        var next: Int32? = nil
+        /// Boolean indicating whether a database read is ongoing.
+        var isPending: Bool = false
+        /// Boolean indicating whether all prices have been read from the database.
+        var isExhausted: Bool = false
+
+        init(epic: IG.Market.Epic) {
+            self.epic = epic
+        }
+
+        /// The number of prices buffered and not yet emitted.
+        var remaining: Int {
+            self.buffer.count - self.head
+        }
+    }
+
+    /// Binary min-heap storing the date of the next price of every cursor with buffered prices.
+    struct _Heap {
+        private var _elements: [(date: Date, cursor: Int)] = []
+
+        var isEmpty: Bool { self._elements.isEmpty }
+        var top: (date: Date, cursor: Int)? { self._elements.first }
+
+        /// Returns a Boolean indicating whether the left element precedes the right element (ties are broken by cursor index to keep the output deterministic).
+        private static func _precedes(_ lhs: (date: Date, cursor: Int), _ rhs: (date: Date, cursor: Int)) -> Bool {
+            (lhs.date != rhs.date) ? lhs.date < rhs.date : lhs.cursor < rhs.cursor
+        }
+
+        mutating func push(date: Date, cursor: Int) {
+            self._elements.append((date, cursor))
+            var child = self._elements.count - 1
+            while child > 0 {
+                let parent = (child - 1) / 2
+                guard Self._precedes(self._elements[child], self._elements[parent]) else { break }
+                self._elements.swapAt(child, parent)
+                child = parent
+            }
+        }
+
+        @discardableResult mutating func pop() -> (date: Date, cursor: Int)? {
+            guard !self._elements.isEmpty else { return nil }
+            self._elements.swapAt(0, self._elements.count - 1)
+            let result = self._elements.removeLast()
+            var parent = 0
+            while true {
+                let (left, right) = (2 * parent + 1, 2 * parent + 2)
+                var candidate = parent
+                if left < self._elements.count, Self._precedes(self._elements[left], self._elements[candidate]) { candidate = left }
+                if right < self._elements.count, Self._precedes(self._elements[right], self._elements[candidate]) { candidate = right }
+                guard candidate != parent else { break }
+                self._elements.swapAt(parent, candidate)
+                parent = candidate
+            }
+            return result
+        }
+    }
+
+    /// Starts the replay (if it was idle).
+    func _start() {
+        self._lock.lock()
+        guard case .idle = self._state else { return self._lock.unlock() }
+        self._state = .running
+        self._lock.unlock()
+
+        self._queue.async {
+            guard !self._cursors.isEmpty else { return self._finish(completion: .finished) }
+            self._waiting = self._cursors.count
+            self._cursors.indices.forEach { self._read(cursor: $0) }
+        }
+    }
+
+    /// Stops the replay without forwarding any completion.
+    func _stop() {
+        self._lock.execute { self._state = .terminated }
+    }
+
+    /// Boolean indicating whether the replay is currently running.
+    var _isRunning: Bool {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+        guard case .running = self._state else { return false }
+        return true
+    }
+
+    /// Terminates the replay forwarding the given completion.
+    /// - attention: This function must be called within `_queue`.
+    func _finish(completion: Subscribers.Completion<IG.Error>) {
+        self._lock.lock()
+        guard case .running = self._state else { return self._lock.unlock() }
+        self._state = .terminated
+        self._lock.unlock()
+        self._subject.send(completion: completion)
+    }
+
+    /// Reads the next batch of prices for the given cursor.
+    /// - attention: This function must be called within `_queue`.
+    func _read(cursor index: Int) {
+        self._cursors[index].isPending = true
+        let (epic, batchSize, to) = (self._cursors[index].epic, self._batchSize, self._range.to)
+        let from = self._cursors[index].next ?? self._range.from
+
+        self._database.channel.readAsync(promise: {
+            self._receive(cursor: index, result: $0)
+        }, on: self._queue) { (sqlite) -> [Database.Price] in
+            guard try Database.Request.Prices._existsPriceTable(epic: epic, sqlite: sqlite) else { return [] }
+
+            var statement: SQLite.Statement? = nil
+            defer { sqlite3_finalize(statement) }
+
+            let query = "SELECT * FROM '\(Database.Price.tableNamePrefix)\(epic)' WHERE date BETWEEN ?1 AND ?2 ORDER BY date ASC LIMIT ?3"
+            try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+            sqlite3_bind_int(statement, 1, from)
+            sqlite3_bind_int(statement, 2, to)
+            sqlite3_bind_int(statement, 3, Int32(clamping: batchSize))
+
+            var result: [Database.Price] = []
+            result.reserveCapacity(batchSize)
+            while true {
+                switch sqlite3_step(statement).result {
+                case .row:  result.append(Database.Price(statement: statement!))
+                case .done: return result
+                case let c: throw IG.Error._queryFailed(code: c)
+                }
+            }
+        }
+    }
+
+    /// Stores the read prices on the targeted cursor and resumes the emission.
+    /// - attention: This function must be called within `_queue`.
+    func _receive(cursor index: Int, result: Result<[Database.Price],IG.Error>) {
+        guard self._isRunning else { return }
+
+        let prices: [Database.Price]
+        switch result {
+        case .success(let values): prices = values
+        case .failure(let error): return self._finish(completion: .failure(error))
+        }
+
+        var cursor = self._cursors[index]
+        let wasEmpty = (cursor.remaining == 0)
+        cursor.isPending = false
+        cursor.isExhausted = prices.count < self._batchSize
+        if let last = prices.last {
+            cursor.next = Int32(last.date.timeIntervalSince1970) + 1
+            // Compact the already emitted prices before appending the new ones.
+            cursor.buffer.removeFirst(cursor.head)
+            cursor.head = 0
+            cursor.buffer.append(contentsOf: prices)
+        }
+        self._cursors[index] = cursor
+
+        if wasEmpty {
+            self._waiting -= 1
+            if cursor.remaining > 0 { self._heap.push(date: cursor.buffer[cursor.head].date, cursor: index) }
+        }
+        self._emit()
+    }
+
+    /// Emits prices in time order till a cursor runs out of buffered prices, the pacing requires waiting, or the replay finishes.
+    /// - attention: This function must be called within `_queue`.
+    func _emit() {
+        let factor = self.speed._factor
+
+        while self._waiting == 0, let top = self._heap.top {
+            guard self._isRunning else { return }
+
+            // 1. Pace the emission against the wall clock (if needed).
+            if let factor = factor {
+                let anchor = self._anchor ?? (DispatchTime.now(), top.date)
+                self._anchor = anchor
+                let offset = top.date.timeIntervalSince(anchor.virtual) / factor
+                let deadline = anchor.wall + .nanoseconds(Int(offset * 1_000_000_000))
+                if deadline > DispatchTime.now() {
+                    guard !self._isScheduled else { return }
+                    self._isScheduled = true
+                    return self._queue.asyncAfter(deadline: deadline) {
+                        self._isScheduled = false
+                        self._emit()
+                    }
+                }
+            }
+
+            // 2. Pop the earliest price.
+            self._heap.pop()
+            let index = top.cursor
+            let price = self._cursors[index].buffer[self._cursors[index].head]
+            self._cursors[index].head += 1
+
+            // 3. Read ahead when half of the buffer has been consumed, and reinsert the cursor on the heap.
+            let cursor = self._cursors[index]
+            if !cursor.isPending, !cursor.isExhausted, cursor.remaining <= self._batchSize / 2 {
+                self._read(cursor: index)
+            }
+            if cursor.remaining > 0 {
+                self._heap.push(date: cursor.buffer[cursor.head].date, cursor: index)
+            } else if self._cursors[index].isPending {
+                self._waiting += 1
+            }
+
+            // 4. Advance the virtual clock(s) and forward the value.
+            self._lock.execute { self._date = price.date }
+            self.clock?.advance(to: price.date)
+            self._subject.send(Streamer.Chart.Aggregated(epic: cursor.epic, interval: self.interval, price: price))
+        }
+
+        if self._waiting == 0, self._heap.isEmpty {
+            self._finish(completion: .finished)
+        }
+    }
+}
+
+extension Streamer.Chart.Aggregated {
+    /// Creates a finished candle from a price stored in the database.
+    /// - parameter epic: The market epic the price belongs to.
+    /// - parameter interval: The resolution of the stored price.
+    /// - parameter price: The stored price.
+    internal init(epic: IG.Market.Epic, interval: Self.Interval, price: Database.Price) {
+        let candle = Self.Candle(date: price.date, numTicks: price.volume, isFinished: true,
+                                 open: .init(bid: price.open.bid, ask: price.open.ask),
+                                 close: .init(bid: price.close.bid, ask: price.close.ask),
+                                 lowest: .init(bid: price.lowest.bid, ask: price.lowest.ask),
+                                 highest: .init(bid: price.highest.bid, ask: price.highest.ask))
+        let day = Self.Day(lowest: nil, mid: nil, highest: nil, changeNet: nil, changePercentage: nil)
+        self.init(epic: epic, interval: interval, candle: candle, day: day)
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when a SQLite command couldn't be compiled.
+    static func _compilationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred trying to compile a SQL statement.", info: ["Error code": code])
+    }
+    /// Error raised when a SQLite table fails.
+    static func _queryFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred querying the SQLite table.", info: ["Table": Database.Price.self, "Error code": code])
+    }
+}
@@ -0,0 +1,145 @@
+import Combine
+import Foundation
+import SQLite3
+
+extension Database.Request {
+    /// Contains all functionality related to the volume profiles of finished trading sessions.
+    @frozen public struct Profiles {
+        /// Pointer to the actual database instance in charge of the low-level objects.
+        private unowned let _database: Database
+        /// Hidden initializer passing the instance needed to perform the database fetches/updates.
+        @usableFromInline internal init(database: Database) { self._database = database }
+    }
+}
+
+extension Database.Request.Profiles {
+    /// Stores the given session profiles (e.g. the ones forwarded by `Streamer.ProfileBuilder.finished`).
+    ///
+    /// A stored profile for the same market and session start is replaced.
+    /// - parameter profiles: The profiles to be stored.
+    /// - returns: A publisher that completes successfully (without sending any value) if the operation has been successful.
+    public func update(_ profiles: [Streamer.Profile]) -> AnyPublisher<Never,IG.Error> {
+        guard !profiles.isEmpty else { return Empty().eraseToAnyPublisher() }
+        return self._update(profiles).publisher
+            .ignoreOutput()
+            .eraseToAnyPublisher()
+    }
+
+    /// Returns the stored profiles of the given market whose sessions start within the given time frame (sorted by session start).
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query (inclusive). If `nil`, the retrieved data starts with the first stored session.
+    /// - parameter to: The date from which to end the query (inclusive). If `nil`, the retrieved data ends with the last stored session.
+    /// - returns: The requested profiles or an empty array if no profile has been stored for that timeframe.
+    public func get(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) -> AnyPublisher<[Streamer.Profile],IG.Error> {
+        self._get(epic: epic, from: from, to: to).publisher
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Profiles {
+    /// Stores the given session profiles.
+    /// - parameter profiles: The profiles to be stored.
+    /// - seealso: `update(_:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    public func update(_ profiles: [Streamer.Profile]) async throws {
+        guard !profiles.isEmpty else { return }
+        try await self._update(profiles).value()
+    }
+
+    /// Returns the stored profiles of the given market whose sessions start within the given time frame (sorted by session start).
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter from: The date from which to start the query (inclusive). If `nil`, the retrieved data starts with the first stored session.
+    /// - parameter to: The date from which to end the query (inclusive). If `nil`, the retrieved data ends with the last stored session.
+    /// - seealso: `get(epic:from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The requested profiles or an empty array if no profile has been stored for that timeframe.
+    public func get(epic: IG.Market.Epic, from: Date? = nil, to: Date? = nil) async throws -> [Streamer.Profile] {
+        try await self._get(epic: epic, from: from, to: to).value()
+    }
+}
+#endif
+
+private extension Database.Request.Profiles {
+    /// Database access shared by `update(_:)` and its `async` variant.
+    func _update(_ profiles: [Streamer.Profile]) -> Database.Access<Void,Void> {
+        self._database.access { _ in () }
+            .write { (sqlite, statement, _) -> Void in
+                let query = """
+                    INSERT INTO \(Streamer.Profile.tableName) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9)
+                        ON CONFLICT(epic, start) DO UPDATE SET
+                        end=excluded.end, binSize=excluded.binSize, base=excluded.base, poc=excluded.poc,
+                        valueLow=excluded.valueLow, valueHigh=excluded.valueHigh, bins=excluded.bins
+                    """
+                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+
+                for profile in profiles {
+                    profile._bind(to: statement!)
+                    try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+                    sqlite3_clear_bindings(statement)
+                    sqlite3_reset(statement)
+                }
+            }
+    }
+
+    /// Database access shared by `get(epic:from:to:)` and its `async` variant.
+    func _get(epic: IG.Market.Epic, from: Date?, to: Date?) -> Database.Access<String,[Streamer.Profile]> {
+        self._database.access { _ -> String in
+                var query = "SELECT * FROM \(Streamer.Profile.tableName) WHERE epic=?1"
+                switch (from, to) {
+                case (let from?, let to?):
+                    guard from <= to else { throw IG.Error._invalidDates() }
+                    query.append(" AND start BETWEEN ?2 AND ?3")
+                case (.some, .none): query.append(" AND start >= ?2")
+                case (.none, .some): query.append(" AND start <= ?2")
+                case (.none, .none): break
+                }
+                query.append(" ORDER BY start ASC")
+                return query
+            }.read { (sqlite, statement, query) in
+                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+
+                sqlite3_bind_text(statement, 1, epic.description, -1, SQLite.Destructor.transient)
+                switch (from, to) {
+                case (let from?, let to?): sqlite3_bind_int64(statement, 2, Int64(from.timeIntervalSince1970))
+                                           sqlite3_bind_int64(statement, 3, Int64(to.timeIntervalSince1970))
+                case (let from?, .none):   sqlite3_bind_int64(statement, 2, Int64(from.timeIntervalSince1970))
+                case (.none, let to?):     sqlite3_bind_int64(statement, 2, Int64(to.timeIntervalSince1970))
+                case (.none, .none): break
+                }
+
+                var result: [Streamer.Profile] = []
+                while true {
+                    switch sqlite3_step(statement).result {
+                    case .row:
+                        guard let profile = Streamer.Profile(statement: statement!) else { throw IG.Error._invalidRow() }
+                        result.append(profile)
+                    case .done: return result
+                    case let c: throw IG.Error._queryFailed(code: c)
+                    }
+                }
+            }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when the _from_ and _to_ date interval are invalid.
+    static func _invalidDates() -> Self {
+        Self(.database(.invalidRequest), "The 'from' date must indicate a date before the 'to' date", help: "Read the request documentation and be sure to follow all requirements.")
+    }
+    /// Error raised when a SQLite command couldn't be compiled.
+    static func _compilationFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred trying to compile a SQL statement.", info: ["Error code": code])
+    }
+    /// Error raised when a SQLite table fails.
+    static func _queryFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred querying the SQLite table.", info: ["Table": Streamer.Profile.self, "Error code": code])
+    }
+    /// Error raised when storing fails.
+    static func _storingFailed(code: SQLite.Result) -> Self {
+        Self(.database(.callFailed), "An error occurred storing values on '\(Streamer.Profile.self)'.", info: ["Error code": code])
+    }
+    /// Error raised when a stored row cannot be decoded.
+    static func _invalidRow() -> Self {
+        Self(.database(.invalidResponse), "A stored session profile couldn't be decoded.", help: "The market epic or the histogram bins are malformed. Store the profile again.")
+    }
+}
@@ -22,7 +22,53 @@ extension Database.Request.Rates {
     public func getInterests(currencies: Set<Currency.Code>, from: Date? = nil, to: Date? = nil) -> AnyPublisher<[Database.InterestRate],IG.Error> {
         guard !currencies.isEmpty else { return Empty().eraseToAnyPublisher() }
         
+        return self._getInterests(currencies: currencies, from: from, to: to).publisher
+    }
+    
+    /// Updates the database with the information given as the argument.
+    /// - parameter interests: The new data to be included in the database.
+    /// - returns: A publisher that completes successfully (without sending any value) if the operation has been successful.
+    internal func update(interests: [Database.InterestRate]) -> AnyPublisher<Never,IG.Error> {
+        guard !interests.isEmpty else { return Empty().eraseToAnyPublisher() }
         return self._database.publisher { _ -> String in
+                "INSERT INTO '\(Database.InterestRate.tableName)' VALUES(?1, ?2, ?3) ON CONFLICT(date,currency) DO UPDATE SET rate=excluded.rate"
+            }.write { (sqlite, statement, query) -> Void in
+                // 1. Compile the SQL statement.
+                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
+                // 2. Write the elements iteratively.
+                for rate in interests {
+                    rate._bind(to: statement!)
+                    try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
+                    sqlite3_clear_bindings(statement)
+                    sqlite3_reset(statement)
+                }
+            }.ignoreOutput()
+            .mapError(errorCast)
+            .eraseToAnyPublisher()
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+extension Database.Request.Rates {
+    /// Returns the interest rates set by the currencies' central banks during the given time frame.
+    /// - parameter currencies: The currencies identifying the targeted central bank interests.
+    /// - parameter from: The date from which to start the query (inclusive). If `nil`, the retrieved data starts with the first ever recorded interest rate.
+    /// - parameter to: The date from which to end the query (inclusive). If `nil`, the retrieved data ends with the last recorded interest rate.
+    /// - seealso: `getInterests(currencies:from:to:)` (Combine variant).
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The requested central bank interest rates or an empty array if no data has been previously stored for that timeframe.
+    public func getInterests(currencies: Set<Currency.Code>, from: Date? = nil, to: Date? = nil) async throws -> [Database.InterestRate] {
+        guard !currencies.isEmpty else { return [] }
+        
+        return try await self._getInterests(currencies: currencies, from: from, to: to).value()
+    }
+}
+#endif
+
+private extension Database.Request.Rates {
+    /// Database access shared by `getInterests(currencies:from:to:)` and its `async` variant.
+    func _getInterests(currencies: Set<Currency.Code>, from: Date?, to: Date?) -> Database.Access<String,[Database.InterestRate]> {
+        self._database.access { _ -> String in
                 var query = "SELECT * FROM '\(Database.InterestRate.tableName)'"
                 switch (from, to) {
                 case (let from?, let to?):
@@ -57,30 +103,7 @@ extension Database.Request.Rates {
                     case let c: throw IG.Error._queryFailed(code: c)
                     }
                 }
-            }.mapError(errorCast)
-            .eraseToAnyPublisher()
-    }
-    
-    /// Updates the database with the information given as the argument.
-    /// - parameter interests: The new data to be included in the database.
-    /// - returns: A publisher that completes successfully (without sending any value) if the operation has been successful.
-    internal func update(interests: [Database.InterestRate]) -> AnyPublisher<Never,IG.Error> {
-        guard !interests.isEmpty else { return Empty().eraseToAnyPublisher() }
-        return self._database.publisher { _ -> String in
-                "INSERT INTO '\(Database.InterestRate.tableName)' VALUES(?1, ?2, ?3) ON CONFLICT(date,currency) DO UPDATE SET rate=excluded.rate"
-            }.write { (sqlite, statement, query) -> Void in
-                // 1. Compile the SQL statement.
-                try sqlite3_prepare_v2(sqlite, query, -1, &statement, nil).expects(.ok) { IG.Error._compilationFailed(code: $0) }
-                // 2. Write the elements iteratively.
-                for rate in interests {
-                    rate._bind(to: statement!)
-                    try sqlite3_step(statement).expects(.done) { IG.Error._storingFailed(code: $0) }
-                    sqlite3_clear_bindings(statement)
-                    sqlite3_reset(statement)
-                }
-            }.ignoreOutput()
-            .mapError(errorCast)
-            .eraseToAnyPublisher()
+            }
     }
 }
 
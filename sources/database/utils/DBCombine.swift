@@ -34,6 +34,81 @@ extension Database {
     }
 }
 
+extension Database {
+    /// Values computed before a database access along with the database instance performing it.
+    ///
+    /// It is the first stage of a reusable `Database.Access`.
+    internal struct Precomputed<T> {
+        /// The database performing the access (or `nil` if it has been deallocated).
+        private(set) weak var database: Database?
+        /// Closure generating the values to be passed to the access interaction.
+        let generator: (_ db: Database) throws -> T
+        
+        /// Designated initializer.
+        /// - parameter database: The database performing the access.
+        /// - parameter generator: Closure generating the values to be passed to the access interaction.
+        fileprivate init(database: Database, generator: @escaping (_ db: Database) throws -> T) {
+            self.database = database
+            self.generator = generator
+        }
+    }
+    
+    /// Description of a single database access, which can be executed as a Combine publisher or as an `async` call.
+    internal struct Access<T,R> {
+        /// The values computed before the access.
+        let values: Precomputed<T>
+        /// Boolean indicating whether the access is a barrier access (read/write) or a parallel access (read only).
+        let isWrite: Bool
+        /// Closure having access to the priviledge database connection.
+        let interaction: (_ database: SQLite.Database, _ statement: inout SQLite.Statement?, _ values: T, _ isCancelled: ()->Bool) throws -> R
+        
+        /// Publisher performing the access once it is subscribed to.
+        var publisher: AnyPublisher<R,IG.Error> {
+            guard let database = self.values.database else { return Fail(error: IG.Error._deallocatedDB()).eraseToAnyPublisher() }
+            let upstream = database.publisher(self.values.generator)
+            return (self.isWrite) ? upstream.cancellableWrite(self.interaction).eraseToAnyPublisher()
+                                  : upstream.cancellableRead(self.interaction).eraseToAnyPublisher()
+        }
+    }
+    
+    /// Starts the description of a database access by indicating the values to compute before the access.
+    /// - parameter valuesGenerator: Closure generating the values to be passed to the access interaction.
+    /// - returns: The first stage of a database access.
+    internal func access<T>(_ valuesGenerator: @escaping (_ db: Database) throws -> T) -> Database.Precomputed<T> {
+        .init(database: self, generator: valuesGenerator)
+    }
+}
+
+extension Database.Precomputed {
+    /// Describes a read from the database.
+    /// - parameter interaction: Closure having access to the priviledge database connection.
+    /// - returns: The database access description.
+    internal func read<R>(_ interaction: @escaping (_ database: SQLite.Database, _ statement: inout SQLite.Statement?, _ values: T) throws -> R) -> Database.Access<T,R> {
+        .init(values: self, isWrite: false) { (sqlite, statement, values, _) in try interaction(sqlite, &statement, values) }
+    }
+    
+    /// Describes a read from the database, which may check midway whether the access has been cancelled.
+    /// - parameter interaction: Closure having access to the priviledge database connection.
+    /// - returns: The database access description.
+    internal func cancellableRead<R>(_ interaction: @escaping (_ database: SQLite.Database, _ statement: inout SQLite.Statement?, _ values: T, _ isCancelled: ()->Bool) throws -> R) -> Database.Access<T,R> {
+        .init(values: self, isWrite: false, interaction: interaction)
+    }
+    
+    /// Describes a read/write from the database.
+    /// - parameter interaction: Closure having access to the priviledge database connection.
+    /// - returns: The database access description.
+    internal func write<R>(_ interaction: @escaping (_ database: SQLite.Database, _ statement: inout SQLite.Statement?, _ values: T) throws -> R) -> Database.Access<T,R> {
+        .init(values: self, isWrite: true) { (sqlite, statement, values, _) in try interaction(sqlite, &statement, values) }
+    }
+    
+    /// Describes a read/write from the database, which may check midway whether the access has been cancelled.
+    /// - parameter interaction: Closure having access to the priviledge database connection.
+    /// - returns: The database access description.
+    internal func cancellableWrite<R>(_ interaction: @escaping (_ database: SQLite.Database, _ statement: inout SQLite.Statement?, _ values: T, _ isCancelled: ()->Bool) throws -> R) -> Database.Access<T,R> {
+        .init(values: self, isWrite: true, interaction: interaction)
+    }
+}
+
 extension Publisher where Failure==IG.Error {
     /// Reads from the database received as an the receiving publisher `Output`.
     /// - parameter interaction: Closure having access to the priviledge database connection.
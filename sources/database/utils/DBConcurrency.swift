@@ -0,0 +1,97 @@
+#if compiler(>=5.7) && canImport(_Concurrency)
+import Foundation
+import SQLite3
+
+internal extension Database.Access {
+    /// Performs the database access and suspends the current task till the transaction ends.
+    ///
+    /// The task continuation is resumed straight from the database queue (right after the transaction is committed or rolled back); that is, there is no hop through the database reception queue.
+    ///
+    /// Cancelling the surrounding task flags the access as cancelled: accesses not yet started are skipped and cancellable interactions may stop midway. Reads then throw `CancellationError`; writes report the outcome of the transaction, since it may have already been committed.
+    /// - throws: `IG.Error` exclusively or `CancellationError` if the task is cancelled.
+    /// - returns: The value returned by the access interaction.
+    func value() async throws -> R {
+        guard let database = self.values.database else { throw IG.Error._deallocatedDB() }
+
+        let values: T
+        do {
+            values = try self.values.generator(database)
+        } catch let error as IG.Error {
+            throw error
+        } catch let error {
+            throw IG.Error._invalidPrecomputedValues(error: error)
+        }
+
+        try Task.checkCancellation()
+        let (channel, isWrite, interaction) = (database.channel, self.isWrite, self.interaction)
+        let cancellation = _Cancellation()
+
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<R,Swift.Error>) in
+                let promise: (Result<R,IG.Error>) -> Void = { (result) in
+                    switch result {
+                    case .failure where cancellation.isCancelled: continuation.resume(throwing: CancellationError())
+                    case .success where cancellation.isCancelled && !isWrite: continuation.resume(throwing: CancellationError())
+                    default: continuation.resume(with: result)
+                    }
+                }
+
+                let body: (SQLite.Database) throws -> R = { (sqlite) in
+                    guard !cancellation.isCancelled else { throw CancellationError() }
+                    var statement: SQLite.Statement? = nil
+                    defer { sqlite3_finalize(statement) }
+                    return try interaction(sqlite, &statement, values) { cancellation.isCancelled }
+                }
+
+                if isWrite {
+                    channel.writeAsync(promise: promise, on: nil, body)
+                } else {
+                    channel.readAsync(promise: promise, on: nil, body)
+                }
+            }
+        } onCancel: {
+            cancellation.cancel()
+        }
+    }
+}
+
+// MARK: -
+
+/// Thread-safe flag indicating whether a database access has been cancelled.
+private final class _Cancellation {
+    /// The lock restricting access to the flag.
+    private let _lock: UnfairLock
+    /// Boolean indicating whether the access has been cancelled.
+    private var _isCancelled: Bool
+
+    init() {
+        self._lock = UnfairLock()
+        self._isCancelled = false
+    }
+
+    deinit {
+        self._lock.invalidate()
+    }
+
+    /// Boolean indicating whether the access has been cancelled.
+    var isCancelled: Bool {
+        self._lock.execute { self._isCancelled }
+    }
+
+    /// Flags the access as cancelled.
+    func cancel() {
+        self._lock.execute { self._isCancelled = true }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when the DB instance is deallocated.
+    static func _deallocatedDB() -> Self {
+        Self(.database(.sessionExpired), "The DB instance has been deallocated.", help: "The DB functionality is asynchronous. Keep around the API instance while the request/response is being processed.")
+    }
+    /// Error raised when the precomputed request values cannot be generated.
+    static func _invalidPrecomputedValues(error: Swift.Error) -> Self {
+        Self(.database(.invalidRequest), "The precomputed request values couldn't be generated.", help: "Read the request documentation and be sure to follow all requirements.", underlying: error)
+    }
+}
+#endif
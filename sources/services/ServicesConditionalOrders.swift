@@ -0,0 +1,478 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Services {
+    /// Creates a manager for client-side conditional orders (if-touched, one-cancels-other, and brackets) executed through this instance's API.
+    /// - parameter journal: If given, the lifecycle of every deal call fired by the manager is recorded on this writer.
+    public func conditionalOrders(journal: Database.JournalWriter? = nil) -> ConditionalOrders {
+        ConditionalOrders(api: self.api, journal: journal)
+    }
+}
+
+extension Services {
+    /// Holds client-side conditional order graphs in memory and executes them when streamed prices reach their trigger levels.
+    ///
+    /// Triggers are indexed per epic and price side in sorted level books, so every price update is evaluated in O(log n + triggered).
+    /// When an order triggers, its REST deal call is fired immediately and its one-cancels-other siblings are suspended in the same evaluation step.
+    /// Once the deal is confirmed as accepted, the suspended siblings are cancelled and the contingent orders are armed; if the deal call fails or the deal is rejected, the siblings are re-armed.
+    /// - note: Prices are fed to the manager through `evaluate(_:)` or the `executeConditionalOrders(on:)` operator on a `Streamer.Market` publisher.
+    ///   When a journal writer is given, the deal calls are journaled with the latest evaluated quote as the decision quote.
+    public final class ConditionalOrders {
+        /// The lock restricting access to the manager state.
+        private let _lock: UnfairLock
+        /// The HTTP API instance executing the deal calls.
+        private let _api: API
+        /// The writer journaling the deal calls (if any).
+        private let _journal: Database.JournalWriter?
+        /// The subject forwarding the orders' lifecycle events.
+        private let _subject: PassthroughSubject<Event,Never>
+        /// The trigger level books for every epic (for both bid and ask prices).
+        private var _books: [IG.Market.Epic:_Books]
+        /// All armed orders indexed by identifier.
+        private var _armed: [UUID:_Armed]
+        /// The identifiers of the armed orders for every group.
+        private var _groups: [UUID:Set<UUID>]
+        /// The one-cancels-other siblings suspended while the deal of the triggered order (the key) is being confirmed.
+        private var _suspended: [UUID:[_Armed]]
+        /// The ongoing deal calls (a `nil` value marks a call whose subscription is still being set up).
+        private var _executions: [UUID:AnyCancellable?]
+        /// The latest evaluated prices for every epic (only tracked when journaling).
+        private var _quotes: [IG.Market.Epic:(bid: Decimal64?, ask: Decimal64?)]
+
+        /// Designated initializer.
+        /// - parameter api: The HTTP API instance executing the deal calls.
+        /// - parameter journal: If given, the lifecycle of every deal call is recorded on this writer.
+        public init(api: API, journal: Database.JournalWriter? = nil) {
+            self._lock = UnfairLock()
+            self._api = api
+            self._journal = journal
+            self._subject = PassthroughSubject()
+            self._books = .init()
+            self._armed = .init()
+            self._groups = .init()
+            self._suspended = .init()
+            self._executions = .init()
+            self._quotes = .init()
+        }
+
+        deinit {
+            self._executions.values.forEach { $0?.cancel() }
+            self._lock.invalidate()
+            self._subject.send(completion: .finished)
+        }
+
+        /// Publisher forwarding the lifecycle events of all managed orders.
+        public var events: AnyPublisher<Event,Never> {
+            self._subject.eraseToAnyPublisher()
+        }
+
+        /// The orders currently armed (i.e. waiting for their triggers).
+        public var armedOrders: [Order] {
+            self._lock.execute { self._armed.values.map { $0.order } }
+        }
+
+        /// Arms all orders of the given group.
+        /// - parameter group: The order group to arm.
+        public func submit(_ group: Group) {
+            self._lock.lock()
+            self._arm(group, parentDeal: nil)
+            self._lock.unlock()
+        }
+
+        /// Disarms all orders (still armed) of the given group.
+        /// - parameter id: The group identifier.
+        /// - returns: The disarmed orders.
+        @discardableResult public func cancel(group id: UUID) -> [Order] {
+            self._lock.lock()
+            var orders = (self._groups.removeValue(forKey: id) ?? .init()).compactMap { self._disarm($0)?.order }
+            // Siblings suspended while a triggered order of the group is being executed are cancelled as well.
+            for (trigger, siblings) in self._suspended where siblings.first?.group == id {
+                self._suspended.removeValue(forKey: trigger)
+                orders.append(contentsOf: siblings.map { $0.order })
+            }
+            self._lock.unlock()
+
+            orders.forEach { self._subject.send(.cancelled($0)) }
+            return orders
+        }
+
+        /// Evaluates the given prices for a market, executing all triggered orders.
+        /// - complexity: O(log n + triggered)
+        /// - parameter epic: The market epic.
+        /// - parameter bid: The latest bid price (if any).
+        /// - parameter ask: The latest ask price (if any).
+        public func evaluate(epic: IG.Market.Epic, bid: Decimal64?, ask: Decimal64?) {
+            self._lock.lock()
+            if self._journal != nil {
+                let previous = self._quotes[epic]
+                self._quotes[epic] = (bid ?? previous?.bid, ask ?? previous?.ask)
+            }
+            guard self._books[epic] != nil else { return self._lock.unlock() }
+
+            var events: [Event] = []
+            var triggered: [(order: Order, parentDeal: IG.Deal.Identifier?)] = []
+            for (side, price) in [(Trigger.Side.bid, bid), (Trigger.Side.ask, ask)] {
+                guard let price = price else { continue }
+                let (rising, falling) = self._books[epic]!.trigger(side: side, price: price)
+                for id in rising + falling {
+                    // The order may have been disarmed by a sibling triggered on this same evaluation.
+                    guard let armed = self._armed.removeValue(forKey: id) else { continue }
+                    triggered.append((armed.order, armed.parentDeal))
+                    events.append(.triggered(armed.order, price: price))
+                    // Suspend the rest of the group if it is one-cancels-other (till the deal is confirmed).
+                    guard let siblings = self._groups.removeValue(forKey: armed.group) else { continue }
+                    guard case .oneCancelsOther = armed.policy else {
+                        let remaining = siblings.subtracting([id])
+                        if !remaining.isEmpty { self._groups[armed.group] = remaining }
+                        continue
+                    }
+                    let suspended = siblings.subtracting([id]).compactMap { self._disarm($0) }
+                    if !suspended.isEmpty { self._suspended[id] = suspended }
+                }
+            }
+
+            if self._books[epic]?.isEmpty ?? false { self._books.removeValue(forKey: epic) }
+            // The quote at trigger time is journaled as the decision quote of the triggered orders.
+            let quote = self._quotes[epic].flatMap { (latest) in latest.bid.flatMap { (bid) in latest.ask.map { (bid: bid, ask: $0) } } }
+            self._lock.unlock()
+
+            // Deal calls are fired before forwarding any event to reduce the reaction time.
+            triggered.forEach { self._execute($0.order, parentDeal: $0.parentDeal, quote: quote) }
+            events.forEach { self._subject.send($0) }
+        }
+
+        /// Evaluates the prices of the given market update, executing all triggered orders.
+        /// - parameter market: The streamed market update.
+        public func evaluate(_ market: Streamer.Market) {
+            self.evaluate(epic: market.epic, bid: market.bid, ask: market.ask)
+        }
+    }
+}
+
+extension Services.ConditionalOrders {
+    /// The price condition triggering an order.
+    public struct Trigger {
+        /// The market epic being watched.
+        public let epic: IG.Market.Epic
+        /// The price side being watched.
+        public let side: Self.Side
+        /// The price level triggering the order.
+        public let level: Decimal64
+        /// The price movement triggering the order.
+        public let direction: Self.Direction
+
+        /// Designated initializer.
+        /// - parameter epic: The market epic being watched.
+        /// - parameter side: The price side being watched.
+        /// - parameter level: The price level triggering the order.
+        /// - parameter direction: The price movement triggering the order.
+        public init(epic: IG.Market.Epic, side: Self.Side, level: Decimal64, direction: Self.Direction) {
+            self.epic = epic
+            self.side = side
+            self.level = level
+            self.direction = direction
+        }
+
+        /// The price side being watched.
+        public enum Side: Hashable {
+            /// The bid (sell) price.
+            case bid
+            /// The ask/offer (buy) price.
+            case ask
+        }
+
+        /// The price movement triggering the order.
+        public enum Direction: Hashable {
+            /// The order triggers when the price is at or above the level.
+            case above
+            /// The order triggers when the price is at or below the level.
+            case below
+        }
+    }
+
+    /// The deal call performed when an order triggers.
+    public enum Action {
+        /// Opens a market position on the trigger's epic.
+        case createPosition(expiry: IG.Market.Expiry, currency: Currency.Code?, direction: IG.Deal.Direction, size: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.Position.Stop?)
+        /// Closes one or more positions at market.
+        /// - parameter identification: The positions to close. If `nil`, the position opened by the parent order is closed.
+        /// - parameter direction: Opposite direction of the position being closed.
+        /// - parameter size: The amount of contracts to close.
+        case closePosition(matchedBy: API.Request.Deals.Identification?, direction: IG.Deal.Direction, size: Decimal64)
+        /// Deletes a server-side working order.
+        case deleteWorkingOrder(id: IG.Deal.Identifier)
+    }
+
+    /// A conditional order.
+    public struct Order: Identifiable {
+        /// The order identifier.
+        public let id: UUID
+        /// The price condition triggering the order.
+        public let trigger: Trigger
+        /// The deal call performed when the order triggers.
+        public let action: Action
+        /// Group of contingent orders armed once this order's deal call succeeds.
+        public let then: Group?
+
+        /// Designated initializer.
+        /// - parameter id: The order identifier.
+        /// - parameter trigger: The price condition triggering the order.
+        /// - parameter action: The deal call performed when the order triggers.
+        /// - parameter then: Group of contingent orders armed once this order's deal call succeeds.
+        public init(id: UUID = UUID(), trigger: Trigger, action: Action, then: Group? = nil) {
+            self.id = id
+            self.trigger = trigger
+            self.action = action
+            self.then = then
+        }
+    }
+
+    /// A set of orders armed together.
+    public struct Group: Identifiable {
+        /// The group identifier.
+        public let id: UUID
+        /// The orders in the group.
+        public let orders: [Order]
+        /// How the triggering of an order affects its siblings.
+        public let policy: Self.Policy
+
+        /// Designated initializer.
+        /// - parameter id: The group identifier.
+        /// - parameter orders: The orders in the group.
+        /// - parameter policy: How the triggering of an order affects its siblings.
+        public init(id: UUID = UUID(), orders: [Order], policy: Self.Policy) {
+            self.id = id
+            self.orders = orders
+            self.policy = policy
+        }
+
+        /// How the triggering of an order affects its siblings.
+        public enum Policy: Hashable {
+            /// Every order triggers independently.
+            case independent
+            /// The first order triggering disarms all its siblings.
+            case oneCancelsOther
+        }
+
+        /// Group containing a single if-touched order.
+        /// - parameter order: The order executed when its trigger is touched.
+        public static func ifTouched(_ order: Order) -> Self {
+            Self(orders: [order], policy: .independent)
+        }
+
+        /// Group where the first order triggering disarms the rest.
+        /// - parameter orders: The mutually exclusive orders.
+        public static func oneCancelsOther(_ orders: [Order]) -> Self {
+            Self(orders: orders, policy: .oneCancelsOther)
+        }
+
+        /// Group containing an entry order which, once executed, arms a take-profit and a stop-loss order (one-cancels-other) closing the opened position.
+        /// - parameter trigger: The price condition opening the position.
+        /// - parameter expiry: The instrument expiry.
+        /// - parameter currency: The position currency.
+        /// - parameter direction: The direction of the opened position.
+        /// - parameter size: The position size.
+        /// - parameter takeProfit: The price level closing the position with a profit.
+        /// - parameter stopLoss: The price level closing the position with a loss.
+        public static func bracket(entry trigger: Trigger, expiry: IG.Market.Expiry = .none, currency: Currency.Code?, direction: IG.Deal.Direction, size: Decimal64, takeProfit: Decimal64, stopLoss: Decimal64) -> Self {
+            // A long position is closed by selling (at the bid price); a short position by buying (at the ask price).
+            let side: Trigger.Side = (direction == .buy) ? .bid : .ask
+            let close = Action.closePosition(matchedBy: nil, direction: direction.oppossite, size: size)
+            let profit = Order(trigger: .init(epic: trigger.epic, side: side, level: takeProfit, direction: (direction == .buy) ? .above : .below), action: close)
+            let loss = Order(trigger: .init(epic: trigger.epic, side: side, level: stopLoss, direction: (direction == .buy) ? .below : .above), action: close)
+            let entry = Order(trigger: trigger, action: .createPosition(expiry: expiry, currency: currency, direction: direction, size: size, limit: nil, stop: nil), then: .oneCancelsOther([profit, loss]))
+            return .ifTouched(entry)
+        }
+    }
+
+    /// Lifecycle events for the managed orders.
+    public enum Event {
+        /// The order trigger has been reached and its deal call has been fired.
+        case triggered(Order, price: Decimal64)
+        /// The order deal has been confirmed as accepted.
+        case executed(Order, reference: IG.Deal.Reference)
+        /// The order deal has been confirmed as rejected (its one-cancels-other siblings are re-armed).
+        case rejected(Order, reference: IG.Deal.Reference, reason: API.Confirmation.Deal.Status.RejectionReason?)
+        /// The order has been disarmed (whether by a one-cancels-other sibling or by the user).
+        case cancelled(Order)
+        /// The order deal call has failed (its one-cancels-other siblings are re-armed).
+        case failed(Order, error: IG.Error)
+    }
+}
+
+// MARK: -
+
+private extension Services.ConditionalOrders {
+    /// An order waiting for its trigger.
+    struct _Armed {
+        /// The armed order.
+        let order: Services.ConditionalOrders.Order
+        /// The identifier of the group the order belongs to.
+        let group: UUID
+        /// The group's policy.
+        let policy: Group.Policy
+        /// The deal identifier of the position opened by the parent order (if any).
+        let parentDeal: IG.Deal.Identifier?
+    }
+
+    /// The bid and ask trigger books for a single epic.
+    struct _Books {
+        typealias Book = TriggerBook<Decimal64,UUID>
+
+        /// Triggers watching the bid price.
+        private var _bid = Book()
+        /// Triggers watching the ask price.
+        private var _ask = Book()
+
+        /// Boolean indicating whether there are no triggers for the epic.
+        var isEmpty: Bool {
+            self._bid.isEmpty && self._ask.isEmpty
+        }
+
+        /// Adds the given order trigger.
+        mutating func insert(_ order: Services.ConditionalOrders.Order) {
+            let direction: Book.Direction = (order.trigger.direction == .above) ? .rising : .falling
+            switch order.trigger.side {
+            case .bid: self._bid.insert(order.id, level: order.trigger.level, direction: direction)
+            case .ask: self._ask.insert(order.id, level: order.trigger.level, direction: direction)
+            }
+        }
+
+        /// Removes the given order trigger.
+        mutating func remove(_ order: Services.ConditionalOrders.Order) {
+            let direction: Book.Direction = (order.trigger.direction == .above) ? .rising : .falling
+            switch order.trigger.side {
+            case .bid: self._bid.remove(order.id, level: order.trigger.level, direction: direction)
+            case .ask: self._ask.remove(order.id, level: order.trigger.level, direction: direction)
+            }
+        }
+
+        /// Removes and returns the orders triggered by the given price.
+        mutating func trigger(side: Trigger.Side, price: Decimal64) -> (rising: [UUID], falling: [UUID]) {
+            switch side {
+            case .bid: return self._bid.trigger(price: price)
+            case .ask: return self._ask.trigger(price: price)
+            }
+        }
+    }
+
+    /// Arms all orders of the given group.
+    /// - attention: This function must be called within a lock.
+    func _arm(_ group: Group, parentDeal: IG.Deal.Identifier?) {
+        guard !group.orders.isEmpty else { return }
+        for order in group.orders {
+            self._armed[order.id] = _Armed(order: order, group: group.id, policy: group.policy, parentDeal: parentDeal)
+            self._books[order.trigger.epic, default: .init()].insert(order)
+        }
+        self._groups[group.id, default: .init()].formUnion(group.orders.map { $0.id })
+    }
+
+    /// Disarms the given order.
+    /// - attention: This function must be called within a lock.
+    /// - returns: The disarmed order (if it was armed).
+    func _disarm(_ id: UUID) -> _Armed? {
+        guard let armed = self._armed.removeValue(forKey: id) else { return nil }
+        let epic = armed.order.trigger.epic
+        self._books[epic]?.remove(armed.order)
+        if self._books[epic]?.isEmpty ?? false { self._books.removeValue(forKey: epic) }
+        return armed
+    }
+
+    /// Settles the execution of a triggered order and forwards the given outcome event.
+    ///
+    /// If the deal has been accepted, the siblings suspended by the order are cancelled and its contingent orders are armed; otherwise, the suspended siblings are re-armed.
+    /// - parameter order: The triggered order.
+    /// - parameter event: The outcome event (`.executed`, `.rejected`, or `.failed`).
+    /// - parameter dealId: The deal identifier of the position the contingent orders refer to.
+    func _settle(_ order: Order, event: Event, dealId: IG.Deal.Identifier? = nil) {
+        var cancelled: [Order] = []
+
+        self._lock.lock()
+        let siblings = self._suspended.removeValue(forKey: order.id) ?? []
+        if case .executed = event {
+            cancelled = siblings.map { $0.order }
+            if let group = order.then { self._arm(group, parentDeal: dealId) }
+        } else {
+            for armed in siblings {
+                self._armed[armed.order.id] = armed
+                self._books[armed.order.trigger.epic, default: .init()].insert(armed.order)
+                self._groups[armed.group, default: .init()].insert(armed.order.id)
+            }
+        }
+        self._lock.unlock()
+
+        self._subject.send(event)
+        cancelled.forEach { self._subject.send(.cancelled($0)) }
+    }
+
+    /// Fires the deal call for a triggered order and settles it once its deal is confirmed.
+    /// - parameter order: The triggered order.
+    /// - parameter parentDeal: The deal identifier of the position opened by the parent order (if any).
+    /// - parameter quote: The latest quote for the order's epic (journaled as the decision quote).
+    func _execute(_ order: Order, parentDeal: IG.Deal.Identifier?, quote: (bid: Decimal64, ask: Decimal64)?) {
+        let deals = self._api.deals
+        let journaled = self._journal.map { deals.journaled(on: $0) }
+        let epic = order.trigger.epic
+
+        let call: AnyPublisher<IG.Deal.Reference,IG.Error>
+        switch order.action {
+        case let .createPosition(expiry, currency, direction, size, limit, stop):
+            call = journaled?.createPosition(quote: quote, epic: epic, expiry: expiry, currency: currency, direction: direction, order: .market, strategy: .execute, size: size, limit: limit, stop: stop)
+                ?? deals.createPosition(epic: epic, expiry: expiry, currency: currency, direction: direction, order: .market, strategy: .execute, size: size, limit: limit, stop: stop)
+        case let .closePosition(identification, direction, size):
+            guard let identification = identification ?? parentDeal.map({ .identifier($0) }) else {
+                return self._settle(order, event: .failed(order, error: ._unknownParentPosition()))
+            }
+            call = journaled?.closePosition(quote: quote, matchedBy: identification, direction: direction, order: .market, strategy: .execute, size: size)
+                ?? deals.closePosition(matchedBy: identification, direction: direction, order: .market, strategy: .execute, size: size)
+        case .deleteWorkingOrder(let id):
+            call = journaled?.deleteWorkingOrder(id: id) ?? deals.deleteWorkingOrder(id: id)
+        }
+
+        // A deal reference only means the request has been received; the confirmation states whether the deal has been accepted.
+        let publisher = call.flatMap { (reference) in
+            (journaled?.getConfirmation(reference: reference) ?? deals.getConfirmation(reference: reference)).map { (reference, $0) }
+        }
+
+        // The execution is marked as pending before subscribing, since the call may complete synchronously (e.g. invalid payloads).
+        self._lock.execute { self._executions[order.id] = .some(nil) }
+        let cancellable = publisher.sink(receiveCompletion: { [weak self] in
+            guard let self = self else { return }
+            self._lock.execute { _ = self._executions.removeValue(forKey: order.id) }
+            guard case .failure(let error) = $0 else { return }
+            self._settle(order, event: .failed(order, error: error))
+        }, receiveValue: { [weak self] (reference, confirmation) in
+            guard let self = self else { return }
+            switch confirmation.deal.status {
+            case .accepted:
+                // Contingent orders refer to the position opened by this order (or the one referred by its parent).
+                let dealId: IG.Deal.Identifier?
+                if case .createPosition = order.action { dealId = confirmation.deal.id } else { dealId = parentDeal }
+                self._settle(order, event: .executed(order, reference: reference), dealId: dealId)
+            case .rejected(let reason):
+                self._settle(order, event: .rejected(order, reference: reference, reason: reason))
+            }
+        })
+
+        self._lock.execute {
+            guard self._executions.index(forKey: order.id) != nil else { return }
+            self._executions[order.id] = .some(cancellable)
+        }
+    }
+}
+
+extension Publisher where Output==Streamer.Market {
+    /// Evaluates every market update received from upstream against the given conditional orders manager.
+    /// - parameter manager: The manager holding the armed conditional orders.
+    public func executeConditionalOrders(on manager: Services.ConditionalOrders) -> Publishers.HandleEvents<Self> {
+        self.handleEvents(receiveOutput: { manager.evaluate($0) })
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when a contingent order tries to close the position opened by its parent, but such position is unknown.
+    static func _unknownParentPosition() -> Self {
+        Self(.api(.invalidRequest), "The position to close couldn't be identified.", help: "Orders closing the parent position with no explicit identification must be contingent on a position creation order.")
+    }
+}
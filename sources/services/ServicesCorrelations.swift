@@ -0,0 +1,382 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Services {
+    /// Maintains the rolling covariance and correlation matrices of the log-returns of a set of markets.
+    ///
+    /// The engine keeps the window's running sums and cross-products (the upper triangle of the matrix, packed). Every new aligned bar adds its return vector and evicts the oldest one in O(N²), instead of recomputing the whole window in O(N²·W).
+    /// The cross-products are updated in contiguous blocks of rows which are processed in parallel (across `shards` cores) for large universes. To bound floating-point drift, the running sums are recomputed from the window once every `window` bars (amortized O(N²)).
+    ///
+    /// Candles of different markets are aligned by date: a bar is complete once every market has reported a finished candle for that date, or once a later candle arrives (missing markets are forward-filled, i.e. their return is zero).
+    public final class Correlations {
+        /// The tracked markets (in matrix order).
+        public let epics: [IG.Market.Epic]
+        /// The amount of returns in the rolling window.
+        public let window: Int
+        /// The number of blocks in which the matrix is partitioned for parallel updates.
+        public let shards: Int
+        /// The lock restricting access to the engine state.
+        private let _lock: UnfairLock
+        /// The matrix position of every tracked market.
+        private let _positions: [IG.Market.Epic:Int]
+        /// The first row of every shard (plus the total number of rows as the last element).
+        private let _boundaries: [Int]
+        /// The aligned bar being gathered.
+        private var _alignment: _Alignment
+        /// The window's running sums.
+        private var _state: _State
+
+        /// Designated initializer.
+        /// - precondition: `window` must be greater than one and `epics` must not be empty.
+        /// - parameter epics: The tracked markets (duplicates are ignored).
+        /// - parameter window: The amount of returns in the rolling window.
+        /// - parameter shards: The number of blocks in which the matrix is partitioned for parallel updates. If `nil`, a single block is used for small universes and a block per active core for large ones.
+        public init(epics: [IG.Market.Epic], window: Int, shards: Int? = nil) {
+            var unique: [IG.Market.Epic] = []
+            var positions: [IG.Market.Epic:Int] = [:]
+            for epic in epics where positions[epic] == nil {
+                positions[epic] = unique.count
+                unique.append(epic)
+            }
+            precondition(!unique.isEmpty, "The correlation engine needs at least one market")
+            precondition(window > 1, "The rolling window must hold at least two returns")
+
+            let dimension = unique.count
+            self.epics = unique
+            self.window = window
+            self.shards = Swift.max(1, Swift.min(dimension, shards ?? ((dimension >= 64) ? ProcessInfo.processInfo.activeProcessorCount : 1)))
+            self._lock = UnfairLock()
+            self._positions = positions
+            self._boundaries = Self._boundaries(dimension: dimension, shards: self.shards)
+            self._alignment = _Alignment(dimension: dimension)
+            self._state = _State(dimension: dimension, window: window)
+        }
+
+        deinit {
+            self._lock.invalidate()
+        }
+
+        /// The amount of returns currently in the window.
+        public var count: Int {
+            self._lock.execute { self._state.count }
+        }
+
+        /// Records the given candle.
+        ///
+        /// Only finished candles of tracked markets are considered; candles older than the last aligned bar are ignored.
+        /// - complexity: O(N²/shards) whenever a bar is completed; O(1) otherwise.
+        /// - parameter candle: A streamed (or replayed) candle.
+        public func update(_ candle: Streamer.Chart.Aggregated) {
+            guard candle.candle.isFinished ?? false,
+                  let date = candle.candle.date,
+                  let bid = candle.candle.close.bid, let ask = candle.candle.close.ask else { return }
+            self.update(epic: candle.epic, date: date, close: bid + Decimal64(5, power: -1).unsafelyUnwrapped * (ask - bid))
+        }
+
+        /// Records the close price of a market's bar.
+        /// - complexity: O(N²/shards) whenever a bar is completed; O(1) otherwise.
+        /// - parameter epic: The market epic (untracked markets are ignored).
+        /// - parameter date: The bar date.
+        /// - parameter close: The bar close (mid) price.
+        public func update(epic: IG.Market.Epic, date: Date, close: Decimal64) {
+            guard let position = self._positions[epic], let value = Double(close.description), value > 0 else { return }
+            self._lock.lock()
+            for returns in self._alignment.record(position: position, date: date, close: value) {
+                self._state.push(returns, boundaries: self._boundaries)
+            }
+            self._lock.unlock()
+        }
+
+        /// Seeds the window with the prices stored in the database.
+        ///
+        /// Only the last `window + 1` stored bars of each tracked market are read (enough to fill the window); they are aligned by date and fed in time order. Subsequent streamed candles must be newer than the stored ones.
+        /// - parameter database: The database storing the price history.
+        /// - parameter from: The date from which to consider the stored prices. If `nil`, the most recent stored bars are read whatever their date.
+        /// - returns: A publisher that completes successfully (without sending any value) once the stored prices have been recorded.
+        public func seed(database: Database, from date: Date? = nil) -> AnyPublisher<Never,IG.Error> {
+            let requests = self.epics.map { [count = self.window + 1] (epic) in
+                database.prices.getLast(count, epic: epic, from: date).map { (epic, $0) }
+            }
+            return Publishers.MergeMany(requests)
+                .collect()
+                .map { [weak self] (histories) -> Void in
+                    guard let self = self else { return }
+                    var bars: [(date: Date, epic: IG.Market.Epic, close: Decimal64)] = []
+                    for (epic, prices) in histories {
+                        bars.append(contentsOf: prices.map { ($0.date, epic, $0.close.mid) })
+                    }
+                    bars.sort { $0.date < $1.date }
+                    bars.forEach { self.update(epic: $0.epic, date: $0.date, close: $0.close) }
+                }.ignoreOutput()
+                .eraseToAnyPublisher()
+        }
+
+        /// Returns the covariance and correlation matrices of the returns currently in the window.
+        /// - complexity: O(N²).
+        public func snapshot() -> Snapshot {
+            self._lock.execute { Snapshot(epics: self.epics, date: self._alignment.lastDate, state: self._state) }
+        }
+    }
+}
+
+extension Services.Correlations {
+    /// The covariance and correlation matrices at a point in time.
+    public struct Snapshot {
+        /// The tracked markets (in matrix order).
+        public let epics: [IG.Market.Epic]
+        /// The date of the last aligned bar (or `nil` if no bar has been completed).
+        public let date: Date?
+        /// The amount of returns the matrices have been computed with.
+        public let count: Int
+        /// The sample covariance matrix of the log-returns (row-major, N×N).
+        public let covariance: [Double]
+        /// The correlation matrix of the log-returns (row-major, N×N). Markets with no variance have `nan` correlations.
+        public let correlation: [Double]
+
+        /// Returns the covariance between the given markets (or `nil` if any market is not tracked or there are not enough returns).
+        public func covariance(_ lhs: IG.Market.Epic, _ rhs: IG.Market.Epic) -> Double? {
+            self._value(self.covariance, lhs, rhs)
+        }
+
+        /// Returns the correlation between the given markets (or `nil` if any market is not tracked or there are not enough returns).
+        public func correlation(_ lhs: IG.Market.Epic, _ rhs: IG.Market.Epic) -> Double? {
+            self._value(self.correlation, lhs, rhs)
+        }
+
+        private func _value(_ matrix: [Double], _ lhs: IG.Market.Epic, _ rhs: IG.Market.Epic) -> Double? {
+            guard self.count > 1, let row = self.epics.firstIndex(of: lhs), let column = self.epics.firstIndex(of: rhs) else { return nil }
+            return matrix[row * self.epics.count + column]
+        }
+    }
+}
+
+// MARK: -
+
+private extension Services.Correlations {
+    /// Partitions the rows of the packed upper triangle in contiguous blocks holding a similar number of elements.
+    static func _boundaries(dimension: Int, shards: Int) -> [Int] {
+        let total = dimension * (dimension + 1) / 2
+        var (boundaries, accumulated) = ([0], 0)
+        for row in 0..<dimension {
+            accumulated += dimension - row
+            if boundaries.count < shards, accumulated * shards >= total * boundaries.count, row + 1 < dimension {
+                boundaries.append(row + 1)
+            }
+        }
+        boundaries.append(dimension)
+        return boundaries
+    }
+}
+
+/// Gathers the closes of every market for a given date into aligned return vectors.
+private struct _Alignment {
+    /// The date of the bar being gathered.
+    private var _date: Date?
+    /// The closes received for the bar being gathered.
+    private var _closes: [Double?]
+    /// The amount of markets which haven't reported a close for the bar being gathered.
+    private var _missing: Int
+    /// The closes of the last aligned bar.
+    private var _previous: [Double?]
+    /// The date of the last aligned bar.
+    private(set) var lastDate: Date?
+
+    init(dimension: Int) {
+        self._closes = .init(repeating: nil, count: dimension)
+        self._missing = dimension
+        self._previous = .init(repeating: nil, count: dimension)
+    }
+
+    /// Records the given close, returning the return vectors of the bars completed by it (if any).
+    mutating func record(position: Int, date: Date, close: Double) -> [[Double]] {
+        if let last = self.lastDate, date <= last { return [] }
+
+        var result: [[Double]] = []
+        switch self._date {
+        case .none: self._date = date
+        case let current? where date > current:
+            result.append(contentsOf: self._complete())
+            self._date = date
+        case let current? where date < current: return []
+        default: break
+        }
+
+        if self._closes[position] == nil { self._missing -= 1 }
+        self._closes[position] = close
+        if self._missing == 0 {
+            result.append(contentsOf: self._complete())
+        }
+        return result
+    }
+
+    /// Completes the bar being gathered (forward-filling the missing closes).
+    private mutating func _complete() -> [[Double]] {
+        defer {
+            self.lastDate = self._date
+            self._date = nil
+            for index in self._closes.indices { self._closes[index] = nil }
+            self._missing = self._closes.count
+        }
+
+        var returns: [Double] = .init(repeating: 0, count: self._closes.count)
+        var isComplete = true
+        for index in self._closes.indices {
+            let close = self._closes[index] ?? self._previous[index]
+            if let close = close, let previous = self._previous[index] {
+                returns[index] = log(close / previous)
+            } else {
+                isComplete = false
+            }
+            self._previous[index] = close
+        }
+        return isComplete ? [returns] : []
+    }
+}
+
+/// The rolling window and its running sums.
+private struct _State {
+    /// The matrix dimension (i.e. the number of tracked markets).
+    let dimension: Int
+    /// The window capacity.
+    let window: Int
+    /// The return vectors in the window (a ring buffer of `window` rows by `dimension` columns).
+    private var _returns: [Double]
+    /// The position of the oldest return vector in the ring buffer.
+    private var _head: Int
+    /// The amount of return vectors in the window.
+    private(set) var count: Int
+    /// The pushes left till the running sums are recomputed from the window.
+    private var _refresh: Int
+    /// The running sum of every market's returns.
+    private(set) var sums: [Double]
+    /// The running sums of the returns' cross-products (the upper triangle, packed by rows).
+    private(set) var products: [Double]
+
+    init(dimension: Int, window: Int) {
+        self.dimension = dimension
+        self.window = window
+        self._returns = .init(repeating: 0, count: dimension * window)
+        self._head = 0
+        self.count = 0
+        self._refresh = window
+        self.sums = .init(repeating: 0, count: dimension)
+        self.products = .init(repeating: 0, count: dimension * (dimension + 1) / 2)
+    }
+
+    /// Returns the position of the `(row, column)` element (with `row <= column`) in the packed triangle.
+    @inline(__always) func offset(row: Int, column: Int) -> Int {
+        Self.offset(row: row, column: column, dimension: self.dimension)
+    }
+
+    /// Returns the position of the `(row, column)` element (with `row <= column`) in the packed triangle of the given dimension.
+    @inline(__always) static func offset(row: Int, column: Int, dimension: Int) -> Int {
+        row * dimension - row * (row - 1) / 2 + (column - row)
+    }
+
+    /// Adds the given return vector to the window (evicting the oldest one if the window is full).
+    mutating func push(_ returns: [Double], boundaries: [Int]) {
+        let (dimension, isFull) = (self.dimension, self.count == self.window)
+        let slot = isFull ? self._head : (self._head + self.count) % self.window
+        let evicted: [Double]? = isFull ? Array(self._returns[(slot * dimension)..<((slot + 1) * dimension)]) : nil
+
+        self._returns.replaceSubrange((slot * dimension)..<((slot + 1) * dimension), with: returns)
+        if isFull { self._head = (self._head + 1) % self.window } else { self.count += 1 }
+
+        self._refresh -= 1
+        guard self._refresh > 0 else {
+            self._refresh = self.window
+            return self._recompute(boundaries: boundaries)
+        }
+
+        for index in 0..<dimension {
+            self.sums[index] += returns[index] - (evicted?[index] ?? 0)
+        }
+
+        let old = evicted ?? .init(repeating: 0, count: dimension)
+        self.products.withUnsafeMutableBufferPointer { (products) in
+            Self._perform(shards: boundaries.count - 1) { (shard) in
+                for row in boundaries[shard]..<boundaries[shard + 1] {
+                    let (new, gone) = (returns[row], old[row])
+                    var position = Self.offset(row: row, column: row, dimension: dimension)
+                    for column in row..<dimension {
+                        products[position] += new * returns[column] - gone * old[column]
+                        position += 1
+                    }
+                }
+            }
+        }
+    }
+
+    /// Recomputes the running sums from the return vectors in the window.
+    private mutating func _recompute(boundaries: [Int]) {
+        let (dimension, count, window, head) = (self.dimension, self.count, self.window, self._head)
+        let returns = self._returns
+
+        self.sums = .init(repeating: 0, count: dimension)
+        for step in 0..<count {
+            let base = ((head + step) % window) * dimension
+            for index in 0..<dimension { self.sums[index] += returns[base + index] }
+        }
+
+        self.products.withUnsafeMutableBufferPointer { (products) in
+            Self._perform(shards: boundaries.count - 1) { (shard) in
+                for row in boundaries[shard]..<boundaries[shard + 1] {
+                    var position = Self.offset(row: row, column: row, dimension: dimension)
+                    for column in row..<dimension {
+                        var total: Double = 0
+                        for step in 0..<count {
+                            let base = ((head + step) % window) * dimension
+                            total += returns[base + row] * returns[base + column]
+                        }
+                        products[position] = total
+                        position += 1
+                    }
+                }
+            }
+        }
+    }
+
+    /// Performs the given closure for every shard (in parallel if there is more than one shard).
+    private static func _perform(shards: Int, _ body: (Int) -> Void) {
+        if shards > 1 {
+            DispatchQueue.concurrentPerform(iterations: shards, execute: body)
+        } else {
+            body(0)
+        }
+    }
+}
+
+private extension Services.Correlations.Snapshot {
+    /// Computes the sample covariance and correlation matrices from the window's running sums.
+    init(epics: [IG.Market.Epic], date: Date?, state: _State) {
+        let (dimension, count) = (state.dimension, state.count)
+        var covariance = [Double](repeating: .nan, count: dimension * dimension)
+        var correlation = [Double](repeating: .nan, count: dimension * dimension)
+
+        if count > 1 {
+            let n = Double(count)
+            for row in 0..<dimension {
+                for column in row..<dimension {
+                    let value = (state.products[state.offset(row: row, column: column)] - state.sums[row] * state.sums[column] / n) / (n - 1)
+                    covariance[row * dimension + column] = value
+                    covariance[column * dimension + row] = value
+                }
+            }
+            for row in 0..<dimension {
+                for column in row..<dimension {
+                    let deviation = (covariance[row * dimension + row] * covariance[column * dimension + column]).squareRoot()
+                    let value = (deviation > 0) ? Swift.max(-1, Swift.min(1, covariance[row * dimension + column] / deviation)) : .nan
+                    correlation[row * dimension + column] = value
+                    correlation[column * dimension + row] = value
+                }
+            }
+        }
+
+        self.epics = epics
+        self.date = date
+        self.count = count
+        self.covariance = covariance
+        self.correlation = correlation
+    }
+}
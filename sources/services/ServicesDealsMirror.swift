@@ -0,0 +1,481 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Services {
+    /// Creates a local mirror of the open positions and working orders of the active account.
+    ///
+    /// The mirror is seeded through the API and then kept up to date with the streamer's trade updates (OPU). Call `start()` on the returned instance to begin mirroring.
+    /// - parameter interval: The time (in seconds) between reconciliations with the API. If `nil`, no reconciliation is performed.
+    /// - throws: `IG.Error` exclusively.
+    public func dealsMirror(reconciliationInterval interval: TimeInterval? = 60) throws -> DealsMirror {
+        guard let account = self.api.channel.credentials?.account else { throw IG.Error._unfoundAPICredentials() }
+        return DealsMirror(api: self.api, streamer: self.streamer, account: account, reconciliationInterval: interval)
+    }
+}
+
+extension Services {
+    /// Local, stream-maintained mirror of the open positions and working orders for a given account.
+    ///
+    /// The mirror is seeded from `api.deals.getPositions()` and `api.deals.getWorkingOrders()` and it then applies the opened/updated/deleted events received on the account's `TRADE` subscription.
+    /// Periodically, the mirror state is reconciled with the API to repair any drift (e.g. missed streaming events during a reconnection).
+    ///
+    /// All queries are answered locally (without network calls) from indexed storage.
+    /// - note: Streaming updates received while seeding/reconciling take precedence over the API response for the same deal.
+    public final class DealsMirror {
+        /// The lock restricting access to the mirror state.
+        private let _lock: UnfairLock
+        /// The HTTP API instance used to seed and reconcile the mirror.
+        private let _api: API
+        /// The streamer instance providing the trade updates.
+        private let _streamer: Streamer
+        /// The time between reconciliations (if any).
+        private let _interval: TimeInterval?
+        /// The subject forwarding the mirror's events.
+        private let _subject: PassthroughSubject<Event,IG.Error>
+        /// The account being mirrored.
+        public let account: IG.Account.Identifier
+        /// The mirror lifecycle state.
+        private var _state: _State
+        /// All mirrored deals indexed by identifier.
+        private var _deals: [IG.Deal.Identifier:Deal]
+        /// Deal identifiers indexed by market epic.
+        private var _epics: [IG.Market.Epic:Set<IG.Deal.Identifier>]
+        /// Deal identifiers indexed by direction.
+        private var _directions: [IG.Deal.Direction:Set<IG.Deal.Identifier>]
+        /// The deals modified by streaming updates while an API snapshot is being fetched (`nil` if there is no ongoing fetch).
+        private var _touched: Set<IG.Deal.Identifier>?
+        /// The trade updates subscription.
+        private var _subscription: AnyCancellable?
+        /// The ongoing API fetch.
+        private var _request: AnyCancellable?
+        /// The next scheduled reconciliation.
+        private var _timer: AnyCancellable?
+
+        /// Designated initializer.
+        /// - parameter api: The HTTP API instance used to seed and reconcile the mirror.
+        /// - parameter streamer: The streamer instance providing the trade updates.
+        /// - parameter account: The account being mirrored.
+        /// - parameter interval: The time (in seconds) between reconciliations with the API. If `nil`, no reconciliation is performed.
+        public init(api: API, streamer: Streamer, account: IG.Account.Identifier, reconciliationInterval interval: TimeInterval? = 60) {
+            self._lock = UnfairLock()
+            self._api = api
+            self._streamer = streamer
+            self._interval = interval.map { Swift.max(1, $0) }
+            self._subject = PassthroughSubject()
+            self.account = account
+            self._state = .idle
+            self._deals = .init()
+            self._epics = .init()
+            self._directions = .init()
+        }
+
+        deinit {
+            self._stop(completion: .finished)
+            self._lock.invalidate()
+        }
+
+        /// Publisher forwarding every change on the mirror.
+        ///
+        /// The publisher fails if the trade updates subscription fails or finishes (e.g. when the streamer disconnects), since the mirror can't be kept up to date anymore; the mirror is then terminated and a new one must be started once the streamer reconnects.
+        /// API errors during reconciliation are ignored (the next reconciliation will try again).
+        public var events: AnyPublisher<Event,IG.Error> {
+            self._subject.eraseToAnyPublisher()
+        }
+
+        /// Starts mirroring: it subscribes to the account trade updates and seeds the mirror from the API.
+        ///
+        /// Calling this function more than once has no effect.
+        public func start() {
+            self._lock.lock()
+            guard case .idle = self._state else { return self._lock.unlock() }
+            self._state = .seeding
+            self._touched = Set()
+            self._lock.unlock()
+
+            let account = self.account
+            let subscription = self._streamer.deals.subscribe(account: self.account, fields: [.updates], snapshot: false)
+                .sink(receiveCompletion: { [weak self] in
+                    // A finished subscription (e.g. streamer disconnection) stops the trade updates as much as a failing one.
+                    switch $0 {
+                    case .failure(let error): self?._stop(completion: .failure(error))
+                    case .finished: self?._stop(completion: .failure(._interruptedTradeUpdates(account: account)))
+                    }
+                }, receiveValue: { [weak self] in
+                    guard let update = $0.update else { return }
+                    self?._apply(update: update)
+                })
+
+            self._lock.lock()
+            guard case .seeding = self._state else { self._lock.unlock(); return subscription.cancel() }
+            self._subscription = subscription
+            self._lock.unlock()
+
+            self._fetch(isSeed: true)
+        }
+
+        /// Stops mirroring (the mirrored deals are kept but they won't be updated anymore).
+        public func stop() {
+            self._stop(completion: .finished)
+        }
+
+        /// Boolean indicating whether the mirror has been seeded and it is currently being kept up to date.
+        ///
+        /// It turns `false` as soon as the trade updates subscription completes (e.g. when the streamer disconnects).
+        public var isReady: Bool {
+            self._lock.execute {
+                guard case .ready = self._state else { return false }
+                return true
+            }
+        }
+
+        /// Returns the mirrored deal with the given identifier (if any).
+        /// - parameter id: The deal identifier.
+        public func deal(id: IG.Deal.Identifier) -> Deal? {
+            self._lock.execute { self._deals[id] }
+        }
+
+        /// Returns the mirrored deals (whether positions or working orders) matching all the given criteria.
+        /// - parameter epic: The market epic of the targeted deals. If `nil`, deals from all markets are returned.
+        /// - parameter direction: The direction of the targeted deals. If `nil`, both directions are returned.
+        public func deals(epic: IG.Market.Epic? = nil, direction: IG.Deal.Direction? = nil) -> [Deal] {
+            self._lock.execute { self._filter(epic: epic, direction: direction) { _ in true } }
+        }
+
+        /// Returns the open positions matching all the given criteria.
+        /// - parameter epic: The market epic of the targeted positions. If `nil`, positions from all markets are returned.
+        /// - parameter direction: The direction of the targeted positions. If `nil`, both directions are returned.
+        public func positions(epic: IG.Market.Epic? = nil, direction: IG.Deal.Direction? = nil) -> [Deal] {
+            self._lock.execute { self._filter(epic: epic, direction: direction) { $0.kind.isPosition } }
+        }
+
+        /// Returns the working orders matching all the given criteria.
+        /// - parameter epic: The market epic of the targeted working orders. If `nil`, working orders from all markets are returned.
+        /// - parameter direction: The direction of the targeted working orders. If `nil`, both directions are returned.
+        public func workingOrders(epic: IG.Market.Epic? = nil, direction: IG.Deal.Direction? = nil) -> [Deal] {
+            self._lock.execute { self._filter(epic: epic, direction: direction) { !$0.kind.isPosition } }
+        }
+
+        /// Forces a reconciliation with the API outside the regular schedule.
+        ///
+        /// If the mirror is not ready or there is already an ongoing reconciliation, this function has no effect.
+        public func reconcile() {
+            self._lock.lock()
+            guard case .ready = self._state, self._touched == nil else { return self._lock.unlock() }
+            self._touched = Set()
+            self._lock.unlock()
+
+            self._fetch(isSeed: false)
+        }
+    }
+}
+
+extension Services.DealsMirror {
+    /// A mirrored position or working order.
+    public struct Deal: Identifiable {
+        /// Permanent deal reference for a confirmed trade.
+        public let id: IG.Deal.Identifier
+        /// Instrument epic identifier.
+        public let epic: IG.Market.Epic
+        /// The type of deal.
+        public let kind: Self.Kind
+        /// Deal direction.
+        public let direction: IG.Deal.Direction
+        /// Deal size.
+        public let size: Decimal64
+        /// Level (instrument price) at which the position was opened or the working order will be triggered.
+        public let level: Decimal64
+        /// The limit used on this deal (if any).
+        public let limit: IG.Deal.Boundary?
+        /// The stop used on this deal (if any).
+        public let stop: IG.Deal.Boundary?
+        /// The date of the last update received for this deal.
+        public let date: Date
+
+        /// The type of deal.
+        public enum Kind {
+            /// The deal is a market open position.
+            case position
+            /// The deal is a working order, not yet open as a position in the market.
+            /// - parameter type: The working order type.
+            /// - parameter expiration: Indicates when the working order expires if its triggers hasn't been met.
+            case workingOrder(_ type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration)
+
+            /// Boolean indicating whether the receiving kind is a position.
+            @_transparent public var isPosition: Bool {
+                guard case .position = self else { return false }
+                return true
+            }
+        }
+    }
+
+    /// Events emitted by the deals mirror.
+    public enum Event {
+        /// The mirror has been seeded from the API.
+        /// - parameter deals: The seeded deals.
+        case seeded([Deal])
+        /// A new deal has been opened (or found during reconciliation).
+        case opened(Deal)
+        /// An existing deal has been amended.
+        case updated(Deal)
+        /// A deal has been closed/deleted.
+        case deleted(Deal)
+    }
+}
+
+// MARK: -
+
+private extension Services.DealsMirror {
+    /// The mirror lifecycle states.
+    enum _State {
+        /// The mirror hasn't been started yet.
+        case idle
+        /// The trade updates are being received, but the API snapshot hasn't arrived yet.
+        case seeding
+        /// The mirror is seeded and kept up to date.
+        case ready
+        /// The mirror has been stopped or it has failed.
+        case terminated
+    }
+
+    /// Applies a streamed trade update to the mirror.
+    /// - parameter update: The received position/working order update.
+    func _apply(update: Streamer.Update) {
+        guard case .accepted = update.deal.status else { return }
+
+        self._lock.lock()
+        switch self._state {
+        case .seeding, .ready: break
+        case .idle, .terminated: return self._lock.unlock()
+        }
+
+        let id = update.deal.id
+        self._touched?.insert(id)
+
+        let event: Event?
+        switch update.details.status {
+        case .deleted:
+            event = self._remove(id: id).map { .deleted($0) }
+        case .opened, .updated:
+            let deal = Deal(id: id, date: update.date, details: update.details)
+            event = (self._insert(deal) == nil) ? .opened(deal) : .updated(deal)
+        }
+
+        // Events are only forwarded once the mirror has been seeded.
+        let isReady: Bool
+        if case .ready = self._state { isReady = true } else { isReady = false }
+        self._lock.unlock()
+
+        if isReady, let event = event { self._subject.send(event) }
+    }
+
+    /// Fetches the positions and working orders from the API and merges them into the mirror.
+    /// - parameter isSeed: Boolean indicating whether this is the initial seed (`true`) or a reconciliation (`false`).
+    func _fetch(isSeed: Bool) {
+        let deals = self._api.deals
+        let cancellable = deals.getPositions()
+            .zip(deals.getWorkingOrders())
+            .sink(receiveCompletion: { [weak self] in
+                guard case .failure(let error) = $0, let self = self else { return }
+                self._lock.lock()
+                self._touched = nil
+                self._request = nil
+                self._lock.unlock()
+                // A failing seed terminates the mirror; a failing reconciliation is retried on the next scheduled time.
+                if isSeed { self._stop(completion: .failure(error)) }
+            }, receiveValue: { [weak self] (positions, workingOrders) in
+                guard let self = self else { return }
+                let date = self._api.clock.now
+                let snapshot = positions.map { Deal(position: $0, date: date) } + workingOrders.map { Deal(workingOrder: $0, date: date) }
+                self._merge(snapshot: snapshot, isSeed: isSeed)
+            })
+
+        self._lock.lock()
+        switch self._state {
+        case .seeding, .ready: self._request = cancellable
+        case .idle, .terminated: cancellable.cancel()
+        }
+        self._lock.unlock()
+    }
+
+    /// Replaces the mirror content with the API snapshot, except for the deals touched by streaming updates during the fetch.
+    /// - parameter snapshot: The deals returned by the API.
+    /// - parameter isSeed: Boolean indicating whether this is the initial seed (`true`) or a reconciliation (`false`).
+    func _merge(snapshot: [Deal], isSeed: Bool) {
+        self._lock.lock()
+        switch self._state {
+        case .seeding, .ready: break
+        case .idle, .terminated: return self._lock.unlock()
+        }
+
+        let touched = self._touched ?? .init()
+        self._touched = nil
+        self._request = nil
+
+        var events: [Event] = []
+        var remaining = Set(self._deals.keys)
+        for deal in snapshot {
+            remaining.remove(deal.id)
+            guard !touched.contains(deal.id) else { continue }
+            switch self._insert(deal) {
+            case .none: events.append(.opened(deal))
+            case let previous? where !previous._isEquivalent(to: deal): events.append(.updated(deal))
+            case .some: continue
+            }
+        }
+        for id in remaining where !touched.contains(id) {
+            if let deal = self._remove(id: id) { events.append(.deleted(deal)) }
+        }
+
+        if isSeed {
+            self._state = .ready
+            events = [.seeded(Array(self._deals.values))]
+            self._scheduleTimer()
+        }
+        self._lock.unlock()
+
+        events.forEach { self._subject.send($0) }
+    }
+
+    /// Returns the deals matching the given indices and filter.
+    /// - attention: This function must be called within a lock.
+    func _filter(epic: IG.Market.Epic?, direction: IG.Deal.Direction?, where filter: (Deal) -> Bool) -> [Deal] {
+        let ids: Set<IG.Deal.Identifier>
+        switch (epic, direction) {
+        case (let e?, let d?): ids = self._epics[e, default: .init()].intersection(self._directions[d, default: .init()])
+        case (let e?, .none):  ids = self._epics[e, default: .init()]
+        case (.none, let d?):  ids = self._directions[d, default: .init()]
+        case (.none, .none):   return self._deals.values.filter(filter)
+        }
+
+        return ids.compactMap {
+            guard let deal = self._deals[$0], filter(deal) else { return nil }
+            return deal
+        }
+    }
+
+    /// Inserts (or replaces) a deal, updating all indices.
+    /// - attention: This function must be called within a lock.
+    /// - returns: The previous deal with the same identifier (if any).
+    func _insert(_ deal: Deal) -> Deal? {
+        let previous = self._deals.updateValue(deal, forKey: deal.id)
+        if let previous = previous {
+            self._epics[previous.epic]?.remove(previous.id)
+            self._directions[previous.direction]?.remove(previous.id)
+        }
+        self._epics[deal.epic, default: .init()].insert(deal.id)
+        self._directions[deal.direction, default: .init()].insert(deal.id)
+        return previous
+    }
+
+    /// Removes a deal, updating all indices.
+    /// - attention: This function must be called within a lock.
+    /// - returns: The removed deal (if any).
+    func _remove(id: IG.Deal.Identifier) -> Deal? {
+        guard let deal = self._deals.removeValue(forKey: id) else { return nil }
+        self._epics[deal.epic]?.remove(id)
+        if self._epics[deal.epic]?.isEmpty ?? false { self._epics.removeValue(forKey: deal.epic) }
+        self._directions[deal.direction]?.remove(id)
+        return deal
+    }
+
+    /// Schedules the next reconciliation on the API clock (if a reconciliation interval was given).
+    /// - attention: This function must be called within a lock.
+    func _scheduleTimer() {
+        guard let interval = self._interval, self._timer == nil else { return }
+
+        let date = self._api.clock.now.addingTimeInterval(interval)
+        self._timer = self._api.clock.schedule(at: date, on: self._api.queue) { [weak self] in
+            guard let self = self else { return }
+            self._lock.lock()
+            self._timer = nil
+            guard case .ready = self._state else { return self._lock.unlock() }
+            self._scheduleTimer()
+            self._lock.unlock()
+            self.reconcile()
+        }
+    }
+
+    /// Stops all mirroring activity and (optionally) forwards a completion event downstream.
+    /// - parameter completion: The completion to forward.
+    func _stop(completion: Subscribers.Completion<IG.Error>) {
+        self._lock.lock()
+        if case .terminated = self._state { return self._lock.unlock() }
+        self._state = .terminated
+        let (subscription, request, timer) = (self._subscription, self._request, self._timer)
+        (self._subscription, self._request, self._timer, self._touched) = (nil, nil, nil, nil)
+        self._lock.unlock()
+
+        timer?.cancel()
+        request?.cancel()
+        subscription?.cancel()
+        self._subject.send(completion: completion)
+    }
+}
+
+private extension Services.DealsMirror.Deal {
+    /// Creates a mirrored deal from an API position.
+    init(position: API.Position, date: Date) {
+        self.id = position.id
+        self.epic = position.epic
+        self.kind = .position
+        self.direction = position.direction
+        self.size = position.size
+        self.level = position.level
+        self.limit = position.limitLevel.map { .level($0) }
+        self.stop = position.stop.map { .level($0.level) }
+        self.date = date
+    }
+
+    /// Creates a mirrored deal from an API working order.
+    init(workingOrder: API.WorkingOrder, date: Date) {
+        self.id = workingOrder.id
+        self.epic = workingOrder.epic
+        self.kind = .workingOrder(workingOrder.type, expiration: workingOrder.expiration)
+        self.direction = workingOrder.direction
+        self.size = workingOrder.size
+        self.level = workingOrder.level
+        self.limit = workingOrder.limitDistance.map { .distance($0) }
+        self.stop = workingOrder.stop.map { .distance($0.distance) }
+        self.date = date
+    }
+
+    /// Creates a mirrored deal from a streamed trade update.
+    init(id: IG.Deal.Identifier, date: Date, details: Streamer.Update.Details) {
+        self.id = id
+        self.epic = details.epic
+        switch details.type {
+        case .position: self.kind = .position
+        case .workingOrder(let type, let expiration, _): self.kind = .workingOrder(type, expiration: expiration)
+        }
+        self.direction = details.direction
+        self.size = details.size
+        self.level = details.level
+        self.limit = details.limit
+        self.stop = details.stop?.type
+        self.date = date
+    }
+
+    /// Boolean indicating whether both deals hold the same trading values (disregarding the update date).
+    func _isEquivalent(to other: Self) -> Bool {
+        guard self.id == other.id, self.epic == other.epic, self.direction == other.direction,
+              self.size == other.size, self.level == other.level,
+              self.limit == other.limit, self.stop == other.stop else { return false }
+        switch (self.kind, other.kind) {
+        case (.position, .position): return true
+        case (.workingOrder(let lt, let le), .workingOrder(let rt, let re)): return lt == rt && le == re
+        default: return false
+        }
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when there are no credentials on the API instance.
+    static func _unfoundAPICredentials() -> Self {
+        Self(.api(.sessionExpired), "No credentials were found on the API instance.", help: "Log in with your username and password.")
+    }
+    /// Error raised when the trade updates subscription completes while the mirror is running.
+    static func _interruptedTradeUpdates(account: IG.Account.Identifier) -> Self {
+        Self(.streamer(.subscriptionFailed), "The trade updates subscription has finished.", help: "The streamer has probably been disconnected. Start a new mirror once the streamer is connected again.", info: ["Account": account])
+    }
+}
@@ -0,0 +1,535 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Services {
+    /// Creates a pre-trade risk engine validating orders in memory against cached dealing rules, exposure and margin.
+    ///
+    /// Call `refresh(epics:)` on the returned instance to populate its caches before validating orders.
+    /// - parameter limits: User-defined risk limits applied on top of the broker's dealing rules.
+    public func riskEngine(limits: RiskEngine.Limits = .init()) -> RiskEngine {
+        RiskEngine(api: self.api, limits: limits)
+    }
+}
+
+extension Services {
+    /// Pre-trade risk engine validating proposed orders in memory before they are sent to the server.
+    ///
+    /// The engine caches the dealing rules and margin bands of every refreshed market, the net exposure of the open positions, and the funds available for trading.
+    /// Orders breaking a dealing rule (e.g. minimum deal size or stop distance), a user-defined limit, or the available margin are rejected locally without spending a round trip or rate-limit budget.
+    ///
+    /// Positions created through the engine reserve their exposure, position slot, and margin as soon as they pass the checks; thus, a burst of orders is checked against each other.
+    /// A reservation is reverted if its deal call fails, and it is superseded by the server values on the next `refresh(epics:)` (or `update(positions:)`/`update(account:)`).
+    /// - note: The checks are a best-effort mirror of the server rules; an order passing them may still be rejected by the server (e.g. if the cached values are stale).
+    public final class RiskEngine {
+        /// The lock restricting access to the engine caches.
+        private let _lock: UnfairLock
+        /// The HTTP API instance used to refresh the caches and send the validated orders.
+        private let _api: API
+        /// User-defined risk limits applied on top of the broker's dealing rules.
+        public let limits: Limits
+        /// The cached dealing rules indexed by market epic.
+        private var _markets: [IG.Market.Epic:_Market]
+        /// The net size of the open positions (positive for long positions, negative for short positions) indexed by market epic.
+        private var _exposures: [IG.Market.Epic:Decimal64]
+        /// The number of open positions.
+        private var _positions: Int
+        /// The funds available for trading (and their currency).
+        private var _funds: (available: Decimal64, currency: IG.Currency.Code?)?
+        /// Counter increased every time the exposure or funds are replaced with server values (invalidating older reservations).
+        private var _generation: Int
+
+        /// Designated initializer.
+        /// - parameter api: The HTTP API instance used to refresh the caches and send the validated orders.
+        /// - parameter limits: User-defined risk limits applied on top of the broker's dealing rules.
+        public init(api: API, limits: Limits = .init()) {
+            self._lock = UnfairLock()
+            self._api = api
+            self.limits = limits
+            self._markets = .init()
+            self._exposures = .init()
+            self._positions = 0
+            self._generation = 0
+        }
+
+        deinit {
+            self._lock.invalidate()
+        }
+
+        /// Fetches the dealing rules for the given markets, the open positions, and the active account balance; and stores them in the engine caches.
+        /// - parameter epics: The markets whose dealing rules will be cached.
+        /// - returns: Publisher completing once all caches have been refreshed.
+        public func refresh(epics: Set<IG.Market.Epic>) -> AnyPublisher<Never,IG.Error> {
+            let account = self._api.channel.credentials?.account
+            // Markets are fetched in batches (the server caps every request to 50 epics) and gathered into a single array.
+            let markets = (epics.isEmpty)
+                ? Just([API.Market]()).setFailureType(to: IG.Error.self).eraseToAnyPublisher()
+                : self._api.markets.getContinuously(epics: epics).collect().map { $0.flatMap { $0 } }.eraseToAnyPublisher()
+
+            return markets.combineLatest(self._api.deals.getPositions(), self._api.accounts.getAll())
+                .handleEvents(receiveOutput: { [weak self] (markets, positions, accounts) in
+                    guard let self = self else { return }
+                    self.update(markets: markets)
+                    self.update(positions: positions)
+                    if let account = accounts.first(where: { $0.id == account }) ?? accounts.first(where: { $0.isDefault }) {
+                        self.update(account: account)
+                    }
+                }).ignoreOutput()
+                .eraseToAnyPublisher()
+        }
+
+        /// Caches the dealing rules, margin bands, status and prices of the given markets.
+        /// - parameter markets: Markets as received from the server.
+        public func update(markets: [API.Market]) {
+            self._lock.execute {
+                for market in markets {
+                    self._markets[market.instrument.epic] = _Market(market)
+                }
+            }
+        }
+
+        /// Refreshes the status and prices of a cached market with a streamed market update.
+        ///
+        /// Updates for markets without cached dealing rules are ignored.
+        /// - parameter market: The streamed market update.
+        public func update(_ market: Streamer.Market) {
+            self._lock.lock()
+            // The cached market is mutated in place (through the dictionary subscript) to avoid copying it.
+            if self._markets[market.epic] != nil {
+                if let status = market.status { self._markets[market.epic]!.isTradeable = (status == .tradeable) }
+                if let bid = market.bid { self._markets[market.epic]!.bid = bid }
+                if let ask = market.ask { self._markets[market.epic]!.ask = ask }
+            }
+            self._lock.unlock()
+        }
+
+        /// Replaces the cached exposure with the one from the given open positions.
+        /// - parameter positions: All open positions for the active account.
+        public func update(positions: [API.Position]) {
+            var exposures: [IG.Market.Epic:Decimal64] = .init()
+            for position in positions {
+                let size = (position.direction == .buy) ? position.size : .zero - position.size
+                exposures[position.market.instrument.epic, default: .zero] = exposures[position.market.instrument.epic, default: .zero] + size
+            }
+
+            self._lock.execute {
+                self._exposures = exposures
+                self._positions = positions.count
+                self._generation += 1
+            }
+        }
+
+        /// Caches the funds available for trading on the given account.
+        /// - parameter account: The account used for trading.
+        public func update(account: API.Account) {
+            self._lock.execute {
+                self._funds = (account.balance.tradeAvailable, account.currency)
+                self._generation += 1
+            }
+        }
+
+        /// Returns the cached net exposure for the given market (positive for long exposure, negative for short exposure).
+        /// - parameter epic: The market epic.
+        public func exposure(epic: IG.Market.Epic) -> Decimal64 {
+            self._lock.execute { self._exposures[epic] ?? .zero }
+        }
+
+        /// Returns the margin required to open a deal of the given size on the targeted market.
+        /// - parameter epic: The market epic.
+        /// - parameter size: The deal size.
+        /// - parameter level: The deal level. If `nil`, the cached mid price is used.
+        /// - returns: The required margin (in the account currency) or `nil` if it cannot be computed from the cached values.
+        public func requiredMargin(epic: IG.Market.Epic, size: Decimal64, level: Decimal64? = nil) -> Decimal64? {
+            self._lock.execute {
+                guard let market = self._markets[epic] else { return nil }
+                return market.margin(size: size, level: level ?? market.mid, currency: self._funds?.currency)
+            }
+        }
+
+        /// Validates a position creation against the cached rules, exposure and margin.
+        /// - parameter epic: Instrument epic identifer.
+        /// - parameter direction: Deal direction (whether buy or sell).
+        /// - parameter order: Describes how the user's order must be executed.
+        /// - parameter size: Deal size.
+        /// - parameter limit: Optional limit level/distance at which the user will like to take profit.
+        /// - parameter stop: Optional stop at which the user doesn't want to incur more losses.
+        /// - throws: `IG.Error` exclusively.
+        /// - complexity: O(1) (no network access).
+        public func checkPosition(epic: IG.Market.Epic, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, size: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.Position.Stop?) throws {
+            try self._checkPosition(epic: epic, direction: direction, order: order, size: size, limit: limit, stop: stop, reserve: false)
+        }
+
+        /// Validates a position creation and, if `reserve` is `true`, applies its reservation within the same critical section.
+        /// - throws: `IG.Error` exclusively.
+        @discardableResult private func _checkPosition(epic: IG.Market.Epic, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, size: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.Position.Stop?, reserve: Bool) throws -> _Reservation {
+            let level: Decimal64?
+            switch order {
+            case .market: level = nil
+            case .limit(let l): level = l
+            case .quote(_, let l): level = l
+            }
+
+            let boundary: _Stop?
+            switch stop {
+            case .none: boundary = nil
+            case .level(let l, let risk): boundary = _Stop(boundary: .level(l), risk: risk, increment: nil)
+            case .distance(let d, let risk): boundary = _Stop(boundary: .distance(d), risk: risk, increment: nil)
+            case .trailing(let d, let increment): boundary = _Stop(boundary: .distance(d), risk: .exposed, increment: increment)
+            }
+
+            self._lock.lock()
+            defer { self._lock.unlock() }
+            var reservation = try self._check(epic: epic, direction: direction, size: size, level: level, isMarketOrder: (order == .market), limit: limit, stop: boundary)
+            if reserve { self._apply(&reservation) }
+            return reservation
+        }
+
+        /// Validates a working order creation against the cached rules, exposure and margin.
+        /// - parameter epic: Instrument epic identifer.
+        /// - parameter direction: Deal direction (whether buy or sell).
+        /// - parameter size: Deal size.
+        /// - parameter level: Price at which to execute the working order.
+        /// - parameter limit: The limit level/distance at which the user will like to take profit once the working order has been transformed into a position.
+        /// - parameter stop: The stop level/distance at which the user doesn't want to incur more losses once the working order has been transformed into a position.
+        /// - throws: `IG.Error` exclusively.
+        /// - complexity: O(1) (no network access).
+        public func checkWorkingOrder(epic: IG.Market.Epic, direction: IG.Deal.Direction, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?) throws {
+            let boundary: _Stop?
+            switch stop {
+            case .none: boundary = nil
+            case .level(let l, let risk): boundary = _Stop(boundary: .level(l), risk: risk, increment: nil)
+            case .distance(let d, let risk): boundary = _Stop(boundary: .distance(d), risk: risk, increment: nil)
+            }
+
+            self._lock.lock()
+            defer { self._lock.unlock() }
+            _ = try self._check(epic: epic, direction: direction, size: size, level: level, isMarketOrder: false, limit: limit, stop: boundary)
+        }
+
+        /// Validates a position creation in memory and, if it passes all checks, sends it to the server.
+        ///
+        /// The deal's exposure, position slot, and margin are reserved right away (and reverted if the deal call fails).
+        /// The parameters are the same as for `API.Request.Deals.createPosition(reference:epic:expiry:currency:direction:order:strategy:size:limit:stop:forceOpen:)`.
+        /// - returns: Publisher forwarding the transient deal reference or failing immediately if the order breaks a pre-trade check.
+        public func createPosition(reference: IG.Deal.Reference? = nil, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code?, direction: IG.Deal.Direction, order: API.Request.Deals.Position.Order, strategy: API.Request.Deals.Position.FillStrategy, size: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.Position.Stop?, forceOpen: Bool = true) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
+            let reservation: _Reservation
+            do {
+                reservation = try self._checkPosition(epic: epic, direction: direction, order: order, size: size, limit: limit, stop: stop, reserve: true)
+            } catch {
+                return Fail(error: errorCast(from: error)).eraseToAnyPublisher()
+            }
+            return self._api.deals.createPosition(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, order: order, strategy: strategy, size: size, limit: limit, stop: stop, forceOpen: forceOpen)
+                .handleEvents(receiveCompletion: { [weak self] in
+                    guard case .failure = $0 else { return }
+                    self?._revert(reservation)
+                }).eraseToAnyPublisher()
+        }
+
+        /// Validates a working order creation in memory and, if it passes all checks, sends it to the server.
+        ///
+        /// Working orders don't reserve exposure, since they only change it once they are triggered (which is reflected on the next refresh).
+        /// The parameters are the same as for `API.Request.Deals.createWorkingOrder(reference:epic:expiry:currency:direction:type:expiration:size:level:limit:stop:forceOpen:)`.
+        /// - returns: Publisher forwarding the transient deal reference or failing immediately if the order breaks a pre-trade check.
+        public func createWorkingOrder(reference: IG.Deal.Reference? = nil, epic: IG.Market.Epic, expiry: IG.Market.Expiry = .none, currency: Currency.Code, direction: IG.Deal.Direction, type: IG.Deal.WorkingOrder, expiration: IG.Deal.WorkingOrder.Expiration, size: Decimal64, level: Decimal64, limit: IG.Deal.Boundary?, stop: API.Request.Deals.WorkingOrder.Stop?, forceOpen: Bool = true) -> AnyPublisher<IG.Deal.Reference,IG.Error> {
+            do {
+                try self.checkWorkingOrder(epic: epic, direction: direction, size: size, level: level, limit: limit, stop: stop)
+            } catch {
+                return Fail(error: errorCast(from: error)).eraseToAnyPublisher()
+            }
+            return self._api.deals.createWorkingOrder(reference: reference, epic: epic, expiry: expiry, currency: currency, direction: direction, type: type, expiration: expiration, size: size, level: level, limit: limit, stop: stop, forceOpen: forceOpen)
+        }
+    }
+}
+
+extension Services.RiskEngine {
+    /// User-defined risk limits applied on top of the broker's dealing rules.
+    public struct Limits {
+        /// The maximum size of a single deal.
+        public var maximumDealSize: Decimal64?
+        /// The maximum absolute net size (summing all open positions) allowed per market.
+        public var maximumExposure: Decimal64?
+        /// The maximum number of open positions.
+        public var maximumPositions: Int?
+        /// The fraction (between 0 and 1) of the available funds that can be committed as margin by a single deal.
+        public var marginUsage: Decimal64?
+
+        /// Designated initializer.
+        /// - parameter maximumDealSize: The maximum size of a single deal.
+        /// - parameter maximumExposure: The maximum absolute net size (summing all open positions) allowed per market.
+        /// - parameter maximumPositions: The maximum number of open positions.
+        /// - parameter marginUsage: The fraction (between 0 and 1) of the available funds that can be committed as margin by a single deal.
+        public init(maximumDealSize: Decimal64? = nil, maximumExposure: Decimal64? = nil, maximumPositions: Int? = nil, marginUsage: Decimal64? = nil) {
+            self.maximumDealSize = maximumDealSize
+            self.maximumExposure = maximumExposure
+            self.maximumPositions = maximumPositions
+            self.marginUsage = marginUsage
+        }
+    }
+}
+
+// MARK: -
+
+private extension Services.RiskEngine {
+    /// The cached dealing information of a single market.
+    struct _Market {
+        /// The market dealing rules.
+        let rules: API.Market.Rules
+        /// The margin requirements.
+        let margin: API.Market.Instrument.Margin
+        /// The size of a contract (or `1` if unknown).
+        let contractSize: Decimal64
+        /// The factor scaling the quoted prices.
+        let scalingFactor: Decimal64
+        /// The market's default currency.
+        let currency: IG.Currency.Code?
+        /// Boolean indicating whether stops and limits are allowed.
+        let isStopLimitAllowed: Bool
+        /// Boolean indicating whether guaranteed stops are allowed.
+        let isLimitedRiskAllowed: Bool
+        /// Boolean indicating whether the market can be traded at the moment.
+        var isTradeable: Bool
+        /// The latest known bid price.
+        var bid: Decimal64?
+        /// The latest known ask price.
+        var ask: Decimal64?
+
+        init(_ market: API.Market) {
+            self.rules = market.rules
+            self.margin = market.instrument.margin
+            self.contractSize = market.instrument.contractSize ?? Decimal64(1, power: 0).unsafelyUnwrapped
+            self.scalingFactor = market.snapshot.scalingFactor
+            self.currency = market.instrument.currencies.first(where: { $0.isDefault })?.code ?? market.instrument.currencies.first?.code
+            self.isStopLimitAllowed = market.instrument.isStopLimitAllowed
+            self.isLimitedRiskAllowed = market.instrument.isLimitedRiskAllowed
+            self.isTradeable = (market.snapshot.status == .tradeable)
+            self.bid = market.snapshot.price?.bid
+            self.ask = market.snapshot.price?.ask
+        }
+
+        /// The middle price between the latest bid and ask prices (if both are known).
+        var mid: Decimal64? {
+            guard let bid = self.bid, let ask = self.ask else { return nil }
+            return bid + Decimal64(5, power: -1).unsafelyUnwrapped * (ask - bid)
+        }
+
+        /// Returns the given distance in points (converting percentages with the given reference level).
+        func points(_ distance: API.Market.Distance, reference: Decimal64?) -> Decimal64? {
+            switch distance.unit {
+            case .points: return distance.value
+            case .percentage: return reference.map { $0 * distance.value / Decimal64(100, power: 0).unsafelyUnwrapped }
+            }
+        }
+
+        /// Returns the margin required for a deal of the given size, applying every deposit band to the portion of the size it covers.
+        ///
+        /// Only margins expressed as percentages can be computed; `nil` is returned otherwise.
+        func margin(size: Decimal64, level: Decimal64?, currency: IG.Currency.Code?) -> Decimal64? {
+            guard case .percentage = self.margin.unit, let level = level, self.scalingFactor > .zero else { return nil }
+            let bands = self.margin.depositBands.filter { $0.currency == (currency ?? self.currency) }
+            guard !bands.isEmpty else { return nil }
+
+            var percentage = Decimal64.zero
+            for band in bands.sorted(by: { $0.minimum < $1.minimum }) {
+                let upper = band.maximum.map { ($0 < size) ? $0 : size } ?? size
+                guard band.minimum < upper else { continue }
+                percentage = percentage + (upper - band.minimum) * band.margin
+            }
+            return percentage / Decimal64(100, power: 0).unsafelyUnwrapped * self.contractSize * level / self.scalingFactor
+        }
+    }
+
+    /// Normalized stop definition shared by positions and working orders.
+    struct _Stop {
+        /// The stop level or distance.
+        let boundary: IG.Deal.Boundary
+        /// Whether the stop is guaranteed.
+        let risk: IG.Deal.Stop.Risk
+        /// The trailing increment (only for trailing stops).
+        let increment: Decimal64?
+    }
+
+    /// The optimistic changes applied to the engine caches by a deal sent to the server.
+    struct _Reservation {
+        /// The targeted market.
+        let epic: IG.Market.Epic
+        /// The signed deal size (positive for buys, negative for sells).
+        let size: Decimal64
+        /// The number of positions opened by the deal.
+        let positions: Int
+        /// The margin committed by the deal (if it could be computed).
+        let margin: Decimal64?
+        /// The cache generation the reservation was applied to.
+        var generation: Int = 0
+    }
+
+    /// Applies the given reservation to the caches.
+    /// - attention: This function must be called while holding the lock.
+    func _apply(_ reservation: inout _Reservation) {
+        self._exposures[reservation.epic] = (self._exposures[reservation.epic] ?? .zero) + reservation.size
+        self._positions += reservation.positions
+        if let margin = reservation.margin, let funds = self._funds {
+            self._funds = (funds.available - margin, funds.currency)
+        }
+        reservation.generation = self._generation
+    }
+
+    /// Reverts the given reservation (unless the caches have been replaced with server values since it was applied).
+    func _revert(_ reservation: _Reservation) {
+        self._lock.execute {
+            guard reservation.generation == self._generation else { return }
+            self._exposures[reservation.epic] = (self._exposures[reservation.epic] ?? .zero) - reservation.size
+            self._positions -= reservation.positions
+            if let margin = reservation.margin, let funds = self._funds {
+                self._funds = (funds.available + margin, funds.currency)
+            }
+        }
+    }
+
+    /// Validates the given order against the cached values.
+    /// - attention: This function must be called while holding the lock.
+    /// - returns: The changes the order would apply to the caches once sent.
+    func _check(epic: IG.Market.Epic, direction: IG.Deal.Direction, size: Decimal64, level: Decimal64?, isMarketOrder: Bool, limit: IG.Deal.Boundary?, stop: _Stop?) throws -> _Reservation {
+        guard let market = self._markets[epic] else { throw IG.Error._unknownMarket(epic: epic) }
+        guard market.isTradeable else { throw IG.Error._untradeableMarket(epic: epic) }
+
+        // 1. Dealing rules.
+        if isMarketOrder, case .unavailable = market.rules.marketOrder { throw IG.Error._unavailableMarketOrder(epic: epic) }
+        if let minimum = market.points(market.rules.minimumDealSize, reference: nil), size < minimum {
+            throw IG.Error._invalid(size: size, minimum: minimum, epic: epic)
+        }
+        if let maximum = self.limits.maximumDealSize, maximum < size {
+            throw IG.Error._invalid(size: size, maximum: maximum, epic: epic)
+        }
+
+        let reference = level ?? ((direction == .buy) ? market.ask : market.bid)
+        if let limit = limit {
+            guard market.isStopLimitAllowed else { throw IG.Error._unallowedStopLimit(epic: epic) }
+            if let distance = Self._distance(limit, reference: reference) {
+                let (minimum, maximum) = (market.points(market.rules.limit.mininumDistance, reference: reference), market.points(market.rules.limit.maximumDistance, reference: reference))
+                if let minimum = minimum, distance < minimum { throw IG.Error._invalid(limitDistance: distance, minimum: minimum, epic: epic) }
+                if let maximum = maximum, maximum > .zero, maximum < distance { throw IG.Error._invalid(limitDistance: distance, maximum: maximum, epic: epic) }
+            }
+        }
+
+        if let stop = stop {
+            guard market.isStopLimitAllowed else { throw IG.Error._unallowedStopLimit(epic: epic) }
+            if case .limited = stop.risk, !market.isLimitedRiskAllowed { throw IG.Error._unallowedGuaranteedStop(epic: epic) }
+            if let increment = stop.increment {
+                guard market.rules.stop.trailing.areAvailable else { throw IG.Error._unallowedTrailingStop(epic: epic) }
+                if let minimum = market.points(market.rules.stop.trailing.minimumIncrement, reference: reference), increment < minimum {
+                    throw IG.Error._invalid(trailingIncrement: increment, minimum: minimum, epic: epic)
+                }
+            }
+            if let distance = Self._distance(stop.boundary, reference: reference) {
+                let rule = (stop.risk == .limited) ? market.rules.stop.minimumLimitedRiskDistance : market.rules.stop.mininumDistance
+                let (minimum, maximum) = (market.points(rule, reference: reference), market.points(market.rules.stop.maximumDistance, reference: reference))
+                if let minimum = minimum, distance < minimum { throw IG.Error._invalid(stopDistance: distance, minimum: minimum, epic: epic) }
+                if let maximum = maximum, maximum > .zero, maximum < distance { throw IG.Error._invalid(stopDistance: distance, maximum: maximum, epic: epic) }
+            }
+        }
+
+        // 2. Exposure limits (only applied to deals increasing the exposure).
+        let current = self._exposures[epic] ?? .zero
+        let delta = (direction == .buy) ? size : .zero - size
+        let exposure = current + delta
+        guard Self._absolute(current) < Self._absolute(exposure) else {
+            return _Reservation(epic: epic, size: delta, positions: 0, margin: nil)
+        }
+
+        if let maximum = self.limits.maximumExposure, maximum < Self._absolute(exposure) {
+            throw IG.Error._exceeded(exposure: exposure, maximum: maximum, epic: epic)
+        }
+        if let maximum = self.limits.maximumPositions, self._positions >= maximum {
+            throw IG.Error._exceeded(positions: self._positions, maximum: maximum)
+        }
+
+        // 3. Margin availability.
+        var committed: Decimal64? = nil
+        if let funds = self._funds, let margin = market.margin(size: size, level: reference, currency: funds.currency) {
+            let available = self.limits.marginUsage.map { funds.available * $0 } ?? funds.available
+            if available < margin { throw IG.Error._insufficientFunds(margin: margin, available: available, epic: epic) }
+            committed = margin
+        }
+        return _Reservation(epic: epic, size: delta, positions: 1, margin: committed)
+    }
+
+    /// Returns the distance (in points) from the reference level to the given boundary (or `nil` if it cannot be computed).
+    static func _distance(_ boundary: IG.Deal.Boundary, reference: Decimal64?) -> Decimal64? {
+        switch boundary {
+        case .distance(let distance): return distance
+        case .level(let level): return reference.map { Self._absolute(level - $0) }
+        }
+    }
+
+    /// Returns the absolute value of the given number.
+    static func _absolute(_ value: Decimal64) -> Decimal64 {
+        (value < .zero) ? .zero - value : value
+    }
+}
+
+private extension IG.Error {
+    /// Error raised when there are no dealing rules cached for a market.
+    static func _unknownMarket(epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "There are no dealing rules cached for the targeted market.", help: "Refresh the risk engine with the targeted epic before validating orders.", info: ["Epic": epic])
+    }
+    /// Error raised when the market cannot be traded at the moment.
+    static func _untradeableMarket(epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The targeted market is not tradeable at the moment.", help: "Check the market status and opening hours.", info: ["Epic": epic])
+    }
+    /// Error raised when market orders are not allowed on the market.
+    static func _unavailableMarketOrder(epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "Market orders are not available for the targeted market.", help: "Use a limit or quote order instead.", info: ["Epic": epic])
+    }
+    /// Error raised when the deal size is smaller than the market's minimum.
+    static func _invalid(size: Decimal64, minimum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The deal size is smaller than the market's minimum deal size.", help: "Increase the deal size.", info: ["Epic": epic, "Size": size, "Minimum": minimum])
+    }
+    /// Error raised when the deal size is larger than the user-defined maximum.
+    static func _invalid(size: Decimal64, maximum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The deal size is larger than the maximum allowed deal size.", help: "Decrease the deal size or relax the risk limits.", info: ["Epic": epic, "Size": size, "Maximum": maximum])
+    }
+    /// Error raised when stops or limits are set on a market not allowing them.
+    static func _unallowedStopLimit(epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "Stops and limits are not allowed on the targeted market.", help: "Remove the stop and limit from the order.", info: ["Epic": epic])
+    }
+    /// Error raised when a guaranteed stop is set on a market not allowing them.
+    static func _unallowedGuaranteedStop(epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "Guaranteed stops are not allowed on the targeted market.", help: "Use a non-guaranteed stop instead.", info: ["Epic": epic])
+    }
+    /// Error raised when a trailing stop is set on a market not allowing them.
+    static func _unallowedTrailingStop(epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "Trailing stops are not available on the targeted market.", help: "Use a static stop instead.", info: ["Epic": epic])
+    }
+    /// Error raised when the trailing stop increment is smaller than the market's minimum.
+    static func _invalid(trailingIncrement: Decimal64, minimum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The trailing stop increment is smaller than the market's minimum.", help: "Increase the trailing stop increment.", info: ["Epic": epic, "Increment": trailingIncrement, "Minimum": minimum])
+    }
+    /// Error raised when the limit distance is smaller than the market's minimum.
+    static func _invalid(limitDistance: Decimal64, minimum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The limit is closer to the deal level than the market's minimum distance.", help: "Move the limit further away from the deal level.", info: ["Epic": epic, "Distance": limitDistance, "Minimum": minimum])
+    }
+    /// Error raised when the limit distance is larger than the market's maximum.
+    static func _invalid(limitDistance: Decimal64, maximum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The limit is further away from the deal level than the market's maximum distance.", help: "Move the limit closer to the deal level.", info: ["Epic": epic, "Distance": limitDistance, "Maximum": maximum])
+    }
+    /// Error raised when the stop distance is smaller than the market's minimum.
+    static func _invalid(stopDistance: Decimal64, minimum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The stop is closer to the deal level than the market's minimum distance.", help: "Move the stop further away from the deal level.", info: ["Epic": epic, "Distance": stopDistance, "Minimum": minimum])
+    }
+    /// Error raised when the stop distance is larger than the market's maximum.
+    static func _invalid(stopDistance: Decimal64, maximum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The stop is further away from the deal level than the market's maximum distance.", help: "Move the stop closer to the deal level.", info: ["Epic": epic, "Distance": stopDistance, "Maximum": maximum])
+    }
+    /// Error raised when the deal would exceed the user-defined exposure limit.
+    static func _exceeded(exposure: Decimal64, maximum: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The deal would exceed the maximum exposure allowed for the targeted market.", help: "Decrease the deal size or relax the risk limits.", info: ["Epic": epic, "Exposure": exposure, "Maximum": maximum])
+    }
+    /// Error raised when the deal would exceed the user-defined number of open positions.
+    static func _exceeded(positions: Int, maximum: Int) -> Self {
+        Self(.api(.invalidRequest), "The deal would exceed the maximum number of open positions.", help: "Close some positions or relax the risk limits.", info: ["Open positions": positions, "Maximum": maximum])
+    }
+    /// Error raised when the available funds don't cover the deal's margin.
+    static func _insufficientFunds(margin: Decimal64, available: Decimal64, epic: IG.Market.Epic) -> Self {
+        Self(.api(.invalidRequest), "The available funds don't cover the margin required by the deal.", help: "Decrease the deal size or deposit more funds.", info: ["Epic": epic, "Margin": margin, "Available": available])
+    }
+}
@@ -0,0 +1,188 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Services {
+    /// Returns a single time-ordered stream of candles for a market, stitching together the local history, the server's history, and the live candles.
+    ///
+    /// The stream is built in three phases:
+    /// 1. The prices cached in the database for the lookback period are forwarded (only for `.minute` intervals, since the database exclusively stores minute candles).
+    /// 2. The gap between the last cached price and the present is filled from the HTTP API. Minute prices are also cached in the database; prices of any other resolution are only forwarded.
+    /// 3. Live candles from the streamer are forwarded.
+    ///
+    /// The live subscription starts at the same time as the historical queries; candles received while the history is being fetched are buffered and only the ones after the last historical candle are forwarded. Therefore, no candle is forwarded twice and no candle is lost on the switch.
+    /// - parameter epic: Instrument's epic (such as `CS.D.EURUSD.MINI.IP`).
+    /// - parameter interval: The candle resolution.
+    /// - parameter lookback: The amount of time (in seconds) before the present from which the stream starts.
+    /// - parameter partial: Boolean indicating whether unfinished live candles are forwarded. If `false`, only finished candles are forwarded.
+    /// - returns: Publisher forwarding candles in time order. Historical candles are always marked as finished.
+    public func series(epic: IG.Market.Epic, interval: Streamer.Chart.Aggregated.Interval = .minute, lookback: TimeInterval, partial: Bool = false) -> AnyPublisher<Streamer.Chart.Aggregated,IG.Error> {
+        let (api, database) = (self.api, self.database)
+        let now = self.clock.now
+        let from = now.addingTimeInterval(-Swift.max(0, lookback))
+        // The candle of the ongoing interval is still in progress; thus, it is only provided by the live subscription.
+        let to = interval._start(for: now)
+        let stitcher = _SeriesStitcher(partial: partial)
+
+        let live = self.streamer.prices.subscribe(epic: epic, interval: interval, fields: .candle, snapshot: true)
+            .map { _SeriesStitcher.Event.live($0) }
+
+        let history: AnyPublisher<_SeriesStitcher.Event,IG.Error>
+        switch interval {
+        case .minute:
+            history = database.prices.get(epic: epic, from: from, to: nil)
+                .flatMap { (stored) -> AnyPublisher<_SeriesStitcher.Event,IG.Error> in
+                    let cached = Just(_SeriesStitcher.Event.history(stored.map { Streamer.Chart.Aggregated(epic: epic, interval: interval, price: $0) }))
+                        .setFailureType(to: IG.Error.self)
+                    let start = stored.last.map { $0.date.addingTimeInterval(interval.seconds) } ?? from
+                    return cached.append(Self._gap(api: api, cache: database, epic: epic, interval: interval, from: start, to: to))
+                        .eraseToAnyPublisher()
+                }.eraseToAnyPublisher()
+        case .second, .minute5, .hour:
+            history = Self._gap(api: api, cache: nil, epic: epic, interval: interval, from: from, to: to)
+        }
+
+        return live.merge(with: history)
+            .flatMap { Publishers.Sequence<[Streamer.Chart.Aggregated],IG.Error>(sequence: stitcher.process($0)) }
+            .eraseToAnyPublisher()
+    }
+}
+
+private extension Services {
+    /// Fetches the prices between the given dates from the HTTP API.
+    ///
+    /// Only the candles starting before `to` are forwarded (and cached), so an unfinished candle is never stored as finished.
+    /// - parameter cache: The database where the fetched prices are cached (only for minute prices) or `nil` if they are just forwarded.
+    /// - returns: A publisher sending a single `.gap` event (empty if there is no time between the given dates).
+    static func _gap(api: API, cache database: Database?, epic: IG.Market.Epic, interval: Streamer.Chart.Aggregated.Interval, from: Date, to: Date) -> AnyPublisher<_SeriesStitcher.Event,IG.Error> {
+        guard from < to else {
+            return Just(.gap([])).setFailureType(to: IG.Error.self).eraseToAnyPublisher()
+        }
+
+        return api.prices.getContinuously(epic: epic, from: from, to: to, resolution: interval._resolution)
+            .map { $0.prices }
+            .collect()
+            .map { $0.flatMap { $0 }.filter { $0.date < to } }
+            .flatMap { (prices) -> AnyPublisher<_SeriesStitcher.Event,IG.Error> in
+                let event = _SeriesStitcher.Event.gap(prices.map { Streamer.Chart.Aggregated(epic: epic, interval: interval, price: $0) })
+                guard let database = database else {
+                    return Just(event).setFailureType(to: IG.Error.self).eraseToAnyPublisher()
+                }
+                // Caching failures (e.g. the market is not stored in the database) don't interrupt the series.
+                return database.prices.update(prices, epic: epic)
+                    .catch { _ in Empty<Never,IG.Error>() }
+                    .collect()
+                    .map { _ in event }
+                    .eraseToAnyPublisher()
+            }.eraseToAnyPublisher()
+    }
+}
+
+// MARK: -
+
+/// Merges historical and live candles into a single ordered sequence without duplicates.
+internal final class _SeriesStitcher {
+    /// The events feeding the stitcher.
+    enum Event {
+        /// Candles cached locally.
+        case history([Streamer.Chart.Aggregated])
+        /// Candles fetched from the server to fill the gap between the local history and the present. It marks the end of the historical phase.
+        case gap([Streamer.Chart.Aggregated])
+        /// A live candle update.
+        case live(Streamer.Chart.Aggregated)
+    }
+
+    /// The lock restricting access to the stitcher state.
+    private let _lock: UnfairLock
+    /// Boolean indicating whether unfinished live candles are forwarded.
+    private let _partial: Bool
+    /// The date of the last finished candle forwarded.
+    private var _last: Date?
+    /// Live candles received during the historical phase (or `nil` once the live phase has started).
+    private var _buffer: [Streamer.Chart.Aggregated]?
+
+    init(partial: Bool) {
+        self._lock = UnfairLock()
+        self._partial = partial
+        self._buffer = []
+    }
+
+    deinit {
+        self._lock.invalidate()
+    }
+
+    /// Processes the given event, returning the candles to forward (in order).
+    func process(_ event: Event) -> [Streamer.Chart.Aggregated] {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+
+        switch event {
+        case .history(let candles):
+            return self._forward(candles)
+        case .gap(let candles):
+            var result = self._forward(candles)
+            let buffer = self._buffer ?? []
+            self._buffer = nil
+            for candle in buffer { result.append(contentsOf: self._forward(live: candle)) }
+            return result
+        case .live(let candle):
+            guard self._buffer == nil else {
+                self._buffer!.append(candle)
+                return []
+            }
+            return self._forward(live: candle)
+        }
+    }
+
+    /// Forwards the historical candles posterior to the last forwarded candle.
+    private func _forward(_ candles: [Streamer.Chart.Aggregated]) -> [Streamer.Chart.Aggregated] {
+        var result: [Streamer.Chart.Aggregated] = []
+        result.reserveCapacity(candles.count)
+        for candle in candles {
+            guard let date = candle.candle.date, self._last.map({ $0 < date }) ?? true else { continue }
+            self._last = date
+            result.append(candle)
+        }
+        return result
+    }
+
+    /// Forwards the live candle if it is posterior to the last forwarded finished candle.
+    private func _forward(live candle: Streamer.Chart.Aggregated) -> [Streamer.Chart.Aggregated] {
+        guard let date = candle.candle.date, self._last.map({ $0 < date }) ?? true else { return [] }
+        guard candle.candle.isFinished ?? false else {
+            return (self._partial) ? [candle] : []
+        }
+        self._last = date
+        return [candle]
+    }
+}
+
+internal extension Streamer.Chart.Aggregated.Interval {
+    /// Returns the start of the interval containing the given date.
+    func _start(for date: Date) -> Date {
+        Date(timeIntervalSince1970: (date.timeIntervalSince1970 / self.seconds).rounded(.down) * self.seconds)
+    }
+
+    /// The HTTP API price resolution matching the receiving interval.
+    var _resolution: API.Price.Resolution {
+        switch self {
+        case .second: return .second
+        case .minute: return .minute
+        case .minute5: return .minute5
+        case .hour: return .hour
+        }
+    }
+}
+
+private extension Streamer.Chart.Aggregated {
+    /// Creates a finished candle from a price fetched from the HTTP API.
+    init(epic: IG.Market.Epic, interval: Self.Interval, price: API.Price) {
+        let candle = Self.Candle(date: price.date, numTicks: price.volume.map { Int($0) }, isFinished: true,
+                                 open: .init(bid: price.open.bid, ask: price.open.ask),
+                                 close: .init(bid: price.close.bid, ask: price.close.ask),
+                                 lowest: .init(bid: price.lowest.bid, ask: price.lowest.ask),
+                                 highest: .init(bid: price.highest.bid, ask: price.highest.ask))
+        let day = Self.Day(lowest: nil, mid: nil, highest: nil, changeNet: nil, changePercentage: nil)
+        self.init(epic: epic, interval: interval, candle: candle, day: day)
+    }
+}
@@ -6,8 +6,12 @@ public final class Streamer {
     public final let rootURL: URL
     /// The queue managing all Streamer responses.
     internal final let queue: DispatchQueue
+    /// The delivery queues where subscription updates are forwarded depending on their urgency.
+    internal final let tiers: Streamer.Tiers
     /// The underlying instance (whether real or mocked) managing the streaming connections.
     internal final let channel: Streamer.Channel
+    /// The clock providing the reference date for the updates carrying only the time of the day.
+    public final let clock: Clock
     
     /// Namespace for the functionality related to managing a LightStreamer connection (e.g. open/close, status, reset, etc.).
     @inlinable public final var session: Streamer.Request.Session { .init(streamer: self) }
@@ -24,19 +28,87 @@ public final class Streamer {
     /// - parameter rootURL: The URL where the streaming server is located.
     /// - parameter credentails: Priviledge credentials permitting the creation of streaming channels.
     /// - parameter queue: The queue used to process the requests and responses. If `nil`, the system will create an appropriate queue.
-    /// - note: Each subscription will have its own serial queue and the QoS will get inherited from `queue`.
-    public convenience init(rootURL: URL, credentials: Streamer.Credentials, queue: DispatchQueue? = nil) {
+    /// - parameter clock: The clock providing the reference date for the updates carrying only the time of the day.
+    /// - note: Subscription updates are delivered on tiered serial queues (trades/accounts, live quotes, bulk charts) with decreasing priority, so market data bursts don't delay trade confirmations. If `queue` is given, the tiered queues are derived from it (named after it and inheriting its QoS as a floor) but they don't target it, since a serial `queue` would funnel all tiers back into a single line. Use `init(rootURL:credentials:executors:clock:)` to choose the queue each tier targets.
+    public convenience init(rootURL: URL, credentials: Streamer.Credentials, queue: DispatchQueue? = nil, clock: Clock = SystemClock.shared) {
         let processingQueue = queue ?? DispatchQueue(label: IG.identifier + ".streamer.queue",  qos: .default)
         let channel = Self.Channel(rootURL: rootURL, credentials: credentials)
-        self.init(rootURL: rootURL, channel: channel, queue: processingQueue)
+        self.init(rootURL: rootURL, channel: channel, queue: processingQueue, tiers: Self.Tiers(derivedFrom: queue), clock: clock)
+    }
+    
+    /// Creates a `Streamer` instance whose session management and subscription updates are executed on the given executors.
+    /// - parameter rootURL: The URL where the streaming server is located.
+    /// - parameter credentails: Priviledge credentials permitting the creation of streaming channels.
+    /// - parameter executors: The executors configuration. The critical tier (and session management) targets the `trading` executor, the quotes tier targets the `marketData` executor, and the chart tier targets the `background` executor.
+    /// - parameter clock: The clock providing the reference date for the updates carrying only the time of the day.
+    public convenience init(rootURL: URL, credentials: Streamer.Credentials, executors: Executors, clock: Clock = SystemClock.shared) {
+        let trading = executors.trading._target(label: IG.identifier + ".streamer.trading")
+        let tiers = Self.Tiers(critical: trading,
+                               quotes: executors.marketData._target(label: IG.identifier + ".streamer.marketData"),
+                               bulk: executors.background._target(label: IG.identifier + ".streamer.background"))
+        let processingQueue = trading ?? DispatchQueue(label: IG.identifier + ".streamer.queue",  qos: .default)
+        let channel = Self.Channel(rootURL: rootURL, credentials: credentials)
+        self.init(rootURL: rootURL, channel: channel, queue: processingQueue, tiers: tiers, clock: clock)
     }
     
     /// Initializer for a Streamer instance.
     /// - parameter rootURL: The URL where the streaming server is located.
     /// - parameter channel: The low-level streaming connection manager.
     /// - parameter queue: The queue on which to process the `Streamer` requests and responses.
-    internal init(rootURL: URL, channel: Streamer.Channel, queue: DispatchQueue) {
-        (self.rootURL, self.queue) = (rootURL, queue)
+    /// - parameter tiers: The delivery queues for subscription updates.
+    /// - parameter clock: The clock providing the reference date for the updates carrying only the time of the day.
+    internal init(rootURL: URL, channel: Streamer.Channel, queue: DispatchQueue, tiers: Streamer.Tiers, clock: Clock = SystemClock.shared) {
+        (self.rootURL, self.queue, self.clock) = (rootURL, queue, clock)
         self.channel = channel
+        self.tiers = tiers
+    }
+}
+
+extension Streamer {
+    /// Delivery queues ordered by urgency.
+    ///
+    /// Each tier is a serial queue with its own quality of service; thus a burst of updates on a low tier doesn't delay the delivery of updates on a higher tier.
+    internal struct Tiers {
+        /// Trade confirmations, position/working order updates, and account updates.
+        let critical: DispatchQueue
+        /// Live market quotes and tick data.
+        let quotes: DispatchQueue
+        /// Aggregated chart candles.
+        let bulk: DispatchQueue
+        
+        /// Creates independent delivery tiers derived from the given queue.
+        ///
+        /// The tiers don't target the given queue: if it were serial, all tiers would be funnelled back into a single line (defeating their purpose). Instead, each tier targets its own global concurrent queue and the given queue only provides the tier labels and a QoS floor.
+        /// - parameter queue: The queue the tiers are derived from. If `nil`, the tiers are named after the streamer and keep their default QoS.
+        init(derivedFrom queue: DispatchQueue?) {
+            let prefix = queue?.label ?? IG.identifier + ".streamer"
+            let floor = queue?.qos.qosClass ?? .unspecified
+            self.init(prefix: prefix,
+                      critical: (Self._qos(.userInteractive, floor: floor), nil),
+                      quotes: (Self._qos(.userInitiated, floor: floor), nil),
+                      bulk: (Self._qos(.utility, floor: floor), nil))
+        }
+        
+        /// Creates the delivery tiers targeting different queues.
+        /// - parameter critical: The queue where the critical tier ends up executing. If `nil`, the global concurrent queue matching its QoS.
+        /// - parameter quotes: The queue where the quotes tier ends up executing. If `nil`, the global concurrent queue matching its QoS.
+        /// - parameter bulk: The queue where the bulk tier ends up executing. If `nil`, the global concurrent queue matching its QoS.
+        init(critical: DispatchQueue?, quotes: DispatchQueue?, bulk: DispatchQueue?) {
+            self.init(prefix: IG.identifier + ".streamer", critical: (.userInteractive, critical), quotes: (.userInitiated, quotes), bulk: (.utility, bulk))
+        }
+        
+        /// Creates the delivery tiers with the given QoS and targets.
+        private init(prefix: String, critical: (qos: DispatchQoS, target: DispatchQueue?), quotes: (qos: DispatchQoS, target: DispatchQueue?), bulk: (qos: DispatchQoS, target: DispatchQueue?)) {
+            self.critical = DispatchQueue(label: prefix + ".tier.critical", qos: critical.qos, target: critical.target)
+            self.quotes = DispatchQueue(label: prefix + ".tier.quotes", qos: quotes.qos, target: quotes.target)
+            self.bulk = DispatchQueue(label: prefix + ".tier.bulk", qos: bulk.qos, target: bulk.target)
+        }
+        
+        /// Returns the given tier QoS raised to the given floor (if the floor is higher).
+        private static func _qos(_ qos: DispatchQoS, floor: DispatchQoS.QoSClass) -> DispatchQoS {
+            let order: [DispatchQoS.QoSClass] = [.unspecified, .background, .utility, .default, .userInitiated, .userInteractive]
+            guard let lhs = order.firstIndex(of: qos.qosClass), let rhs = order.firstIndex(of: floor), rhs > lhs else { return qos }
+            return DispatchQoS(qosClass: floor, relativePriority: 0)
+        }
     }
 }
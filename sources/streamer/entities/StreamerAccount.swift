@@ -74,7 +74,7 @@ fileprivate typealias F = Streamer.Account.Field
 
 internal extension Streamer.Account {
     /// - throws: `IG.Error` exclusively.
-    init(id: IG.Account.Identifier, update: LSItemUpdate, fields: Set<Field>) throws {
+    init(id: IG.Account.Identifier, update: StreamerItemUpdate, fields: Set<Field>) throws {
         self.id = id
         self.funds = fields.contains(F.funds) ? try update.decodeIfPresent(Decimal64.self, forKey: F.funds) : nil
         self.equity = try .init(update: update, fields: fields)
@@ -85,7 +85,7 @@ internal extension Streamer.Account {
 
 fileprivate extension Streamer.Account.Equity {
     /// - throws: `IG.Error` exclusively.
-    init(update: LSItemUpdate, fields: Set<Streamer.Account.Field>) throws {
+    init(update: StreamerItemUpdate, fields: Set<Streamer.Account.Field>) throws {
         self.value = fields.contains(F.equity) ? try update.decodeIfPresent(Decimal64.self, forKey: F.equity) : nil
         self.used = fields.contains(F.equityUsed) ? try update.decodeIfPresent(Decimal64.self, forKey: F.equityUsed) : nil
         self.cashAvailable = fields.contains(F.cashAvailable) ? try update.decodeIfPresent(Decimal64.self, forKey: F.cashAvailable) : nil
@@ -95,7 +95,7 @@ fileprivate extension Streamer.Account.Equity {
 
 fileprivate extension Streamer.Account.Margins {
     /// - throws: `IG.Error` exclusively.
-    init(update: LSItemUpdate, fields: Set<Streamer.Account.Field>) throws {
+    init(update: StreamerItemUpdate, fields: Set<Streamer.Account.Field>) throws {
         self.value = fields.contains(F.margin) ? try update.decodeIfPresent(Decimal64.self, forKey: F.margin) : nil
         self.limitedRisk = fields.contains(F.marginLimitedRisk) ? try update.decodeIfPresent(Decimal64.self, forKey: F.marginLimitedRisk) : nil
         self.nonLimitedRisk = fields.contains(F.marginNonLimitedRisk) ? try update.decodeIfPresent(Decimal64.self, forKey: F.marginNonLimitedRisk) : nil
@@ -105,7 +105,7 @@ fileprivate extension Streamer.Account.Margins {
 
 fileprivate extension Streamer.Account.ProfitLoss {
     /// - throws: `IG.Error` exclusively.
-    init(update: LSItemUpdate, fields: Set<Streamer.Account.Field>) throws {
+    init(update: StreamerItemUpdate, fields: Set<Streamer.Account.Field>) throws {
         self.value = fields.contains(F.profitLoss) ? try update.decodeIfPresent(Decimal64.self, forKey: F.profitLoss) : nil
         self.limitedRisk = fields.contains(F.profitLossLimitedRisk) ? try update.decodeIfPresent(Decimal64.self, forKey: F.profitLossLimitedRisk) : nil
         self.nonLimitedRisk = fields.contains(F.profitLossNonLimitedRisk) ? try update.decodeIfPresent(Decimal64.self, forKey: F.profitLossNonLimitedRisk) : nil
@@ -76,7 +76,7 @@ fileprivate typealias F = Streamer.Chart.Aggregated.Field
 
 internal extension Streamer.Chart.Aggregated {
     /// - throws: `IG.Error` exclusively.
-    init(epic: IG.Market.Epic, interval: Self.Interval, update: LSItemUpdate, fields: Set<Field>) throws {
+    init(epic: IG.Market.Epic, interval: Self.Interval, update: StreamerItemUpdate, fields: Set<Field>) throws {
         self.epic = epic
         self.interval = interval
         self.candle = try Candle(update: update, fields: fields)
@@ -86,7 +86,7 @@ internal extension Streamer.Chart.Aggregated {
 
 fileprivate extension Streamer.Chart.Aggregated.Candle {
     /// - throws: `IG.Error` exclusively.
-    init(update: LSItemUpdate, fields: Set<Streamer.Chart.Aggregated.Field>) throws {
+    init(update: StreamerItemUpdate, fields: Set<Streamer.Chart.Aggregated.Field>) throws {
         self.date = fields.contains(F.date) ? try update.decodeIfPresent(Date.self, forKey: F.date) : nil
         self.numTicks = fields.contains(F.numTicks) ? try update.decodeIfPresent(Int.self, forKey: F.numTicks) : nil
         self.isFinished = fields.contains(F.isFinished) ? try update.decodeIfPresent(Bool.self, forKey: F.isFinished) : nil
@@ -111,7 +111,7 @@ fileprivate extension Streamer.Chart.Aggregated.Candle {
 
 fileprivate extension Streamer.Chart.Aggregated.Day {
     /// - throws: `IG.Error` exclusively.
-    init(update: LSItemUpdate, fields: Set<Streamer.Chart.Aggregated.Field>) throws {
+    init(update: StreamerItemUpdate, fields: Set<Streamer.Chart.Aggregated.Field>) throws {
         self.lowest = fields.contains(F.dayLowest) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayLowest) : nil
         self.mid = fields.contains(F.dayMid) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayMid) : nil
         self.highest = fields.contains(F.dayHighest) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayHighest) : nil
@@ -55,7 +55,7 @@ fileprivate typealias F = Streamer.Chart.Tick.Field
 
 internal extension Streamer.Chart.Tick {
     /// - throws: `IG.Error` exclusively.
-    init(epic: IG.Market.Epic, item: String, update: LSItemUpdate, fields: Set<Field>) throws {
+    init(epic: IG.Market.Epic, item: String, update: StreamerItemUpdate, fields: Set<Field>) throws {
         self.epic = epic
         self.date = fields.contains(F.date) ? try update.decodeIfPresent(Date.self, forKey: F.date) : nil
         self.bid = fields.contains(F.bid) ? try update.decodeIfPresent(Decimal64.self, forKey: F.bid) : nil
@@ -67,7 +67,7 @@ internal extension Streamer.Chart.Tick {
 
 fileprivate extension Streamer.Chart.Tick.Day {
     /// - throws: `IG.Error` exclusively.
-    init(update: LSItemUpdate, fields: Set<Streamer.Chart.Tick.Field>) throws {
+    init(update: StreamerItemUpdate, fields: Set<Streamer.Chart.Tick.Field>) throws {
         self.lowest = fields.contains(F.dayLowest) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayLowest) : nil
         self.mid = fields.contains(F.dayMid) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayMid) : nil
         self.highest = fields.contains(F.dayHighest) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayHighest) : nil
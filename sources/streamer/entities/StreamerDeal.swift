@@ -30,7 +30,7 @@ internal extension Streamer.Deal {
     /// - parameter decoder: The JSON decoder being used to decode the packet.
     /// - parameter fields: The packet fields the user is interested on.
     /// - throws: `IG.Error` exclusively.
-    init(account: IG.Account.Identifier, item: String, update: LSItemUpdate, decoder: JSONDecoder, fields: Set<Field>) throws {
+    init(account: IG.Account.Identifier, item: String, update: StreamerItemUpdate, decoder: JSONDecoder, fields: Set<Field>) throws {
         self.account = account
         
         do {
@@ -69,7 +69,7 @@ fileprivate typealias F = Streamer.Market.Field
 
 internal extension Streamer.Market {
     /// - throws: `IG.Error` exclusively.
-    init(epic: IG.Market.Epic, update: LSItemUpdate, timeFormatter: DateFormatter, fields: Set<Field>) throws {
+    init(epic: IG.Market.Epic, update: StreamerItemUpdate, timeFormatter: DateFormatter, now: Date, fields: Set<Field>) throws {
         self.epic = epic
         
         if fields.contains(F.status), let status = update.decodeIfPresent(String.self, forKey: F.status) {
@@ -85,7 +85,7 @@ internal extension Streamer.Market {
             }
         } else { self.status = nil }
         
-        self.date = fields.contains(F.date) ? try update.decodeIfPresent(Date.self, with: timeFormatter, forKey: F.date) : nil
+        self.date = fields.contains(F.date) ? try update.decodeIfPresent(Date.self, with: timeFormatter, relativeTo: now, forKey: F.date) : nil
         self.isDelayed = fields.contains(F.isDelayed) ? try update.decodeIfPresent(Bool.self, forKey: F.isDelayed) : nil
         self.bid = fields.contains(F.bid) ? try update.decodeIfPresent(Decimal64.self, forKey: F.bid) : nil
         self.ask = fields.contains(F.ask) ? try update.decodeIfPresent(Decimal64.self, forKey: F.ask) : nil
@@ -95,7 +95,7 @@ internal extension Streamer.Market {
 
 fileprivate extension Streamer.Market.Day {
     /// - throws: `IG.Error` exclusively.
-    init(update: LSItemUpdate, fields: Set<Streamer.Market.Field>) throws {
+    init(update: StreamerItemUpdate, fields: Set<Streamer.Market.Field>) throws {
         self.lowest = fields.contains(F.dayLowest) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayLowest) : nil
         self.mid = fields.contains(F.dayMid) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayMid) : nil
         self.highest = fields.contains(F.dayHighest) ? try update.decodeIfPresent(Decimal64.self, forKey: F.dayHighest) : nil
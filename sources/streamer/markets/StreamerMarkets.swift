@@ -23,15 +23,16 @@ extension Streamer.Request.Markets {
     /// - parameter epic: The epic identifying the targeted market.
     /// - parameter fields: The market properties/fields bieng targeted.
     /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of the market.
-    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the internal `Streamer` queue will be used. 
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` live quotes delivery queue will be used. 
     public func subscribe(epic: IG.Market.Epic, fields: Set<Streamer.Market.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> AnyPublisher<Streamer.Market,IG.Error> {
         let item = "MARKET:\(epic)"
         let properties = fields.map { $0.rawValue }
         let timeFormatter = DateFormatter.londonTime
+        let clock = self._streamer.clock
         
         return self._streamer.channel
-            .subscribe(on: queue ?? self._streamer.queue, mode: .merge, items: [item], fields: properties, snapshot: snapshot)
-            .tryMap { [fields] in try Streamer.Market(epic: epic, update: $0, timeFormatter: timeFormatter, fields: fields) }
+            .subscribe(on: queue ?? self._streamer.tiers.quotes, mode: .merge, items: [item], fields: properties, snapshot: snapshot)
+            .tryMap { [fields] in try Streamer.Market(epic: epic, update: $0, timeFormatter: timeFormatter, now: clock.now, fields: fields) }
             .mapError(errorCast)
             .eraseToAnyPublisher()
     }
@@ -42,25 +43,41 @@ extension Streamer.Request.Markets {
     /// - parameter epics: The epics identifying the targeted markets.
     /// - parameter fields: The market properties/fields bieng targeted.
     /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of the market.
-    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the internal `Streamer` queue will be used. 
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` live quotes delivery queue will be used. 
     public func subscribe(epics: Set<IG.Market.Epic>, fields: Set<Streamer.Market.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> AnyPublisher<Streamer.Market,IG.Error> {
         guard !epics.isEmpty else { return Empty().eraseToAnyPublisher() }
-        guard epics.count > 1 else { return self.subscribe(epic: epics.first.unsafelyUnwrapped, fields: fields, snapshot: snapshot) }
+        guard epics.count > 1 else { return self.subscribe(epic: epics.first.unsafelyUnwrapped, fields: fields, snapshot: snapshot, queue: queue) }
         
         let items = epics.map { "MARKET:\($0)" }
         let properties = fields.map { $0.rawValue }
         let timeFormatter = DateFormatter.londonTime
+        let clock = self._streamer.clock
         
         return self._streamer.channel
-            .subscribe(on: queue ?? self._streamer.queue, mode: .merge, items: items, fields: properties, snapshot: snapshot)
+            .subscribe(on: queue ?? self._streamer.tiers.quotes, mode: .merge, items: items, fields: properties, snapshot: snapshot)
             .tryMap { [fields] in
                 guard let item = $0.itemName, let epic = IG.Market.Epic(item.split(separator: ":").dropFirst().joined(separator: ":")) else {
                     throw IG.Error._invalid(itemName: $0.itemName)
                 }
-                return try Streamer.Market(epic: epic, update: $0, timeFormatter: timeFormatter, fields: fields)
+                return try Streamer.Market(epic: epic, update: $0, timeFormatter: timeFormatter, now: clock.now, fields: fields)
             }.mapError(errorCast)
             .eraseToAnyPublisher()
     }
+    
+    /// Creates a mutable set of market subscriptions whose members can be added or removed without disturbing the remaining ones.
+    ///
+    /// Each epic is backed by its own Lightstreamer subscription; therefore membership changes only (un)subscribe the delta and unchanged markets keep streaming without new snapshots or gaps.
+    /// - parameter epics: The initial epics identifying the targeted markets.
+    /// - parameter fields: The market properties/fields bieng targeted.
+    /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of every newly added market.
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` live quotes delivery queue will be used.
+    /// - returns: The subscription set. No subscription is established till its `publisher` is subscribed to.
+    public func subscriptionSet(epics: Set<IG.Market.Epic>, fields: Set<Streamer.Market.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> Streamer.SubscriptionSet<IG.Market.Epic,Streamer.Market> {
+        .init(keys: epics) { [weak weakStreamer = self._streamer] (epic) in
+            guard let streamer = weakStreamer else { return Fail(error: IG.Error._deallocatedInstance()).eraseToAnyPublisher() }
+            return streamer.markets.subscribe(epic: epic, fields: fields, snapshot: snapshot, queue: queue)
+        }
+    }
 }
 
 // MARK: - Request Entities
@@ -106,6 +123,10 @@ extension Set where Element == Streamer.Market.Field {
 }
 
 private extension IG.Error {
+    /// Error raised when the Streamer instance is deallocated.
+    static func _deallocatedInstance() -> Self {
+        Self(.streamer(.sessionExpired), "The \(Streamer.self) instance has been deallocated.", help: "The \(Streamer.self) functionality is asynchronous. Keep around the Streamer instance while the subscription set is in use.")
+    }
     /// Error raised when the epic reveived as an update item is invalid.
     static func _invalid(itemName: String?) -> Self {
         Self(.streamer(.invalidResponse), "The Lightstreamer item name received couldn't be matched to a supported epic.", help: "Review the received item name.", info: ["Received item": itemName ?? ""])
@@ -24,14 +24,14 @@ extension Streamer.Request.Prices {
     /// - parameter interval: The aggregation interval for the candle.
     /// - parameter fields: The chart properties/fields bieng targeted.
     /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of the market. explicitly call `connect()`.
-    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the internal `Streamer` queue will be used.
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` bulk chart delivery queue will be used.
     /// - returns: Signal producer that can be started at any time.
     public func subscribe(epic: IG.Market.Epic, interval: Streamer.Chart.Aggregated.Interval, fields: Set<Streamer.Chart.Aggregated.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> AnyPublisher<Streamer.Chart.Aggregated,IG.Error> {
         let item = "CHART:\(epic):\(interval.description)"
         let properties = fields.map { $0.rawValue }
         
         return self.streamer.channel
-            .subscribe(on: queue ?? self.streamer.queue, mode: .merge, items: [item], fields: properties, snapshot: snapshot)
+            .subscribe(on: queue ?? self.streamer.tiers.bulk, mode: .merge, items: [item], fields: properties, snapshot: snapshot)
             .tryMap { [fields] in try Streamer.Chart.Aggregated(epic: epic, interval: interval, update: $0, fields: fields) }
             .mapError(errorCast)
             .eraseToAnyPublisher()
@@ -44,17 +44,17 @@ extension Streamer.Request.Prices {
     /// - parameter interval: The aggregation interval for the candle.
     /// - parameter fields: The chart properties/fields bieng targeted.
     /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of the market. explicitly call `connect()`.
-    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the internal `Streamer` queue will be used. 
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` bulk chart delivery queue will be used. 
     /// - returns: Signal producer that can be started at any time.
     public func subscribe(epics: Set<IG.Market.Epic>, interval: Streamer.Chart.Aggregated.Interval, fields: Set<Streamer.Chart.Aggregated.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> AnyPublisher<Streamer.Chart.Aggregated,IG.Error> {
         guard !epics.isEmpty else { return Empty().eraseToAnyPublisher() }
-        guard epics.count > 1 else { return self.subscribe(epic: epics.first.unsafelyUnwrapped, interval: interval, fields: fields, snapshot: snapshot) }
+        guard epics.count > 1 else { return self.subscribe(epic: epics.first.unsafelyUnwrapped, interval: interval, fields: fields, snapshot: snapshot, queue: queue) }
         
         let items = epics.map { "CHART:\($0):\(interval.description)" }
         let properties = fields.map { $0.rawValue }
         
         return self.streamer.channel
-            .subscribe(on: queue ?? self.streamer.queue, mode: .merge, items: items, fields: properties, snapshot: snapshot)
+            .subscribe(on: queue ?? self.streamer.tiers.bulk, mode: .merge, items: items, fields: properties, snapshot: snapshot)
             .tryMap { [fields] in
                 guard let item = $0.itemName, let epic = IG.Market.Epic(item.split(separator: ":").dropFirst().dropLast().joined(separator: ":")) else {
                     throw IG.Error._invalid(itemName: $0.itemName)
@@ -63,6 +63,22 @@ extension Streamer.Request.Prices {
             }.mapError(errorCast)
             .eraseToAnyPublisher()
     }
+    
+    /// Creates a mutable set of aggregated chart subscriptions whose members can be added or removed without disturbing the remaining ones.
+    ///
+    /// Each epic is backed by its own Lightstreamer subscription; therefore membership changes only (un)subscribe the delta and unchanged markets keep streaming without new snapshots or gaps.
+    /// - parameter epics: The initial epics identifying the targeted markets.
+    /// - parameter interval: The aggregation interval for the candle.
+    /// - parameter fields: The chart properties/fields bieng targeted.
+    /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of every newly added market.
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` bulk chart delivery queue will be used.
+    /// - returns: The subscription set. No subscription is established till its `publisher` is subscribed to.
+    public func subscriptionSet(epics: Set<IG.Market.Epic>, interval: Streamer.Chart.Aggregated.Interval, fields: Set<Streamer.Chart.Aggregated.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> Streamer.SubscriptionSet<IG.Market.Epic,Streamer.Chart.Aggregated> {
+        .init(keys: epics) { [weak weakStreamer = self.streamer] (epic) in
+            guard let streamer = weakStreamer else { return Fail(error: IG.Error._deallocatedInstance()).eraseToAnyPublisher() }
+            return streamer.prices.subscribe(epic: epic, interval: interval, fields: fields, snapshot: snapshot, queue: queue)
+        }
+    }
 }
 
 // MARK: - Request Entities
@@ -163,6 +179,10 @@ extension Set where Element == Streamer.Chart.Aggregated.Field {
 }
 
 private extension IG.Error {
+    /// Error raised when the Streamer instance is deallocated.
+    static func _deallocatedInstance() -> Self {
+        Self(.streamer(.sessionExpired), "The \(Streamer.self) instance has been deallocated.", help: "The \(Streamer.self) functionality is asynchronous. Keep around the Streamer instance while the subscription set is in use.")
+    }
     /// Error raised when the epic reveived as an update item is invalid.
     static func _invalid(itemName: String?) -> Self {
         Self(.streamer(.invalidResponse), "The Lightstreamer item name received couldn't be matched to a supported epic.", help: "Review the received item name.", info: ["Received item": itemName ?? ""])
@@ -10,14 +10,14 @@ extension Streamer.Request.Prices {
     /// - parameter epic: The epic identifying the targeted market.
     /// - parameter fields: The chart properties/fields bieng targeted.
     /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of the market. explicitly call `connect()`.
-    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the internal `Streamer` queue will be used.
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` live quotes delivery queue will be used.
     /// - returns: Signal producer that can be started at any time.
     public func subscribe(epic: IG.Market.Epic, fields: Set<Streamer.Chart.Tick.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> AnyPublisher<Streamer.Chart.Tick,IG.Error> {
         let item = "CHART:\(epic):TICK"
         let properties = fields.map { $0.rawValue }
         
         return self.streamer.channel
-            .subscribe(on: queue ?? self.streamer.queue, mode: .distinct, items: [item], fields: properties, snapshot: snapshot)
+            .subscribe(on: queue ?? self.streamer.tiers.quotes, mode: .distinct, items: [item], fields: properties, snapshot: snapshot)
             .tryMap { [fields] in try Streamer.Chart.Tick(epic: epic, item: item, update: $0, fields: fields) }
             .mapError(errorCast)
             .eraseToAnyPublisher()
@@ -27,17 +27,17 @@ extension Streamer.Request.Prices {
     /// - parameter epics: The epics identifying the targeted markets.
     /// - parameter fields: The chart properties/fields bieng targeted.
     /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of the market. explicitly call `connect()`.
-    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the internal `Streamer` queue will be used.
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` live quotes delivery queue will be used.
     /// - returns: Signal producer that can be started at any time.
     public func subscribe(epics: Set<IG.Market.Epic>, fields: Set<Streamer.Chart.Tick.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> AnyPublisher<Streamer.Chart.Tick,IG.Error> {
         guard !epics.isEmpty else { return Empty().eraseToAnyPublisher() }
-        guard epics.count > 1 else { return self.subscribe(epic: epics.first.unsafelyUnwrapped, fields: fields, snapshot: snapshot) }
+        guard epics.count > 1 else { return self.subscribe(epic: epics.first.unsafelyUnwrapped, fields: fields, snapshot: snapshot, queue: queue) }
         
         let items = epics.map { "CHART:\($0):TICK" }
         let properties = fields.map { $0.rawValue }
         
         return self.streamer.channel
-            .subscribe(on: queue ?? self.streamer.queue, mode: .distinct, items: items, fields: properties, snapshot: snapshot)
+            .subscribe(on: queue ?? self.streamer.tiers.quotes, mode: .distinct, items: items, fields: properties, snapshot: snapshot)
             .tryMap { [fields] in
                 guard let item = $0.itemName, let epic = IG.Market.Epic(item.split(separator: ":").dropFirst().joined(separator: ":")) else {
                     throw IG.Error._invalid(itemName: $0.itemName)
@@ -46,6 +46,21 @@ extension Streamer.Request.Prices {
             }.mapError(errorCast)
             .eraseToAnyPublisher()
     }
+    
+    /// Creates a mutable set of tick subscriptions whose members can be added or removed without disturbing the remaining ones.
+    ///
+    /// Each epic is backed by its own Lightstreamer subscription; therefore membership changes only (un)subscribe the delta and unchanged markets keep streaming.
+    /// - parameter epics: The initial epics identifying the targeted markets.
+    /// - parameter fields: The chart properties/fields bieng targeted.
+    /// - parameter snapshot: Boolean indicating whether a "beginning" package should be sent with the current state of every newly added market.
+    /// - parameter queue: `DispatchQueue` processing the received values and where the value is forwarded. If `nil`, the `Streamer` live quotes delivery queue will be used.
+    /// - returns: The subscription set. No subscription is established till its `publisher` is subscribed to.
+    public func subscriptionSet(epics: Set<IG.Market.Epic>, fields: Set<Streamer.Chart.Tick.Field>, snapshot: Bool = true, queue: DispatchQueue? = nil) -> Streamer.SubscriptionSet<IG.Market.Epic,Streamer.Chart.Tick> {
+        .init(keys: epics) { [weak weakStreamer = self.streamer] (epic) in
+            guard let streamer = weakStreamer else { return Fail(error: IG.Error._deallocatedInstance()).eraseToAnyPublisher() }
+            return streamer.prices.subscribe(epic: epic, fields: fields, snapshot: snapshot, queue: queue)
+        }
+    }
 }
 
 // MARK: - Request Entities
@@ -91,6 +106,10 @@ extension Set where Element == Streamer.Chart.Tick.Field {
 }
 
 private extension IG.Error {
+    /// Error raised when the Streamer instance is deallocated.
+    static func _deallocatedInstance() -> Self {
+        Self(.streamer(.sessionExpired), "The \(Streamer.self) instance has been deallocated.", help: "The \(Streamer.self) functionality is asynchronous. Keep around the Streamer instance while the subscription set is in use.")
+    }
     /// Error raised when the epic reveived as an update item is invalid.
     static func _invalid(itemName: String?) -> Self {
         Self(.streamer(.invalidResponse), "The Lightstreamer item name received couldn't be matched to a supported epic.", help: "Review the received item name.", info: ["Received item": itemName ?? ""])
@@ -0,0 +1,255 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Streamer {
+    /// Evaluates a large number of one-shot price alerts against streamed market prices.
+    ///
+    /// Alerts are indexed per epic and price side in sorted level books, so evaluating a price update costs O(log n + fired) independently of the total number of registered alerts.
+    /// An alert fires (and it is removed from the engine) the first time the targeted price is at or beyond its level in the alert's direction.
+    public final class AlertEngine<ID> where ID:Hashable {
+        /// The lock restricting access to the engine state.
+        private let _lock: UnfairLock
+        /// The subject forwarding the fired alerts.
+        private let _subject: PassthroughSubject<Fire,Never>
+        /// All registered alerts indexed by identifier.
+        private var _alerts: [ID:Alert]
+        /// The level books for every epic (for both bid and ask prices).
+        private var _books: [IG.Market.Epic:_Books]
+
+        /// Designated initializer creating an empty engine.
+        public init() {
+            self._lock = UnfairLock()
+            self._subject = PassthroughSubject()
+            self._alerts = .init()
+            self._books = .init()
+        }
+
+        deinit {
+            self._lock.invalidate()
+            self._subject.send(completion: .finished)
+        }
+
+        /// Publisher forwarding the alerts as they fire.
+        public var fired: AnyPublisher<Fire,Never> {
+            self._subject.eraseToAnyPublisher()
+        }
+
+        /// The number of registered (non-fired) alerts.
+        public var count: Int {
+            self._lock.execute { self._alerts.count }
+        }
+
+        /// Returns the registered (non-fired) alerts for the given market.
+        /// - parameter epic: The market epic.
+        public func alerts(epic: IG.Market.Epic) -> [Alert] {
+            self._lock.execute { self._alerts.values.filter { $0.epic == epic } }
+        }
+
+        /// Returns the registered (non-fired) alert with the given identifier.
+        /// - parameter id: The alert identifier.
+        public func alert(id: ID) -> Alert? {
+            self._lock.execute { self._alerts[id] }
+        }
+
+        /// Registers the given alerts.
+        ///
+        /// Alerts with an identifier already registered replace the previous alert. If the given sequence contains several alerts with the same identifier, the last one wins.
+        /// - complexity: O((n + m) log(n + m)) for each targeted epic.
+        /// - parameter alerts: The alerts to register.
+        public func add<S>(_ alerts: S) where S:Sequence, S.Element==Alert {
+            // Duplicates within the batch are collapsed beforehand; otherwise the earlier ones would be left dangling in the level books.
+            var batch: [ID:Alert] = .init()
+            for alert in alerts { batch[alert.id] = alert }
+
+            self._lock.lock()
+            var additions: [IG.Market.Epic:[_Books.Element]] = .init()
+            for alert in batch.values {
+                if let previous = self._alerts.updateValue(alert, forKey: alert.id) {
+                    self._books[previous.epic]?.remove(previous)
+                }
+                additions[alert.epic, default: .init()].append((side: alert.side, entry: (id: alert.id, level: alert.level, direction: alert.direction._book)))
+            }
+            for (epic, elements) in additions {
+                self._books[epic, default: .init()].insert(contentsOf: elements)
+            }
+            self._lock.unlock()
+        }
+
+        /// Removes the alerts with the given identifiers.
+        /// - parameter ids: The identifiers of the alerts to remove.
+        /// - returns: The alerts actually removed.
+        @discardableResult public func remove<S>(ids: S) -> [Alert] where S:Sequence, S.Element==ID {
+            self._lock.lock()
+            var result: [Alert] = []
+            for id in ids {
+                guard let alert = self._alerts.removeValue(forKey: id) else { continue }
+                self._books[alert.epic]?.remove(alert)
+                if self._books[alert.epic]?.isEmpty ?? false { self._books.removeValue(forKey: alert.epic) }
+                result.append(alert)
+            }
+            self._lock.unlock()
+            return result
+        }
+
+        /// Removes all registered alerts.
+        public func removeAll() {
+            self._lock.execute {
+                self._alerts.removeAll()
+                self._books.removeAll()
+            }
+        }
+
+        /// Evaluates the given prices for a market, firing (and removing) all reached alerts.
+        /// - complexity: O(log n + fired)
+        /// - parameter epic: The market epic.
+        /// - parameter bid: The latest bid price (if any).
+        /// - parameter ask: The latest ask price (if any).
+        /// - parameter date: The date of the prices (if known).
+        /// - returns: The fired alerts (also sent through the `fired` publisher).
+        @discardableResult public func evaluate(epic: IG.Market.Epic, bid: Decimal64?, ask: Decimal64?, date: Date? = nil) -> [Fire] {
+            self._lock.lock()
+            // The books are mutated in place (through the dictionary subscript) to avoid copying the level storage.
+            guard self._books[epic] != nil else { self._lock.unlock(); return [] }
+
+            var result: [Fire] = []
+            for (side, price) in [(Alert.Side.bid, bid), (Alert.Side.ask, ask)] {
+                guard let price = price else { continue }
+                let (rising, falling) = self._books[epic]!.trigger(side: side, price: price)
+                for id in rising + falling {
+                    guard let alert = self._alerts.removeValue(forKey: id) else { continue }
+                    result.append(Fire(alert: alert, price: price, date: date))
+                }
+            }
+
+            if self._books[epic]!.isEmpty { self._books.removeValue(forKey: epic) }
+            self._lock.unlock()
+
+            result.forEach { self._subject.send($0) }
+            return result
+        }
+
+        /// Evaluates the prices of the given market update, firing (and removing) all reached alerts.
+        /// - parameter market: The streamed market update.
+        /// - returns: The fired alerts (also sent through the `fired` publisher).
+        @discardableResult public func evaluate(_ market: Streamer.Market) -> [Fire] {
+            self.evaluate(epic: market.epic, bid: market.bid, ask: market.ask, date: market.date)
+        }
+    }
+}
+
+extension Streamer.AlertEngine {
+    /// A one-shot price alert.
+    public struct Alert: Identifiable {
+        /// The alert identifier.
+        public let id: ID
+        /// The market epic being watched.
+        public let epic: IG.Market.Epic
+        /// The price side being watched.
+        public let side: Self.Side
+        /// The price level triggering the alert.
+        public let level: Decimal64
+        /// The price movement triggering the alert.
+        public let direction: Self.Direction
+
+        /// Designated initializer.
+        /// - parameter id: The alert identifier.
+        /// - parameter epic: The market epic being watched.
+        /// - parameter side: The price side being watched.
+        /// - parameter level: The price level triggering the alert.
+        /// - parameter direction: The price movement triggering the alert.
+        public init(id: ID, epic: IG.Market.Epic, side: Self.Side, level: Decimal64, direction: Self.Direction) {
+            self.id = id
+            self.epic = epic
+            self.side = side
+            self.level = level
+            self.direction = direction
+        }
+
+        /// The price side being watched.
+        public enum Side: Hashable {
+            /// The bid (sell) price.
+            case bid
+            /// The ask/offer (buy) price.
+            case ask
+        }
+
+        /// The price movement triggering the alert.
+        public enum Direction: Hashable {
+            /// The alert fires when the price is at or above the level.
+            case above
+            /// The alert fires when the price is at or below the level.
+            case below
+        }
+    }
+
+    /// A fired alert.
+    public struct Fire {
+        /// The alert that has been fired.
+        public let alert: Alert
+        /// The price reaching the alert's level.
+        public let price: Decimal64
+        /// The date of the price update (if known).
+        public let date: Date?
+    }
+}
+
+// MARK: -
+
+private extension Streamer.AlertEngine {
+    /// The bid and ask level books for a single epic.
+    struct _Books {
+        typealias Book = TriggerBook<Decimal64,ID>
+        typealias Element = (side: Alert.Side, entry: (id: ID, level: Decimal64, direction: Book.Direction))
+
+        /// Alerts watching the bid price.
+        private var _bid = Book()
+        /// Alerts watching the ask price.
+        private var _ask = Book()
+
+        /// Boolean indicating whether there are no alerts for the epic.
+        var isEmpty: Bool {
+            self._bid.isEmpty && self._ask.isEmpty
+        }
+
+        /// Adds several alerts at once.
+        mutating func insert(contentsOf elements: [Element]) {
+            self._bid.insert(contentsOf: elements.lazy.filter { $0.side == .bid }.map { $0.entry })
+            self._ask.insert(contentsOf: elements.lazy.filter { $0.side == .ask }.map { $0.entry })
+        }
+
+        /// Removes the given alert.
+        mutating func remove(_ alert: Alert) {
+            switch alert.side {
+            case .bid: self._bid.remove(alert.id, level: alert.level, direction: alert.direction._book)
+            case .ask: self._ask.remove(alert.id, level: alert.level, direction: alert.direction._book)
+            }
+        }
+
+        /// Removes and returns the alerts reached by the given price.
+        mutating func trigger(side: Alert.Side, price: Decimal64) -> (rising: [ID], falling: [ID]) {
+            switch side {
+            case .bid: return self._bid.trigger(price: price)
+            case .ask: return self._ask.trigger(price: price)
+            }
+        }
+    }
+}
+
+private extension Streamer.AlertEngine.Alert.Direction {
+    /// The level book direction matching the alert direction.
+    var _book: TriggerBook<Decimal64,ID>.Direction {
+        switch self {
+        case .above: return .rising
+        case .below: return .falling
+        }
+    }
+}
+
+extension Publisher where Output==Streamer.Market {
+    /// Evaluates every market update received from upstream against the given alert engine.
+    /// - parameter engine: The engine holding the price alerts.
+    public func evaluateAlerts<ID>(on engine: Streamer.AlertEngine<ID>) -> Publishers.HandleEvents<Self> {
+        self.handleEvents(receiveOutput: { engine.evaluate($0) })
+    }
+}
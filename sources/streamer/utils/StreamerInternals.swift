@@ -37,20 +37,35 @@ extension Streamer {
     }
 }
 
+// MARK: - Item Updates
+
+/// The field values of a single Lightstreamer item update.
+///
+/// Streamer entities are decoded from this abstraction (instead of the concrete `LSItemUpdate`), so synthetic updates (e.g. the ones produced by `Streamer.LoadGenerator`) go through the exact same decoding path as the real ones.
+internal protocol StreamerItemUpdate {
+    /// The item name as specified in the subscription (e.g. `MARKET:CS.D.EURUSD.MINI.IP`).
+    var itemName: String? { get }
+    /// Returns the current value of the given field (or `nil` if the field has no value).
+    /// - parameter fieldName: The field name as specified in the subscription.
+    func value(withFieldName fieldName: String) -> String?
+}
+
+extension LSItemUpdate: StreamerItemUpdate {}
+
 // MARK: - Convenience Formatter
 
-internal extension LSItemUpdate {
+internal extension StreamerItemUpdate {
     /// Decodes a value of the given type for the given key.
     /// - parameter type: The type of value to decode.
     /// - parameter key: The key that the decoded value is associated with.
-    @nonobjc func decodeIfPresent<Field>(_ type: String.Type, forKey key: Field) -> String? where Field: RawRepresentable, Field.RawValue==String {
+    func decodeIfPresent<Field>(_ type: String.Type, forKey key: Field) -> String? where Field: RawRepresentable, Field.RawValue==String {
         self.value(withFieldName: key.rawValue)
     }
     /// Decodes a value of the given type for the given key.
     /// - parameter type: The type of value to decode.
     /// - parameter key: The key that the decoded value is associated with.
     /// - throws: `IG.Error` exclusively.
-    @nonobjc func decodeIfPresent<Field>(_ type: Bool.Type, forKey key: Field) throws -> Bool? where Field: RawRepresentable, Field.RawValue==String {
+    func decodeIfPresent<Field>(_ type: Bool.Type, forKey key: Field) throws -> Bool? where Field: RawRepresentable, Field.RawValue==String {
         guard let value = self.value(withFieldName: key.rawValue) else { return nil }
         switch value {
         case "0", "false": return false
@@ -62,7 +77,7 @@ internal extension LSItemUpdate {
     /// - parameter type: The type of value to decode.
     /// - parameter key: The key that the decoded value is associated with.
     /// - throws: `IG.Error` exclusively.
-    @nonobjc func decodeIfPresent<Field>(_ type: Int.Type, forKey key: Field) throws -> Int? where Field: RawRepresentable, Field.RawValue==String {
+    func decodeIfPresent<Field>(_ type: Int.Type, forKey key: Field) throws -> Int? where Field: RawRepresentable, Field.RawValue==String {
         guard let value = self.value(withFieldName: key.rawValue) else { return nil }
         return try Int(value) ?> IG.Error._invalid(value: value, forKey: key)
     }
@@ -70,20 +85,21 @@ internal extension LSItemUpdate {
     /// - parameter type: The type of value to decode.
     /// - parameter key: The key that the decoded value is associated with.
     /// - throws: `IG.Error` exclusively.
-    @nonobjc func decodeIfPresent<Field>(_ type: Decimal64.Type, forKey key: Field) throws -> Decimal64? where Field: RawRepresentable, Field.RawValue==String {
+    func decodeIfPresent<Field>(_ type: Decimal64.Type, forKey key: Field) throws -> Decimal64? where Field: RawRepresentable, Field.RawValue==String {
         guard let value = self.value(withFieldName: key.rawValue) else { return nil }
         return try Decimal64(value) ?> IG.Error._invalid(value: value, forKey: key)
     }
     /// Decodes a value of the given type for the given key.
     ///
-    /// Transforms a value representing the time into a `Date` instance.
+    /// Transforms a value representing the time into a `Date` instance (the latest date with such time not posterior to `now`).
     /// - parameter type: The type of value to decode.
+    /// - parameter formatter: The formatter parsing the time.
+    /// - parameter now: The reference date providing the day.
     /// - parameter key: The key that the decoded value is associated with.
     /// - throws: `IG.Error` exclusively.
-    @nonobjc func decodeIfPresent<Field>(_ type: Date.Type, with formatter: DateFormatter, forKey key: Field) throws -> Date? where Field: RawRepresentable, Field.RawValue==String {
+    func decodeIfPresent<Field>(_ type: Date.Type, with formatter: DateFormatter, relativeTo now: Date, forKey key: Field) throws -> Date? where Field: RawRepresentable, Field.RawValue==String {
         guard let value = self.value(withFieldName: key.rawValue) else { return nil }
         
-        let now = Date()
         guard let timeDate = formatter.date(from: value),
               let cal = formatter.calendar,
               let zone = formatter.timeZone,
@@ -99,7 +115,7 @@ internal extension LSItemUpdate {
     /// - parameter type: The type of value to decode.
     /// - parameter key: The key that the decoded value is associated with.
     /// - throws: `IG.Error` exclusively.
-    @nonobjc func decodeIfPresent<Field>(_ type: Date.Type, forKey key: Field) throws -> Date? where Field: RawRepresentable, Field.RawValue==String {
+    func decodeIfPresent<Field>(_ type: Date.Type, forKey key: Field) throws -> Date? where Field: RawRepresentable, Field.RawValue==String {
         guard let value = self.value(withFieldName: key.rawValue) else { return nil }
         guard let milliseconds = TimeInterval(value) else { throw IG.Error._invalid(value: value, forKey: key) }
         return Date(timeIntervalSince1970: milliseconds / 1000)
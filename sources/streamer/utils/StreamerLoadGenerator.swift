@@ -0,0 +1,430 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Streamer {
+    /// Synthetic market-data source measuring the capacity of a streaming pipeline.
+    ///
+    /// The generator produces `MARKET`, `CHART` (tick and candle), and `TRADE` item updates for a configurable number of synthetic markets, at a configurable rate and burstiness.
+    /// Every synthetic update is decoded through the same initializers used for the real Lightstreamer updates; thus decoding cost is part of the measurement.
+    /// Each sample is timestamped right before decoding, so the latency reported by `measure(duration:pipeline:)` covers decoding and every stage of the pipeline under test.
+    public final class LoadGenerator {
+        /// The generator configuration.
+        public let configuration: Configuration
+        /// The clock providing the dates of the generated updates.
+        public let clock: Clock
+        /// The queue where updates are generated and decoded (as the streamer's delivery queues).
+        private let _queue: DispatchQueue
+
+        /// Designated initializer.
+        /// - parameter configuration: The generated load characteristics.
+        /// - parameter queue: The queue where updates are generated and decoded. If `nil`, a serial queue is created.
+        /// - parameter clock: The clock providing the dates of the generated updates (the generation pace and latencies are always measured in wall time).
+        public init(configuration: Configuration, queue: DispatchQueue? = nil, clock: Clock = SystemClock.shared) {
+            self.configuration = configuration
+            self.clock = clock
+            self._queue = queue ?? DispatchQueue(label: IG.identifier + ".streamer.load", qos: .userInitiated)
+        }
+
+        /// Returns a publisher generating (and decoding) synthetic updates.
+        ///
+        /// Generation starts on subscription and stops on cancellation. Every subscription generates its own independent load.
+        /// - parameter duration: The amount of seconds after which the publisher completes. If `nil`, the publisher never completes.
+        /// - returns: Publisher forwarding decoded samples. Updates failing to decode are counted as failures but don't terminate the stream.
+        public func samples(duration: TimeInterval? = nil) -> AnyPublisher<Sample,IG.Error> {
+            _Source(configuration: self.configuration, queue: self._queue, clock: self.clock).publisher(duration: duration)
+        }
+
+        /// Runs the generator for the given time through the given pipeline and reports the achieved throughput and latency.
+        ///
+        /// The latency of a sample is the time elapsed from its generation (right before decoding) till it reaches the end of the pipeline.
+        /// - parameter duration: The amount of seconds the load is generated.
+        /// - parameter pipeline: Closure building the pipeline under test. It receives the generated samples and must forward them (or a subset of them) downstream.
+        /// - returns: Publisher forwarding a single report once the load has finished and the pipeline has completed.
+        public func measure<P>(duration: TimeInterval, pipeline: @escaping (AnyPublisher<Sample,IG.Error>) -> P) -> AnyPublisher<Report,IG.Error> where P:Publisher, P.Output==Sample, P.Failure==IG.Error {
+            let (configuration, queue, clock) = (self.configuration, self._queue, self.clock)
+            return Deferred { () -> AnyPublisher<Report,IG.Error> in
+                let source = _Source(configuration: configuration, queue: queue, clock: clock)
+                let recorder = _Recorder()
+                return pipeline(source.publisher(duration: duration))
+                    .reduce(recorder) { $0.record($1); return $0 }
+                    .map { $0.report(counters: source.counters, start: source.start) }
+                    .eraseToAnyPublisher()
+            }.eraseToAnyPublisher()
+        }
+    }
+}
+
+extension Streamer.LoadGenerator {
+    /// The characteristics of the generated load.
+    public struct Configuration {
+        /// The number of synthetic markets.
+        public var epics: Int
+        /// The average amount of updates generated per second (across all markets and kinds).
+        public var rate: Double
+        /// The amount of updates released back to back. `1` spaces the updates evenly; bigger values generate bursts separated by idle periods (keeping the same average rate).
+        public var burst: Int
+        /// The kinds of updates generated (round-robin among them).
+        public var kinds: Set<Kind>
+        /// The market fields present on `MARKET` updates.
+        public var marketFields: Set<Streamer.Market.Field>
+        /// The tick fields present on `CHART` tick updates.
+        public var tickFields: Set<Streamer.Chart.Tick.Field>
+        /// The candle fields present on `CHART` candle updates.
+        public var candleFields: Set<Streamer.Chart.Aggregated.Field>
+        /// The candle interval for `CHART` candle updates.
+        public var interval: Streamer.Chart.Aggregated.Interval
+
+        /// Designated initializer.
+        /// - parameter epics: The number of synthetic markets.
+        /// - parameter rate: The average amount of updates generated per second.
+        /// - parameter burst: The amount of updates released back to back.
+        /// - parameter kinds: The kinds of updates generated.
+        public init(epics: Int = 100, rate: Double = 1_000, burst: Int = 1, kinds: Set<Kind> = [.market], marketFields: Set<Streamer.Market.Field> = .all, tickFields: Set<Streamer.Chart.Tick.Field> = .all, candleFields: Set<Streamer.Chart.Aggregated.Field> = .all, interval: Streamer.Chart.Aggregated.Interval = .second) {
+            self.epics = Swift.max(1, epics)
+            self.rate = Swift.max(1, rate)
+            self.burst = Swift.max(1, burst)
+            self.kinds = kinds.isEmpty ? [.market] : kinds
+            self.marketFields = marketFields
+            self.tickFields = tickFields
+            self.candleFields = candleFields
+            self.interval = interval
+        }
+    }
+
+    /// The kinds of synthetic updates.
+    public enum Kind: Hashable, CaseIterable {
+        /// `MARKET:EPIC` updates.
+        case market
+        /// `CHART:EPIC:TICK` updates.
+        case tick
+        /// `CHART:EPIC:INTERVAL` updates.
+        case candle
+        /// `TRADE:ACCOUNT` updates (open position updates).
+        case trade
+    }
+
+    /// A decoded synthetic update.
+    public struct Sample {
+        /// The decoded value.
+        public let value: Value
+        /// The moment the update was generated (right before decoding).
+        public let timestamp: DispatchTime
+
+        /// The decoded value of a synthetic update.
+        public enum Value {
+            case market(Streamer.Market)
+            case tick(Streamer.Chart.Tick)
+            case candle(Streamer.Chart.Aggregated)
+            case trade(Streamer.Deal)
+        }
+    }
+
+    /// The measurements of a load run.
+    public struct Report {
+        /// The amount of updates generated.
+        public let generated: Int
+        /// The amount of updates that failed to decode.
+        public let failures: Int
+        /// The amount of samples reaching the end of the pipeline.
+        public let received: Int
+        /// The time (in seconds) elapsed from the first generated update till the pipeline completed.
+        public let duration: TimeInterval
+        /// The amount of samples reaching the end of the pipeline per second.
+        public var throughput: Double {
+            (self.duration > 0) ? Double(self.received) / self.duration : 0
+        }
+        /// The end-to-end latency distribution (in seconds).
+        public let latency: Percentiles
+    }
+
+    /// A latency distribution (in seconds).
+    public struct Percentiles {
+        /// The median latency.
+        public let p50: TimeInterval
+        /// The 90th percentile latency.
+        public let p90: TimeInterval
+        /// The 99th percentile latency.
+        public let p99: TimeInterval
+        /// The 99.9th percentile latency.
+        public let p999: TimeInterval
+        /// The maximum latency.
+        public let maximum: TimeInterval
+    }
+}
+
+// MARK: -
+
+extension Streamer.LoadGenerator {
+    /// Synthetic Lightstreamer item update.
+    fileprivate struct _ItemUpdate: StreamerItemUpdate {
+        let itemName: String?
+        let values: [String:String]
+
+        func value(withFieldName fieldName: String) -> String? {
+            self.values[fieldName]
+        }
+    }
+
+    /// Generates, decodes, and forwards the synthetic updates of a single subscription.
+    fileprivate final class _Source {
+        /// The load characteristics.
+        private let _configuration: Streamer.LoadGenerator.Configuration
+        /// The queue where updates are generated and decoded.
+        private let _queue: DispatchQueue
+        /// The clock providing the dates of the generated updates.
+        private let _clock: Clock
+        /// The lock restricting access to the counters.
+        private let _lock: UnfairLock
+        /// The subject forwarding the decoded samples.
+        private let _subject: PassthroughSubject<Sample,IG.Error>
+        /// The timer releasing the updates.
+        private var _timer: DispatchSourceTimer?
+        /// The synthetic markets and their mid prices (a random walk).
+        private var _markets: [(epic: IG.Market.Epic, mid: Double)]
+        /// The kinds generated (in round-robin order).
+        private let _kinds: [Kind]
+        /// The amount of updates generated and failed to decode.
+        private var _counters: (generated: Int, failures: Int)
+        /// The moment the first update was generated.
+        private var _start: DispatchTime?
+        /// Formatters and decoders shared among all generated updates.
+        private let _timeFormatter: DateFormatter
+        private let _decoder: JSONDecoder
+
+        init(configuration: Streamer.LoadGenerator.Configuration, queue: DispatchQueue, clock: Clock) {
+            self._configuration = configuration
+            self._queue = queue
+            self._clock = clock
+            self._lock = UnfairLock()
+            self._subject = PassthroughSubject()
+            self._markets = (0..<configuration.epics).map { (IG.Market.Epic("SYN.D.M\($0).IP")!, 1 + Double($0 % 100) / 100) }
+            self._kinds = Kind.allCases.filter { configuration.kinds.contains($0) }
+            self._counters = (0, 0)
+            self._start = nil
+            self._timeFormatter = DateFormatter.londonTime
+            self._decoder = JSONDecoder()
+        }
+
+        deinit {
+            self._timer?.cancel()
+            self._lock.invalidate()
+        }
+
+        /// The amount of updates generated and failed to decode.
+        var counters: (generated: Int, failures: Int) {
+            self._lock.execute { self._counters }
+        }
+
+        /// The moment the first update was generated (or `nil` if no update has been generated yet).
+        var start: DispatchTime? {
+            self._lock.execute { self._start }
+        }
+
+        /// Returns the publisher starting the generation on subscription.
+        /// - parameter duration: The amount of seconds after which the publisher completes (if any).
+        func publisher(duration: TimeInterval?) -> AnyPublisher<Sample,IG.Error> {
+            // The source is strongly captured, so it lives as long as the subscription.
+            self._subject
+                .handleEvents(receiveSubscription: { _ in self._queue.async { self._start(duration: duration) } },
+                              receiveCancel: { self._queue.async { self._stop() } })
+                .eraseToAnyPublisher()
+        }
+
+        /// Starts the timer releasing the updates.
+        ///
+        /// The timer fires at most every millisecond; on every fire, the updates due since the start are released in groups of `burst` updates. Thus, the average rate is kept even for rates higher than the timer resolution.
+        private func _start(duration: TimeInterval?) {
+            guard self._timer == nil else { return }
+            let (rate, burst) = (self._configuration.rate, self._configuration.burst)
+            let start = DispatchTime.now()
+            let end = duration.map { start + $0 }
+            let period = Swift.max(Double(burst) / rate, 0.001)
+
+            let timer = DispatchSource.makeTimerSource(queue: self._queue)
+            timer.schedule(deadline: start, repeating: period, leeway: .microseconds(100))
+            timer.setEventHandler { [unowned self] in
+                let now = DispatchTime.now()
+                let elapsed = Double(now.uptimeNanoseconds - start.uptimeNanoseconds) / 1_000_000_000
+                let generated = self._lock.execute { self._counters.generated }
+                let due = (Int(elapsed * rate) - generated) / burst * burst
+                for _ in 0..<Swift.max(0, due) { self._generate() }
+
+                if let end = end, now >= end {
+                    self._stop()
+                    self._subject.send(completion: .finished)
+                }
+            }
+            self._timer = timer
+            timer.resume()
+        }
+
+        /// Stops generating updates.
+        private func _stop() {
+            self._timer?.cancel()
+            self._timer = nil
+        }
+
+        /// Generates, decodes, and forwards a single update.
+        private func _generate() {
+            let timestamp = DispatchTime.now()
+            let index = self._lock.execute { () -> Int in
+                defer { self._counters.generated += 1 }
+                if self._start == nil { self._start = timestamp }
+                return self._counters.generated
+            }
+
+            let kind = self._kinds[index % self._kinds.count]
+            let row = (index / self._kinds.count) % self._markets.count
+            // The mid price follows a random walk in 0.1 pip steps.
+            let mid = Swift.max(0.01, self._markets[row].mid + Double(Int.random(in: -1...1)) / 100_000)
+            self._markets[row].mid = mid
+            let epic = self._markets[row].epic
+            let date = self._clock.now
+
+            do {
+                let value: Sample.Value
+                switch kind {
+                case .market:
+                    let update = _ItemUpdate(itemName: "MARKET:\(epic)", values: self._marketValues(mid: mid, date: date))
+                    value = .market(try Streamer.Market(epic: epic, update: update, timeFormatter: self._timeFormatter, now: date, fields: self._configuration.marketFields))
+                case .tick:
+                    let item = "CHART:\(epic):TICK"
+                    let update = _ItemUpdate(itemName: item, values: self._tickValues(mid: mid, date: date))
+                    value = .tick(try Streamer.Chart.Tick(epic: epic, item: item, update: update, fields: self._configuration.tickFields))
+                case .candle:
+                    let interval = self._configuration.interval
+                    let update = _ItemUpdate(itemName: "CHART:\(epic):\(interval.description)", values: self._candleValues(mid: mid, date: date, index: index))
+                    value = .candle(try Streamer.Chart.Aggregated(epic: epic, interval: interval, update: update, fields: self._configuration.candleFields))
+                case .trade:
+                    let item = "TRADE:SYN01"
+                    let update = _ItemUpdate(itemName: item, values: [Streamer.Deal.Field.updates.rawValue: self._tradeValue(epic: epic, mid: mid, date: date, index: index)])
+                    value = .trade(try Streamer.Deal(account: "SYN01", item: item, update: update, decoder: self._decoder, fields: .all))
+                }
+                self._subject.send(Sample(value: value, timestamp: timestamp))
+            } catch {
+                self._lock.execute { self._counters.failures += 1 }
+            }
+        }
+    }
+}
+
+private extension Streamer.LoadGenerator._Source {
+    /// Formats a price as a Lightstreamer field value.
+    static func _price(_ value: Double) -> String {
+        String(format: "%.5f", value)
+    }
+
+    /// The field values of a synthetic `MARKET` update (restricted to the configured fields).
+    func _marketValues(mid: Double, date: Date) -> [String:String] {
+        let fields = self._configuration.marketFields
+        var result: [String:String] = [:]
+        result.reserveCapacity(fields.count)
+        for field in fields {
+            switch field {
+            case .status: result[field.rawValue] = "TRADEABLE"
+            case .date: result[field.rawValue] = self._timeFormatter.string(from: date)
+            case .isDelayed: result[field.rawValue] = "0"
+            case .bid: result[field.rawValue] = Self._price(mid - 0.0001)
+            case .ask: result[field.rawValue] = Self._price(mid + 0.0001)
+            case .dayHighest: result[field.rawValue] = Self._price(mid + 0.01)
+            case .dayMid: result[field.rawValue] = Self._price(mid)
+            case .dayLowest: result[field.rawValue] = Self._price(mid - 0.01)
+            case .dayChangeNet: result[field.rawValue] = Self._price(0.001)
+            case .dayChangePercentage: result[field.rawValue] = "0.10"
+            }
+        }
+        return result
+    }
+
+    /// The field values of a synthetic `CHART` tick update (restricted to the configured fields).
+    func _tickValues(mid: Double, date: Date) -> [String:String] {
+        let fields = self._configuration.tickFields
+        var result: [String:String] = [:]
+        result.reserveCapacity(fields.count)
+        for field in fields {
+            switch field {
+            case .date: result[field.rawValue] = String(Int(date.timeIntervalSince1970 * 1000))
+            case .bid: result[field.rawValue] = Self._price(mid - 0.0001)
+            case .ask: result[field.rawValue] = Self._price(mid + 0.0001)
+            case .volume: result[field.rawValue] = "1"
+            case .dayLowest: result[field.rawValue] = Self._price(mid - 0.01)
+            case .dayMid: result[field.rawValue] = Self._price(mid)
+            case .dayHighest: result[field.rawValue] = Self._price(mid + 0.01)
+            case .dayChangeNet: result[field.rawValue] = Self._price(0.001)
+            case .dayChangePercentage: result[field.rawValue] = "0.10"
+            }
+        }
+        return result
+    }
+
+    /// The field values of a synthetic `CHART` candle update (restricted to the configured fields).
+    func _candleValues(mid: Double, date: Date, index: Int) -> [String:String] {
+        let fields = self._configuration.candleFields
+        var result: [String:String] = [:]
+        result.reserveCapacity(fields.count)
+        for field in fields {
+            switch field {
+            case .date: result[field.rawValue] = String(Int(date.timeIntervalSince1970) * 1000)
+            case .openBid, .closeBid: result[field.rawValue] = Self._price(mid - 0.0001)
+            case .openAsk, .closeAsk: result[field.rawValue] = Self._price(mid + 0.0001)
+            case .lowestBid: result[field.rawValue] = Self._price(mid - 0.0006)
+            case .lowestAsk: result[field.rawValue] = Self._price(mid - 0.0004)
+            case .highestBid: result[field.rawValue] = Self._price(mid + 0.0004)
+            case .highestAsk: result[field.rawValue] = Self._price(mid + 0.0006)
+            case .isFinished: result[field.rawValue] = (index % 10 == 0) ? "1" : "0"
+            case .numTicks: result[field.rawValue] = String(index % 10 + 1)
+            case .volume: result[field.rawValue] = "1"
+            case .dayLowest: result[field.rawValue] = Self._price(mid - 0.01)
+            case .dayMid: result[field.rawValue] = Self._price(mid)
+            case .dayHighest: result[field.rawValue] = Self._price(mid + 0.01)
+            case .dayChangeNet: result[field.rawValue] = Self._price(0.001)
+            case .dayChangePercentage: result[field.rawValue] = "0.10"
+            }
+        }
+        return result
+    }
+
+    /// The JSON payload of a synthetic `OPU` (open position update) field.
+    func _tradeValue(epic: IG.Market.Epic, mid: Double, date: Date, index: Int) -> String {
+        let timestamp = DateFormatter.iso8601.string(from: date)
+        let direction = (index % 2 == 0) ? "BUY" : "SELL"
+        return #"{"timestamp":"\#(timestamp)","dealId":"DIAAAASYN\#(index)","dealReference":"SYNREF\#(index)","dealStatus":"ACCEPTED","epic":"\#(epic)","expiry":"-","status":"OPEN","direction":"\#(direction)","size":1,"level":\#(Self._price(mid)),"channel":"SYNTHETIC"}"#
+    }
+}
+
+/// Accumulates the latencies of the samples reaching the end of the pipeline.
+private final class _Recorder {
+    /// The latencies (in nanoseconds) of every received sample.
+    private var _latencies: [UInt64]
+
+    init() {
+        self._latencies = []
+        self._latencies.reserveCapacity(1 << 16)
+    }
+
+    /// Records the latency of the given sample.
+    func record(_ sample: Streamer.LoadGenerator.Sample) {
+        let now = DispatchTime.now().uptimeNanoseconds
+        let timestamp = sample.timestamp.uptimeNanoseconds
+        self._latencies.append((now > timestamp) ? now - timestamp : 0)
+    }
+
+    /// Builds the report from the recorded latencies.
+    /// - complexity: O(n log n) where `n` is the number of recorded samples.
+    /// - parameter counters: The amount of updates generated and failed to decode.
+    /// - parameter start: The moment the first update was generated (if any).
+    func report(counters: (generated: Int, failures: Int), start: DispatchTime?) -> Streamer.LoadGenerator.Report {
+        let (now, start) = (DispatchTime.now().uptimeNanoseconds, start?.uptimeNanoseconds)
+        let duration = start.map { Double((now > $0) ? now - $0 : 0) / 1_000_000_000 } ?? 0
+        let sorted = self._latencies.sorted()
+        func percentile(_ p: Double) -> TimeInterval {
+            guard !sorted.isEmpty else { return 0 }
+            let index = Swift.min(sorted.count - 1, Int((p * Double(sorted.count)).rounded(.up)) - 1)
+            return Double(sorted[Swift.max(0, index)]) / 1_000_000_000
+        }
+
+        let latency = Streamer.LoadGenerator.Percentiles(p50: percentile(0.5), p90: percentile(0.9), p99: percentile(0.99), p999: percentile(0.999), maximum: percentile(1))
+        return .init(generated: counters.generated, failures: counters.failures, received: sorted.count, duration: duration, latency: latency)
+    }
+}
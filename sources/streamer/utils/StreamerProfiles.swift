@@ -0,0 +1,355 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Streamer {
+    /// Builds volume and market profiles (price-at-volume and time-at-price histograms) incrementally from streamed ticks.
+    ///
+    /// Every tick is binned by its mid price into a fixed-size price histogram for the ongoing session of its market. Bins are stored contiguously (growing at either end as the price explores new levels) and the point of control is maintained on every tick; thus, recording a tick is O(1) amortized and raw ticks are never kept in memory.
+    /// When a tick falls on a later session, the previous session's profile is finished and forwarded through `finished` (e.g. to be stored with `database.profiles.update(_:)`).
+    public final class ProfileBuilder {
+        /// The size of the price bins for every profiled market.
+        public let binSizes: [IG.Market.Epic:Decimal64]
+        /// The session partitioning the ticks.
+        public let session: Streamer.Profile.Session
+        /// The maximum number of price bins of a session profile (ticks stretching the histogram beyond it are ignored).
+        public let maximumBins: Int
+        /// The lock restricting access to the builder state.
+        private let _lock: UnfairLock
+        /// The subject forwarding the finished profiles.
+        private let _subject: PassthroughSubject<Streamer.Profile,Never>
+        /// The ongoing profile of every market.
+        private var _profiles: [IG.Market.Epic:_Accumulator]
+
+        /// Designated initializer.
+        /// - parameter binSizes: The size of the price bins for every profiled market (ticks of other markets are ignored).
+        /// - parameter session: The session partitioning the ticks.
+        /// - parameter maximumBins: The maximum number of price bins of a session profile. Ticks stretching the histogram beyond it (e.g. bad prints or zero prices) are ignored.
+        /// - precondition: `maximumBins` must be a positive number.
+        public init(binSizes: [IG.Market.Epic:Decimal64], session: Streamer.Profile.Session = .daily(), maximumBins: Int = 10_000) {
+            precondition(maximumBins > 0, "The maximum number of bins must be a positive number")
+            self.binSizes = binSizes.filter { $0.value > .zero }
+            self.session = session
+            self.maximumBins = maximumBins
+            self._lock = UnfairLock()
+            self._subject = PassthroughSubject()
+            self._profiles = .init()
+        }
+
+        deinit {
+            self._lock.invalidate()
+            self._subject.send(completion: .finished)
+        }
+
+        /// Publisher forwarding the profiles of the sessions that have finished.
+        public var finished: AnyPublisher<Streamer.Profile,Never> {
+            self._subject.eraseToAnyPublisher()
+        }
+
+        /// Records the given tick on the ongoing profile of its market.
+        ///
+        /// Ticks without date or prices, ticks older than the ongoing session, and ticks stretching the profile beyond `maximumBins` are ignored. Ticks without volume (e.g. forex markets) count as a single unit of volume (i.e. tick volume).
+        /// - complexity: O(1) amortized.
+        /// - parameter tick: The streamed tick.
+        public func update(_ tick: Streamer.Chart.Tick) {
+            guard let date = tick.date, let bid = tick.bid, let ask = tick.ask,
+                  let price = Double((bid + Decimal64(5, power: -1).unsafelyUnwrapped * (ask - bid)).description) else { return }
+            let volume = tick.volume.flatMap { Double($0.description) } ?? 1
+            self.update(epic: tick.epic, date: date, price: price, volume: volume)
+        }
+
+        /// Records a trade (or quote) on the ongoing profile of the given market.
+        /// - complexity: O(1) amortized.
+        /// - parameter epic: The market epic (markets without bin size are ignored).
+        /// - parameter date: The moment of the trade.
+        /// - parameter price: The trade price.
+        /// - parameter volume: The traded volume.
+        public func update(epic: IG.Market.Epic, date: Date, price: Double, volume: Double) {
+            guard let binSize = self.binSizes[epic], price.isFinite, volume.isFinite, volume >= 0 else { return }
+
+            var finished: Streamer.Profile? = nil
+            self._lock.lock()
+            let start = self.session.start(for: date)
+            if let profile = self._profiles[epic], profile.start < start {
+                finished = profile.profile(epic: epic)
+                self._profiles[epic] = nil
+            }
+
+            switch self._profiles[epic] {
+            case .some(let profile) where profile.start > start:
+                break
+            case .some:
+                self._profiles[epic]!.add(price: price, volume: volume, date: date)
+            case .none:
+                var profile = _Accumulator(start: start, end: start.addingTimeInterval(self.session.length), binSize: binSize, maximumBins: self.maximumBins)
+                if profile.add(price: price, volume: volume, date: date) { self._profiles[epic] = profile }
+            }
+            self._lock.unlock()
+
+            if let profile = finished { self._subject.send(profile) }
+        }
+
+        /// Returns the point of control (i.e. the price level with the highest volume) of the ongoing session.
+        /// - complexity: O(1).
+        /// - parameter epic: The market epic.
+        public func pointOfControl(epic: IG.Market.Epic) -> Decimal64? {
+            self._lock.execute { self._profiles[epic]?.pointOfControl }
+        }
+
+        /// Returns a snapshot of the profile of the ongoing session.
+        /// - complexity: O(b) where `b` is the number of price bins.
+        /// - parameter epic: The market epic.
+        public func profile(epic: IG.Market.Epic) -> Streamer.Profile? {
+            self._lock.execute { self._profiles[epic]?.profile(epic: epic) }
+        }
+
+        /// Finishes the ongoing session of the given markets (e.g. at market close), forwarding their profiles through `finished`.
+        /// - parameter epics: The markets whose sessions are finished. If `nil`, all ongoing sessions are finished.
+        /// - returns: The finished profiles.
+        @discardableResult public func finish(epics: Set<IG.Market.Epic>? = nil) -> [Streamer.Profile] {
+            self._lock.lock()
+            let targets = epics.map { Array($0) } ?? Array(self._profiles.keys)
+            let profiles = targets.compactMap { (epic) -> Streamer.Profile? in
+                self._profiles.removeValue(forKey: epic)?.profile(epic: epic)
+            }
+            self._lock.unlock()
+
+            profiles.forEach { self._subject.send($0) }
+            return profiles
+        }
+    }
+}
+
+extension Streamer {
+    /// The volume and time distribution over price levels of a market during a session.
+    public struct Profile {
+        /// The market epic identifier.
+        public let epic: IG.Market.Epic
+        /// The session start (inclusive).
+        public let start: Date
+        /// The session end (exclusive).
+        public let end: Date
+        /// The size of every price bin.
+        public let binSize: Decimal64
+        /// The lowest price level (i.e. the lower bound of the first bin).
+        public let base: Decimal64
+        /// The histogram bins (ordered by increasing price level).
+        public let bins: [Bin]
+
+        /// Designated initializer.
+        public init(epic: IG.Market.Epic, start: Date, end: Date, binSize: Decimal64, base: Decimal64, bins: [Bin]) {
+            self.epic = epic
+            self.start = start
+            self.end = end
+            self.binSize = binSize
+            self.base = base
+            self.bins = bins
+        }
+    }
+}
+
+extension Streamer.Profile {
+    /// A price level of the histogram.
+    public struct Bin: Equatable {
+        /// The volume traded at the price level.
+        public var volume: Double
+        /// The number of ticks at the price level.
+        public var ticks: Int
+        /// The time (in seconds) the price spent at the price level.
+        public var time: TimeInterval
+
+        /// Designated initializer.
+        public init(volume: Double = 0, ticks: Int = 0, time: TimeInterval = 0) {
+            self.volume = volume
+            self.ticks = ticks
+            self.time = time
+        }
+    }
+
+    /// The partition of time into consecutive sessions of the same length.
+    public struct Session {
+        /// The session length (in seconds).
+        public let length: TimeInterval
+        /// The offset (in seconds) of the session starts from the Unix epoch.
+        public let offset: TimeInterval
+
+        /// Designated initializer.
+        /// - precondition: `length` must be a positive number.
+        public init(length: TimeInterval, offset: TimeInterval = 0) {
+            precondition(length > 0, "The session length must be a positive number")
+            self.length = length
+            self.offset = offset
+        }
+
+        /// Daily sessions starting at the given offset from midnight UTC (e.g. `-7_200` for sessions starting at 22:00 UTC).
+        public static func daily(offset: TimeInterval = 0) -> Self {
+            Self(length: 86_400, offset: offset)
+        }
+
+        /// Returns the start of the session containing the given date.
+        public func start(for date: Date) -> Date {
+            let seconds = date.timeIntervalSince1970 - self.offset
+            return Date(timeIntervalSince1970: (seconds / self.length).rounded(.down) * self.length + self.offset)
+        }
+    }
+
+    /// Returns the lower bound of the price level of the bin at the given position.
+    public func level(at index: Int) -> Decimal64 {
+        self.base + self.binSize * Decimal64(index, power: 0).unsafelyUnwrapped
+    }
+
+    /// The total volume traded during the session.
+    public var volume: Double {
+        self.bins.reduce(0) { $0 + $1.volume }
+    }
+
+    /// The price level with the highest volume (the lowest one on ties) or `nil` if there is no volume.
+    public var pointOfControl: Decimal64? {
+        self._pointOfControl.map { self.level(at: $0) }
+    }
+
+    /// Returns the price range around the point of control containing the given fraction of the session volume.
+    ///
+    /// The area starts at the point of control and it is expanded to the adjacent level with more volume till the targeted volume is reached.
+    /// - complexity: O(b) where `b` is the number of price bins.
+    /// - parameter fraction: The fraction of the session volume (e.g. `0.7` for the conventional 70% value area).
+    /// - returns: The lower bounds of the lowest and highest price levels of the value area or `nil` if there is no volume.
+    public func valueArea(fraction: Double = 0.7) -> ClosedRange<Decimal64>? {
+        guard let poc = self._pointOfControl else { return nil }
+        let target = self.volume * Swift.max(0, Swift.min(1, fraction))
+
+        var (low, high, accumulated) = (poc, poc, self.bins[poc].volume)
+        while accumulated < target, low > 0 || high < self.bins.count - 1 {
+            let below = (low > 0) ? self.bins[low - 1].volume : -1
+            let above = (high < self.bins.count - 1) ? self.bins[high + 1].volume : -1
+            if above >= below {
+                high += 1; accumulated += above
+            } else {
+                low -= 1; accumulated += below
+            }
+        }
+        return self.level(at: low)...self.level(at: high)
+    }
+
+    /// The position of the bin with the highest volume.
+    private var _pointOfControl: Int? {
+        var result: Int? = nil
+        for (index, bin) in self.bins.enumerated() where bin.volume > 0 {
+            if let current = result, self.bins[current].volume >= bin.volume { continue }
+            result = index
+        }
+        return result
+    }
+}
+
+// MARK: -
+
+/// The profile of an ongoing session.
+private struct _Accumulator {
+    /// The session start (inclusive).
+    let start: Date
+    /// The session end (exclusive).
+    let end: Date
+    /// The size of every price bin.
+    let binSize: Decimal64
+    /// The size of every price bin as a floating-point number.
+    private let _binSize: Double
+    /// The maximum number of bins.
+    private let _maximumBins: Int
+    /// The bin number (i.e. `floor(price / binSize)`) of the first bin.
+    private var _base: Int
+    /// The histogram bins.
+    private var _bins: [Streamer.Profile.Bin]
+    /// The position of the bin with the highest volume (the lowest one on ties).
+    private var _poc: Int?
+    /// The date and bin position of the last recorded tick.
+    private var _last: (date: Date, index: Int)?
+
+    init(start: Date, end: Date, binSize: Decimal64, maximumBins: Int) {
+        self.start = start
+        self.end = end
+        self.binSize = binSize
+        self._binSize = Double(binSize.description)!
+        self._maximumBins = maximumBins
+        self._base = 0
+        self._bins = []
+    }
+
+    /// The lower bound of the price level with the highest volume (the lowest one on ties).
+    var pointOfControl: Decimal64? {
+        self._poc.map { self.binSize * Decimal64(self._base + $0, power: 0).unsafelyUnwrapped }
+    }
+
+    /// Records the given trade (unless it stretches the histogram beyond the maximum number of bins).
+    /// - returns: Boolean indicating whether the trade has been recorded.
+    @discardableResult mutating func add(price: Double, volume: Double, date: Date) -> Bool {
+        guard let number = self._number(price: price) else { return false }
+        if !self._bins.isEmpty {
+            let (lower, upper) = (Swift.min(self._base, number), Swift.max(self._base + self._bins.count - 1, number))
+            guard upper - lower < self._maximumBins else { return false }
+        }
+        let index = self._index(number: number)
+
+        // The time elapsed since the previous tick is spent at the previous tick's level.
+        if let last = self._last, date > last.date {
+            self._bins[last.index].time += Swift.min(date, self.end).timeIntervalSince(last.date)
+        }
+        if let last = self._last, date < last.date {
+            // Out of order ticks don't move the price level.
+        } else {
+            self._last = (date, index)
+        }
+
+        self._bins[index].volume += volume
+        self._bins[index].ticks += 1
+        // Same tie rule as `Streamer.Profile.pointOfControl`: the lowest bin wins among bins with the same volume.
+        if volume > 0, self._poc.map({ (poc) in
+            let (current, candidate) = (self._bins[poc].volume, self._bins[index].volume)
+            return current < candidate || (current == candidate && index < poc)
+        }) ?? true {
+            self._poc = index
+        }
+        return true
+    }
+
+    /// Returns the bin number (i.e. `floor(price / binSize)`) for the given price or `nil` if it is out of range.
+    ///
+    /// Prices are usually exact multiples of the tick size, but the floating-point division may fall right below the bin edge (e.g. `0.3 / 0.1 = 2.9999999999999996`); thus, quotients within a relative tolerance of an integer are rounded to it.
+    private func _number(price: Double) -> Int? {
+        let quotient = price / self._binSize
+        guard Swift.abs(quotient) < 1e15 else { return nil }
+        let nearest = quotient.rounded()
+        let isEdge = Swift.abs(quotient - nearest) <= Swift.max(1, Swift.abs(nearest)) * 1e-9
+        return Int(isEdge ? nearest : quotient.rounded(.down))
+    }
+
+    /// Returns the position of the bin with the given number (growing the histogram if needed).
+    private mutating func _index(number: Int) -> Int {
+        guard !self._bins.isEmpty else {
+            self._base = number
+            self._bins.append(.init())
+            return 0
+        }
+
+        if number < self._base {
+            let count = self._base - number
+            self._bins.insert(contentsOf: repeatElement(.init(), count: count), at: 0)
+            self._base = number
+            self._poc = self._poc.map { $0 + count }
+            self._last = self._last.map { ($0.date, $0.index + count) }
+            return 0
+        }
+
+        let index = number - self._base
+        if index >= self._bins.count {
+            self._bins.append(contentsOf: repeatElement(.init(), count: index - self._bins.count + 1))
+        }
+        return index
+    }
+
+    /// Returns a snapshot of the profile.
+    func profile(epic: IG.Market.Epic) -> Streamer.Profile {
+        let base = self.binSize * Decimal64(self._base, power: 0).unsafelyUnwrapped
+        return .init(epic: epic, start: self.start, end: self.end, binSize: self.binSize, base: base, bins: self._bins)
+    }
+}
@@ -0,0 +1,305 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Streamer {
+    /// Cross-sectional screener keeping the latest values of every streamed market and ranking them on registered metrics.
+    ///
+    /// Market values are stored in a columnar table (one array per field), and every registered metric keeps an order-statistics index (a sorted array) updated incrementally on each market update.
+    /// Ranking queries (e.g. "top movers" or "widest spreads") are therefore answered in O(K) without re-sorting the whole universe.
+    public final class Screener {
+        /// The lock restricting access to the screener state.
+        private let _lock: UnfairLock
+        /// The row index for every screened market.
+        private var _rows: [IG.Market.Epic:Int]
+        /// The columnar table storing the latest market values.
+        private var _table: _Table
+        /// The sorted indices for every registered metric.
+        private var _indices: [String:_Index]
+
+        /// Designated initializer.
+        /// - parameter metrics: The metrics ranked from the start.
+        public init(metrics: [Metric] = []) {
+            self._lock = UnfairLock()
+            self._rows = .init()
+            self._table = .init()
+            self._indices = .init()
+            metrics.forEach { self._indices[$0.name] = _Index(metric: $0) }
+        }
+
+        deinit {
+            self._lock.invalidate()
+        }
+
+        /// The number of markets being screened.
+        public var count: Int {
+            self._lock.execute { self._rows.count }
+        }
+
+        /// The names of the registered metrics.
+        public var metrics: Set<String> {
+            self._lock.execute { Set(self._indices.keys) }
+        }
+
+        /// Starts ranking the screened markets on the given metric.
+        ///
+        /// The metric index is built from the current table content; further updates are applied incrementally. Registering a metric with the same name as a previously registered one replaces it.
+        /// - complexity: O(n log n)
+        /// - parameter metric: The metric to rank.
+        public func register(_ metric: Metric) {
+            self._lock.lock()
+            var index = _Index(metric: metric)
+            index.rebuild(from: self._rows.keys.lazy.map { self._table.row(at: self._rows[$0]!, epic: $0) })
+            self._indices[metric.name] = index
+            self._lock.unlock()
+        }
+
+        /// Stops ranking the screened markets on the metric with the given name.
+        /// - parameter name: The metric name.
+        public func unregister(metric name: String) {
+            self._lock.execute { _ = self._indices.removeValue(forKey: name) }
+        }
+
+        /// Returns the latest values for the given market (if it is being screened).
+        /// - parameter epic: The market epic.
+        public func row(epic: IG.Market.Epic) -> Row? {
+            self._lock.execute {
+                self._rows[epic].map { self._table.row(at: $0, epic: epic) }
+            }
+        }
+
+        /// Merges the given market update into the table and updates all metric indices.
+        ///
+        /// Fields not present on the update (i.e. `nil`) keep their previous values.
+        /// - complexity: O(m log n) where `m` is the number of registered metrics.
+        /// - parameter market: The streamed market update.
+        public func update(_ market: Streamer.Market) {
+            self._lock.lock()
+            let index: Int
+            if let row = self._rows[market.epic] {
+                index = row
+            } else {
+                index = self._table.append()
+                self._rows[market.epic] = index
+            }
+
+            self._table.merge(market, at: index)
+            let row = self._table.row(at: index, epic: market.epic)
+            // The indices are mutated in place (through the values view) to avoid copying their storage.
+            for position in self._indices.values.indices {
+                self._indices.values[position].update(row)
+            }
+            self._lock.unlock()
+        }
+
+        /// Returns the `k` markets ranking highest (or lowest) on the given metric.
+        /// - complexity: O(k)
+        /// - parameter k: The maximum number of markets returned.
+        /// - parameter name: The name of a registered metric.
+        /// - parameter order: Whether the highest or lowest values are returned first.
+        /// - returns: The ranked markets with their metric values. If the metric is not registered, an empty array is returned.
+        public func top(_ k: Int, by name: String, order: Order = .descending) -> [(epic: IG.Market.Epic, value: Decimal64)] {
+            self._lock.execute {
+                self._indices[name]?.top(k, order: order) ?? []
+            }
+        }
+
+        /// Returns the `k` markets ranking highest (or lowest) on the given metric.
+        /// - complexity: O(k)
+        /// - parameter k: The maximum number of markets returned.
+        /// - parameter metric: A registered metric.
+        /// - parameter order: Whether the highest or lowest values are returned first.
+        public func top(_ k: Int, by metric: Metric, order: Order = .descending) -> [(epic: IG.Market.Epic, value: Decimal64)] {
+            self.top(k, by: metric.name, order: order)
+        }
+    }
+}
+
+extension Streamer.Screener {
+    /// The latest values stored for a single market.
+    public struct Row {
+        /// The market epic identifier.
+        public let epic: IG.Market.Epic
+        /// The latest bid price.
+        public let bid: Decimal64?
+        /// The latest offer price.
+        public let ask: Decimal64?
+        /// The day's price change percentage.
+        public let changePercentage: Decimal64?
+        /// The day's highest price.
+        public let highest: Decimal64?
+        /// The day's lowest price.
+        public let lowest: Decimal64?
+        /// The date of the last update.
+        public let date: Date?
+
+        /// The middle price between bid and ask (if both are known).
+        public var mid: Decimal64? {
+            guard let bid = self.bid, let ask = self.ask else { return nil }
+            return bid + Decimal64(5, power: -1).unsafelyUnwrapped * (ask - bid)
+        }
+    }
+
+    /// A value derived from a market row used to rank markets.
+    public struct Metric {
+        /// The metric name (it must be unique among registered metrics).
+        public let name: String
+        /// Closure computing the metric value for a given row (or `nil` if it cannot be computed).
+        public let value: (_ row: Row) -> Decimal64?
+
+        /// Designated initializer.
+        /// - parameter name: The metric name (it must be unique among registered metrics).
+        /// - parameter value: Closure computing the metric value for a given row (or `nil` if it cannot be computed).
+        public init(name: String, value: @escaping (_ row: Row) -> Decimal64?) {
+            self.name = name
+            self.value = value
+        }
+
+        /// The day's price change percentage (i.e. "top movers").
+        public static var changePercentage: Self {
+            .init(name: "changePercentage") { $0.changePercentage }
+        }
+
+        /// The absolute difference between the ask and bid prices.
+        public static var spread: Self {
+            .init(name: "spread") {
+                guard let bid = $0.bid, let ask = $0.ask else { return nil }
+                return ask - bid
+            }
+        }
+
+        /// The spread relative to the mid price.
+        public static var relativeSpread: Self {
+            .init(name: "relativeSpread") {
+                guard let bid = $0.bid, let ask = $0.ask, let mid = $0.mid, mid > .zero else { return nil }
+                return (ask - bid) / mid
+            }
+        }
+
+        /// The distance from the mid price to the day's highest price, relative to the mid price (lower values are closer to the day high).
+        public static var distanceToHigh: Self {
+            .init(name: "distanceToHigh") {
+                guard let highest = $0.highest, let mid = $0.mid, mid > .zero else { return nil }
+                return (highest - mid) / mid
+            }
+        }
+
+        /// The distance from the mid price to the day's lowest price, relative to the mid price (lower values are closer to the day low).
+        public static var distanceToLow: Self {
+            .init(name: "distanceToLow") {
+                guard let lowest = $0.lowest, let mid = $0.mid, mid > .zero else { return nil }
+                return (mid - lowest) / mid
+            }
+        }
+    }
+
+    /// The ranking order.
+    public enum Order: Hashable {
+        /// Highest values first.
+        case descending
+        /// Lowest values first.
+        case ascending
+    }
+}
+
+// MARK: -
+
+private extension Streamer.Screener {
+    /// Columnar storage for the screened market values (every column shares the same row indices).
+    struct _Table {
+        private var _bid: [Decimal64?] = []
+        private var _ask: [Decimal64?] = []
+        private var _changePercentage: [Decimal64?] = []
+        private var _highest: [Decimal64?] = []
+        private var _lowest: [Decimal64?] = []
+        private var _date: [Date?] = []
+
+        /// Appends an empty row and returns its index.
+        mutating func append() -> Int {
+            self._bid.append(nil)
+            self._ask.append(nil)
+            self._changePercentage.append(nil)
+            self._highest.append(nil)
+            self._lowest.append(nil)
+            self._date.append(nil)
+            return self._bid.count - 1
+        }
+
+        /// Merges the non-`nil` values of the given market update into the targeted row.
+        mutating func merge(_ market: Streamer.Market, at index: Int) {
+            if let value = market.bid { self._bid[index] = value }
+            if let value = market.ask { self._ask[index] = value }
+            if let value = market.day.changePercentage { self._changePercentage[index] = value }
+            if let value = market.day.highest { self._highest[index] = value }
+            if let value = market.day.lowest { self._lowest[index] = value }
+            if let value = market.date { self._date[index] = value }
+        }
+
+        /// Returns the values of the targeted row.
+        func row(at index: Int, epic: IG.Market.Epic) -> Row {
+            Row(epic: epic, bid: self._bid[index], ask: self._ask[index], changePercentage: self._changePercentage[index],
+                highest: self._highest[index], lowest: self._lowest[index], date: self._date[index])
+        }
+    }
+
+    /// Order-statistics index for a single metric.
+    struct _Index {
+        /// The ranked metric.
+        let metric: Metric
+        /// The metric values sorted in ascending order.
+        private var _sorted: [(value: Decimal64, epic: IG.Market.Epic)] = []
+        /// The current metric value for every ranked market.
+        private var _values: [IG.Market.Epic:Decimal64] = [:]
+
+        init(metric: Metric) {
+            self.metric = metric
+        }
+
+        /// Rebuilds the index from scratch with the given rows.
+        mutating func rebuild<S>(from rows: S) where S:Sequence, S.Element==Row {
+            self._values.removeAll()
+            for row in rows {
+                guard let value = self.metric.value(row) else { continue }
+                self._values[row.epic] = value
+            }
+            self._sorted = self._values.map { ($0.value, $0.key) }.sorted { $0.value < $1.value }
+        }
+
+        /// Recomputes the metric for the given row and repositions it in the index.
+        /// - complexity: O(log n) to locate the positions (plus the array element shifting).
+        mutating func update(_ row: Row) {
+            let value = self.metric.value(row)
+            let previous = self._values[row.epic]
+            guard previous != value else { return }
+
+            if let previous = previous {
+                var index = self._sorted.partitioningIndex { $0.value >= previous }
+                while self._sorted[index].epic != row.epic { index += 1 }
+                self._sorted.remove(at: index)
+            }
+
+            if let value = value {
+                let index = self._sorted.partitioningIndex { $0.value > value }
+                self._sorted.insert((value, row.epic), at: index)
+            }
+            self._values[row.epic] = value
+        }
+
+        /// Returns the first `k` elements in the given order.
+        func top(_ k: Int, order: Order) -> [(epic: IG.Market.Epic, value: Decimal64)] {
+            let k = Swift.min(Swift.max(k, 0), self._sorted.count)
+            switch order {
+            case .ascending: return self._sorted.prefix(k).map { ($0.epic, $0.value) }
+            case .descending: return self._sorted.suffix(k).reversed().map { ($0.epic, $0.value) }
+            }
+        }
+    }
+}
+
+extension Publisher where Output==Streamer.Market {
+    /// Feeds every market update received from upstream into the given screener.
+    /// - parameter screener: The screener ranking the markets.
+    public func screen(on screener: Streamer.Screener) -> Publishers.HandleEvents<Self> {
+        self.handleEvents(receiveOutput: { screener.update($0) })
+    }
+}
@@ -0,0 +1,236 @@
+import Combine
+import Foundation
+
+extension Streamer {
+    /// Supervises a (potentially large) number of streamed items and signals when any of them stops receiving updates within its expected interval.
+    ///
+    /// All supervised items share a single timer source. Deadlines are kept on a hierarchical timer wheel, so resetting an item's deadline on every update is an O(1) operation independently of the number of supervised items.
+    /// The timer is suspended while no deadline is pending (e.g. all items are stale or paused) and resumed as soon as a deadline is scheduled.
+    /// - note: Stale events are delivered on the monitor's queue, while recovered events are delivered on the thread calling `reset(_:)`/`pause(_:)`.
+    public final class StalenessMonitor<Key> where Key:Hashable {
+        /// The lock restricting access to the monitor state.
+        private let _lock: UnfairLock
+        /// The duration of a single wheel tick (in nanoseconds).
+        private let _resolution: UInt64
+        /// The single timer advancing the wheel.
+        private let _timer: DispatchSourceTimer
+        /// Boolean indicating whether the timer is suspended (because the wheel is empty).
+        private var _isSuspended: Bool
+        /// The subject forwarding staleness events.
+        private let _subject: PassthroughSubject<Event,Never>
+        /// Timing wheel storing the deadline for every supervised (non-stale and non-paused) item.
+        private var _wheel: TimerWheel<Key>
+        /// The supervision state of every item.
+        private var _items: [Key:_Item]
+
+        /// Designated initializer.
+        /// - parameter resolution: The granularity of the staleness checks (in seconds). Items are flagged stale at most one `resolution` after their deadline.
+        /// - parameter queue: The queue where the timer fires and stale events are delivered. If `nil`, a private serial queue is created.
+        public init(resolution: TimeInterval = 0.25, queue: DispatchQueue? = nil) {
+            precondition(resolution > 0, "The staleness monitor resolution must be a positive number")
+            self._lock = UnfairLock()
+            self._resolution = Swift.max(1, UInt64(resolution * 1_000_000_000))
+            self._subject = PassthroughSubject()
+            self._items = .init()
+            self._isSuspended = false
+
+            let queue = queue ?? DispatchQueue(label: IG.identifier + ".streamer.staleness", qos: .utility, attributes: [], autoreleaseFrequency: .inherit, target: nil)
+            self._timer = DispatchSource.makeTimerSource(queue: queue)
+            self._wheel = TimerWheel(tick: DispatchTime.now().uptimeNanoseconds / self._resolution)
+
+            let interval = DispatchTimeInterval.nanoseconds(Int(self._resolution))
+            self._timer.setEventHandler { [weak self] in self?._fire() }
+            self._timer.schedule(deadline: .now() + interval, repeating: interval, leeway: .nanoseconds(Int(self._resolution / 10)))
+            self._timer.activate()
+        }
+
+        deinit {
+            self._timer.cancel()
+            // A dispatch source must not be released while suspended.
+            if self._isSuspended { self._timer.resume() }
+            self._lock.invalidate()
+            self._subject.send(completion: .finished)
+        }
+
+        /// Publisher forwarding the stale/recovered events of all supervised items.
+        public var events: AnyPublisher<Event,Never> {
+            self._subject.eraseToAnyPublisher()
+        }
+
+        /// The items currently being supervised.
+        public var keys: Set<Key> {
+            self._lock.execute { Set(self._items.keys) }
+        }
+
+        /// The items currently flagged as stale.
+        public var staleKeys: Set<Key> {
+            self._lock.execute { Set(self._items.compactMap { ($0.value.isStale) ? $0.key : nil }) }
+        }
+
+        /// Starts (or modifies) the supervision of the given item.
+        ///
+        /// The item's deadline starts counting from this moment.
+        /// - parameter key: The item identifier.
+        /// - parameter interval: The maximum expected time (in seconds) between two consecutive updates.
+        public func supervise(_ key: Key, interval: TimeInterval) {
+            let ticks = Swift.max(1, UInt64((interval * 1_000_000_000) / Double(self._resolution)))
+
+            self._lock.lock()
+            let now = self._now()
+            var item = self._items[key] ?? _Item()
+            item.interval = ticks
+            if !item.isPaused, !item.isStale { self._schedule(key, at: now + ticks, now: now) }
+            self._items[key] = item
+            self._lock.unlock()
+        }
+
+        /// Stops the supervision of the given item.
+        /// - parameter key: The item identifier.
+        public func unsupervise(_ key: Key) {
+            self._lock.lock()
+            if self._items.removeValue(forKey: key) != nil {
+                self._wheel.cancel(key)
+            }
+            self._lock.unlock()
+        }
+
+        /// Signals that the given item has just been updated, pushing forward its deadline.
+        ///
+        /// If the item was stale, a recovered event is sent. Non-supervised or paused items are ignored.
+        /// - parameter key: The item identifier.
+        public func reset(_ key: Key) {
+            self._lock.lock()
+            guard var item = self._items[key], !item.isPaused else { return self._lock.unlock() }
+            let wasStale = item.isStale
+            item.isStale = false
+            item.lastUpdate = Date()
+            self._items[key] = item
+            let now = self._now()
+            self._schedule(key, at: now + item.interval, now: now)
+            self._lock.unlock()
+
+            if wasStale { self._subject.send(.recovered(key)) }
+        }
+
+        /// Temporarily suspends the supervision of the given item (e.g. when its market closes).
+        ///
+        /// A paused item is not expected to update; therefore, if it was stale a recovered event is sent.
+        /// - parameter key: The item identifier.
+        public func pause(_ key: Key) {
+            self._lock.lock()
+            guard var item = self._items[key], !item.isPaused else { return self._lock.unlock() }
+            let wasStale = item.isStale
+            item.isStale = false
+            item.isPaused = true
+            self._items[key] = item
+            self._wheel.cancel(key)
+            self._lock.unlock()
+
+            if wasStale { self._subject.send(.recovered(key)) }
+        }
+
+        /// Resumes the supervision of a paused item. The item's deadline starts counting from this moment.
+        /// - parameter key: The item identifier.
+        public func resume(_ key: Key) {
+            self._lock.lock()
+            guard var item = self._items[key], item.isPaused else { return self._lock.unlock() }
+            item.isPaused = false
+            self._items[key] = item
+            let now = self._now()
+            self._schedule(key, at: now + item.interval, now: now)
+            self._lock.unlock()
+        }
+    }
+}
+
+extension Streamer.StalenessMonitor {
+    /// Events emitted by the staleness monitor.
+    public enum Event {
+        /// The item hasn't received an update within its expected interval.
+        /// - parameter lastUpdate: The date of the last received update (or `nil` if the item never received one).
+        case stale(Key, lastUpdate: Date?)
+        /// The previously stale item has received an update (or it has been paused).
+        case recovered(Key)
+    }
+}
+
+private extension Streamer.StalenessMonitor {
+    /// The supervision state for a single item.
+    struct _Item {
+        /// The expected interval between updates (in ticks).
+        var interval: UInt64 = 1
+        /// The date of the last received update.
+        var lastUpdate: Date? = nil
+        /// Boolean indicating whether the item is currently flagged as stale.
+        var isStale: Bool = false
+        /// Boolean indicating whether the item supervision is suspended.
+        var isPaused: Bool = false
+    }
+
+    /// Returns the current tick.
+    func _now() -> UInt64 {
+        DispatchTime.now().uptimeNanoseconds / self._resolution
+    }
+
+    /// Schedules the item's deadline on the wheel, resuming the timer if it was suspended.
+    /// - attention: This function must be called within a lock.
+    /// - parameter key: The item identifier.
+    /// - parameter deadline: The tick at which the item becomes stale.
+    /// - parameter now: The current tick.
+    func _schedule(_ key: Key, at deadline: UInt64, now: UInt64) {
+        if self._isSuspended {
+            // The wheel is empty; thus, it jumps straight to the current tick (instead of visiting every tick elapsed while suspended).
+            _ = self._wheel.advance(to: now)
+            self._isSuspended = false
+            self._timer.resume()
+        }
+        self._wheel.schedule(key, at: deadline)
+    }
+
+    /// Advances the wheel to the current tick and sends the stale events for the expired items.
+    ///
+    /// The timer is suspended if no deadline remains on the wheel.
+    func _fire() {
+        self._lock.lock()
+        var events: [Event] = []
+        for key in self._wheel.advance(to: self._now()) {
+            guard var item = self._items[key] else { continue }
+            item.isStale = true
+            self._items[key] = item
+            events.append(.stale(key, lastUpdate: item.lastUpdate))
+        }
+        if self._wheel.count == 0, !self._isSuspended {
+            self._isSuspended = true
+            self._timer.suspend()
+        }
+        self._lock.unlock()
+
+        events.forEach { self._subject.send($0) }
+    }
+}
+
+extension Publisher {
+    /// Resets the item's deadline on the given staleness monitor every time a value is received from upstream.
+    /// - parameter monitor: The monitor supervising the items.
+    /// - parameter key: Closure extracting the supervised item identifier from a received value.
+    public func supervised<K>(by monitor: Streamer.StalenessMonitor<K>, key: @escaping (Output) -> K) -> Publishers.HandleEvents<Self> {
+        self.handleEvents(receiveOutput: { monitor.reset(key($0)) })
+    }
+}
+
+extension Publisher where Output==Streamer.Market {
+    /// Resets the market's deadline on the given staleness monitor every time an update is received.
+    ///
+    /// The market supervision is paused while the market is not tradeable (e.g. closed, offline, or suspended) and resumed once it becomes tradeable again.
+    /// - remark: The market status is only known if the `.status` field is part of the subscription.
+    /// - parameter monitor: The monitor supervising the market epics.
+    public func supervised(by monitor: Streamer.StalenessMonitor<IG.Market.Epic>) -> Publishers.HandleEvents<Self> {
+        self.handleEvents(receiveOutput: { (market) in
+            switch market.status {
+            case .closed, .offline, .suspended: monitor.pause(market.epic)
+            case .some: monitor.resume(market.epic); monitor.reset(market.epic)
+            case .none: monitor.reset(market.epic)
+            }
+        })
+    }
+}
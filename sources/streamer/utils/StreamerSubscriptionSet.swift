@@ -0,0 +1,180 @@
+import Combine
+import Foundation
+
+extension Streamer {
+    /// A mutable set of Lightstreamer subscriptions whose updates are merged into a single publisher.
+    ///
+    /// Each member (e.g. a market epic) is backed by its own low-level subscription, so adding or removing members only subscribes/unsubscribes the delta. Members that stay in the set keep receiving updates uninterrupted (no new snapshots and no gaps).
+    ///
+    /// Members whose subscription finishes (e.g. when the streamer disconnects) are dropped from the set; once the last member is dropped this way, the `publisher` completes successfully. A failing member fails the whole set.
+    /// - note: Low-level subscriptions are not established till the `publisher` receives its first subscriber. Cancelling that subscriber tears down all member subscriptions.
+    public final class SubscriptionSet<Key,Value> where Key:Hashable {
+        /// The lock restricting access to the set state.
+        private let _lock: UnfairLock
+        /// Closure generating the subscription publisher for a single member.
+        private let _generator: (_ key: Key) -> AnyPublisher<Value,IG.Error>
+        /// The subject merging all member updates.
+        private let _subject: PassthroughSubject<Value,IG.Error>
+        /// The members currently in the set.
+        private var _keys: Set<Key>
+        /// The active low-level subscriptions (only populated once the set is active).
+        private var _cancellables: [Key:AnyCancellable]
+        /// The set lifecycle state.
+        private var _state: _State
+
+        /// Designated initializer.
+        /// - parameter keys: The initial set members.
+        /// - parameter generator: Closure generating a subscription publisher for a given member.
+        internal init<S>(keys: S, generator: @escaping (_ key: Key) -> AnyPublisher<Value,IG.Error>) where S:Sequence, S.Element==Key {
+            self._lock = UnfairLock()
+            self._generator = generator
+            self._subject = PassthroughSubject()
+            self._keys = Set(keys)
+            self._cancellables = .init()
+            self._state = .idle
+        }
+
+        deinit {
+            self._terminate(completion: .finished)
+            self._lock.invalidate()
+        }
+
+        /// Publisher forwarding the updates of all set members.
+        ///
+        /// The first subscriber activates the set. There is no support for multiple subscribers; use `share()` if needed.
+        public var publisher: AnyPublisher<Value,IG.Error> {
+            self._subject
+                .handleEvents(receiveSubscription: { [weak self] _ in self?._activate() },
+                              receiveCancel: { [weak self] in self?._terminate(completion: nil) })
+                .eraseToAnyPublisher()
+        }
+
+        /// The members currently in the set.
+        public var keys: Set<Key> {
+            self._lock.execute { self._keys }
+        }
+
+        /// Adds the given members to the set; only the ones that weren't already members get subscribed.
+        /// - parameter keys: The members to add.
+        /// - returns: The members that were actually added.
+        @discardableResult public func insert<S>(_ keys: S) -> Set<Key> where S:Sequence, S.Element==Key {
+            self.update { $0.formUnion(keys) }.inserted
+        }
+
+        /// Removes the given members from the set; only the ones that were members get unsubscribed.
+        /// - parameter keys: The members to remove.
+        /// - returns: The members that were actually removed.
+        @discardableResult public func remove<S>(_ keys: S) -> Set<Key> where S:Sequence, S.Element==Key {
+            self.update { $0.subtract(keys) }.removed
+        }
+
+        /// Replaces the set members with the given ones, subscribing/unsubscribing only the difference.
+        /// - parameter keys: The new set members.
+        /// - returns: The members added and removed during the operation.
+        @discardableResult public func replace(with keys: Set<Key>) -> (inserted: Set<Key>, removed: Set<Key>) {
+            self.update { $0 = keys }
+        }
+
+        /// Modifies the set members within the given closure and applies the resulting delta.
+        /// - parameter closure: Closure modifying the current members.
+        /// - parameter keys: The current members to be modified.
+        /// - returns: The members added and removed during the operation.
+        @discardableResult public func update(_ closure: (_ keys: inout Set<Key>) -> Void) -> (inserted: Set<Key>, removed: Set<Key>) {
+            self._lock.lock()
+            if case .terminated = self._state {
+                self._lock.unlock()
+                return (.init(), .init())
+            }
+
+            var keys = self._keys
+            closure(&keys)
+            let (inserted, removed) = (keys.subtracting(self._keys), self._keys.subtracting(keys))
+            self._keys = keys
+            // If the set is not yet active, the members will be subscribed on activation.
+            guard case .active = self._state else {
+                self._lock.unlock()
+                return (inserted, removed)
+            }
+
+            let cancellables = removed.compactMap { self._cancellables.removeValue(forKey: $0) }
+            self._lock.unlock()
+
+            cancellables.forEach { $0.cancel() }
+            inserted.forEach { self._subscribe(key: $0) }
+            return (inserted, removed)
+        }
+    }
+}
+
+private extension Streamer.SubscriptionSet {
+    /// The set lifecycle states.
+    enum _State {
+        /// No subscriber has attached to the set publisher yet.
+        case idle
+        /// The low-level subscriptions are live.
+        case active
+        /// The set has been cancelled or it has failed.
+        case terminated
+    }
+
+    /// Establishes all member subscriptions (if the set was idle).
+    func _activate() {
+        self._lock.lock()
+        guard case .idle = self._state else { return self._lock.unlock() }
+        self._state = .active
+        let keys = self._keys
+        self._lock.unlock()
+
+        keys.forEach { self._subscribe(key: $0) }
+    }
+
+    /// Subscribes to a single member and forwards its values to the set's subject.
+    /// - parameter key: The targeted member.
+    func _subscribe(key: Key) {
+        let cancellable = self._generator(key).sink(receiveCompletion: { [weak self] in
+            switch $0 {
+            case .failure(let error): self?._terminate(completion: .failure(error))
+            case .finished: self?._drop(key: key)
+            }
+        }, receiveValue: { [weak self] in
+            self?._subject.send($0)
+        })
+
+        self._lock.lock()
+        // The member may have been removed (or the set terminated) while the subscription was being created.
+        guard case .active = self._state, self._keys.contains(key) else {
+            self._lock.unlock()
+            return cancellable.cancel()
+        }
+        let previous = self._cancellables.updateValue(cancellable, forKey: key)
+        self._lock.unlock()
+        previous?.cancel()
+    }
+
+    /// Drops a member whose subscription has finished, completing the set if no members remain.
+    /// - parameter key: The finished member.
+    func _drop(key: Key) {
+        self._lock.lock()
+        guard case .active = self._state, self._keys.remove(key) != nil else { return self._lock.unlock() }
+        self._cancellables.removeValue(forKey: key)
+        guard self._keys.isEmpty else { return self._lock.unlock() }
+        self._state = .terminated
+        self._lock.unlock()
+
+        self._subject.send(completion: .finished)
+    }
+
+    /// Cancels all member subscriptions and (optionally) forwards a completion event downstream.
+    /// - parameter completion: The completion to forward or `nil` if downstream already cancelled.
+    func _terminate(completion: Subscribers.Completion<IG.Error>?) {
+        self._lock.lock()
+        if case .terminated = self._state { return self._lock.unlock() }
+        self._state = .terminated
+        let cancellables = self._cancellables.values
+        self._cancellables.removeAll()
+        self._lock.unlock()
+
+        cancellables.forEach { $0.cancel() }
+        if let completion = completion { self._subject.send(completion: completion) }
+    }
+}
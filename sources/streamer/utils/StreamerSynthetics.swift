@@ -0,0 +1,339 @@
+import Combine
+import Foundation
+import Decimals
+
+extension Streamer {
+    /// Computes synthetic instruments (e.g. thin crosses) from the streamed prices of their constituent legs.
+    ///
+    /// Each synthetic instrument is defined as a product of legs (each leg either quoted directly or inverted), such as `NOKSEK = USDSEK / USDNOK`.
+    /// Every `Streamer.Market` update of a leg recomputes the bid/ask of the synthetic instruments depending on it in O(legs), and feeds the synthetic candle of the ongoing interval.
+    /// Thus, the legs' subscriptions (which are usually needed anyway) produce tighter and more frequent cross quotes than subscribing to the thin cross itself.
+    public final class Synthetics {
+        /// The aggregation interval of the synthetic candles.
+        public let interval: Streamer.Chart.Aggregated.Interval
+        /// The clock providing the date of the leg updates carrying no publish time.
+        public let clock: Clock
+        /// The lock restricting access to the engine state.
+        private let _lock: UnfairLock
+        /// The subject forwarding the synthetic quotes.
+        private let _quotes: PassthroughSubject<Quote,Never>
+        /// The subject forwarding the synthetic candles.
+        private let _candles: PassthroughSubject<Streamer.Chart.Aggregated,Never>
+        /// The latest prices of every leg (and the synthetic instruments depending on them).
+        private var _legs: [IG.Market.Epic:_Leg]
+        /// The registered synthetic instruments indexed by their epic.
+        private var _instruments: [IG.Market.Epic:_Instrument]
+
+        /// Designated initializer.
+        /// - parameter definitions: The synthetic instruments computed from the start.
+        /// - parameter interval: The aggregation interval of the synthetic candles.
+        /// - parameter clock: The clock providing the date of the leg updates carrying no publish time.
+        public init(_ definitions: [Definition] = [], interval: Streamer.Chart.Aggregated.Interval = .minute, clock: Clock = SystemClock.shared) {
+            self.interval = interval
+            self.clock = clock
+            self._lock = UnfairLock()
+            self._quotes = PassthroughSubject()
+            self._candles = PassthroughSubject()
+            self._legs = .init()
+            self._instruments = .init()
+            definitions.forEach { self._register($0) }
+        }
+
+        deinit {
+            self._lock.invalidate()
+            self._quotes.send(completion: .finished)
+            self._candles.send(completion: .finished)
+        }
+
+        /// Publisher forwarding every synthetic quote as soon as any of its legs is updated.
+        public var quotes: AnyPublisher<Quote,Never> {
+            self._quotes.eraseToAnyPublisher()
+        }
+
+        /// Publisher forwarding the ongoing synthetic candle on every quote (and the finished candle once a quote falls on a later interval).
+        public var candles: AnyPublisher<Streamer.Chart.Aggregated,Never> {
+            self._candles.eraseToAnyPublisher()
+        }
+
+        /// The epics of all legs needed by the registered synthetic instruments (i.e. the markets to subscribe to with, at least, the bid, ask, and date fields).
+        public var legs: Set<IG.Market.Epic> {
+            self._lock.execute { Set(self._legs.keys) }
+        }
+
+        /// Returns the latest quote of the given synthetic instrument (or `nil` if not all its legs have been priced yet).
+        /// - parameter epic: The synthetic instrument epic.
+        public func quote(epic: IG.Market.Epic) -> Quote? {
+            self._lock.execute { self._instruments[epic]?.quote }
+        }
+
+        /// Starts computing the given synthetic instrument.
+        ///
+        /// Registering a definition with the same epic as a previously registered one replaces it. Leg prices already received are used right away.
+        /// - parameter definition: The synthetic instrument definition.
+        public func register(_ definition: Definition) {
+            self._lock.execute { self._register(definition) }
+        }
+
+        /// Stops computing the synthetic instrument with the given epic.
+        /// - parameter epic: The synthetic instrument epic.
+        public func unregister(epic: IG.Market.Epic) {
+            self._lock.execute { self._unregister(epic: epic) }
+        }
+
+        /// Merges the given leg update and recomputes the synthetic instruments depending on it.
+        ///
+        /// Fields not present on the update (i.e. `nil`) keep their previous values. Updates for markets which are not legs of any synthetic instrument are ignored.
+        /// - complexity: O(s·l) where `s` is the number of synthetic instruments depending on the market and `l` their number of legs.
+        /// - parameter market: The streamed market update.
+        public func update(_ market: Streamer.Market) {
+            self.update(epic: market.epic, bid: market.bid, ask: market.ask, date: market.date)
+        }
+
+        /// Merges the given leg prices and recomputes the synthetic instruments depending on it.
+        /// - complexity: O(s·l) where `s` is the number of synthetic instruments depending on the market and `l` their number of legs.
+        /// - parameter epic: The leg market epic.
+        /// - parameter bid: The latest bid price (or `nil` to keep the previous one).
+        /// - parameter ask: The latest ask price (or `nil` to keep the previous one).
+        /// - parameter date: The publish time of the prices. If `nil`, the engine's clock current date is used.
+        public func update(epic: IG.Market.Epic, bid: Decimal64?, ask: Decimal64?, date: Date? = nil) {
+            var (quotes, candles): ([Quote], [Streamer.Chart.Aggregated]) = ([], [])
+
+            self._lock.lock()
+            guard var leg = self._legs[epic] else { return self._lock.unlock() }
+            leg.merge(bid: bid, ask: ask, date: date ?? self.clock.now)
+            self._legs[epic] = leg
+
+            for dependent in leg.dependents {
+                guard var instrument = self._instruments[dependent],
+                      let quote = instrument.definition.quote(legs: self._legs) else { continue }
+                candles.append(contentsOf: instrument.record(quote, interval: self.interval))
+                self._instruments[dependent] = instrument
+                quotes.append(quote)
+            }
+            self._lock.unlock()
+
+            quotes.forEach { self._quotes.send($0) }
+            candles.forEach { self._candles.send($0) }
+        }
+    }
+}
+
+extension Streamer.Synthetics {
+    /// The definition of a synthetic instrument as a product of legs.
+    public struct Definition {
+        /// The identifier given to the synthetic instrument (used on its quotes and candles).
+        public let epic: IG.Market.Epic
+        /// The constituent legs.
+        public let legs: [Leg]
+
+        /// Designated initializer.
+        /// - precondition: There must be at least one leg.
+        /// - parameter epic: The identifier given to the synthetic instrument.
+        /// - parameter legs: The constituent legs.
+        public init(epic: IG.Market.Epic, legs: [Leg]) {
+            precondition(!legs.isEmpty, "A synthetic instrument needs at least one leg")
+            self.epic = epic
+            self.legs = legs
+        }
+
+        /// Defines a synthetic instrument as the product of two markets (e.g. `NOKSEK = NOKUSD · USDSEK`).
+        public static func product(epic: IG.Market.Epic, _ lhs: IG.Market.Epic, _ rhs: IG.Market.Epic) -> Self {
+            Self(epic: epic, legs: [.init(epic: lhs), .init(epic: rhs)])
+        }
+
+        /// Defines a synthetic instrument as the ratio of two markets (e.g. `NOKSEK = USDSEK / USDNOK`).
+        public static func ratio(epic: IG.Market.Epic, _ numerator: IG.Market.Epic, _ denominator: IG.Market.Epic) -> Self {
+            Self(epic: epic, legs: [.init(epic: numerator), .init(epic: denominator, isInverted: true)])
+        }
+    }
+
+    /// A constituent leg of a synthetic instrument.
+    public struct Leg: Hashable {
+        /// The streamed market.
+        public let epic: IG.Market.Epic
+        /// Boolean indicating whether the market quote is inverted (i.e. `1/price`) before being multiplied.
+        ///
+        /// The inverted bid is computed from the market's ask (and vice versa), so the synthetic spread is never tighter than the legs' spreads.
+        public let isInverted: Bool
+        /// The factor by which the streamed prices are multiplied (e.g. `10000` for a forex market quoted in points; see `API.Market.Snapshot.scalingFactor`).
+        ///
+        /// The leg prices are divided by this factor before being combined, so legs with different scaling factors can be mixed and the synthetic prices are always expressed in actual price units.
+        public let scalingFactor: Decimal64
+
+        /// Designated initializer.
+        /// - precondition: `scalingFactor` must be greater than zero.
+        /// - parameter epic: The streamed market.
+        /// - parameter isInverted: Boolean indicating whether the market quote is inverted before being multiplied.
+        /// - parameter scalingFactor: The factor by which the streamed prices are multiplied.
+        public init(epic: IG.Market.Epic, isInverted: Bool = false, scalingFactor: Decimal64 = 1) {
+            precondition(scalingFactor > .zero, "The scaling factor of a synthetic leg must be greater than zero")
+            self.epic = epic
+            self.isInverted = isInverted
+            self.scalingFactor = scalingFactor
+        }
+    }
+
+    /// A synthetic instrument price (expressed in actual price units, i.e. with the legs' scaling factors removed).
+    public struct Quote {
+        /// The synthetic instrument identifier.
+        public let epic: IG.Market.Epic
+        /// The publish time of the latest leg update.
+        public let date: Date
+        /// The synthetic bid price.
+        public let bid: Decimal64
+        /// The synthetic ask price.
+        public let ask: Decimal64
+    }
+}
+
+// MARK: -
+
+private extension Streamer.Synthetics {
+    /// Registers the given definition.
+    /// - precondition: The lock must be held.
+    func _register(_ definition: Definition) {
+        self._unregister(epic: definition.epic)
+
+        var instrument = _Instrument(definition: definition)
+        for leg in definition.legs {
+            self._legs[leg.epic, default: _Leg()].dependents.insert(definition.epic)
+        }
+        instrument.quote = definition.quote(legs: self._legs)
+        self._instruments[definition.epic] = instrument
+    }
+
+    /// Unregisters the synthetic instrument with the given epic (dropping the legs no longer needed).
+    /// - precondition: The lock must be held.
+    func _unregister(epic: IG.Market.Epic) {
+        guard let instrument = self._instruments.removeValue(forKey: epic) else { return }
+        for leg in instrument.definition.legs {
+            guard var state = self._legs[leg.epic] else { continue }
+            state.dependents.remove(epic)
+            self._legs[leg.epic] = state.dependents.isEmpty ? nil : state
+        }
+    }
+}
+
+/// The latest prices of a leg.
+private struct _Leg {
+    /// The latest bid price.
+    var bid: Decimal64? = nil
+    /// The latest ask price.
+    var ask: Decimal64? = nil
+    /// The publish time of the latest price update.
+    var date: Date? = nil
+    /// The synthetic instruments depending on this leg.
+    var dependents: Set<IG.Market.Epic> = []
+
+    /// Merges the given prices (keeping the previous values of the missing fields).
+    mutating func merge(bid: Decimal64?, ask: Decimal64?, date: Date) {
+        if let bid = bid { self.bid = bid }
+        if let ask = ask { self.ask = ask }
+        self.date = date
+    }
+}
+
+/// A registered synthetic instrument with its ongoing candle.
+private struct _Instrument {
+    /// The synthetic instrument definition.
+    let definition: Streamer.Synthetics.Definition
+    /// The latest synthetic quote.
+    var quote: Streamer.Synthetics.Quote? = nil
+    /// The candle for the ongoing interval.
+    var candle: _Candle? = nil
+
+    init(definition: Streamer.Synthetics.Definition) {
+        self.definition = definition
+    }
+
+    /// Records the given quote, returning the candles to be forwarded (the finished candle of the previous interval, if any, and the ongoing candle).
+    mutating func record(_ quote: Streamer.Synthetics.Quote, interval: Streamer.Chart.Aggregated.Interval) -> [Streamer.Chart.Aggregated] {
+        self.quote = quote
+        let start = Date(timeIntervalSince1970: (quote.date.timeIntervalSince1970 / interval.seconds).rounded(.down) * interval.seconds)
+
+        var result: [Streamer.Chart.Aggregated] = []
+        switch self.candle {
+        case .some(var candle) where candle.start == start:
+            candle.add(quote)
+            self.candle = candle
+        case .some(let candle) where candle.start > start:
+            // Out of order quotes (from a previous interval) don't modify finished candles.
+            return result
+        case .some(let candle):
+            result.append(candle.aggregated(epic: quote.epic, interval: interval, isFinished: true))
+            self.candle = _Candle(start: start, quote: quote)
+        case .none:
+            self.candle = _Candle(start: start, quote: quote)
+        }
+        result.append(self.candle!.aggregated(epic: quote.epic, interval: interval, isFinished: false))
+        return result
+    }
+}
+
+/// A synthetic candle being built.
+private struct _Candle {
+    typealias Point = (bid: Decimal64, ask: Decimal64)
+    /// The start of the candle interval.
+    let start: Date
+    let open: Point
+    var close: Point
+    var lowest: Point
+    var highest: Point
+    /// The number of synthetic quotes within the candle.
+    var ticks: Int
+
+    init(start: Date, quote: Streamer.Synthetics.Quote) {
+        let point = (quote.bid, quote.ask)
+        self.start = start
+        self.open = point
+        self.close = point
+        self.lowest = point
+        self.highest = point
+        self.ticks = 1
+    }
+
+    mutating func add(_ quote: Streamer.Synthetics.Quote) {
+        self.close = (quote.bid, quote.ask)
+        self.lowest = (Swift.min(self.lowest.bid, quote.bid), Swift.min(self.lowest.ask, quote.ask))
+        self.highest = (Swift.max(self.highest.bid, quote.bid), Swift.max(self.highest.ask, quote.ask))
+        self.ticks += 1
+    }
+
+    func aggregated(epic: IG.Market.Epic, interval: Streamer.Chart.Aggregated.Interval, isFinished: Bool) -> Streamer.Chart.Aggregated {
+        typealias A = Streamer.Chart.Aggregated
+        let candle = A.Candle(date: self.start, numTicks: self.ticks, isFinished: isFinished,
+                              open: .init(bid: self.open.bid, ask: self.open.ask),
+                              close: .init(bid: self.close.bid, ask: self.close.ask),
+                              lowest: .init(bid: self.lowest.bid, ask: self.lowest.ask),
+                              highest: .init(bid: self.highest.bid, ask: self.highest.ask))
+        let day = A.Day(lowest: nil, mid: nil, highest: nil, changeNet: nil, changePercentage: nil)
+        return A(epic: epic, interval: interval, candle: candle, day: day)
+    }
+}
+
+private extension Streamer.Synthetics.Definition {
+    /// Computes the synthetic quote from the given leg prices (or `nil` if any leg hasn't been fully priced yet).
+    /// - complexity: O(l) where `l` is the number of legs.
+    func quote(legs: [IG.Market.Epic:_Leg]) -> Streamer.Synthetics.Quote? {
+        let one = Decimal64(1, power: 0).unsafelyUnwrapped
+        var (bid, ask, date) = (one, one, Date.distantPast)
+
+        for leg in self.legs {
+            guard let state = legs[leg.epic], var legBid = state.bid, var legAsk = state.ask,
+                  legBid > .zero, legAsk > .zero else { return nil }
+            if leg.scalingFactor != one {
+                legBid = legBid / leg.scalingFactor
+                legAsk = legAsk / leg.scalingFactor
+            }
+            if leg.isInverted {
+                bid = bid * (one / legAsk)
+                ask = ask * (one / legBid)
+            } else {
+                bid = bid * legBid
+                ask = ask * legAsk
+            }
+            if let legDate = state.date, legDate > date { date = legDate }
+        }
+        return .init(epic: self.epic, date: date, bid: bid, ask: ask)
+    }
+}
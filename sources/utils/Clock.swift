@@ -0,0 +1,159 @@
+import Combine
+import Foundation
+
+/// Source of the current date and scheduler of time-dependent work.
+///
+/// All time-dependent logic (token expirations, reconciliation timers, "now" relative decoding, etc.) queries the injected clock instead of the wall clock. Using a `VirtualClock` lets replays and simulations advance time instantly.
+public protocol Clock: AnyObject {
+    /// The current date.
+    var now: Date { get }
+    /// Schedules the given closure to be executed once the clock reaches the given date.
+    ///
+    /// If the date is already in the past, the closure is dispatched right away on the given queue.
+    /// - parameter date: The date at which the closure is executed.
+    /// - parameter queue: The queue where the closure is executed.
+    /// - parameter action: The closure to execute.
+    /// - returns: Cancellable instance. The scheduled closure is cancelled when `cancel()` is called or the instance is deallocated.
+    func schedule(at date: Date, on queue: DispatchQueue, _ action: @escaping () -> Void) -> AnyCancellable
+}
+
+/// Clock following the system's wall time.
+public final class SystemClock: Clock {
+    /// The shared system clock instance.
+    public static let shared = SystemClock()
+
+    /// Designated initializer.
+    public init() {}
+
+    public var now: Date {
+        Date()
+    }
+
+    public func schedule(at date: Date, on queue: DispatchQueue, _ action: @escaping () -> Void) -> AnyCancellable {
+        let interval = date.timeIntervalSinceNow
+        guard interval > 0 else {
+            let item = DispatchWorkItem(block: action)
+            queue.async(execute: item)
+            return AnyCancellable { item.cancel() }
+        }
+
+        let source = DispatchSource.makeTimerSource(queue: queue)
+        source.setEventHandler(handler: action)
+        source.schedule(deadline: .now() + interval, repeating: .never, leeway: .nanoseconds(10))
+        source.activate()
+        return AnyCancellable { source.cancel() }
+    }
+}
+
+/// Clock whose time only moves when it is explicitly advanced.
+///
+/// Scheduled closures always execute on the queue passed when scheduling them:
+/// - Closures scheduled in the past are dispatched right away (asynchronously) on their queue.
+/// - Closures reached by `advance(to:)` are executed (in deadline order) on their queue, and `advance(to:)` waits for each of them to finish before moving on. While each closure executes, `now` returns its scheduled date.
+///
+/// Thus, simulations run as fast as their computations allow, independently of the wall time.
+/// - attention: Advancing the clock from a thread blocking any of the scheduled closures' queues (other than the current one) deadlocks.
+public final class VirtualClock: Clock {
+    /// The lock restricting access to the clock state.
+    private let _lock: UnfairLock
+    /// Key tagging the queues of the scheduled closures (so `advance(to:)` can tell whether it is already running on them).
+    private let _queueKey: DispatchSpecificKey<ObjectIdentifier>
+    /// The current virtual date.
+    private var _now: Date
+    /// The scheduled closures sorted by date (and insertion order for equal dates).
+    private var _scheduled: [_Item]
+    /// Counter used to identify the scheduled closures.
+    private var _sequence: UInt64
+
+    /// Designated initializer.
+    /// - parameter start: The initial virtual date.
+    public init(start: Date = Date()) {
+        self._lock = UnfairLock()
+        self._queueKey = DispatchSpecificKey()
+        self._now = start
+        self._scheduled = .init()
+        self._sequence = 0
+    }
+
+    deinit {
+        self._lock.invalidate()
+    }
+
+    public var now: Date {
+        self._lock.execute { self._now }
+    }
+
+    /// The number of closures waiting for the clock to reach their date.
+    public var pending: Int {
+        self._lock.execute { self._scheduled.count }
+    }
+
+    public func schedule(at date: Date, on queue: DispatchQueue, _ action: @escaping () -> Void) -> AnyCancellable {
+        queue.setSpecific(key: self._queueKey, value: ObjectIdentifier(queue))
+        self._lock.lock()
+        guard date > self._now else {
+            self._lock.unlock()
+            let item = DispatchWorkItem(block: action)
+            queue.async(execute: item)
+            return AnyCancellable { item.cancel() }
+        }
+
+        self._sequence += 1
+        let id = self._sequence
+        let index = self._scheduled.partitioningIndex { $0.date > date }
+        self._scheduled.insert(_Item(id: id, date: date, queue: queue, action: action), at: index)
+        self._lock.unlock()
+
+        return AnyCancellable { [weak self] in
+            guard let self = self else { return }
+            self._lock.execute { self._scheduled.removeAll { $0.id == id } }
+        }
+    }
+
+    /// Moves the clock forward to the given date, executing every closure scheduled till then.
+    ///
+    /// Each closure is executed on its queue and this function returns once all of them have finished. Closures scheduled by the executed closures are also executed if their date is not posterior to the given date.
+    /// - parameter date: The targeted date. If it is in the past, the clock doesn't move.
+    public func advance(to date: Date) {
+        while true {
+            self._lock.lock()
+            guard let first = self._scheduled.first, first.date <= date else {
+                if date > self._now { self._now = date }
+                return self._lock.unlock()
+            }
+            self._scheduled.removeFirst()
+            self._now = first.date
+            self._lock.unlock()
+            self._execute(first)
+        }
+    }
+
+    /// Moves the clock forward the given amount of seconds, executing every closure scheduled till then.
+    /// - parameter interval: The amount of seconds to move forward.
+    public func advance(by interval: TimeInterval) {
+        self.advance(to: self.now.addingTimeInterval(Swift.max(0, interval)))
+    }
+}
+
+private extension VirtualClock {
+    /// A scheduled closure.
+    struct _Item {
+        let id: UInt64
+        let date: Date
+        let queue: DispatchQueue
+        let action: () -> Void
+    }
+
+    /// Executes the given closure on its queue, waiting for it to finish.
+    ///
+    /// If the current thread is already executing on the closure's queue (or on a queue targeting it), the closure is executed in place to avoid deadlocking.
+    func _execute(_ item: _Item) {
+        let isCurrent = (DispatchQueue.getSpecific(key: self._queueKey) == ObjectIdentifier(item.queue))
+            || (item.queue === DispatchQueue.main && Thread.isMainThread)
+        if isCurrent {
+            item.action()
+        } else {
+            item.queue.sync(execute: item.action)
+        }
+    }
+}
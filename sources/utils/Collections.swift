@@ -71,3 +71,25 @@ extension PartialRangeThrough: CustomDebugStringConvertible {
         return result
     }
 }
+
+extension RandomAccessCollection {
+    /// Returns the index of the first element satisfying the given predicate, assuming the collection is already partitioned by it (i.e. all elements not satisfying the predicate come first).
+    ///
+    /// If no element satisfies the predicate, `endIndex` is returned.
+    /// - complexity: O(log n)
+    /// - parameter belongsInSecondPartition: Predicate used to partition the collection.
+    internal func partitioningIndex(where belongsInSecondPartition: (Element) throws -> Bool) rethrows -> Index {
+        var (low, count) = (self.startIndex, self.count)
+        while count > 0 {
+            let half = count / 2
+            let middle = self.index(low, offsetBy: half)
+            if try belongsInSecondPartition(self[middle]) {
+                count = half
+            } else {
+                low = self.index(after: middle)
+                count -= half + 1
+            }
+        }
+        return low
+    }
+}
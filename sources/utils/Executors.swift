@@ -0,0 +1,73 @@
+import Foundation
+
+/// Assignment of the library's workload classes to the queues executing them.
+///
+/// By default every subsystem creates its own queues. Use this configuration to, for example, give the order flow a dedicated high-priority thread while keeping history backfills and database writes away from it.
+/// - note: Each subsystem (`API`, `Streamer`, `Database`) resolves the executors it is given independently; pass `.queue(_:)` executors (or use the `Services` factories) to share a single dedicated executor among them.
+public struct Executors {
+    /// Order flow: HTTP requests/responses (deal creation, confirmations, session management), the streamer's session status, and the streamer's critical tier (trade confirmations, positions, working orders, and accounts).
+    public var trading: Executor
+    /// Market data: the streamer's live quotes and tick updates.
+    public var marketData: Executor
+    /// Background work: the streamer's aggregated chart candles and all database reads/writes (including history backfills).
+    public var background: Executor
+
+    /// Designated initializer.
+    /// - parameter trading: The executor for the order flow.
+    /// - parameter marketData: The executor for the live market data.
+    /// - parameter background: The executor for the chart candles and database accesses.
+    public init(trading: Executor = .automatic, marketData: Executor = .automatic, background: Executor = .automatic) {
+        self.trading = trading
+        self.marketData = marketData
+        self.background = background
+    }
+
+    /// Every workload is executed on the queues created by default by each subsystem.
+    public static var automatic: Self {
+        .init()
+    }
+}
+
+/// The execution context of a workload class.
+public enum Executor {
+    /// The subsystem creates its default queue.
+    case automatic
+    /// The work is executed on (or targets) the given queue.
+    case queue(DispatchQueue)
+    /// The work is executed on a serial queue serviced by its own dispatch workloop; that is, the queue doesn't compete for threads with the process' global concurrent queues.
+    /// - parameter qos: The quality of service of the work items.
+    case dedicated(qos: DispatchQoS)
+}
+
+internal extension Executor {
+    /// Returns the queue executing the receiving workload.
+    /// - parameter label: The label used if a dedicated queue is created.
+    /// - parameter automatic: The subsystem default queue (only created for `.automatic` executors).
+    func _queue(label: String, automatic: @autoclosure () -> DispatchQueue) -> DispatchQueue {
+        self._target(label: label) ?? automatic()
+    }
+
+    /// Returns the queue where the receiving workload ends executing or `nil` if it is left to the subsystem.
+    /// - parameter label: The label used if a dedicated queue is created.
+    func _target(label: String) -> DispatchQueue? {
+        switch self {
+        case .automatic:
+            return nil
+        case .queue(let queue):
+            return queue
+        case .dedicated(let qos):
+            let workloop = DispatchWorkloop(label: label + ".workloop", autoreleaseFrequency: .workItem)
+            return DispatchQueue(label: label, qos: qos, autoreleaseFrequency: .inherit, target: workloop)
+        }
+    }
+}
+
+internal extension Executors {
+    /// Resolves every workload class into a concrete queue, so the same queues are shared among several subsystems.
+    /// - parameter fallback: The queue used for `.automatic` executors.
+    func _resolved(fallback: DispatchQueue) -> Self {
+        .init(trading: .queue(self.trading._queue(label: IG.identifier + ".executors.trading", automatic: fallback)),
+              marketData: .queue(self.marketData._queue(label: IG.identifier + ".executors.marketData", automatic: fallback)),
+              background: .queue(self.background._queue(label: IG.identifier + ".executors.background", automatic: fallback)))
+    }
+}
@@ -0,0 +1,132 @@
+/// Hierarchical timing wheel storing deadlines (measured in ticks) for hashable keys.
+///
+/// Scheduling, rescheduling, and cancelling a key are O(1) operations. Advancing the wheel costs O(1) per elapsed tick plus the number of expired/cascaded keys.
+/// - note: This type is not thread-safe. Synchronization is left to the owner.
+internal struct TimerWheel<Key> where Key:Hashable {
+    /// Number of bits used to index the slots of a single level.
+    private static var _bits: Int { 6 }
+    /// Number of slots per level.
+    private static var _slots: Int { 1 << Self._bits }
+    /// Number of levels in the hierarchy (covering `64^4` ticks).
+    private static var _levels: Int { 4 }
+
+    /// The slots for each level; each slot stores the keys scheduled on it.
+    private var _wheels: [[Set<Key>]]
+    /// The location and deadline for every scheduled key.
+    private var _entries: [Key:_Entry]
+    /// The last processed tick.
+    private(set) var tick: UInt64
+
+    /// Designated initializer.
+    /// - parameter tick: The wheel's starting tick.
+    init(tick: UInt64 = 0) {
+        self._wheels = .init(repeating: .init(repeating: .init(), count: Self._slots), count: Self._levels)
+        self._entries = .init()
+        self.tick = tick
+    }
+
+    /// The number of scheduled keys.
+    var count: Int {
+        self._entries.count
+    }
+
+    /// Returns the deadline for the given key (if any).
+    func deadline(for key: Key) -> UInt64? {
+        self._entries[key]?.deadline
+    }
+
+    /// Schedules (or reschedules) the given key to expire at the given tick.
+    ///
+    /// Deadlines in the past expire on the next `advance(to:)` call.
+    /// - parameter key: The key to be scheduled.
+    /// - parameter deadline: The tick at which the key expires.
+    mutating func schedule(_ key: Key, at deadline: UInt64) {
+        self.cancel(key)
+        self._insert(key, deadline: deadline)
+    }
+
+    /// Removes the given key from the wheel.
+    /// - returns: Boolean indicating whether the key was scheduled.
+    @discardableResult mutating func cancel(_ key: Key) -> Bool {
+        guard let entry = self._entries.removeValue(forKey: key) else { return false }
+        self._wheels[entry.level][entry.slot].remove(key)
+        return true
+    }
+
+    /// Advances the wheel till the given tick (included) and returns the keys whose deadlines expired.
+    /// - parameter tick: The current tick. If it is lower than the last processed tick, nothing happens.
+    /// - returns: The expired keys (which have been removed from the wheel).
+    mutating func advance(to tick: UInt64) -> [Key] {
+        var result: [Key] = []
+
+        while self.tick < tick {
+            // If there is nothing scheduled, there is no need to visit every tick.
+            guard !self._entries.isEmpty else { self.tick = tick; break }
+            self.tick += 1
+            // 1. Cascade the higher levels whose lower indices just wrapped around (from top to bottom).
+            for level in stride(from: Self._levels - 1, through: 1, by: -1) {
+                let shift = UInt64(level * Self._bits)
+                guard self.tick & ((1 << shift) - 1) == 0 else { continue }
+                let slot = Int((self.tick >> shift) & UInt64(Self._slots - 1))
+                let keys = self._wheels[level][slot]
+                guard !keys.isEmpty else { continue }
+                self._wheels[level][slot].removeAll(keepingCapacity: true)
+                for key in keys {
+                    let entry = self._entries.removeValue(forKey: key)!
+                    // Keys expiring exactly on the cascading tick are reported right away.
+                    if entry.deadline <= self.tick {
+                        result.append(key)
+                    } else {
+                        self._insert(key, deadline: entry.deadline)
+                    }
+                }
+            }
+            // 2. Expire the lowest level slot.
+            let slot = Int(self.tick & UInt64(Self._slots - 1))
+            let keys = self._wheels[0][slot]
+            guard !keys.isEmpty else { continue }
+            self._wheels[0][slot].removeAll(keepingCapacity: true)
+            for key in keys {
+                let entry = self._entries.removeValue(forKey: key)!
+                if entry.deadline <= self.tick {
+                    result.append(key)
+                } else {
+                    self._insert(key, deadline: entry.deadline)
+                }
+            }
+        }
+
+        return result
+    }
+}
+
+private extension TimerWheel {
+    /// The location of a scheduled key.
+    struct _Entry {
+        /// The tick at which the key expires.
+        let deadline: UInt64
+        /// The wheel level where the key is stored.
+        let level: Int
+        /// The slot within the level where the key is stored.
+        let slot: Int
+    }
+
+    /// Stores the key in the appropriate level and slot.
+    /// - precondition: The key must not be scheduled.
+    mutating func _insert(_ key: Key, deadline: UInt64) {
+        // Expired deadlines are placed on the next tick.
+        let target = Swift.max(deadline, self.tick + 1)
+        let delta = target - self.tick
+
+        var level = 0
+        while level < Self._levels - 1, delta >= (1 << UInt64((level + 1) * Self._bits)) { level += 1 }
+
+        let shift = UInt64(level * Self._bits)
+        let maxTarget = self.tick + (1 << UInt64((level + 1) * Self._bits)) - 1
+        // Deadlines beyond the wheel horizon are parked on the furthest slot and cascaded again when reached.
+        let slot = Int((Swift.min(target, maxTarget) >> shift) & UInt64(Self._slots - 1))
+
+        self._entries[key] = _Entry(deadline: deadline, level: level, slot: slot)
+        self._wheels[level][slot].insert(key)
+    }
+}
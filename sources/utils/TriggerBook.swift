@@ -0,0 +1,118 @@
+/// Price levels waiting to be reached, indexed so that evaluating a new price costs O(log n + triggered).
+///
+/// Each direction is stored in a sorted array where the levels closest to being reached sit at the end; therefore, triggered levels are removed from the tail without shifting the rest of the storage.
+/// - note: This type is not thread-safe. Synchronization is left to the owner.
+internal struct TriggerBook<Level,ID> where Level:Comparable, ID:Hashable {
+    /// Levels triggering when the price rises to (or above) them, sorted in descending order.
+    private var _rising: [_Entry]
+    /// Levels triggering when the price falls to (or below) them, sorted in ascending order.
+    private var _falling: [_Entry]
+
+    /// Designated initializer creating an empty book.
+    init() {
+        self._rising = .init()
+        self._falling = .init()
+    }
+
+    /// The number of levels stored in the book.
+    var count: Int {
+        self._rising.count + self._falling.count
+    }
+
+    /// Boolean indicating whether the book has no levels.
+    var isEmpty: Bool {
+        self._rising.isEmpty && self._falling.isEmpty
+    }
+
+    /// Adds a single level to the book.
+    /// - complexity: O(log n) to find the position plus O(n) for the array insertion.
+    /// - parameter id: The identifier being triggered when the level is reached.
+    /// - parameter level: The targeted level.
+    /// - parameter direction: The price movement triggering the level.
+    mutating func insert(_ id: ID, level: Level, direction: Direction) {
+        let entry = _Entry(level: level, id: id)
+        switch direction {
+        case .rising:
+            let index = self._rising.partitioningIndex { $0.level < level }
+            self._rising.insert(entry, at: index)
+        case .falling:
+            let index = self._falling.partitioningIndex { $0.level > level }
+            self._falling.insert(entry, at: index)
+        }
+    }
+
+    /// Adds several levels to the book at once.
+    /// - complexity: O((n + m) log(n + m))
+    /// - parameter elements: The levels to add.
+    mutating func insert<S>(contentsOf elements: S) where S:Sequence, S.Element==(id: ID, level: Level, direction: Direction) {
+        var (isRisingDirty, isFallingDirty) = (false, false)
+        for element in elements {
+            let entry = _Entry(level: element.level, id: element.id)
+            switch element.direction {
+            case .rising: self._rising.append(entry); isRisingDirty = true
+            case .falling: self._falling.append(entry); isFallingDirty = true
+            }
+        }
+        if isRisingDirty { self._rising.sort { $0.level > $1.level } }
+        if isFallingDirty { self._falling.sort { $0.level < $1.level } }
+    }
+
+    /// Removes the level for the given identifier.
+    /// - parameter id: The identifier being removed.
+    /// - parameter level: The level where the identifier was stored.
+    /// - parameter direction: The price movement triggering the level.
+    /// - returns: Boolean indicating whether the identifier was found.
+    @discardableResult mutating func remove(_ id: ID, level: Level, direction: Direction) -> Bool {
+        switch direction {
+        case .rising:
+            var index = self._rising.partitioningIndex { $0.level <= level }
+            while index < self._rising.endIndex, self._rising[index].level == level {
+                guard self._rising[index].id != id else { self._rising.remove(at: index); return true }
+                index += 1
+            }
+        case .falling:
+            var index = self._falling.partitioningIndex { $0.level >= level }
+            while index < self._falling.endIndex, self._falling[index].level == level {
+                guard self._falling[index].id != id else { self._falling.remove(at: index); return true }
+                index += 1
+            }
+        }
+        return false
+    }
+
+    /// Removes all identifiers whose levels have been reached by the given price.
+    /// - complexity: O(log n + triggered)
+    /// - parameter price: The latest price.
+    /// - returns: The triggered identifiers for each direction (in the order the price crossed their levels).
+    mutating func trigger(price: Level) -> (rising: [ID], falling: [ID]) {
+        let risingIndex = self._rising.partitioningIndex { $0.level <= price }
+        let rising = self._rising[risingIndex...].reversed().map { $0.id }
+        self._rising.removeSubrange(risingIndex...)
+
+        let fallingIndex = self._falling.partitioningIndex { $0.level >= price }
+        let falling = self._falling[fallingIndex...].reversed().map { $0.id }
+        self._falling.removeSubrange(fallingIndex...)
+
+        return (rising, falling)
+    }
+}
+
+extension TriggerBook {
+    /// The price movement triggering a level.
+    enum Direction: Hashable {
+        /// The level is triggered when the price rises to (or above) it.
+        case rising
+        /// The level is triggered when the price falls to (or below) it.
+        case falling
+    }
+}
+
+private extension TriggerBook {
+    /// A stored level.
+    struct _Entry {
+        /// The level triggering the identifier.
+        let level: Level
+        /// The identifier being triggered.
+        let id: ID
+    }
+}
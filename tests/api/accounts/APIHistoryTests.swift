@@ -0,0 +1,50 @@
+#if DEBUG
+@testable import IG
+import Combine
+import ConbiniForTesting
+import XCTest
+
+final class APIHistoryTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that windows arriving out of order are forwarded chronologically, without duplicates, and that empty windows are still forwarded.
+    func testShardMerger() {
+        let start = Date(timeIntervalSince1970: 1_600_000_000)
+        let merger = _ShardMerger<Int,Int>(count: 4, date: { start.addingTimeInterval(TimeInterval($0)) }, key: { $0 })
+
+        // Later windows are kept till the previous ones arrive.
+        XCTAssertTrue(merger.process(window: 2, elements: []).isEmpty)
+        XCTAssertTrue(merger.process(window: 1, elements: [200, 100, 150]).isEmpty)
+        // Elements are sorted; duplicates within a window and on the window edges are dropped.
+        XCTAssertEqual(merger.process(window: 0, elements: [100, 0, 50, 50]), [[0, 50, 100], [150, 200], []])
+        XCTAssertEqual(merger.process(window: 3, elements: [350, 300]), [[300, 350]])
+    }
+
+    /// Tests the concurrent download of several windows (finishing in reverse order) and their chronological forwarding.
+    func testShardedDownload() {
+        let start = Date(timeIntervalSince1970: 1_600_000_000)
+        let offset: (Date) -> Int = { Int($0.timeIntervalSince(start)) }
+
+        for concurrency in [1, 4] {
+            var windows: [ClosedRange<Int>] = []
+            let values = API.Request.Accounts._sharded(from: start, to: start.addingTimeInterval(350), window: 100, concurrency: concurrency, fetch: { (from, to) -> AnyPublisher<[Int],IG.Error> in
+                let (lower, upper) = (offset(from), offset(to))
+                windows.append(lower...upper)
+                // Each window is retrieved in two pages (the third window is empty) and the later windows finish first.
+                let pages: [[Int]] = (lower == 200) ? [] : [[upper], [lower]]
+                return Publishers.Sequence<[[Int]],IG.Error>(sequence: pages)
+                    .delay(for: .milliseconds(350 - lower), scheduler: DispatchQueue.main)
+                    .eraseToAnyPublisher()
+            }, date: { start.addingTimeInterval(TimeInterval($0)) }, key: { $0 }).expectsAll(timeout: 2, on: self)
+
+            XCTAssertEqual(windows, [0...100, 100...200, 200...300, 300...350])
+            XCTAssertEqual(values, [[0, 100], [200], [], [300, 350]])
+        }
+
+        API.Request.Accounts._sharded(from: start, to: start.addingTimeInterval(-1), window: 100, concurrency: 1, fetch: { (_, _) in Empty().eraseToAnyPublisher() }, date: { start.addingTimeInterval(TimeInterval($0)) }, key: { (value: Int) in value })
+            .expectsFailure(timeout: 0.5, on: self)
+    }
+}
+#endif
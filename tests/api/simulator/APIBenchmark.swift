@@ -0,0 +1,318 @@
+import IG
+import Combine
+import Foundation
+import Decimals
+#if canImport(Darwin)
+import Darwin
+#endif
+
+/// Measures the latency (and allocations) the library adds to the trading endpoints.
+///
+/// The benchmark lives in the test target (and not in the library) since it counts allocations by patching the process' default malloc zone. Run it in release mode with `swift test -c release --filter APIBenchmarkTests`.
+///
+/// The benchmark runs `createPosition`, `getConfirmation`, `updatePosition`, `closePosition`, and `createWorkingOrder` sequentially against an in-process `API.Simulator` answering every request after a fixed delay.
+/// The whole request path is exercised (payload validation, JSON encoding, request assembly, `URLSession` dispatch, and response decoding); the library-added latency of a call is its end-to-end time minus the simulator's fixed response time.
+final class APIBenchmark {
+    /// The benchmark configuration.
+    let configuration: Configuration
+
+    /// Designated initializer.
+    /// - parameter configuration: The benchmark characteristics.
+    init(configuration: Configuration = .init()) {
+        self.configuration = configuration
+    }
+
+    /// Runs the benchmark and reports the measurements per endpoint.
+    ///
+    /// Every subscription creates its own simulator and `API` instance, logs in, and performs `warmup + iterations` order lifecycles (only the last `iterations` are measured).
+    /// - note: Allocations are counted process-wide (i.e. they include the simulator's request handling and any other thread's allocations); thus run a single benchmark at a time on an otherwise idle process.
+    /// - returns: Publisher forwarding a single report once all iterations have finished.
+    func run() -> AnyPublisher<Report,IG.Error> {
+        let configuration = self.configuration
+        return Deferred { () -> AnyPublisher<Report,IG.Error> in
+            let simulator = API.Simulator(funds: Decimal64(1_000_000, power: 0)!, latency: configuration.latency)
+            let api = API(simulator: simulator)
+            let recorder = _Recorder()
+            simulator.update(epic: configuration.epic, bid: configuration.bid, ask: configuration.ask)
+
+            return api.session.login(type: .oauth, key: Self._key, user: Self._user)
+                .map { _ in () }
+                .append(())
+                .last()
+                .flatMap { _ in
+                    Publishers.Sequence<Range<Int>,IG.Error>(sequence: 0..<(configuration.warmup + configuration.iterations))
+                        .flatMap(maxPublishers: .max(1)) { (index) -> AnyPublisher<Void,IG.Error> in
+                            let measurer = _Measurer(recorder: (index >= configuration.warmup) ? recorder : nil, latency: configuration.latency)
+                            return Self._iteration(api: api, configuration: configuration, measurer: measurer)
+                        }
+                }.collect()
+                .handleEvents(receiveSubscription: { _ in _Allocations.install() }, receiveCompletion: { _ in _Allocations.uninstall() }, receiveCancel: { _Allocations.uninstall() })
+                .map { _ in
+                    withExtendedLifetime(simulator) { recorder.report(iterations: configuration.iterations, latency: configuration.latency) }
+                }.eraseToAnyPublisher()
+        }.eraseToAnyPublisher()
+    }
+}
+
+extension APIBenchmark {
+    /// The characteristics of a benchmark run.
+    struct Configuration {
+        /// The amount of measured order lifecycles.
+        var iterations: Int
+        /// The amount of order lifecycles performed (and discarded) before measuring.
+        var warmup: Int
+        /// The fixed delay (in seconds) the simulator adds to every response.
+        var latency: TimeInterval
+        /// The market being traded.
+        var epic: IG.Market.Epic
+        /// The bid price quoted by the simulator.
+        var bid: Decimal64
+        /// The ask/offer price quoted by the simulator.
+        var ask: Decimal64
+
+        /// Designated initializer.
+        /// - parameter iterations: The amount of measured order lifecycles.
+        /// - parameter warmup: The amount of order lifecycles performed (and discarded) before measuring.
+        /// - parameter latency: The fixed delay (in seconds) the simulator adds to every response.
+        init(iterations: Int = 200, warmup: Int = 20, latency: TimeInterval = 0.001, epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP", bid: Decimal64 = Decimal64(11000, power: -4)!, ask: Decimal64 = Decimal64(11002, power: -4)!) {
+            self.iterations = Swift.max(1, iterations)
+            self.warmup = Swift.max(0, warmup)
+            self.latency = Swift.max(0, latency)
+            self.epic = epic
+            self.bid = bid
+            self.ask = ask
+        }
+    }
+
+    /// The endpoints being measured.
+    enum Endpoint: Hashable, CaseIterable {
+        case createPosition
+        case updatePosition
+        case closePosition
+        case createWorkingOrder
+        case getConfirmation
+    }
+
+    /// The measurements of a benchmark run.
+    struct Report {
+        /// The amount of measured order lifecycles.
+        let iterations: Int
+        /// The fixed delay (in seconds) the simulator added to every response.
+        let latency: TimeInterval
+        /// The measurements indexed by endpoint.
+        let endpoints: [Endpoint:Measurement]
+    }
+
+    /// The measurements of a single endpoint.
+    struct Measurement {
+        /// The amount of measured calls.
+        let calls: Int
+        /// The library-added latency distribution (in seconds).
+        let overhead: Percentiles
+        /// The average amount of memory allocations per call (or `nil` if allocations cannot be counted in the current platform).
+        let allocations: Double?
+    }
+
+    /// A latency distribution (in seconds).
+    struct Percentiles {
+        /// The median latency.
+        let p50: TimeInterval
+        /// The 90th percentile latency.
+        let p90: TimeInterval
+        /// The 99th percentile latency.
+        let p99: TimeInterval
+        /// The maximum latency.
+        let maximum: TimeInterval
+        /// The average latency.
+        let mean: TimeInterval
+    }
+}
+
+// MARK: -
+
+private extension APIBenchmark {
+    /// Fake (but syntactically valid) OAuth API key used to log into the simulator.
+    static let _key: API.Key = "0123456789abcdef0123456789abcdef01234567"
+    /// Fake user credentials used to log into the simulator.
+    static let _user: API.User = ["benchmark", "password"]
+
+    /// Performs a single order lifecycle: a position is opened, edited, and closed; and a working order is placed (and deleted without measuring).
+    static func _iteration(api: API, configuration: Configuration, measurer: _Measurer) -> AnyPublisher<Void,IG.Error> {
+        let (epic, one) = (configuration.epic, Decimal64(1, power: 0)!)
+        let limit = configuration.ask + Decimal64(100, power: -4)!
+        let level = configuration.bid - Decimal64(100, power: -4)!
+
+        return measurer.measure(.createPosition, api.deals.createPosition(epic: epic, currency: "USD", direction: .buy, order: .market, strategy: .execute, size: one, limit: nil, stop: nil))
+            .flatMap { measurer.measure(.getConfirmation, api.deals.getConfirmation(reference: $0)) }
+            .flatMap { (confirmation) in
+                measurer.measure(.updatePosition, api.deals.updatePosition(id: confirmation.deal.id, limitLevel: limit, stop: nil))
+                    .map { _ in confirmation.deal.id }
+            }.flatMap { measurer.measure(.closePosition, api.deals.closePosition(matchedBy: .identifier($0), direction: .sell, order: .market, strategy: .execute, size: one)) }
+            .flatMap { _ in measurer.measure(.createWorkingOrder, api.deals.createWorkingOrder(epic: epic, currency: "USD", direction: .buy, type: .limit, expiration: .tillCancelled, size: one, level: level, limit: nil, stop: nil)) }
+            .flatMap { measurer.measure(.getConfirmation, api.deals.getConfirmation(reference: $0)) }
+            .flatMap { api.deals.deleteWorkingOrder(id: $0.deal.id) }
+            .map { _ in () }
+            .eraseToAnyPublisher()
+    }
+}
+
+/// Measures the calls of a single order lifecycle.
+private struct _Measurer {
+    /// The recorder storing the measurements (or `nil` if the calls are not measured, e.g. during warmup).
+    let recorder: _Recorder?
+    /// The fixed delay (in seconds) added by the simulator to every response.
+    let latency: TimeInterval
+
+    /// Wraps the given endpoint call measuring its latency and allocations from subscription till the first value is received.
+    func measure<P>(_ endpoint: APIBenchmark.Endpoint, _ call: P) -> AnyPublisher<P.Output,IG.Error> where P:Publisher, P.Failure==IG.Error {
+        guard let recorder = self.recorder else { return call.eraseToAnyPublisher() }
+        let latency = UInt64(self.latency * 1_000_000_000)
+        return Deferred { () -> Publishers.HandleEvents<P> in
+            let (start, allocations) = (DispatchTime.now().uptimeNanoseconds, _Allocations.count)
+            return call.handleEvents(receiveOutput: { _ in
+                let elapsed = DispatchTime.now().uptimeNanoseconds - start
+                let allocated = allocations.flatMap { (before) in _Allocations.count.map { $0 - before } }
+                recorder.record(endpoint, overhead: (elapsed > latency) ? elapsed - latency : 0, allocations: allocated)
+            })
+        }.eraseToAnyPublisher()
+    }
+}
+
+/// Stores the measurements of a benchmark run.
+private final class _Recorder {
+    /// The lock restricting access to the measurements.
+    private let _lock: NSLock
+    /// The library-added latencies (in nanoseconds) and allocations of every measured call, indexed by endpoint.
+    private var _samples: [APIBenchmark.Endpoint:(overheads: [UInt64], allocations: Int?)]
+
+    init() {
+        self._lock = NSLock()
+        self._samples = .init(minimumCapacity: APIBenchmark.Endpoint.allCases.count)
+    }
+
+    /// Records the measurements of a single call.
+    func record(_ endpoint: APIBenchmark.Endpoint, overhead: UInt64, allocations: Int?) {
+        self._lock.lock()
+        defer { self._lock.unlock() }
+        var samples = self._samples[endpoint] ?? ([], 0)
+        samples.overheads.append(overhead)
+        samples.allocations = samples.allocations.flatMap { (total) in allocations.map { total + $0 } }
+        self._samples[endpoint] = samples
+    }
+
+    /// Builds the report from the recorded measurements.
+    /// - complexity: O(n log n) where `n` is the number of recorded calls.
+    func report(iterations: Int, latency: TimeInterval) -> APIBenchmark.Report {
+        self._lock.lock()
+        let samples = self._samples
+        self._lock.unlock()
+        var endpoints: [APIBenchmark.Endpoint:APIBenchmark.Measurement] = .init(minimumCapacity: samples.count)
+
+        for (endpoint, (overheads, allocations)) in samples {
+            let sorted = overheads.sorted()
+            func percentile(_ p: Double) -> TimeInterval {
+                guard !sorted.isEmpty else { return 0 }
+                let index = Swift.min(sorted.count - 1, Int((p * Double(sorted.count)).rounded(.up)) - 1)
+                return Double(sorted[Swift.max(0, index)]) / 1_000_000_000
+            }
+
+            let mean = sorted.isEmpty ? 0 : Double(sorted.reduce(0, +)) / Double(sorted.count) / 1_000_000_000
+            let overhead = APIBenchmark.Percentiles(p50: percentile(0.5), p90: percentile(0.9), p99: percentile(0.99), maximum: percentile(1), mean: mean)
+            endpoints[endpoint] = .init(calls: sorted.count, overhead: overhead, allocations: allocations.map { Double($0) / Double(Swift.max(1, sorted.count)) })
+        }
+        return .init(iterations: iterations, latency: latency, endpoints: endpoints)
+    }
+}
+
+/// Process-wide allocation counter.
+///
+/// On Darwin platforms, the default malloc zone's `malloc`, `calloc`, and `realloc` entries are swapped by counting trampolines while a benchmark is running. On other platforms, allocations are not counted.
+private enum _Allocations {
+    #if canImport(Darwin)
+    /// The default malloc zone.
+    private static let _zone: UnsafeMutablePointer<malloc_zone_t> = malloc_default_zone()
+    /// The original zone entries (retrieved before any trampoline is installed).
+    private static let _original = (malloc: _zone.pointee.malloc!, calloc: _zone.pointee.calloc!, realloc: _zone.pointee.realloc!)
+    /// The lock restricting access to the counter (it never allocates).
+    private static let _lock: os_unfair_lock_t = {
+        let lock = os_unfair_lock_t.allocate(capacity: 1)
+        lock.initialize(to: os_unfair_lock())
+        return lock
+    }()
+    /// The amount of allocations performed since the trampolines were installed.
+    private static let _counter: UnsafeMutablePointer<Int> = {
+        let counter = UnsafeMutablePointer<Int>.allocate(capacity: 1)
+        counter.initialize(to: 0)
+        return counter
+    }()
+    /// The amount of benchmarks currently running (the trampolines are installed while it is greater than zero).
+    private static var _installations = 0
+    /// Boolean indicating whether the trampolines are installed.
+    private static var _isInstalled = false
+
+    /// The amount of allocations counted so far (or `nil` if the trampolines are not installed).
+    static var count: Int? {
+        os_unfair_lock_lock(_lock)
+        defer { os_unfair_lock_unlock(_lock) }
+        return _isInstalled ? _counter.pointee : nil
+    }
+
+    /// Installs the counting trampolines (if they weren't already installed).
+    static func install() {
+        _ = (_original, _lock, _counter)
+        os_unfair_lock_lock(_lock)
+        defer { os_unfair_lock_unlock(_lock) }
+        _installations += 1
+        guard _installations == 1 else { return }
+        _isInstalled = _swap(malloc: { (zone, size) in
+                _Allocations._increment()
+                return _Allocations._original.malloc(zone, size)
+            }, calloc: { (zone, count, size) in
+                _Allocations._increment()
+                return _Allocations._original.calloc(zone, count, size)
+            }, realloc: { (zone, pointer, size) in
+                _Allocations._increment()
+                return _Allocations._original.realloc(zone, pointer, size)
+            })
+    }
+
+    /// Restores the original zone entries once no benchmark is running.
+    static func uninstall() {
+        os_unfair_lock_lock(_lock)
+        defer { os_unfair_lock_unlock(_lock) }
+        guard _installations > 0 else { return }
+        _installations -= 1
+        guard _installations == 0, _isInstalled else { return }
+        _ = _swap(malloc: _original.malloc, calloc: _original.calloc, realloc: _original.realloc)
+        _isInstalled = false
+    }
+
+    /// Increments the allocation counter.
+    private static func _increment() {
+        os_unfair_lock_lock(_lock)
+        _counter.pointee += 1
+        os_unfair_lock_unlock(_lock)
+    }
+
+    /// Replaces the default zone entries (which live in read-only memory) with the given functions.
+    /// - returns: Boolean indicating whether the entries could be replaced.
+    private static func _swap(malloc: @escaping @convention(c) (UnsafeMutablePointer<malloc_zone_t>?, Int) -> UnsafeMutableRawPointer?,
+                              calloc: @escaping @convention(c) (UnsafeMutablePointer<malloc_zone_t>?, Int, Int) -> UnsafeMutableRawPointer?,
+                              realloc: @escaping @convention(c) (UnsafeMutablePointer<malloc_zone_t>?, UnsafeMutableRawPointer?, Int) -> UnsafeMutableRawPointer?) -> Bool {
+        let (address, size) = (vm_address_t(UInt(bitPattern: _zone)), vm_size_t(MemoryLayout<malloc_zone_t>.size))
+        guard vm_protect(mach_task_self_, address, size, 0, VM_PROT_READ | VM_PROT_WRITE) == KERN_SUCCESS else { return false }
+        _zone.pointee.malloc = malloc
+        _zone.pointee.calloc = calloc
+        _zone.pointee.realloc = realloc
+        _ = vm_protect(mach_task_self_, address, size, 0, VM_PROT_READ)
+        return true
+    }
+    #else
+    /// Allocations are not counted in the current platform.
+    static var count: Int? { nil }
+    /// Allocations are not counted in the current platform.
+    static func install() {}
+    /// Allocations are not counted in the current platform.
+    static func uninstall() {}
+    #endif
+}
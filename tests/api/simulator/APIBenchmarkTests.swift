@@ -0,0 +1,24 @@
+import IG
+import ConbiniForTesting
+import XCTest
+
+final class APIBenchmarkTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that every trading endpoint is measured against the in-process simulator.
+    func testTradingPathBenchmark() throws {
+        let benchmark = APIBenchmark(configuration: .init(iterations: 10, warmup: 2, latency: 0.001))
+        let report = benchmark.run().expectsOne(timeout: 5, on: self)
+        XCTAssertEqual(report.iterations, 10)
+
+        for endpoint in APIBenchmark.Endpoint.allCases {
+            let measurement = try XCTUnwrap(report.endpoints[endpoint])
+            XCTAssertEqual(measurement.calls, (endpoint == .getConfirmation) ? 20 : 10)
+            XCTAssertLessThanOrEqual(measurement.overhead.p50, measurement.overhead.p99)
+            XCTAssertLessThanOrEqual(measurement.overhead.p99, measurement.overhead.maximum)
+            if let allocations = measurement.allocations { XCTAssertGreaterThan(allocations, 0) }
+        }
+    }
+}
@@ -0,0 +1,139 @@
+import IG
+import ConbiniForTesting
+import Decimals
+import XCTest
+
+final class APISimulatorTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the position creation, confirmation, and closing against the in-process simulator.
+    func testSimulatedPositionLifecycle() {
+        let simulator = API.Simulator(funds: 10_000)
+        let api = API(simulator: simulator)
+        api.session.login(type: .oauth, key: "0123456789abcdef0123456789abcdef01234567", user: ["simulated", "password"]).expectsCompletion(timeout: 1, on: self)
+
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        simulator.update(epic: epic, bid: Decimal64(11000, power: -4)!, ask: Decimal64(11002, power: -4)!)
+
+        // 1. Open a market position.
+        let reference = api.deals
+            .createPosition(epic: epic, currency: "USD", direction: .buy, order: .market, strategy: .execute, size: 1, limit: .distance(20), stop: .distance(20))
+            .expectsOne(timeout: 1, on: self)
+        let opened = api.deals.getConfirmation(reference: reference).expectsOne(timeout: 1, on: self)
+        XCTAssertEqual(opened.deal.status, .accepted)
+        XCTAssertEqual(opened.details.status!, .opened)
+        XCTAssertEqual(opened.details.level!, Decimal64(11002, power: -4)!)
+        XCTAssertEqual(simulator.positions.count, 1)
+
+        // 2. Close it after the price moves up.
+        simulator.update(epic: epic, bid: Decimal64(11010, power: -4)!, ask: Decimal64(11012, power: -4)!)
+        let closing = api.deals
+            .closePosition(matchedBy: .identifier(opened.deal.id), direction: .sell, order: .market, strategy: .execute, size: 1)
+            .expectsOne(timeout: 1, on: self)
+        let closed = api.deals.getConfirmation(reference: closing).expectsOne(timeout: 1, on: self)
+        XCTAssertEqual(closed.deal.status, .accepted)
+        XCTAssertEqual(closed.details.status!, .closed(.fully))
+        XCTAssertTrue(simulator.positions.isEmpty)
+        XCTAssertGreaterThan(simulator.funds.balance, Decimal64(10_000, power: 0)!)
+        // The closing deal gets its own reference; thus, the opening confirmation is still retrievable.
+        XCTAssertNotEqual(closing, reference)
+        XCTAssertEqual(api.deals.getConfirmation(reference: reference).expectsOne(timeout: 1, on: self).details.status!, .opened)
+
+        // 3. Unknown markets are rejected.
+        let rejection = api.deals
+            .createPosition(epic: "CS.D.GBPUSD.MINI.IP", currency: "USD", direction: .buy, order: .market, strategy: .execute, size: 1, limit: nil, stop: nil)
+            .expectsOne(timeout: 1, on: self)
+        let rejected = api.deals.getConfirmation(reference: rejection).expectsOne(timeout: 1, on: self)
+        XCTAssertEqual(rejected.deal.status, .rejected(reason: .instrumentNotFound))
+    }
+
+
+    /// Tests that partial closes realize the closed size only and that rejected netting deals leave the account untouched.
+    func testSimulatedPartialCloseAndNetting() {
+        let simulator = API.Simulator(funds: 10_000)
+        let api = API(simulator: simulator)
+        api.session.login(type: .oauth, key: "0123456789abcdef0123456789abcdef01234567", user: ["simulated", "password"]).expectsCompletion(timeout: 1, on: self)
+
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        simulator.update(epic: epic, bid: Decimal64(11000, power: -4)!, ask: Decimal64(11002, power: -4)!)
+        let reference = api.deals
+            .createPosition(epic: epic, currency: "USD", direction: .buy, order: .market, strategy: .execute, size: 2, limit: nil, stop: nil)
+            .expectsOne(timeout: 1, on: self)
+        let opened = api.deals.getConfirmation(reference: reference).expectsOne(timeout: 1, on: self)
+
+        // 1. Close half of the position: only the closed size is realized.
+        simulator.update(epic: epic, bid: Decimal64(11010, power: -4)!, ask: Decimal64(11012, power: -4)!)
+        let closing = api.deals
+            .closePosition(matchedBy: .identifier(opened.deal.id), direction: .sell, order: .market, strategy: .execute, size: 1)
+            .expectsOne(timeout: 1, on: self)
+        let closed = api.deals.getConfirmation(reference: closing).expectsOne(timeout: 1, on: self)
+        XCTAssertEqual(closed.details.status!, .closed(.partially))
+        XCTAssertEqual(closed.details.profit!.value, Decimal64(8, power: -4)!)
+        XCTAssertEqual(simulator.funds.balance, Decimal64(100_000_008, power: -4)!)
+
+        // 2. A netting deal whose residual position exceeds the available funds is rejected without closing the opposite position.
+        let netting = api.deals
+            .createPosition(epic: epic, currency: "USD", direction: .sell, order: .market, strategy: .execute, size: 1_000_001, limit: nil, stop: nil, forceOpen: false)
+            .expectsOne(timeout: 1, on: self)
+        let rejected = api.deals.getConfirmation(reference: netting).expectsOne(timeout: 1, on: self)
+        XCTAssertEqual(rejected.deal.status, .rejected(reason: .insufficientFunds))
+        XCTAssertEqual(simulator.positions.map { $0.size }, [Decimal64(1, power: 0)!])
+        XCTAssertEqual(simulator.funds.balance, Decimal64(100_000_008, power: -4)!)
+    }
+
+    /// Tests that working order amendments and deletions get their own deal references, and that triggered orders are filled at the market price.
+    func testSimulatedWorkingOrders() {
+        let simulator = API.Simulator(funds: 10_000)
+        let api = API(simulator: simulator)
+        api.session.login(type: .oauth, key: "0123456789abcdef0123456789abcdef01234567", user: ["simulated", "password"]).expectsCompletion(timeout: 1, on: self)
+
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        simulator.update(epic: epic, bid: Decimal64(11000, power: -4)!, ask: Decimal64(11002, power: -4)!)
+
+        // 1. Place, amend, and delete a limit order below the market.
+        let placing = api.deals
+            .createWorkingOrder(epic: epic, currency: "USD", direction: .buy, type: .limit, expiration: .tillCancelled, size: 1, level: Decimal64(10990, power: -4)!, limit: nil, stop: nil)
+            .expectsOne(timeout: 1, on: self)
+        let order = simulator.workingOrders.first!
+        let amending = api.deals
+            .updateWorkingOrder(id: order.id, type: .limit, expiration: .tillCancelled, level: Decimal64(10995, power: -4)!, limit: nil, stop: nil)
+            .expectsOne(timeout: 1, on: self)
+        let deleting = api.deals.deleteWorkingOrder(id: order.id).expectsOne(timeout: 1, on: self)
+        XCTAssertEqual(Set([placing, amending, deleting]).count, 3)
+        XCTAssertEqual(api.deals.getConfirmation(reference: placing).expectsOne(timeout: 1, on: self).details.status!, .opened)
+        XCTAssertEqual(api.deals.getConfirmation(reference: amending).expectsOne(timeout: 1, on: self).details.status!, .amended)
+        XCTAssertEqual(api.deals.getConfirmation(reference: deleting).expectsOne(timeout: 1, on: self).details.status!, .deleted)
+        XCTAssertTrue(simulator.workingOrders.isEmpty)
+
+        // 2. A limit order above the market is triggered right away and filled at the (better) market price.
+        api.deals
+            .createWorkingOrder(epic: epic, currency: "USD", direction: .buy, type: .limit, expiration: .tillCancelled, size: 1, level: Decimal64(11010, power: -4)!, limit: nil, stop: nil)
+            .expectsOne(timeout: 1, on: self)
+        XCTAssertTrue(simulator.workingOrders.isEmpty)
+        XCTAssertEqual(simulator.positions.map { $0.level }, [Decimal64(11002, power: -4)!])
+    }
+
+    #if compiler(>=5.7) && canImport(_Concurrency)
+    /// Tests the `async` endpoint variants against the in-process simulator.
+    func testAsyncPositionLifecycle() async throws {
+        let simulator = API.Simulator(funds: 10_000)
+        let api = API(simulator: simulator)
+        let settings = try await api.session.login(type: .oauth, key: "0123456789abcdef0123456789abcdef01234567", user: ["simulated", "password"])
+        XCTAssertNil(settings)
+
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        simulator.update(epic: epic, bid: Decimal64(11000, power: -4)!, ask: Decimal64(11002, power: -4)!)
+
+        let reference = try await api.deals.createPosition(epic: epic, currency: "USD", direction: .buy, order: .market, strategy: .execute, size: 1, limit: nil, stop: nil)
+        let opened = try await api.deals.getConfirmation(reference: reference)
+        XCTAssertEqual(opened.deal.status, .accepted)
+
+        let closing = try await api.deals.closePosition(matchedBy: .identifier(opened.deal.id), direction: .sell, order: .market, strategy: .execute, size: 1)
+        let closed = try await api.deals.getConfirmation(reference: closing)
+        XCTAssertEqual(closed.details.status!, .closed(.fully))
+        XCTAssertTrue(simulator.positions.isEmpty)
+    }
+    #endif
+}
@@ -0,0 +1,89 @@
+#if DEBUG
+@testable import IG
+import XCTest
+
+final class APIStreamingTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that multi-byte UTF8 characters and string escapes are delimited correctly whatever the segment boundaries are.
+    func testSplitSegments() throws {
+        let json = #"{"metadata":{"size":2},"prices":[{"name":"Zürich €","note":"say \"hi\" \\ bye"},{"name":"ø\"]"}]}"#
+        let expected = [#"{"name":"Zürich €","note":"say \"hi\" \\ bye"}"#, #"{"name":"ø\"]"}"#]
+
+        let bytes = Array(json.utf8)
+        // Every possible single split (including the ones within a multi-byte character or in between a backslash and the escaped character).
+        for offset in 1..<bytes.count {
+            let result = Self._scan(json, splits: [offset])
+            XCTAssertEqual(result.elements, expected, "Split at byte \(offset)")
+            XCTAssertTrue(result.isFinished)
+        }
+        // Byte per byte.
+        let result = Self._scan(json, splits: Array(1..<bytes.count))
+        XCTAssertEqual(result.elements, expected)
+        XCTAssertTrue(result.isFinished)
+
+        let decoded = try result.elements.map { try JSONDecoder().decode([String:String].self, from: Data($0.utf8)) }
+        XCTAssertEqual(decoded[0]["name"], "Zürich €")
+        XCTAssertEqual(decoded[0]["note"], #"say "hi" \ bye"#)
+        XCTAssertEqual(decoded[1]["name"], #"ø"]"#)
+    }
+
+    /// Tests nested containers, strings containing brackets and commas, and keys that only match at the root level.
+    func testNestedContainers() {
+        let json = """
+        {
+            "metadata": { "prices": [9] },
+            "name": "prices",
+            "prices": [ {"a": [1, [2, 3]], "b": {"c": "]"}} , [4, {"d": "[{"}] , "x,]}" , 5 ],
+            "other": [6]
+        }
+        """
+        let result = Self._scan(json, splits: [40, 97, 98, 120])
+        XCTAssertEqual(result.elements, [#"{"a":[1,[2,3]],"b":{"c":"]"}}"#, #"[4,{"d":"[{"}]"#, #""x,]}""#, "5"])
+        XCTAssertTrue(result.isFinished)
+    }
+
+    /// Tests that an empty targeted array doesn't produce any element.
+    func testEmptyArray() {
+        for json in [#"{"prices":[],"metadata":{}}"#, #"{"prices": [ ]}"#] {
+            let result = Self._scan(json, splits: [11])
+            XCTAssertTrue(result.elements.isEmpty)
+            XCTAssertTrue(result.isFinished)
+        }
+    }
+
+    /// Tests that truncated input only forwards the completed elements and never finishes.
+    func testTruncatedInput() {
+        var result = Self._scan(#"{"prices":[{"a":1},{"b":"#, splits: [14])
+        XCTAssertEqual(result.elements, [#"{"a":1}"#])
+        XCTAssertFalse(result.isFinished)
+
+        result = Self._scan(#"{"pri"#, splits: [])
+        XCTAssertTrue(result.elements.isEmpty)
+        XCTAssertFalse(result.isFinished)
+
+        result = Self._scan(#"{"prices":[1,2"#, splits: [])
+        XCTAssertEqual(result.elements, ["1"])
+        XCTAssertFalse(result.isFinished)
+    }
+}
+
+private extension APIStreamingTests {
+    /// Feeds the given JSON to a scanner targeting the `prices` key in segments split at the given byte offsets.
+    /// - returns: The delimited elements (as strings) and whether the targeted array has been fully parsed.
+    static func _scan(_ json: String, splits: [Int]) -> (elements: [String], isFinished: Bool) {
+        let bytes = Array(json.utf8)
+        let bounds = [0] + splits + [bytes.count]
+
+        var scanner = _JSONArrayScanner(key: "prices")
+        var elements: [String] = []
+        for (start, end) in zip(bounds, bounds.dropFirst()) {
+            let segments = try! scanner.feed(Data(bytes[start..<end]))
+            elements.append(contentsOf: segments.map { String(decoding: $0, as: UTF8.self) })
+        }
+        return (elements, scanner.isFinished)
+    }
+}
+#endif
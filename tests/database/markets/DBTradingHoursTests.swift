@@ -0,0 +1,64 @@
+import IG
+import XCTest
+
+final class DBTradingHoursTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the compilation of opening hours into minute-of-week bitmaps and their queries.
+    func testTradingHoursQueries() throws {
+        let utc = TimeZone(identifier: "UTC")!
+        let epic: IG.Market.Epic = "IX.D.FTSE.IFE.IP"
+        // 2020-09-14 00:00:00 UTC was a Monday.
+        let monday = Date(timeIntervalSince1970: 1_600_041_600)
+        let hour: TimeInterval = 3_600, day: TimeInterval = 86_400
+
+        let hours = try XCTUnwrap(Database.Market.TradingHours(epic: epic, timezone: utc, ranges: [("08:00", "16:30")]))
+        XCTAssertFalse(hours.isOpen(at: monday.addingTimeInterval(7 * hour + 59 * 60)))
+        XCTAssertTrue(hours.isOpen(at: monday.addingTimeInterval(8 * hour)))
+        XCTAssertTrue(hours.isOpen(at: monday.addingTimeInterval(16 * hour + 29 * 60)))
+        XCTAssertFalse(hours.isOpen(at: monday.addingTimeInterval(16 * hour + 30 * 60)))
+        XCTAssertFalse(hours.isOpen(at: monday.addingTimeInterval(5 * day + 10 * hour)))
+
+        let open = monday.addingTimeInterval(10 * hour)
+        XCTAssertEqual(hours.nextOpen(after: open), open)
+        XCTAssertEqual(hours.nextOpen(after: monday.addingTimeInterval(17 * hour)), monday.addingTimeInterval(day + 8 * hour))
+        XCTAssertEqual(hours.nextOpen(after: monday.addingTimeInterval(5 * day + 12 * hour)), monday.addingTimeInterval(7 * day + 8 * hour))
+
+        let overnight = try XCTUnwrap(Database.Market.TradingHours(epic: epic, timezone: utc, ranges: [("22:00", "06:00")], weekdays: [5]))
+        XCTAssertTrue(overnight.isOpen(at: monday.addingTimeInterval(5 * day + 3 * hour)))
+        XCTAssertFalse(overnight.isOpen(at: monday.addingTimeInterval(3 * hour)))
+        XCTAssertEqual(overnight.nextOpen(after: monday), monday.addingTimeInterval(4 * day + 22 * hour))
+
+        XCTAssertNil(Database.Market.TradingHours(epic: epic, timezone: utc, ranges: [("8h", "16:30")]))
+        let calendar = Database.TradingCalendar(hours: [hours])
+        XCTAssertEqual(calendar.isOpen(epic: epic, at: open), true)
+        XCTAssertNil(calendar.isOpen(epic: "CS.D.EURUSD.CFD.IP", at: open))
+    }
+
+    /// Tests that ranges spilling over into the following day start on the eve of each trading day by default.
+    func testOvernightDefaultWeekdays() throws {
+        let london = TimeZone(identifier: "Europe/London")!
+        let epic: IG.Market.Epic = "CS.D.EURUSD.CFD.IP"
+        // 2020-09-14 00:00:00 (London time) was a Monday.
+        let monday = Date(timeIntervalSince1970: 1_600_038_000)
+        let hour: TimeInterval = 3_600, day: TimeInterval = 86_400
+
+        // Forex sessions open on Sunday evening and close on Friday evening.
+        let forex = try XCTUnwrap(Database.Market.TradingHours(epic: epic, timezone: london, ranges: [("22:00", "22:00")]))
+        XCTAssertFalse(forex.isOpen(at: monday.addingTimeInterval(-1 * day + 21 * hour)))
+        XCTAssertTrue(forex.isOpen(at: monday.addingTimeInterval(-1 * day + 22 * hour)))
+        XCTAssertTrue(forex.isOpen(at: monday.addingTimeInterval(2 * day + 22 * hour)))
+        XCTAssertTrue(forex.isOpen(at: monday.addingTimeInterval(4 * day + 21 * hour + 59 * 60)))
+        XCTAssertFalse(forex.isOpen(at: monday.addingTimeInterval(4 * day + 22 * hour)))
+        XCTAssertFalse(forex.isOpen(at: monday.addingTimeInterval(5 * day + 12 * hour)))
+        XCTAssertEqual(forex.nextOpen(after: monday.addingTimeInterval(5 * day)), monday.addingTimeInterval(6 * day + 22 * hour))
+
+        // Ranges contained within a day keep starting from Monday till Friday.
+        let daily = try XCTUnwrap(Database.Market.TradingHours(epic: epic, timezone: london, ranges: [("00:00", "24:00")]))
+        XCTAssertTrue(daily.isOpen(at: monday))
+        XCTAssertTrue(daily.isOpen(at: monday.addingTimeInterval(4 * day + 23 * hour)))
+        XCTAssertFalse(daily.isOpen(at: monday.addingTimeInterval(-1 * hour)))
+    }
+}
@@ -0,0 +1,94 @@
+import IG
+import Combine
+import ConbiniForTesting
+import Decimals
+import XCTest
+
+final class DBJournalTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the storage and transaction cost analysis of the order lifecycle journal.
+    func testJournalAnalysis() throws {
+        let database = try Database(location: .memory)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let quote = (bid: Decimal64(11000, power: -4)!, ask: Decimal64(11002, power: -4)!)
+        let start = Date(timeIntervalSince1970: 1_600_000_000)
+
+        let (accepted, rejected) = (IG.Deal.Reference("JOURNAL-ACCEPTED")!, IG.Deal.Reference("JOURNAL-REJECTED")!)
+        let events: [Database.OrderEvent] = [
+            .built(reference: accepted, epic: epic, direction: .buy, quote: quote, date: start),
+            .sent(reference: accepted, date: start.addingTimeInterval(0.001)),
+            .acknowledged(reference: accepted, date: start.addingTimeInterval(0.051)),
+            .init(reference: accepted, stage: .confirmedStream, date: start.addingTimeInterval(0.061), epic: epic, direction: .buy, level: Decimal64(11003, power: -4)!),
+            .built(reference: rejected, epic: epic, direction: .sell, quote: quote, date: start.addingTimeInterval(1)),
+            .sent(reference: rejected, date: start.addingTimeInterval(1.002)),
+            .init(reference: rejected, stage: .confirmedREST, date: start.addingTimeInterval(1.1), epic: epic, direction: .sell, rejection: .insufficientFunds)
+        ]
+        database.journal.append(events).expectsCompletion(timeout: 0.5, on: self)
+
+        let stored = database.journal.get().expectsOne(timeout: 0.5, on: self)
+        XCTAssertEqual(stored.count, events.count)
+        XCTAssertEqual(stored.map { $0.stage }, events.map { $0.stage })
+        XCTAssertEqual(stored.first!.quote!.ask, quote.ask)
+
+        let report = database.journal.analyze().expectsOne(timeout: 0.5, on: self)
+        XCTAssertEqual(report.orders, 2)
+        XCTAssertEqual(report.confirmed, 2)
+        XCTAssertEqual(report.rejections[.insufficientFunds], 1)
+        XCTAssertEqual(report.rejectionRates[.insufficientFunds]!, 0.5, accuracy: 0.0001)
+        XCTAssertEqual(report.slippage!.count, 1)
+        XCTAssertEqual(report.slippage!.p50, 1.8181, accuracy: 0.001)
+        XCTAssertEqual(report.latencies[.acknowledgement]!.p50, 0.05, accuracy: 0.0001)
+        XCTAssertEqual(report.latencies[.endToEnd]!.count, 2)
+        XCTAssertEqual(report.latencies[.restConfirmation]!.count, 1)
+
+        // Windows select the orders built within them, along with all their lifecycle events (even the ones outside the window).
+        let early = database.journal.analyze(from: start, to: start.addingTimeInterval(0.01)).expectsOne(timeout: 0.5, on: self)
+        XCTAssertEqual(early.orders, 1)
+        XCTAssertEqual(early.confirmed, 1)
+        XCTAssertTrue(early.rejections.isEmpty)
+        XCTAssertEqual(early.latencies[.endToEnd]!.p50, 0.061, accuracy: 0.0001)
+
+        let late = database.journal.analyze(from: start.addingTimeInterval(0.01), to: start.addingTimeInterval(1.05)).expectsOne(timeout: 0.5, on: self)
+        XCTAssertEqual(late.orders, 1)
+        XCTAssertEqual(late.confirmed, 1)
+        XCTAssertEqual(late.rejections[.insufficientFunds], 1)
+        XCTAssertEqual(late.latencies[.endToEnd]!.p50, 0.1, accuracy: 0.0001)
+    }
+
+    /// Tests that deal calls sent through the journaling proxy record their whole lifecycle (whether the reference is generated locally or by the server).
+    func testJournaledDeals() throws {
+        let database = try Database(location: .memory)
+        let writer = database.journal.makeWriter(batchSize: 100, interval: 60)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let quote = (bid: Decimal64(11000, power: -4)!, ask: Decimal64(11002, power: -4)!)
+
+        let simulator = API.Simulator(funds: 10_000)
+        simulator.update(epic: epic, bid: quote.bid, ask: quote.ask)
+        let api = API(simulator: simulator)
+        api.session.login(type: .oauth, key: "0123456789abcdef0123456789abcdef01234567", user: ["simulated", "password"]).expectsCompletion(timeout: 1, on: self)
+        let deals = api.deals.journaled(on: writer)
+
+        // No reference is given; thus, one is generated (and sent) for the position.
+        let opened = deals.createPosition(quote: quote, epic: epic, currency: "USD", direction: .buy, order: .market, strategy: .execute, size: 1, limit: nil, stop: nil)
+            .expectsOne(timeout: 1, on: self)
+        XCTAssertEqual(deals.getConfirmation(reference: opened).expectsOne(timeout: 1, on: self).deal.status, .accepted)
+        // Closing calls get their references from the server.
+        let closed = deals.closePosition(quote: quote, matchedBy: .identifier("DIAAAANOTFOUND"), direction: .sell, order: .market, strategy: .execute, size: 1)
+            .expectsOne(timeout: 1, on: self)
+        XCTAssertNotEqual(opened, closed)
+
+        writer.flush().expectsCompletion(timeout: 0.5, on: self)
+        let events = database.journal.get().expectsOne(timeout: 0.5, on: self)
+        XCTAssertEqual(events.filter { $0.reference == opened }.map { $0.stage }, [.built, .sent, .acknowledged, .confirmedREST])
+        XCTAssertEqual(events.filter { $0.reference == closed }.map { $0.stage }, [.built, .sent, .acknowledged])
+
+        let built = events.first { $0.reference == opened }!
+        XCTAssertEqual(built.epic, epic)
+        XCTAssertEqual(built.direction, .buy)
+        XCTAssertEqual(built.quote?.ask, quote.ask)
+        XCTAssertTrue(zip(events.dropFirst(), events).allSatisfy { ($0.reference != $1.reference) || ($0.date >= $1.date) })
+    }
+}
@@ -14,10 +14,46 @@ final class DBPriceTests: XCTestCase {
         
         let from = Date().lastTuesday
         let to = Calendar(identifier: .iso8601).date(byAdding: .hour, value: 1, to: from)!
-        let prices = database.prices.get(epic: Market.Epic.forex.randomElement()!, from: from, to: to).expectsOne(timeout: 0.5, on: self)
+        let epic = Market.Epic.forex.randomElement()!
+        let prices = database.prices.get(epic: epic, from: from, to: to).expectsOne(timeout: 0.5, on: self)
         XCTAssertTrue(prices.isEmpty)
     }
 
+    #if compiler(>=5.7) && canImport(_Concurrency)
+    /// Tests the `async` retrieval of price data from a table that it is not there.
+    func testAsyncNonExistentPriceTable() async throws {
+        let database = try Database(location: .memory)
+        let epic = Market.Epic.forex.randomElement()!
+
+        let from = Date().lastTuesday
+        let to = Calendar(identifier: .iso8601).date(byAdding: .hour, value: 1, to: from)!
+        let prices = try await database.prices.get(epic: epic, from: from, to: to)
+        XCTAssertTrue(prices.isEmpty)
+    }
+    #endif
+
+    /// Tests the replay of markets with no stored prices.
+    func testEmptyReplay() throws {
+        let database = try Database(location: .memory)
+        
+        let epics = Set(Market.Epic.forex.prefix(3))
+        let replay = database.prices.replay(epics: epics, speed: .maximum, batchSize: 10)
+        let candles = replay.publisher.expectsAll(timeout: 0.5, on: self)
+        XCTAssertTrue(candles.isEmpty)
+        XCTAssertNil(replay.date)
+    }
+
+    /// Tests the continuous series of a market with no stored prices.
+    func testEmptyContinuousSeries() throws {
+        let database = try Database(location: .memory)
+        let epic: IG.Market.Epic = "IX.D.FTSE.FWM1.IP"
+
+        database.prices.continuous.update(epic: epic, adjustment: .ratio, threshold: 0.02).expectsCompletion(timeout: 0.5, on: self)
+        XCTAssertTrue(database.prices.continuous.get(epic: epic).expectsOne(timeout: 0.5, on: self).isEmpty)
+        XCTAssertTrue(database.prices.continuous.rolls(epic: epic).expectsOne(timeout: 0.5, on: self).isEmpty)
+        database.prices.continuous.update(epic: epic, adjustment: .difference, threshold: -1).expectsFailure(timeout: 0.5, on: self)
+    }
+
     /// Tests the creation of a price table.
     func testPriceTableCreation() throws {
         let api = API()
@@ -0,0 +1,141 @@
+#if DEBUG
+@testable import IG
+import ConbiniForTesting
+import Decimals
+import XCTest
+
+final class DBPricesContinuousTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the stitching of three contracts (two recorded expiries) with both adjustment methods and the incremental update of the series.
+    func testContinuousSeries() throws {
+        let database = try Database(location: .memory)
+        let epic: IG.Market.Epic = "IX.D.FTSE.FWM1.IP"
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let hour: (Int) -> Date = { start.addingTimeInterval(TimeInterval($0 * 3_600)) }
+        let closes: ([Database.Price]) -> [Double] = { $0.map { Double($0.close.mid.description)! } }
+
+        // Each market update records the expiry of the contract being traded (02:30 and 04:30).
+        database.markets.update(try Self._market(epic: epic, expiry: "2020-09-14T02:30:00")).expectsCompletion(timeout: 0.5, on: self)
+        database.markets.update(try Self._market(epic: epic, expiry: "2020-09-14T04:30:00")).expectsCompletion(timeout: 0.5, on: self)
+        database.prices.update([
+            try Self._price(date: hour(0), open: 100, close: 101), try Self._price(date: hour(1), open: 101, close: 102), try Self._price(date: hour(2), open: 102, close: 104),
+            try Self._price(date: hour(3), open: 110, close: 111), try Self._price(date: hour(4), open: 111, close: 112),
+            try Self._price(date: hour(5), open: 120, close: 121)
+        ], epic: epic).expectsCompletion(timeout: 0.5, on: self)
+
+        // 1. Difference adjustment: previous contracts are shifted by the gaps (+6 and +8).
+        database.prices.continuous.update(epic: epic, adjustment: .difference).expectsCompletion(timeout: 0.5, on: self)
+        XCTAssertEqual(closes(database.prices.continuous.get(epic: epic).expectsOne(timeout: 0.5, on: self)), [115, 116, 118, 119, 120, 121])
+
+        let rolls = database.prices.continuous.rolls(epic: epic).expectsOne(timeout: 0.5, on: self)
+        XCTAssertEqual(rolls.map { $0.date }, [hour(3), hour(5)])
+        XCTAssertEqual(rolls.map { $0.source }, [.expiry, .expiry])
+        XCTAssertEqual(rolls.map { $0.previousClose }, [104, 112])
+        XCTAssertEqual(rolls.map { $0.nextOpen }, [110, 120])
+
+        // 2. Ratio adjustment: previous contracts are multiplied by the ratios (110/104 and 120/112).
+        database.prices.continuous.update(epic: epic, adjustment: .ratio).expectsCompletion(timeout: 0.5, on: self)
+        let (first, second) = (110.0 / 104.0, 120.0 / 112.0)
+        let expected = [101 * first * second, 102 * first * second, 104 * first * second, 111 * second, 112 * second, 121]
+        let ratios = closes(database.prices.continuous.get(epic: epic).expectsOne(timeout: 0.5, on: self))
+        XCTAssertEqual(ratios.count, expected.count)
+        for (result, expected) in zip(ratios, expected) { XCTAssertEqual(result, expected, accuracy: 0.0001) }
+        XCTAssertEqual(database.prices.continuous.rolls(epic: epic).expectsOne(timeout: 0.5, on: self).count, 2)
+
+        // 3. Incremental update: only candles newer than the last materialised one are processed (the modified old candle is ignored).
+        database.prices.continuous.update(epic: epic, adjustment: .difference).expectsCompletion(timeout: 0.5, on: self)
+        database.prices.update([
+            try Self._price(date: hour(0), open: 100, close: 91),
+            try Self._price(date: hour(6), open: 121, close: 123), try Self._price(date: hour(7), open: 123, close: 122)
+        ], epic: epic).expectsCompletion(timeout: 0.5, on: self)
+        database.prices.continuous.update(epic: epic, adjustment: .difference).expectsCompletion(timeout: 0.5, on: self)
+        XCTAssertEqual(closes(database.prices.continuous.get(epic: epic).expectsOne(timeout: 0.5, on: self)), [115, 116, 118, 119, 120, 121, 123, 122])
+        XCTAssertEqual(database.prices.continuous.rolls(epic: epic).expectsOne(timeout: 0.5, on: self).count, 2)
+        XCTAssertEqual(closes(database.prices.continuous.get(epic: epic, from: hour(6)).expectsOne(timeout: 0.5, on: self)), [123, 122])
+
+        // 4. Rebuilding recomputes the whole series (picking up the modified candle).
+        database.prices.continuous.update(epic: epic, adjustment: .difference, rebuild: true).expectsCompletion(timeout: 0.5, on: self)
+        XCTAssertEqual(closes(database.prices.continuous.get(epic: epic).expectsOne(timeout: 0.5, on: self)).first, 105)
+    }
+
+    /// Tests the retrieval of the most recent stored prices (bounded by count and by date).
+    func testLastPrices() throws {
+        let database = try Database(location: .memory)
+        let epic: IG.Market.Epic = "IX.D.FTSE.FWM1.IP"
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let hour: (Int) -> Date = { start.addingTimeInterval(TimeInterval($0 * 3_600)) }
+
+        // Markets with no stored prices (not even a price table) return no prices.
+        XCTAssertTrue(database.prices.getLast(10, epic: epic).expectsOne(timeout: 0.5, on: self).isEmpty)
+
+        database.markets.update(try Self._market(epic: epic, expiry: "2020-09-14T02:30:00")).expectsCompletion(timeout: 0.5, on: self)
+        database.prices.update(try (0..<6).map { try Self._price(date: hour($0), open: 100 + $0, close: 101 + $0) }, epic: epic)
+            .expectsCompletion(timeout: 0.5, on: self)
+
+        // The newest prices are returned sorted by date (oldest first).
+        XCTAssertEqual(database.prices.getLast(2, epic: epic).expectsOne(timeout: 0.5, on: self).map { $0.date }, [hour(4), hour(5)])
+        XCTAssertEqual(database.prices.getLast(10, epic: epic).expectsOne(timeout: 0.5, on: self).map { $0.date }, (0..<6).map(hour))
+        // The date bound is inclusive and applied before the count.
+        XCTAssertEqual(database.prices.getLast(10, epic: epic, from: hour(3)).expectsOne(timeout: 0.5, on: self).map { $0.date }, [hour(3), hour(4), hour(5)])
+        XCTAssertEqual(database.prices.getLast(1, epic: epic, from: hour(3)).expectsOne(timeout: 0.5, on: self).map { $0.date }, [hour(5)])
+        XCTAssertTrue(database.prices.getLast(10, epic: epic, from: hour(6)).expectsOne(timeout: 0.5, on: self).isEmpty)
+    }
+}
+
+private extension DBPricesContinuousTests {
+    /// Decodes an index market whose current contract expires at the given date (in `yyyy-MM-ddTHH:mm:ss` UTC format).
+    static func _market(epic: IG.Market.Epic, expiry: String) throws -> API.Market {
+        let json = """
+        {
+            "instrument": {
+                "epic": "\(epic)", "name": "FTSE 100", "type": "INDICES", "unit": "CONTRACTS",
+                "expiry": "\(expiry)", "expiryDetails": null,
+                "currencies": [{ "code": "GBP", "symbol": "£", "baseExchangeRate": 1, "exchangeRate": 1, "isDefault": true }],
+                "lotSize": 1, "contractSize": "1",
+                "forceOpenAllowed": true, "controlledRiskAllowed": false, "stopsLimitsAllowed": true, "streamingPricesAvailable": true,
+                "marginFactor": 5, "marginFactorUnit": "PERCENTAGE",
+                "marginDepositBands": [{ "currency": "GBP", "margin": 5, "min": 0, "max": null }],
+                "slippageFactor": { "unit": "pct", "value": 50 },
+                "limitedRiskPremium": { "value": 1, "unit": "POINTS" },
+                "newsCode": "FTSE",
+                "sprintMarketsMinimumExpiryTime": null, "sprintMarketsMaximumExpiryTime": null
+            },
+            "dealingRules": {
+                "marketOrderPreference": "AVAILABLE_DEFAULT_ON",
+                "minDealSize": { "value": 1, "unit": "POINTS" },
+                "minNormalStopOrLimitDistance": { "value": 2, "unit": "POINTS" },
+                "maxStopOrLimitDistance": { "value": 500, "unit": "POINTS" },
+                "minControlledRiskStopDistance": { "value": 5, "unit": "POINTS" },
+                "minStepDistance": { "value": 1, "unit": "POINTS" },
+                "trailingStopsPreference": "NOT_AVAILABLE"
+            },
+            "snapshot": {
+                "updateTime": "10:00:00", "delayTime": 0, "marketStatus": "TRADEABLE",
+                "bid": 120, "offer": 122, "high": 123, "low": 119, "netChange": 1, "percentageChange": 0.8,
+                "scalingFactor": 1, "decimalPlacesFactor": 0, "controlledRiskExtraSpread": 1
+            }
+        }
+        """
+        let decoder = JSONDecoder()
+        decoder.userInfo[API.JSON.DecoderKey.responseDate] = Date()
+        return try decoder.decode(API.Market.self, from: Data(json.utf8))
+    }
+
+    /// Decodes an hourly candle whose bid and ask are one point apart from the given mid prices.
+    static func _price(date: Date, open: Int, close: Int) throws -> API.Price {
+        let point: (Int) -> String = { #"{ "bid": \#($0 - 1), "ask": \#($0 + 1) }"# }
+        let json = """
+        {
+            "snapshotTimeUTC": "\(DateFormatter.iso8601Broad.string(from: date))",
+            "openPrice": \(point(open)), "closePrice": \(point(close)),
+            "highPrice": \(point(max(open, close))), "lowPrice": \(point(min(open, close))),
+            "lastTradedVolume": 10
+        }
+        """
+        return try JSONDecoder().decode(API.Price.self, from: Data(json.utf8))
+    }
+}
+#endif
@@ -0,0 +1,158 @@
+#if DEBUG
+@testable import IG
+import Combine
+import ConbiniForTesting
+import XCTest
+
+final class DBPricesReplayTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the merge order of several epics read in batches smaller than their stored prices, and the virtual clock advancing with them.
+    func testMergeOrder() throws {
+        let database = try Database(location: .memory)
+        let (eurgbp, eurusd): (IG.Market.Epic, IG.Market.Epic) = ("CS.D.EURGBP.MINI.IP", "CS.D.EURUSD.MINI.IP")
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let minute: (Int) -> Date = { start.addingTimeInterval(TimeInterval($0 * 60)) }
+        try Self._store(epic: eurgbp, dates: [0, 1, 2, 3, 4].map(minute), on: database, test: self)
+        try Self._store(epic: eurusd, dates: [1, 3, 5].map(minute), on: database, test: self)
+
+        let clock = VirtualClock(start: start.addingTimeInterval(-60))
+        var events: [String] = []
+        let timer = clock.schedule(at: minute(2).addingTimeInterval(30), on: DispatchQueue(label: "replay.timer")) { events.append("timer") }
+        defer { timer.cancel() }
+
+        // The batch size forces every epic to be read ahead several times (its prices span multiple batches).
+        let replay = database.prices.replay(epics: [eurusd, eurgbp], speed: .maximum, batchSize: 2, clock: clock)
+        let candles = replay.publisher
+            .handleEvents(receiveOutput: {
+                XCTAssertEqual(clock.now, $0.candle.date)
+                events.append("\($0.epic)@\(Int($0.candle.date.timeIntervalSince(start) / 60))")
+            }).expectsAll(timeout: 1, on: self)
+
+        // Equal dates are emitted in epic order.
+        XCTAssertEqual(candles.map { $0.epic }, [eurgbp, eurgbp, eurusd, eurgbp, eurgbp, eurusd, eurgbp, eurusd])
+        XCTAssertEqual(candles.map { $0.candle.date }, [0, 1, 1, 2, 3, 3, 4, 5].map(minute))
+        XCTAssertEqual(events, ["\(eurgbp)@0", "\(eurgbp)@1", "\(eurusd)@1", "\(eurgbp)@2", "timer", "\(eurgbp)@3", "\(eurusd)@3", "\(eurgbp)@4", "\(eurusd)@5"])
+        XCTAssertEqual(replay.date, minute(5))
+        XCTAssertEqual(clock.now, minute(5))
+    }
+
+    /// Tests that a bounded date range is honored across batch boundaries.
+    func testDateRange() throws {
+        let database = try Database(location: .memory)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let minute: (Int) -> Date = { start.addingTimeInterval(TimeInterval($0 * 60)) }
+        try Self._store(epic: epic, dates: (0..<10).map(minute), on: database, test: self)
+
+        let candles = database.prices.replay(epics: [epic], from: minute(2), to: minute(7), speed: .maximum, batchSize: 2)
+            .publisher.expectsAll(timeout: 1, on: self)
+        XCTAssertEqual(candles.map { $0.candle.date }, (2...7).map(minute))
+    }
+
+    /// Tests that the prices are paced against the wall clock at the given speed.
+    func testPacing() throws {
+        let database = try Database(location: .memory)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        // Three prices a minute apart replayed 600 times faster take 0.2 seconds (the first one is emitted right away).
+        try Self._store(epic: epic, dates: (0..<3).map { start.addingTimeInterval(TimeInterval($0 * 60)) }, on: database, test: self)
+
+        var arrivals: [DispatchTime] = []
+        let candles = database.prices.replay(epics: [epic], speed: .multiplied(600), batchSize: 2).publisher
+            .handleEvents(receiveOutput: { _ in arrivals.append(.now()) })
+            .expectsAll(timeout: 2, on: self)
+        XCTAssertEqual(candles.count, 3)
+
+        let elapsed = zip(arrivals.dropFirst(), arrivals).map { Double($0.uptimeNanoseconds - $1.uptimeNanoseconds) / 1_000_000_000 }
+        for interval in elapsed { XCTAssertGreaterThanOrEqual(interval, 0.09) }
+        XCTAssertGreaterThanOrEqual(Double(arrivals.last!.uptimeNanoseconds - arrivals.first!.uptimeNanoseconds) / 1_000_000_000, 0.19)
+    }
+
+    #if compiler(>=5.7) && canImport(_Concurrency)
+    /// Tests that the `async` price cursor reads the stored prices in batches (honoring the date range) and ends on missing tables.
+    func testAsyncCursor() async throws {
+        let database = try Database(location: .memory)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let minute: (Int) -> Date = { start.addingTimeInterval(TimeInterval($0 * 60)) }
+
+        var dates: [Date] = []
+        for try await price in database.prices.getCursor(epic: epic, batchSize: 10) { dates.append(price.date) }
+        XCTAssertTrue(dates.isEmpty)
+
+        try await database.markets.update(try Self._market(epic: epic))
+        try await database.prices.update(try (0..<7).map { try Self._price(date: minute($0)) }, epic: epic)
+
+        // The last batch is partially filled.
+        for try await price in database.prices.getCursor(epic: epic, batchSize: 2) { dates.append(price.date) }
+        XCTAssertEqual(dates, (0..<7).map(minute))
+        // The range covers exactly two full batches.
+        dates.removeAll()
+        for try await price in database.prices.getCursor(epic: epic, from: minute(1), to: minute(4), batchSize: 2) { dates.append(price.date) }
+        XCTAssertEqual(dates, (1...4).map(minute))
+    }
+    #endif
+}
+
+private extension DBPricesReplayTests {
+    /// Stores the given market and a flat price for every given date.
+    static func _store(epic: IG.Market.Epic, dates: [Date], on database: Database, test: XCTestCase) throws {
+        database.markets.update(try Self._market(epic: epic)).expectsCompletion(timeout: 0.5, on: test)
+        database.prices.update(try dates.map { try Self._price(date: $0) }, epic: epic).expectsCompletion(timeout: 0.5, on: test)
+    }
+
+    /// Decodes an undated (daily funded bet) currency market.
+    static func _market(epic: IG.Market.Epic) throws -> API.Market {
+        let json = """
+        {
+            "instrument": {
+                "epic": "\(epic)", "name": "Mini", "type": "CURRENCIES", "unit": "CONTRACTS",
+                "expiry": "-", "expiryDetails": null,
+                "currencies": [{ "code": "USD", "symbol": "$", "baseExchangeRate": 1, "exchangeRate": 1, "isDefault": true }],
+                "lotSize": 1, "contractSize": "1",
+                "forceOpenAllowed": true, "controlledRiskAllowed": false, "stopsLimitsAllowed": true, "streamingPricesAvailable": true,
+                "marginFactor": 1, "marginFactorUnit": "PERCENTAGE",
+                "marginDepositBands": [{ "currency": "USD", "margin": 1, "min": 0, "max": null }],
+                "slippageFactor": { "unit": "pct", "value": 50 },
+                "limitedRiskPremium": { "value": 1, "unit": "POINTS" },
+                "newsCode": "FX",
+                "sprintMarketsMinimumExpiryTime": null, "sprintMarketsMaximumExpiryTime": null
+            },
+            "dealingRules": {
+                "marketOrderPreference": "AVAILABLE_DEFAULT_ON",
+                "minDealSize": { "value": 1, "unit": "POINTS" },
+                "minNormalStopOrLimitDistance": { "value": 2, "unit": "POINTS" },
+                "maxStopOrLimitDistance": { "value": 500, "unit": "POINTS" },
+                "minControlledRiskStopDistance": { "value": 5, "unit": "POINTS" },
+                "minStepDistance": { "value": 1, "unit": "POINTS" },
+                "trailingStopsPreference": "NOT_AVAILABLE"
+            },
+            "snapshot": {
+                "updateTime": "10:00:00", "delayTime": 0, "marketStatus": "TRADEABLE",
+                "bid": 120, "offer": 122, "high": 123, "low": 119, "netChange": 1, "percentageChange": 0.8,
+                "scalingFactor": 1, "decimalPlacesFactor": 0, "controlledRiskExtraSpread": 1
+            }
+        }
+        """
+        let decoder = JSONDecoder()
+        decoder.userInfo[API.JSON.DecoderKey.responseDate] = Date()
+        return try decoder.decode(API.Market.self, from: Data(json.utf8))
+    }
+
+    /// Decodes a flat one minute candle for the given date.
+    static func _price(date: Date) throws -> API.Price {
+        let point = #"{ "bid": 120, "ask": 122 }"#
+        let json = """
+        {
+            "snapshotTimeUTC": "\(DateFormatter.iso8601Broad.string(from: date))",
+            "openPrice": \(point), "closePrice": \(point), "highPrice": \(point), "lowPrice": \(point),
+            "lastTradedVolume": 10
+        }
+        """
+        return try JSONDecoder().decode(API.Price.self, from: Data(json.utf8))
+    }
+}
+#endif
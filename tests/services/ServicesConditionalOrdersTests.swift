@@ -0,0 +1,148 @@
+import IG
+import Combine
+import ConbiniForTesting
+import Decimals
+import XCTest
+
+final class ServicesConditionalOrdersTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests a bracket: the entry order triggers and arms a take-profit and a stop-loss order (one-cancels-other).
+    func testBracketExecution() {
+        let (simulator, api) = Self._makeAPI(on: self)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let manager = Services.ConditionalOrders(api: api)
+
+        var (triggered, cancelled) = (0, 0)
+        var executed: [UUID] = []
+        var expectation = self.expectation(description: "Entry executed")
+        let cancellable = manager.events.receive(on: DispatchQueue.main).sink {
+            switch $0 {
+            case .triggered: triggered += 1
+            case .cancelled: cancelled += 1
+            case .executed(let order, _): executed.append(order.id); expectation.fulfill()
+            case .rejected(_, _, let reason): XCTFail("Unexpected rejection: \(String(describing: reason))")
+            case .failed(_, let error): XCTFail("Unexpected failure: \(error)")
+            }
+        }
+        defer { cancellable.cancel() }
+
+        let entry = Services.ConditionalOrders.Trigger(epic: epic, side: .ask, level: Decimal64(11012, power: -4)!, direction: .above)
+        let bracket = Services.ConditionalOrders.Group.bracket(entry: entry, currency: "USD", direction: .buy, size: 1,
+                                                               takeProfit: Decimal64(11030, power: -4)!, stopLoss: Decimal64(10990, power: -4)!)
+        manager.submit(bracket)
+        XCTAssertEqual(manager.armedOrders.count, 1)
+
+        // 1. Prices below the entry level don't trigger anything.
+        Self._quote(epic: epic, bid: 11000, ask: 11002, simulator: simulator, manager: manager)
+        XCTAssertEqual(manager.armedOrders.count, 1)
+
+        // 2. The entry triggers, opens a position, and arms its contingent orders.
+        Self._quote(epic: epic, bid: 11010, ask: 11012, simulator: simulator, manager: manager)
+        self.wait(for: [expectation], timeout: 1)
+        XCTAssertEqual(executed, [bracket.orders[0].id])
+        XCTAssertEqual(simulator.positions.count, 1)
+        XCTAssertEqual(manager.armedOrders.count, 2)
+
+        // 3. The take-profit triggers, closing the position and disarming the stop-loss.
+        expectation = self.expectation(description: "Take profit executed")
+        Self._quote(epic: epic, bid: 11030, ask: 11032, simulator: simulator, manager: manager)
+        self.wait(for: [expectation], timeout: 1)
+        XCTAssertEqual(executed.count, 2)
+        XCTAssertEqual(executed.last, bracket.orders[0].then!.orders[0].id)
+        XCTAssertEqual(triggered, 2)
+        XCTAssertEqual(cancelled, 1)
+        XCTAssertTrue(manager.armedOrders.isEmpty)
+        XCTAssertTrue(simulator.positions.isEmpty)
+    }
+
+    /// Tests that user cancellation disarms a one-cancels-other group and that failing deal calls are reported.
+    func testCancellationAndFailure() {
+        let (simulator, api) = Self._makeAPI(on: self)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let manager = Services.ConditionalOrders(api: api)
+
+        var failed: [UUID] = []
+        let expectation = self.expectation(description: "Order failed")
+        let cancellable = manager.events.receive(on: DispatchQueue.main).sink {
+            guard case .failed(let order, _) = $0 else { return }
+            failed.append(order.id)
+            expectation.fulfill()
+        }
+        defer { cancellable.cancel() }
+
+        let above = Services.ConditionalOrders.Trigger(epic: epic, side: .bid, level: Decimal64(11050, power: -4)!, direction: .above)
+        let below = Services.ConditionalOrders.Trigger(epic: epic, side: .bid, level: Decimal64(10950, power: -4)!, direction: .below)
+        let close = Services.ConditionalOrders.Action.closePosition(matchedBy: .identifier("DIAAAANOTFOUND"), direction: .sell, size: 1)
+        let group = Services.ConditionalOrders.Group.oneCancelsOther([.init(trigger: above, action: close), .init(trigger: below, action: close)])
+        manager.submit(group)
+        XCTAssertEqual(manager.armedOrders.count, 2)
+        XCTAssertEqual(manager.cancel(group: group.id).count, 2)
+        XCTAssertTrue(manager.armedOrders.isEmpty)
+
+        // An invalid deal size makes the call fail synchronously (before reaching the server).
+        let invalid = Services.ConditionalOrders.Order(trigger: above, action: .createPosition(expiry: .none, currency: "USD", direction: .buy, size: 0, limit: nil, stop: nil))
+        manager.submit(.ifTouched(invalid))
+        Self._quote(epic: epic, bid: 11050, ask: 11052, simulator: simulator, manager: manager)
+        self.wait(for: [expectation], timeout: 1)
+        XCTAssertEqual(failed, [invalid.id])
+        XCTAssertTrue(manager.armedOrders.isEmpty)
+        XCTAssertTrue(simulator.positions.isEmpty)
+    }
+
+    /// Tests that one-cancels-other siblings are only cancelled once the triggered deal is accepted (and re-armed if it is rejected).
+    func testRejectionRearmsSiblings() {
+        let (simulator, api) = Self._makeAPI(on: self)
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let manager = Services.ConditionalOrders(api: api)
+
+        var (rejected, cancelled) = ([UUID](), 0)
+        let expectation = self.expectation(description: "Order rejected")
+        let cancellable = manager.events.receive(on: DispatchQueue.main).sink {
+            switch $0 {
+            case .triggered: break
+            case .cancelled: cancelled += 1
+            case .rejected(let order, _, let reason): rejected.append(order.id); XCTAssertEqual(reason, .positionNotFound); expectation.fulfill()
+            case .executed(let order, _): XCTFail("Unexpected execution of \(order.id)")
+            case .failed(_, let error): XCTFail("Unexpected failure: \(error)")
+            }
+        }
+        defer { cancellable.cancel() }
+
+        // The take-profit closes an unknown position; thus, the server accepts the request but rejects the deal.
+        let above = Services.ConditionalOrders.Trigger(epic: epic, side: .bid, level: Decimal64(11050, power: -4)!, direction: .above)
+        let below = Services.ConditionalOrders.Trigger(epic: epic, side: .bid, level: Decimal64(10950, power: -4)!, direction: .below)
+        let close = Services.ConditionalOrders.Action.closePosition(matchedBy: .identifier("DIAAAANOTFOUND"), direction: .sell, size: 1)
+        let (profit, loss) = (Services.ConditionalOrders.Order(trigger: above, action: close), Services.ConditionalOrders.Order(trigger: below, action: close))
+        let group = Services.ConditionalOrders.Group.oneCancelsOther([profit, loss])
+        manager.submit(group)
+
+        Self._quote(epic: epic, bid: 11050, ask: 11052, simulator: simulator, manager: manager)
+        self.wait(for: [expectation], timeout: 1)
+        // The sibling was suspended (never cancelled) while the triggered deal was being confirmed.
+        XCTAssertEqual(rejected, [profit.id])
+        XCTAssertEqual(cancelled, 0)
+        XCTAssertEqual(manager.armedOrders.map { $0.id }, [loss.id])
+        // The re-armed sibling still belongs to its group.
+        XCTAssertEqual(manager.cancel(group: group.id).map { $0.id }, [loss.id])
+    }
+}
+
+private extension ServicesConditionalOrdersTests {
+    /// Creates an API instance logged into an in-process simulator.
+    static func _makeAPI(on test: XCTestCase) -> (API.Simulator, API) {
+        let simulator = API.Simulator(funds: 10_000)
+        let api = API(simulator: simulator)
+        api.session.login(type: .oauth, key: "0123456789abcdef0123456789abcdef01234567", user: ["simulated", "password"]).expectsCompletion(timeout: 1, on: test)
+        return (simulator, api)
+    }
+
+    /// Quotes the given prices (in ten-thousandths) on the simulator and feeds them to the manager.
+    static func _quote(epic: IG.Market.Epic, bid: Int, ask: Int, simulator: API.Simulator, manager: Services.ConditionalOrders) {
+        let (bid, ask) = (Decimal64(bid, power: -4)!, Decimal64(ask, power: -4)!)
+        simulator.update(epic: epic, bid: bid, ask: ask)
+        manager.evaluate(epic: epic, bid: bid, ask: ask)
+    }
+}
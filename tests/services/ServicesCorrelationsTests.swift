@@ -0,0 +1,38 @@
+import IG
+import Decimals
+import XCTest
+
+final class ServicesCorrelationsTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the rolling correlations of perfectly (anti)correlated markets across matrix shards.
+    func testRollingCorrelations() {
+        let (a, b, c): (IG.Market.Epic, IG.Market.Epic, IG.Market.Epic) = ("CS.D.EURUSD.MINI.IP", "CS.D.GBPUSD.MINI.IP", "CS.D.USDJPY.MINI.IP")
+        let engine = Services.Correlations(epics: [a, b, c], window: 5, shards: 2)
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+
+        for step in 0..<20 {
+            let date = start.addingTimeInterval(TimeInterval(step * 60))
+            let price = 100 + (step * 7) % 5
+            engine.update(epic: a, date: date, close: Decimal64(price, power: 0)!)
+            engine.update(epic: c, date: date, close: Decimal64(10_000_000_000 / price, power: -8)!)
+            engine.update(epic: b, date: date, close: Decimal64(2 * price, power: 0)!)
+        }
+        XCTAssertEqual(engine.count, 5)
+
+        let snapshot = engine.snapshot()
+        XCTAssertEqual(snapshot.count, 5)
+        XCTAssertEqual(snapshot.date, start.addingTimeInterval(19 * 60))
+        XCTAssertEqual(snapshot.correlation(a, a)!, 1, accuracy: 1e-9)
+        XCTAssertEqual(snapshot.correlation(a, b)!, 1, accuracy: 1e-9)
+        XCTAssertEqual(snapshot.correlation(b, c)!, -1, accuracy: 1e-6)
+        XCTAssertEqual(snapshot.covariance(a, b)!, snapshot.covariance(a, a)!, accuracy: 1e-12)
+
+        // A market reporting a later bar completes the pending one (forward-filling the missing markets).
+        engine.update(epic: a, date: start.addingTimeInterval(20 * 60), close: Decimal64(101, power: 0)!)
+        engine.update(epic: a, date: start.addingTimeInterval(21 * 60), close: Decimal64(101, power: 0)!)
+        XCTAssertEqual(engine.snapshot().date, start.addingTimeInterval(20 * 60))
+    }
+}
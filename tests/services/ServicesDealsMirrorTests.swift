@@ -0,0 +1,46 @@
+import IG
+import Combine
+import ConbiniForTesting
+import XCTest
+
+final class ServicesDealsMirrorTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that the mirror is seeded with the same positions and working orders returned by the API.
+    func testMirrorSeed() throws {
+        let api = API()
+        api.session.login(type: .certificate, key: "<#API key#>", user: ["<#Username#>", "<#Password#>"]).expectsCompletion(timeout: 1.2, on: self)
+
+        let creds = (api: try XCTUnwrap(api.session.credentials), streamer: try Streamer.Credentials(api.session.credentials))
+        let streamer = Streamer(rootURL: creds.api.streamerURL, credentials: creds.streamer)
+
+        streamer.session.connect().expectsCompletion(timeout: 2, on: self)
+        XCTAssertTrue(streamer.session.status.isReady)
+
+        let positions = api.deals.getPositions().expectsOne(timeout: 2, on: self)
+        let workingOrders = api.deals.getWorkingOrders().expectsOne(timeout: 2, on: self)
+
+        let mirror = Services.DealsMirror(api: api, streamer: streamer, account: creds.api.account, reconciliationInterval: nil)
+        let seeded = mirror.events.first().map { (event) -> [Services.DealsMirror.Deal] in
+            guard case .seeded(let deals) = event else { return [] }
+            return deals
+        }
+        mirror.start()
+
+        let deals = seeded.expectsOne(timeout: 3, on: self)
+        XCTAssertTrue(mirror.isReady)
+        XCTAssertEqual(deals.count, positions.count + workingOrders.count)
+        XCTAssertEqual(mirror.positions().count, positions.count)
+        XCTAssertEqual(mirror.workingOrders().count, workingOrders.count)
+        for position in positions {
+            XCTAssertEqual(mirror.deal(id: position.id)?.epic, position.epic)
+            XCTAssertTrue(mirror.deals(epic: position.epic, direction: position.direction).contains { $0.id == position.id })
+        }
+
+        mirror.stop()
+        streamer.session.disconnect().expectsOne(timeout: 2, on: self)
+        XCTAssertEqual(streamer.session.status, .disconnected(isRetrying: false))
+    }
+}
@@ -0,0 +1,105 @@
+#if DEBUG
+@testable import IG
+import ConbiniForTesting
+import Decimals
+import XCTest
+
+final class ServicesRiskEngineTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the pre-trade checks against cached dealing rules and user-defined limits.
+    func testRuleChecks() throws {
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let engine = Services.RiskEngine(api: API(), limits: .init(maximumDealSize: 5, maximumExposure: 3))
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: nil, stop: nil))
+
+        engine.update(markets: [try Self._market(epic: epic)])
+        XCTAssertNoThrow(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: .distance(10), stop: .distance(10, risk: .exposed)))
+        XCTAssertEqual(engine.requiredMargin(epic: epic, size: 2, level: Decimal64(11000, power: -4)!), Decimal64(22, power: -3)!)
+
+        // Deal sizes (market minimum and user-defined maximum).
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: Decimal64(1, power: -1)!, limit: nil, stop: nil))
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 6, limit: nil, stop: nil))
+        // Limit and stop distances.
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: .distance(1), stop: nil))
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: .distance(600), stop: nil))
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: nil, stop: .distance(1, risk: .exposed)))
+        XCTAssertNoThrow(try engine.checkWorkingOrder(epic: epic, direction: .sell, size: 1, level: Decimal64(11100, power: -4)!, limit: .distance(10), stop: .distance(20, risk: .exposed)))
+        // Guaranteed and trailing stops are not allowed on this market.
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: nil, stop: .distance(10, risk: .limited)))
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: nil, stop: .trailing(distance: 10, increment: 1)))
+        // Exposure (only applied to deals increasing it).
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .sell, order: .market, size: 4, limit: nil, stop: nil))
+        XCTAssertEqual(engine.exposure(epic: epic), .zero)
+    }
+
+    /// Tests that positions sent through the engine reserve their exposure and position slot right away (and release them if the deal call fails).
+    func testReservations() throws {
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let simulator = API.Simulator(funds: 10_000)
+        simulator.update(epic: epic, bid: Decimal64(11000, power: -4)!, ask: Decimal64(11002, power: -4)!)
+        let api = API(simulator: simulator)
+        let engine = Services.RiskEngine(api: api, limits: .init(maximumExposure: 3, maximumPositions: 1))
+        engine.update(markets: [try Self._market(epic: epic)])
+
+        // The deal call fails (there are no credentials); thus, the reservation is reverted.
+        engine.createPosition(epic: epic, currency: "USD", direction: .buy, order: .market, strategy: .execute, size: 2, limit: nil, stop: nil)
+            .expectsFailure(timeout: 1, on: self)
+        XCTAssertEqual(engine.exposure(epic: epic), .zero)
+
+        api.session.login(type: .oauth, key: "0123456789abcdef0123456789abcdef01234567", user: ["simulated", "password"]).expectsCompletion(timeout: 1, on: self)
+        engine.createPosition(epic: epic, currency: "USD", direction: .buy, order: .market, strategy: .execute, size: 2, limit: nil, stop: nil)
+            .expectsOne(timeout: 1, on: self)
+        // Later orders are checked against the reserved exposure and position count (without refreshing the engine).
+        XCTAssertEqual(engine.exposure(epic: epic), Decimal64(2, power: 0)!)
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 2, limit: nil, stop: nil))
+        XCTAssertThrowsError(try engine.checkPosition(epic: epic, direction: .buy, order: .market, size: 1, limit: nil, stop: nil))
+        XCTAssertNoThrow(try engine.checkPosition(epic: epic, direction: .sell, order: .market, size: 1, limit: nil, stop: nil))
+
+        // Server values supersede the reservations.
+        engine.update(positions: [])
+        XCTAssertEqual(engine.exposure(epic: epic), .zero)
+    }
+}
+
+private extension ServicesRiskEngineTests {
+    /// Decodes a currency market whose dealing rules allow non-guaranteed stops and limits between 2 and 500 points, and minimum deals of 0.5 contracts.
+    static func _market(epic: IG.Market.Epic) throws -> API.Market {
+        let json = """
+        {
+            "instrument": {
+                "epic": "\(epic)", "name": "EUR/USD Mini", "type": "CURRENCIES", "unit": "CONTRACTS",
+                "currencies": [{ "code": "USD", "symbol": "$", "baseExchangeRate": 1, "exchangeRate": 1, "isDefault": true }],
+                "lotSize": 1, "contractSize": "1",
+                "forceOpenAllowed": true, "controlledRiskAllowed": false, "stopsLimitsAllowed": true, "streamingPricesAvailable": true,
+                "marginFactor": 1, "marginFactorUnit": "PERCENTAGE",
+                "marginDepositBands": [{ "currency": "USD", "margin": 1, "min": 0, "max": null }],
+                "slippageFactor": { "unit": "pct", "value": 50 },
+                "limitedRiskPremium": { "value": 1, "unit": "POINTS" },
+                "newsCode": "EURUSD",
+                "sprintMarketsMinimumExpiryTime": null, "sprintMarketsMaximumExpiryTime": null
+            },
+            "dealingRules": {
+                "marketOrderPreference": "AVAILABLE_DEFAULT_ON",
+                "minDealSize": { "value": 0.5, "unit": "POINTS" },
+                "minNormalStopOrLimitDistance": { "value": 2, "unit": "POINTS" },
+                "maxStopOrLimitDistance": { "value": 500, "unit": "POINTS" },
+                "minControlledRiskStopDistance": { "value": 5, "unit": "POINTS" },
+                "minStepDistance": { "value": 1, "unit": "POINTS" },
+                "trailingStopsPreference": "NOT_AVAILABLE"
+            },
+            "snapshot": {
+                "updateTime": "10:00:00", "delayTime": 0, "marketStatus": "TRADEABLE",
+                "bid": 1.1000, "offer": 1.1002, "high": 1.1050, "low": 1.0950, "netChange": 0.001, "percentageChange": 0.09,
+                "scalingFactor": 1, "decimalPlacesFactor": 4, "controlledRiskExtraSpread": 1
+            }
+        }
+        """
+        let decoder = JSONDecoder()
+        decoder.userInfo[API.JSON.DecoderKey.responseDate] = Date()
+        return try decoder.decode(API.Market.self, from: Data(json.utf8))
+    }
+}
+#endif
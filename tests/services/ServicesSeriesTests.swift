@@ -0,0 +1,53 @@
+#if DEBUG
+@testable import IG
+import Decimals
+import XCTest
+
+final class ServicesSeriesTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the stitching of cached, gap, and live candles into a single ordered sequence without duplicates.
+    func testSeriesStitching() {
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let candle: (_ minute: Int, _ isFinished: Bool) -> Streamer.Chart.Aggregated = { (minute, isFinished) in
+            typealias A = Streamer.Chart.Aggregated
+            let point = A.Point(bid: Decimal64(minute, power: 0)!, ask: Decimal64(minute + 1, power: 0)!)
+            let candle = A.Candle(date: start.addingTimeInterval(TimeInterval(minute * 60)), numTicks: 1, isFinished: isFinished,
+                                  open: point, close: point, lowest: point, highest: point)
+            let day = A.Day(lowest: nil, mid: nil, highest: nil, changeNet: nil, changePercentage: nil)
+            return A(epic: "CS.D.EURUSD.MINI.IP", interval: .minute, candle: candle, day: day)
+        }
+        let minutes: ([Streamer.Chart.Aggregated]) -> [Int] = { $0.map { Int($0.candle.date!.timeIntervalSince(start) / 60) } }
+
+        let stitcher = _SeriesStitcher(partial: false)
+        // Cached candles are forwarded straight away.
+        XCTAssertEqual(minutes(stitcher.process(.history([candle(0, true), candle(1, true)]))), [0, 1])
+        // Live candles are buffered during the historical phase.
+        XCTAssertTrue(stitcher.process(.live(candle(1, true))).isEmpty)
+        XCTAssertTrue(stitcher.process(.live(candle(3, true))).isEmpty)
+        // The gap ends the historical phase: duplicates are dropped and the buffered candles are flushed in order.
+        XCTAssertEqual(minutes(stitcher.process(.gap([candle(1, true), candle(2, true)]))), [2, 3])
+        // Live phase: unfinished and already forwarded candles are dropped.
+        XCTAssertTrue(stitcher.process(.live(candle(4, false))).isEmpty)
+        XCTAssertTrue(stitcher.process(.live(candle(3, true))).isEmpty)
+        XCTAssertEqual(minutes(stitcher.process(.live(candle(4, true)))), [4])
+
+        let partial = _SeriesStitcher(partial: true)
+        XCTAssertTrue(partial.process(.gap([])).isEmpty)
+        XCTAssertEqual(minutes(partial.process(.live(candle(0, false)))), [0])
+        XCTAssertEqual(minutes(partial.process(.live(candle(0, true)))), [0])
+        XCTAssertTrue(partial.process(.live(candle(0, false))).isEmpty)
+    }
+
+    /// Tests that the historical gap stops at the start of the ongoing interval (whose candle is still in progress).
+    func testGapEnd() {
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        XCTAssertEqual(Streamer.Chart.Aggregated.Interval.minute._start(for: start.addingTimeInterval(90)), start.addingTimeInterval(60))
+        XCTAssertEqual(Streamer.Chart.Aggregated.Interval.minute._start(for: start.addingTimeInterval(60)), start.addingTimeInterval(60))
+        XCTAssertEqual(Streamer.Chart.Aggregated.Interval.minute5._start(for: start.addingTimeInterval(599)), start.addingTimeInterval(300))
+        XCTAssertEqual(Streamer.Chart.Aggregated.Interval.hour._start(for: start.addingTimeInterval(3_599)), start)
+    }
+}
+#endif
@@ -0,0 +1,61 @@
+import IG
+import Combine
+import Decimals
+import XCTest
+
+final class StreamerAlertEngineTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that alerts fire once (and only once) when the price reaches their levels.
+    func testAlertFiring() {
+        typealias Alert = Streamer.AlertEngine<Int>.Alert
+        let epic: IG.Market.Epic = "CS.D.EURUSD.MINI.IP"
+        let engine = Streamer.AlertEngine<Int>()
+
+        engine.add((0..<100).map { Alert(id: $0, epic: epic, side: .bid, level: Decimal64($0, power: 0)!, direction: .above) })
+        engine.add((100..<200).map { Alert(id: $0, epic: epic, side: .ask, level: Decimal64($0 - 100, power: 0)!, direction: .below) })
+        XCTAssertEqual(engine.count, 200)
+
+        let rising = engine.evaluate(epic: epic, bid: 10, ask: nil)
+        XCTAssertEqual(rising.map { $0.alert.id }, Array(0...10))
+        XCTAssertTrue(engine.evaluate(epic: epic, bid: 10, ask: nil).isEmpty)
+
+        let falling = engine.evaluate(epic: epic, bid: nil, ask: 95)
+        XCTAssertEqual(falling.map { $0.alert.id }, Array((195..<200).reversed()))
+        XCTAssertEqual(engine.count, 200 - 11 - 5)
+
+        let removed = engine.remove(ids: [50, 150, 199])
+        XCTAssertEqual(Set(removed.map { $0.id }), [50, 150])
+        XCTAssertNil(engine.alert(id: 50))
+        XCTAssertEqual(engine.count, 200 - 11 - 5 - 2)
+    }
+
+    /// Tests that alerts sharing an identifier within a single batch collapse into the last one.
+    func testDuplicateIdentifiers() {
+        typealias Alert = Streamer.AlertEngine<Int>.Alert
+        let (eurusd, gbpusd): (IG.Market.Epic, IG.Market.Epic) = ("CS.D.EURUSD.MINI.IP", "CS.D.GBPUSD.MINI.IP")
+        let engine = Streamer.AlertEngine<Int>()
+
+        engine.add([
+            Alert(id: 1, epic: eurusd, side: .bid, level: 10, direction: .above),
+            Alert(id: 2, epic: eurusd, side: .ask, level: 5, direction: .below),
+            Alert(id: 1, epic: eurusd, side: .bid, level: 20, direction: .above),
+            Alert(id: 2, epic: gbpusd, side: .ask, level: 5, direction: .below)
+        ])
+        XCTAssertEqual(engine.count, 2)
+        XCTAssertEqual(engine.alert(id: 1)?.level, 20)
+        XCTAssertEqual(engine.alert(id: 2)?.epic, gbpusd)
+
+        // The superseded alerts must not be left behind in the level books.
+        XCTAssertTrue(engine.evaluate(epic: eurusd, bid: 15, ask: 1).isEmpty)
+        XCTAssertEqual(engine.count, 2)
+
+        let fired = engine.evaluate(epic: eurusd, bid: 25, ask: nil)
+        XCTAssertEqual(fired.map { $0.alert.id }, [1])
+        XCTAssertEqual(fired.first?.alert.level, 20)
+        XCTAssertEqual(engine.evaluate(epic: gbpusd, bid: nil, ask: 5).map { $0.alert.id }, [2])
+        XCTAssertEqual(engine.count, 0)
+    }
+}
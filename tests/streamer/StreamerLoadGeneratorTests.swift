@@ -0,0 +1,45 @@
+import IG
+import Combine
+import ConbiniForTesting
+import XCTest
+
+final class StreamerLoadGeneratorTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that every synthetic update kind is decoded and measured through a pass-through pipeline.
+    func testPassThroughLoad() {
+        let configuration = Streamer.LoadGenerator.Configuration(epics: 50, rate: 2_000, burst: 10, kinds: Set(Streamer.LoadGenerator.Kind.allCases))
+        let generator = Streamer.LoadGenerator(configuration: configuration)
+
+        // Combine requires serial delivery; a concurrent queue would interleave the downstream events.
+        let queue = DispatchQueue(label: "Load pipeline queue")
+        let report = generator.measure(duration: 0.5) { $0.receive(on: queue) }
+            .expectsOne(timeout: 2, on: self)
+        XCTAssertGreaterThan(report.generated, 0)
+        XCTAssertEqual(report.failures, 0)
+        XCTAssertEqual(report.received, report.generated)
+        XCTAssertGreaterThan(report.throughput, 0)
+        XCTAssertLessThanOrEqual(report.latency.p50, report.latency.p99)
+        XCTAssertLessThanOrEqual(report.latency.p99, report.latency.maximum)
+        XCTAssertLessThanOrEqual(report.duration, 1)
+    }
+
+    /// Tests that the generated updates are dated with the injected clock.
+    func testClockDates() {
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let configuration = Streamer.LoadGenerator.Configuration(epics: 5, rate: 1_000, kinds: [.tick, .candle])
+        let generator = Streamer.LoadGenerator(configuration: configuration, clock: VirtualClock(start: start))
+
+        let samples = generator.samples(duration: 0.1).expectsAll(timeout: 1, on: self)
+        XCTAssertFalse(samples.isEmpty)
+        for sample in samples {
+            switch sample.value {
+            case .tick(let tick): XCTAssertEqual(tick.date, start)
+            case .candle(let candle): XCTAssertEqual(candle.date, start)
+            default: XCTFail("Unexpected sample kind")
+            }
+        }
+    }
+}
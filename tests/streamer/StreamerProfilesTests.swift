@@ -0,0 +1,108 @@
+import IG
+import Combine
+import ConbiniForTesting
+import Decimals
+import XCTest
+
+final class StreamerProfilesTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the incremental session profile, its value area, and the storage of the finished sessions.
+    func testSessionProfile() throws {
+        let epic: IG.Market.Epic = "IX.D.DAX.IFD.IP"
+        let builder = Streamer.ProfileBuilder(binSizes: [epic: Decimal64(1, power: 0)!])
+
+        var finished: [Streamer.Profile] = []
+        let cancellable = builder.finished.sink { finished.append($0) }
+        defer { cancellable.cancel() }
+
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        builder.update(epic: epic, date: start, price: 100.5, volume: 10)
+        builder.update(epic: epic, date: start.addingTimeInterval(10), price: 101.2, volume: 30)
+        builder.update(epic: epic, date: start.addingTimeInterval(20), price: 99.9, volume: 5)
+        builder.update(epic: epic, date: start.addingTimeInterval(30), price: 101.7, volume: 20)
+        builder.update(epic: epic, date: start.addingTimeInterval(40), price: 103, volume: 40)
+        builder.update(epic: "CS.D.EURUSD.MINI.IP", date: start, price: 1.1, volume: 1)
+        XCTAssertNil(builder.profile(epic: "CS.D.EURUSD.MINI.IP"))
+        XCTAssertEqual(builder.pointOfControl(epic: epic), Decimal64(101, power: 0)!)
+
+        let ongoing = try XCTUnwrap(builder.profile(epic: epic))
+        XCTAssertEqual(ongoing.base, Decimal64(99, power: 0)!)
+        XCTAssertEqual(ongoing.bins.map { $0.volume }, [5, 10, 50, 0, 40])
+        XCTAssertEqual(ongoing.bins[2].ticks, 2)
+        XCTAssertEqual(ongoing.bins[2].time, 20, accuracy: 0.0001)
+        XCTAssertEqual(ongoing.volume, 105, accuracy: 0.0001)
+        XCTAssertEqual(ongoing.valueArea(fraction: 0.5), Decimal64(100, power: 0)!...Decimal64(101, power: 0)!)
+        XCTAssertTrue(finished.isEmpty)
+
+        builder.update(epic: epic, date: start.addingTimeInterval(86_405), price: 100, volume: 1)
+        XCTAssertEqual(finished.count, 1)
+        XCTAssertEqual(finished[0].start, start)
+        XCTAssertEqual(finished[0].bins, ongoing.bins)
+        XCTAssertEqual(builder.profile(epic: epic)?.start, start.addingTimeInterval(86_400))
+
+        let database = try Database(location: .memory)
+        database.profiles.update(finished).expectsCompletion(timeout: 0.5, on: self)
+
+        let stored = database.profiles.get(epic: epic).expectsOne(timeout: 0.5, on: self)
+        XCTAssertEqual(stored.count, 1)
+        XCTAssertEqual(stored[0].end, start.addingTimeInterval(86_400))
+        XCTAssertEqual(stored[0].base, Decimal64(99, power: 0)!)
+        XCTAssertEqual(stored[0].bins, ongoing.bins)
+        XCTAssertEqual(stored[0].pointOfControl, Decimal64(101, power: 0)!)
+        XCTAssertTrue(database.profiles.get(epic: epic, from: start.addingTimeInterval(1)).expectsOne(timeout: 0.5, on: self).isEmpty)
+    }
+
+    /// Tests that the ongoing and the snapshot point of control break ties the same way (the lowest price level wins).
+    func testPointOfControlTies() throws {
+        let epic: IG.Market.Epic = "IX.D.DAX.IFD.IP"
+        let builder = Streamer.ProfileBuilder(binSizes: [epic: Decimal64(1, power: 0)!])
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+
+        // The higher level reaches the maximum volume first.
+        builder.update(epic: epic, date: start, price: 105, volume: 20)
+        builder.update(epic: epic, date: start.addingTimeInterval(10), price: 101, volume: 20)
+        XCTAssertEqual(builder.pointOfControl(epic: epic), Decimal64(101, power: 0)!)
+        XCTAssertEqual(try XCTUnwrap(builder.profile(epic: epic)).pointOfControl, Decimal64(101, power: 0)!)
+
+        builder.update(epic: epic, date: start.addingTimeInterval(20), price: 103, volume: 20)
+        XCTAssertEqual(builder.pointOfControl(epic: epic), Decimal64(101, power: 0)!)
+        builder.update(epic: epic, date: start.addingTimeInterval(30), price: 105, volume: 1)
+        XCTAssertEqual(builder.pointOfControl(epic: epic), Decimal64(105, power: 0)!)
+        XCTAssertEqual(try XCTUnwrap(builder.profile(epic: epic)).pointOfControl, Decimal64(105, power: 0)!)
+    }
+
+    /// Tests that prices lying on bin edges are binned on their own level, and that outliers stretching the profile beyond its maximum span are ignored.
+    func testBinEdgesAndOutliers() throws {
+        let (eurusd, index): (IG.Market.Epic, IG.Market.Epic) = ("CS.D.EURUSD.MINI.IP", "IX.D.DAX.IFD.IP")
+        let builder = Streamer.ProfileBuilder(binSizes: [eurusd: Decimal64(1, power: -4)!, index: Decimal64(1, power: -1)!], maximumBins: 100)
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+
+        // `1.1012 / 0.0001` and `0.3 / 0.1` fall right below the bin edges in floating-point arithmetic.
+        builder.update(epic: eurusd, date: start, price: 1.1012, volume: 1)
+        builder.update(epic: eurusd, date: start.addingTimeInterval(1), price: 1.1013, volume: 2)
+        var profile = try XCTUnwrap(builder.profile(epic: eurusd))
+        XCTAssertEqual(profile.base, Decimal64(11012, power: -4)!)
+        XCTAssertEqual(profile.bins.map { $0.volume }, [1, 2])
+        XCTAssertEqual(builder.pointOfControl(epic: eurusd), Decimal64(11013, power: -4)!)
+
+        for (offset, price) in [0.3, 0.6, 0.7].enumerated() {
+            builder.update(epic: index, date: start.addingTimeInterval(TimeInterval(offset)), price: price, volume: 1)
+        }
+        profile = try XCTUnwrap(builder.profile(epic: index))
+        XCTAssertEqual(profile.base, Decimal64(3, power: -1)!)
+        XCTAssertEqual(profile.bins.map { $0.volume }, [1, 0, 0, 1, 1])
+
+        // A zero price or a spike would allocate thousands of empty bins.
+        builder.update(epic: eurusd, date: start.addingTimeInterval(2), price: 0, volume: 1)
+        builder.update(epic: eurusd, date: start.addingTimeInterval(3), price: 2.2, volume: 1)
+        builder.update(epic: eurusd, date: start.addingTimeInterval(4), price: 1.1111, volume: 1)
+        profile = try XCTUnwrap(builder.profile(epic: eurusd))
+        XCTAssertEqual(profile.bins.count, 100)
+        XCTAssertEqual(profile.volume, 4, accuracy: 0.0001)
+        builder.update(epic: eurusd, date: start.addingTimeInterval(5), price: 1.1112, volume: 1)
+        XCTAssertEqual(try XCTUnwrap(builder.profile(epic: eurusd)).bins.count, 100)
+    }
+}
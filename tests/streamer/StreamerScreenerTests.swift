@@ -0,0 +1,74 @@
+#if DEBUG
+@testable import IG
+import Decimals
+import XCTest
+
+final class StreamerScreenerTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that the metric rankings are repositioned incrementally on every market update.
+    func testIncrementalRanking() throws {
+        let (eurusd, gbpusd, usdjpy): (IG.Market.Epic, IG.Market.Epic, IG.Market.Epic) = ("CS.D.EURUSD.MINI.IP", "CS.D.GBPUSD.MINI.IP", "CS.D.USDJPY.MINI.IP")
+        let screener = Streamer.Screener(metrics: [.changePercentage, .spread])
+        let epics: ([(epic: IG.Market.Epic, value: Decimal64)]) -> [IG.Market.Epic] = { $0.map { $0.epic } }
+
+        screener.update(try Self._market(epic: eurusd, bid: "10", ask: "12", change: "0.5"))
+        screener.update(try Self._market(epic: gbpusd, bid: "10", ask: "11", change: "1.5"))
+        screener.update(try Self._market(epic: usdjpy, bid: "10", ask: "13", change: "-0.5"))
+        XCTAssertEqual(screener.count, 3)
+        XCTAssertEqual(epics(screener.top(3, by: .changePercentage)), [gbpusd, eurusd, usdjpy])
+        XCTAssertEqual(epics(screener.top(2, by: .spread, order: .ascending)), [gbpusd, eurusd])
+
+        // A market overtaking the leader moves to the top (the other metrics keep their order).
+        screener.update(try Self._market(epic: usdjpy, bid: nil, ask: nil, change: "2.5"))
+        let movers = screener.top(3, by: .changePercentage)
+        XCTAssertEqual(epics(movers), [usdjpy, gbpusd, eurusd])
+        XCTAssertEqual(movers.first!.value, Decimal64(25, power: -1)!)
+        XCTAssertEqual(epics(screener.top(3, by: .spread)), [usdjpy, eurusd, gbpusd])
+
+        // Missing fields keep their previous values; ties are repositioned without losing any market.
+        screener.update(try Self._market(epic: gbpusd, bid: nil, ask: "12", change: nil))
+        screener.update(try Self._market(epic: eurusd, bid: "11", ask: nil, change: nil))
+        XCTAssertEqual(screener.row(epic: gbpusd)!.bid, Decimal64(10, power: 0)!)
+        XCTAssertEqual(screener.row(epic: gbpusd)!.changePercentage, Decimal64(15, power: -1)!)
+        let spreads = screener.top(3, by: .spread, order: .ascending)
+        XCTAssertEqual(epics(spreads), [eurusd, gbpusd, usdjpy])
+        XCTAssertEqual(spreads.map { $0.value }, [1, 2, 3].map { Decimal64($0, power: 0)! })
+
+        // Metrics registered later are built from the current table and keep updating.
+        screener.register(.relativeSpread)
+        XCTAssertEqual(epics(screener.top(1, by: .relativeSpread)), [usdjpy])
+        screener.update(try Self._market(epic: eurusd, bid: "5", ask: nil, change: "-1"))
+        XCTAssertEqual(epics(screener.top(1, by: .relativeSpread)), [eurusd])
+        XCTAssertEqual(epics(screener.top(3, by: .changePercentage, order: .ascending)), [eurusd, gbpusd, usdjpy])
+
+        screener.unregister(metric: Streamer.Screener.Metric.spread.name)
+        XCTAssertTrue(screener.top(3, by: .spread).isEmpty)
+        XCTAssertEqual(screener.metrics, ["changePercentage", "relativeSpread"])
+    }
+}
+
+private extension StreamerScreenerTests {
+    /// Lightstreamer item update backed by a dictionary.
+    struct _Update: StreamerItemUpdate {
+        let itemName: String?
+        let values: [String:String]
+
+        func value(withFieldName fieldName: String) -> String? {
+            self.values[fieldName]
+        }
+    }
+
+    /// Decodes a market update carrying only the given (non-`nil`) prices and daily change percentage.
+    static func _market(epic: IG.Market.Epic, bid: String?, ask: String?, change: String?) throws -> Streamer.Market {
+        var values: [String:String] = [:]
+        values[Streamer.Market.Field.bid.rawValue] = bid
+        values[Streamer.Market.Field.ask.rawValue] = ask
+        values[Streamer.Market.Field.dayChangePercentage.rawValue] = change
+        let update = _Update(itemName: "MARKET:\(epic)", values: values)
+        return try Streamer.Market(epic: epic, update: update, timeFormatter: DateFormatter(), now: Date(), fields: [.bid, .ask, .dayChangePercentage])
+    }
+}
+#endif
@@ -0,0 +1,43 @@
+import IG
+import Combine
+import XCTest
+
+final class StreamerStalenessTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that supervised items are flagged as stale when they are not reset, and recovered once they are.
+    func testStaleAndRecovered() {
+        let monitor = Streamer.StalenessMonitor<String>(resolution: 0.01)
+
+        let stale = self.expectation(description: "Stale item")
+        stale.assertForOverFulfill = false
+        let recovered = self.expectation(description: "Recovered item")
+        let cancellable = monitor.events.sink {
+            switch $0 {
+            case .stale(let key, let lastUpdate):
+                XCTAssertEqual(key, "A")
+                XCTAssertNotNil(lastUpdate)
+                stale.fulfill()
+            case .recovered(let key):
+                XCTAssertEqual(key, "A")
+                recovered.fulfill()
+            }
+        }
+
+        monitor.supervise("A", interval: 0.1)
+        monitor.supervise("B", interval: 10)
+        monitor.reset("A")
+        self.wait(for: [stale], timeout: 1)
+        XCTAssertEqual(monitor.staleKeys, ["A"])
+
+        monitor.reset("A")
+        self.wait(for: [recovered], timeout: 1)
+        XCTAssertTrue(monitor.staleKeys.isEmpty)
+
+        monitor.unsupervise("A")
+        XCTAssertEqual(monitor.keys, ["B"])
+        cancellable.cancel()
+    }
+}
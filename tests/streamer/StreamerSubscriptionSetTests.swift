@@ -0,0 +1,105 @@
+#if DEBUG
+@testable import IG
+import Combine
+import XCTest
+
+final class StreamerSubscriptionSetTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that inserting and removing members only subscribes/unsubscribes the delta, and that finished members are dropped.
+    func testMembershipDeltas() {
+        let members = _Members(keys: ["A", "B", "C"])
+        let set = Streamer.SubscriptionSet<String,Int>(keys: ["A", "B"], generator: members.publisher(key:))
+        XCTAssertTrue(members.active.isEmpty)
+
+        var (values, completion) = ([Int](), Subscribers.Completion<IG.Error>?.none)
+        let cancellable = set.publisher.sink(receiveCompletion: { completion = $0 }, receiveValue: { values.append($0) })
+        defer { cancellable.cancel() }
+        XCTAssertEqual(members.active, ["A", "B"])
+
+        members.subjects["A"]!.send(1)
+        members.subjects["B"]!.send(2)
+        XCTAssertEqual(values, [1, 2])
+
+        // 1. Only the new members are subscribed (the existing ones keep their subscriptions).
+        XCTAssertEqual(set.insert(["B", "C"]), ["C"])
+        XCTAssertEqual(members.active, ["A", "B", "C"])
+        XCTAssertEqual(members.subscriptions, ["A": 1, "B": 1, "C": 1])
+
+        // 2. Removed members are unsubscribed and their updates are not forwarded anymore.
+        XCTAssertEqual(set.remove(["A", "D"]), ["A"])
+        XCTAssertEqual(members.active, ["B", "C"])
+        members.subjects["A"]!.send(3)
+        members.subjects["C"]!.send(4)
+        XCTAssertEqual(values, [1, 2, 4])
+
+        // 3. Finished members are dropped; the set completes once no members remain.
+        members.subjects["B"]!.send(completion: .finished)
+        XCTAssertEqual(set.keys, ["C"])
+        XCTAssertNil(completion)
+        members.subjects["C"]!.send(completion: .finished)
+        XCTAssertTrue(set.keys.isEmpty)
+        XCTAssertNotNil(completion)
+        guard case .finished = completion! else { return XCTFail("The set should have completed successfully") }
+        XCTAssertTrue(set.insert(["A"]).isEmpty)
+    }
+
+    /// Tests that a failing member fails the whole set and cancels the rest of the members.
+    func testMemberFailure() {
+        let members = _Members(keys: ["A", "B"])
+        let set = Streamer.SubscriptionSet<String,Int>(keys: ["A", "B"], generator: members.publisher(key:))
+
+        var completion: Subscribers.Completion<IG.Error>? = nil
+        let cancellable = set.publisher.sink(receiveCompletion: { completion = $0 }, receiveValue: { _ in })
+        defer { cancellable.cancel() }
+        XCTAssertEqual(members.active, ["A", "B"])
+
+        members.subjects["A"]!.send(completion: .failure(IG.Error(.streamer(.subscriptionFailed), "Test failure")))
+        guard case .failure = completion else { return XCTFail("The set should have failed") }
+        XCTAssertTrue(members.active.isEmpty)
+        XCTAssertTrue(set.insert(["C"]).isEmpty)
+    }
+
+    /// Tests that cancelling the set's subscriber tears down all member subscriptions.
+    func testCancellation() {
+        let members = _Members(keys: ["A", "B"])
+        let set = Streamer.SubscriptionSet<String,Int>(keys: ["A"], generator: members.publisher(key:))
+
+        let cancellable = set.publisher.sink(receiveCompletion: { _ in }, receiveValue: { _ in })
+        set.insert(["B"])
+        XCTAssertEqual(members.active, ["A", "B"])
+        cancellable.cancel()
+        XCTAssertTrue(members.active.isEmpty)
+    }
+}
+
+private extension StreamerSubscriptionSetTests {
+    /// Fake member subscriptions keeping track of the active ones.
+    final class _Members {
+        /// The subject backing every member.
+        let subjects: [String:PassthroughSubject<Int,IG.Error>]
+        /// The members currently subscribed.
+        private(set) var active: Set<String> = []
+        /// The number of times every member has been subscribed.
+        private(set) var subscriptions: [String:Int] = [:]
+
+        init(keys: [String]) {
+            self.subjects = Dictionary(uniqueKeysWithValues: keys.map { ($0, PassthroughSubject()) })
+        }
+
+        /// Returns the subscription publisher for the given member.
+        func publisher(key: String) -> AnyPublisher<Int,IG.Error> {
+            self.subjects[key]!.handleEvents(receiveSubscription: { [unowned self] _ in
+                self.active.insert(key)
+                self.subscriptions[key, default: 0] += 1
+            }, receiveCompletion: { [unowned self] _ in
+                self.active.remove(key)
+            }, receiveCancel: { [unowned self] in
+                self.active.remove(key)
+            }).eraseToAnyPublisher()
+        }
+    }
+}
+#endif
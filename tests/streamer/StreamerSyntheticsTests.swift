@@ -0,0 +1,86 @@
+import IG
+import Combine
+import Decimals
+import XCTest
+
+final class StreamerSyntheticsTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests the synthetic quotes and candles computed from the legs' prices.
+    func testSyntheticCross() {
+        let (usdsek, usdnok): (IG.Market.Epic, IG.Market.Epic) = ("CS.D.USDSEK.CFD.IP", "CS.D.USDNOK.CFD.IP")
+        let noksek: IG.Market.Epic = "SY.D.NOKSEK.CFD.IP"
+        let engine = Streamer.Synthetics([.ratio(epic: noksek, usdsek, usdnok)], interval: .minute)
+        XCTAssertEqual(engine.legs, [usdsek, usdnok])
+
+        var candles: [Streamer.Chart.Aggregated] = []
+        let cancellable = engine.candles.sink { candles.append($0) }
+        defer { cancellable.cancel() }
+
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        engine.update(epic: usdsek, bid: Decimal64(8, power: 0)!, ask: Decimal64(10, power: 0)!, date: start)
+        XCTAssertNil(engine.quote(epic: noksek))
+
+        engine.update(epic: usdnok, bid: Decimal64(2, power: 0)!, ask: Decimal64(4, power: 0)!, date: start.addingTimeInterval(1))
+        let quote = engine.quote(epic: noksek)!
+        XCTAssertEqual(quote.bid, Decimal64(2, power: 0)!)
+        XCTAssertEqual(quote.ask, Decimal64(5, power: 0)!)
+
+        engine.update(epic: usdnok, bid: Decimal64(1, power: 0)!, ask: nil, date: start.addingTimeInterval(2))
+        engine.update(epic: usdsek, bid: Decimal64(12, power: 0)!, ask: nil, date: start.addingTimeInterval(61))
+        XCTAssertEqual(candles.count, 4)
+        XCTAssertEqual(candles[2].candle.isFinished, true)
+        XCTAssertEqual(candles[2].candle.numTicks, 2)
+        XCTAssertEqual(candles[2].candle.highest.ask, Decimal64(10, power: 0)!)
+        XCTAssertEqual(candles[3].candle.open.bid, Decimal64(3, power: 0)!)
+        XCTAssertEqual(candles[3].candle.date, start.addingTimeInterval(60))
+
+        engine.unregister(epic: noksek)
+        XCTAssertTrue(engine.legs.isEmpty)
+    }
+
+    /// Tests that leg updates without a publish time are dated by the injected clock.
+    func testClockDates() {
+        let (usdsek, usdnok): (IG.Market.Epic, IG.Market.Epic) = ("CS.D.USDSEK.CFD.IP", "CS.D.USDNOK.CFD.IP")
+        let noksek: IG.Market.Epic = "SY.D.NOKSEK.CFD.IP"
+        let start = Date(timeIntervalSince1970: 1_600_041_600)
+        let clock = VirtualClock(start: start)
+        let engine = Streamer.Synthetics([.ratio(epic: noksek, usdsek, usdnok)], interval: .minute, clock: clock)
+
+        engine.update(epic: usdsek, bid: Decimal64(8, power: 0)!, ask: Decimal64(10, power: 0)!)
+        clock.advance(by: 5)
+        engine.update(epic: usdnok, bid: Decimal64(2, power: 0)!, ask: Decimal64(4, power: 0)!)
+        XCTAssertEqual(engine.quote(epic: noksek)!.date, start.addingTimeInterval(5))
+
+        clock.advance(by: 60)
+        engine.update(epic: usdnok, bid: Decimal64(1, power: 0)!, ask: nil)
+        XCTAssertEqual(engine.quote(epic: noksek)!.date, start.addingTimeInterval(65))
+    }
+
+    /// Tests that the legs' prices are normalized by their scaling factors before being combined.
+    func testScalingFactors() {
+        let (eurusd, usdjpy): (IG.Market.Epic, IG.Market.Epic) = ("CS.D.EURUSD.MINI.IP", "CS.D.USDJPY.MINI.IP")
+        let eurjpy: IG.Market.Epic = "SY.D.EURJPY.MINI.IP"
+        let definition = Streamer.Synthetics.Definition(epic: eurjpy, legs: [
+            .init(epic: eurusd, scalingFactor: 10_000),
+            .init(epic: usdjpy, scalingFactor: 100)
+        ])
+        let engine = Streamer.Synthetics([definition])
+
+        // EURUSD is quoted in points (1.1250/1.1252) and USDJPY in pips (110.00/110.02).
+        engine.update(epic: eurusd, bid: Decimal64(11_250, power: 0)!, ask: Decimal64(11_252, power: 0)!)
+        engine.update(epic: usdjpy, bid: Decimal64(11_000, power: 0)!, ask: Decimal64(11_002, power: 0)!)
+        let quote = engine.quote(epic: eurjpy)!
+        XCTAssertEqual(quote.bid, Decimal64(12_375, power: -2)!)
+        XCTAssertEqual(quote.ask, Decimal64(123_794_504, power: -6)!)
+
+        // Inverted legs are normalized before being inverted.
+        let usdeur: IG.Market.Epic = "SY.D.USDEUR.MINI.IP"
+        engine.register(.init(epic: usdeur, legs: [.init(epic: eurusd, isInverted: true, scalingFactor: 10_000)]))
+        engine.update(epic: eurusd, bid: Decimal64(12_500, power: 0)!, ask: Decimal64(20_000, power: 0)!)
+        XCTAssertEqual(engine.quote(epic: usdeur)!.bid, Decimal64(5, power: -1)!)
+        XCTAssertEqual(engine.quote(epic: usdeur)!.ask, Decimal64(8, power: -1)!)
+    }
+}
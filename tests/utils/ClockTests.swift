@@ -0,0 +1,70 @@
+import IG
+import Combine
+import XCTest
+
+final class ClockTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that advancing a virtual clock executes the scheduled closures in date order (skipping the cancelled ones).
+    func testVirtualClockAdvance() {
+        let start = Date(timeIntervalSince1970: 1_600_000_000)
+        let clock = VirtualClock(start: start)
+        let queue = DispatchQueue.main
+
+        var fired: [(Int,Date)] = []
+        let first = clock.schedule(at: start.addingTimeInterval(20), on: queue) { fired.append((2, clock.now)) }
+        let second = clock.schedule(at: start.addingTimeInterval(10), on: queue) { fired.append((1, clock.now)) }
+        let third = clock.schedule(at: start.addingTimeInterval(30), on: queue) { fired.append((3, clock.now)) }
+        XCTAssertEqual(clock.pending, 3)
+
+        third.cancel()
+        XCTAssertEqual(clock.pending, 2)
+
+        clock.advance(by: 15)
+        XCTAssertEqual(fired.map { $0.0 }, [1])
+        XCTAssertEqual(fired.last!.1, start.addingTimeInterval(10))
+        XCTAssertEqual(clock.now, start.addingTimeInterval(15))
+
+        clock.advance(to: start.addingTimeInterval(3_600))
+        XCTAssertEqual(fired.map { $0.0 }, [1, 2])
+        XCTAssertEqual(fired.last!.1, start.addingTimeInterval(20))
+        XCTAssertEqual(clock.now, start.addingTimeInterval(3_600))
+        XCTAssertEqual(clock.pending, 0)
+        _ = (first, second)
+    }
+
+    /// Tests that closures are always executed on the queue given when scheduling them (whether reached by advancing the clock or scheduled in the past).
+    func testVirtualClockQueues() {
+        let start = Date(timeIntervalSince1970: 1_600_000_000)
+        let clock = VirtualClock(start: start)
+        let (queue, key) = (DispatchQueue(label: "clock.tests"), DispatchSpecificKey<Int>())
+        queue.setSpecific(key: key, value: 1)
+
+        var (onQueue, dates) = ([Bool](), [Date]())
+        let scheduled = clock.schedule(at: start.addingTimeInterval(10), on: queue) {
+            onQueue.append(DispatchQueue.getSpecific(key: key) == 1)
+            dates.append(clock.now)
+        }
+        // Advancing waits for the closure to finish on its queue.
+        clock.advance(by: 20)
+        XCTAssertEqual(onQueue, [true])
+        XCTAssertEqual(dates, [start.addingTimeInterval(10)])
+
+        // Advancing from the closure's queue executes the closure in place (without deadlocking).
+        let nested = clock.schedule(at: start.addingTimeInterval(30), on: queue) { onQueue.append(DispatchQueue.getSpecific(key: key) == 1) }
+        queue.sync { clock.advance(by: 20) }
+        XCTAssertEqual(onQueue, [true, true])
+
+        // Closures scheduled in the past are dispatched right away on their queue.
+        let expectation = self.expectation(description: "Past closure")
+        let past = clock.schedule(at: start, on: queue) {
+            onQueue.append(DispatchQueue.getSpecific(key: key) == 1)
+            expectation.fulfill()
+        }
+        self.wait(for: [expectation], timeout: 1)
+        XCTAssertEqual(queue.sync { onQueue }, [true, true, true])
+        _ = (scheduled, nested, past)
+    }
+}
@@ -0,0 +1,67 @@
+#if DEBUG
+@testable import IG
+import XCTest
+
+final class TimerWheelTests: XCTestCase {
+    override func setUp() {
+        self.continueAfterFailure = false
+    }
+
+    /// Tests that keys on every wheel level expire exactly at their deadlines (across several rotations of the lower levels), and that cancelled or rescheduled keys don't.
+    func testExpiryAcrossRotations() {
+        // The starting tick is right before a level 1 rotation (64 * 64 ticks).
+        let start: UInt64 = 4_090
+        var wheel = TimerWheel<Int>(tick: start)
+        let deadlines: [Int:UInt64] = [
+            0: start + 1, 1: start + 6, 2: start + 63, 3: start + 64,     // level 0 (and the boundary with level 1)
+            4: start + 100, 5: start + 4_095, 6: start + 4_096,          // level 1 (and the boundary with level 2)
+            7: start + 10_000, 8: start + 262_143, 9: start + 262_144,   // level 2 (and the boundary with level 3)
+            10: start + 300_000
+        ]
+        for (key, deadline) in deadlines { wheel.schedule(key, at: deadline) }
+        XCTAssertEqual(wheel.count, deadlines.count)
+        XCTAssertEqual(wheel.deadline(for: 7), start + 10_000)
+
+        // Cancelled keys never expire; rescheduled keys only expire at their new deadline.
+        XCTAssertTrue(wheel.cancel(4))
+        XCTAssertFalse(wheel.cancel(4))
+        wheel.schedule(1, at: start + 5_000)
+        XCTAssertEqual(wheel.count, deadlines.count - 1)
+
+        var expected = deadlines
+        expected.removeValue(forKey: 4)
+        expected[1] = start + 5_000
+
+        var expired: [Int:UInt64] = [:]
+        for tick in (start + 1)...(start + 300_000) {
+            for key in wheel.advance(to: tick) {
+                XCTAssertNil(expired.updateValue(tick, forKey: key), "Key \(key) expired twice")
+            }
+        }
+        XCTAssertEqual(expired, expected)
+        XCTAssertEqual(wheel.count, 0)
+        XCTAssertEqual(wheel.tick, start + 300_000)
+    }
+
+    /// Tests that jumping several ticks at once reports all due keys and that deadlines in the past expire on the next advance.
+    func testJumpsAndPastDeadlines() {
+        var wheel = TimerWheel<String>(tick: 10)
+        wheel.schedule("past", at: 3)
+        wheel.schedule("near", at: 70)
+        wheel.schedule("far", at: 20_000)
+        XCTAssertEqual(wheel.advance(to: 11), ["past"])
+
+        // Lower ticks don't move the wheel backwards.
+        XCTAssertTrue(wheel.advance(to: 5).isEmpty)
+        XCTAssertEqual(wheel.tick, 11)
+
+        XCTAssertEqual(Set(wheel.advance(to: 19_999)), ["near"])
+        XCTAssertEqual(wheel.advance(to: 1_000_000), ["far"])
+        XCTAssertEqual(wheel.count, 0)
+
+        // An empty wheel jumps straight to the given tick.
+        XCTAssertTrue(wheel.advance(to: 5_000_000).isEmpty)
+        XCTAssertEqual(wheel.tick, 5_000_000)
+    }
+}
+#endif